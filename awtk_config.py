@@ -95,6 +95,10 @@ COMMON_CCFLAGS=COMMON_CCFLAGS+' -DWITH_MBEDTLS=1 '
 COMMON_CCFLAGS=COMMON_CCFLAGS+' -DENABLE_CURSOR=1 '
 COMMON_CCFLAGS=COMMON_CCFLAGS+' -DWITH_TEXT_BIDI=1 '
 #COMMON_CCFLAGS=COMMON_CCFLAGS+' -DLOAD_ASSET_WITH_MMAP=1 '
+#COMMON_CCFLAGS=COMMON_CCFLAGS+' -DWITHOUT_PARALLEL_PAINT=1 '
+#COMMON_CCFLAGS=COMMON_CCFLAGS+' -DWITH_DISPLAY_LIST=1 '
+#COMMON_CCFLAGS=COMMON_CCFLAGS+' -DWITH_PAINT_PROFILER=1 '
+#COMMON_CCFLAGS=COMMON_CCFLAGS+' -DWITH_WINDOW_SNAPSHOT_RGB565=1 '
 COMMON_CCFLAGS=COMMON_CCFLAGS+' -DWITH_DATA_READER_WRITER=1 '
 COMMON_CCFLAGS=COMMON_CCFLAGS+' -DWITH_EVENT_RECORDER_PLAYER=1 '
 COMMON_CCFLAGS=COMMON_CCFLAGS+' -DWITH_ASSET_LOADER -DWITH_FS_RES -DWITH_ASSET_LOADER_ZIP ' 
@@ -0,0 +1,400 @@
+﻿/**
+ * File:   render_bench.c
+ * Author: AWTK Develop Team
+ * Brief:  headless rendering benchmark on lcd_mem
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#include "awtk.h"
+#include "tkc/fs.h"
+#include "tkc/time_now.h"
+#include "base/system_info.h"
+#include "lcd/lcd_mem_bgr565.h"
+#include "lcd/lcd_mem_rgb565.h"
+#include "lcd/lcd_mem_bgr888.h"
+#include "lcd/lcd_mem_rgb888.h"
+#include "lcd/lcd_mem_bgra8888.h"
+#include "lcd/lcd_mem_rgba8888.h"
+#include "ext_widgets/ext_widgets.h"
+#include "demos/assets.h"
+
+#define BENCH_LCD_W 800
+#define BENCH_LCD_H 480
+#define BENCH_DEFAULT_MIN_TIME_MS 200
+#define BENCH_DEFAULT_OUTPUT "render_bench.json"
+
+typedef lcd_t* (*bench_lcd_create_t)(wh_t w, wh_t h, uint8_t* fbuff);
+
+typedef struct _bench_format_t {
+  const char* name;
+  uint32_t bpp;
+  bench_lcd_create_t create;
+} bench_format_t;
+
+typedef struct _bench_ctx_t {
+  bitmap_t image;
+  bitmap_t opaque_image;
+  bitmap_t patch9_image;
+  gradient_t gradient;
+  widget_t* win;
+} bench_ctx_t;
+
+typedef ret_t (*bench_run_t)(canvas_t* c, bench_ctx_t* ctx);
+
+typedef struct _bench_case_t {
+  const char* name;
+  bench_run_t run;
+} bench_case_t;
+
+static const bench_format_t s_formats[] = {
+    {"bgra8888", 4, lcd_mem_bgra8888_create_single_fb},
+    {"rgba8888", 4, lcd_mem_rgba8888_create_single_fb},
+    {"bgr888", 3, lcd_mem_bgr888_create_single_fb},
+    {"rgb888", 3, lcd_mem_rgb888_create_single_fb},
+    {"bgr565", 2, lcd_mem_bgr565_create_single_fb},
+    {"rgb565", 2, lcd_mem_rgb565_create_single_fb},
+};
+
+/*对demos中的界面做完整的widget_paint*/
+static const char* s_uis[] = {"main", "basic", "button", "edit", "list_view", "slide_view",
+                              "keyboard"};
+
+static ret_t bench_fill_rect(canvas_t* c, bench_ctx_t* ctx) {
+  canvas_set_fill_color(c, color_init(0x20, 0x60, 0xa0, 0xff));
+
+  return canvas_fill_rect(c, 100, 100, 400, 300);
+}
+
+static ret_t bench_fill_rect_alpha(canvas_t* c, bench_ctx_t* ctx) {
+  canvas_set_fill_color(c, color_init(0x20, 0x60, 0xa0, 0x80));
+
+  return canvas_fill_rect(c, 100, 100, 400, 300);
+}
+
+static ret_t bench_draw_image_1x(canvas_t* c, bench_ctx_t* ctx) {
+  bitmap_t* img = &(ctx->image);
+  rect_t src = rect_init(0, 0, img->w, img->h);
+  rect_t dst = rect_init(100, 100, img->w, img->h);
+
+  return canvas_draw_image(c, img, &src, &dst);
+}
+
+static ret_t bench_draw_image_opaque_1x(canvas_t* c, bench_ctx_t* ctx) {
+  bitmap_t* img = &(ctx->opaque_image);
+  rect_t src = rect_init(0, 0, img->w, img->h);
+  rect_t dst = rect_init(100, 100, img->w, img->h);
+
+  return canvas_draw_image(c, img, &src, &dst);
+}
+
+static ret_t bench_draw_image_scale_up(canvas_t* c, bench_ctx_t* ctx) {
+  bitmap_t* img = &(ctx->image);
+  rect_t src = rect_init(0, 0, img->w, img->h);
+  rect_t dst = rect_init(50, 10, img->w * 3 / 2, img->h * 3 / 2);
+
+  return canvas_draw_image(c, img, &src, &dst);
+}
+
+static ret_t bench_draw_image_scale_down(canvas_t* c, bench_ctx_t* ctx) {
+  bitmap_t* img = &(ctx->image);
+  rect_t src = rect_init(0, 0, img->w, img->h);
+  rect_t dst = rect_init(100, 100, img->w / 2, img->h / 2);
+
+  return canvas_draw_image(c, img, &src, &dst);
+}
+
+static ret_t bench_draw_image_patch9(canvas_t* c, bench_ctx_t* ctx) {
+  rect_t dst = rect_init(100, 100, 300, 60);
+
+  return canvas_draw_image_patch9(c, &(ctx->patch9_image), &dst);
+}
+
+static ret_t bench_draw_text(canvas_t* c, const char* font, const char* text) {
+  wstr_t str;
+  ret_t ret = RET_OK;
+
+  wstr_init(&str, 0);
+  wstr_set_utf8(&str, text);
+  canvas_set_font(c, font, 20);
+  canvas_set_text_color(c, color_init(0x10, 0x10, 0x10, 0xff));
+  ret = canvas_draw_text(c, str.str, str.size, 20, 100);
+  wstr_reset(&str);
+
+  return ret;
+}
+
+static ret_t bench_draw_text_latin(canvas_t* c, bench_ctx_t* ctx) {
+  return bench_draw_text(c, "default", "The quick brown fox jumps over the lazy dog 0123456789");
+}
+
+static ret_t bench_draw_text_cjk(canvas_t* c, bench_ctx_t* ctx) {
+  const char* text = "嵌入式图形界面性能测试：中文字符串的绘制速度";
+
+  return bench_draw_text(c, "default_full", text);
+}
+
+static ret_t bench_fill_rounded_rect(canvas_t* c, bench_ctx_t* ctx) {
+  rect_t r = rect_init(100, 100, 300, 200);
+  color_t color = color_init(0x20, 0x60, 0xa0, 0xff);
+
+  return canvas_fill_rounded_rect(c, &r, NULL, &color, 20);
+}
+
+static ret_t bench_stroke_rounded_rect(canvas_t* c, bench_ctx_t* ctx) {
+  rect_t r = rect_init(100, 100, 300, 200);
+  color_t color = color_init(0x20, 0x60, 0xa0, 0xff);
+
+  return canvas_stroke_rounded_rect(c, &r, NULL, &color, 20, 2);
+}
+
+static ret_t bench_fill_rect_gradient(canvas_t* c, bench_ctx_t* ctx) {
+  return canvas_fill_rect_gradient(c, 100, 100, 400, 300, &(ctx->gradient));
+}
+
+static ret_t bench_fill_rounded_rect_gradient(canvas_t* c, bench_ctx_t* ctx) {
+  rect_t r = rect_init(100, 100, 300, 200);
+
+  return canvas_fill_rounded_rect_gradient(c, &r, NULL, &(ctx->gradient), 20);
+}
+
+static ret_t bench_widget_paint(canvas_t* c, bench_ctx_t* ctx) {
+  return widget_paint(ctx->win, c);
+}
+
+static const bench_case_t s_cases[] = {
+    {"fill_rect", bench_fill_rect},
+    {"fill_rect_alpha", bench_fill_rect_alpha},
+    {"draw_image_1x", bench_draw_image_1x},
+    {"draw_image_opaque_1x", bench_draw_image_opaque_1x},
+    {"draw_image_scale_up", bench_draw_image_scale_up},
+    {"draw_image_scale_down", bench_draw_image_scale_down},
+    {"draw_image_patch9", bench_draw_image_patch9},
+    {"draw_text_latin", bench_draw_text_latin},
+    {"draw_text_cjk", bench_draw_text_cjk},
+    {"fill_rounded_rect", bench_fill_rounded_rect},
+    {"stroke_rounded_rect", bench_stroke_rounded_rect},
+    {"fill_rect_gradient", bench_fill_rect_gradient},
+    {"fill_rounded_rect_gradient", bench_fill_rounded_rect_gradient},
+};
+
+typedef struct _bench_t {
+  str_t json;
+  uint32_t nr;
+  uint64_t min_time_us;
+  const char* filter;
+} bench_t;
+
+static bool_t bench_match(bench_t* bench, const char* name, const char* format) {
+  if (bench->filter == NULL) {
+    return TRUE;
+  }
+
+  return strstr(name, bench->filter) != NULL || tk_str_eq(format, bench->filter);
+}
+
+/*先执行一次(加载字模和缓存等)，再重复执行到时间不少于min_time_us*/
+static ret_t bench_run(bench_t* bench, const char* name, const char* format, canvas_t* c,
+                       bench_run_t run, bench_ctx_t* ctx) {
+  uint32_t n = 0;
+  uint64_t cost = 0;
+  uint64_t start = 0;
+  dirty_rects_t dr;
+  rect_t r = rect_init(0, 0, BENCH_LCD_W, BENCH_LCD_H);
+  str_t* json = &(bench->json);
+
+  if (!bench_match(bench, name, format)) {
+    return RET_OK;
+  }
+
+  dirty_rects_init(&dr);
+  dirty_rects_add(&dr, &r);
+  canvas_begin_frame(c, &dr, LCD_DRAW_OFFLINE);
+
+  if (run(c, ctx) != RET_OK) {
+    canvas_end_frame(c);
+    log_warn("%s on %s is not supported, skip it\n", name, format);
+    return RET_NOT_IMPL;
+  }
+
+  start = time_now_us();
+  do {
+    run(c, ctx);
+    n++;
+    cost = time_now_us() - start;
+  } while (cost < bench->min_time_us);
+
+  canvas_end_frame(c);
+
+  if (bench->nr > 0) {
+    str_append_char(json, ',');
+  }
+  str_append(json, "\n    {");
+  str_append_json_str_pair(json, "case", name);
+  str_append_char(json, ',');
+  str_append_json_str_pair(json, "format", format);
+  str_append_char(json, ',');
+  str_append_json_int_pair(json, "iterations", n);
+  str_append_char(json, ',');
+  str_append_json_str(json, "total_us");
+  str_append_char(json, ':');
+  str_append_uint64(json, cost);
+  str_append_char(json, ',');
+  str_append_json_str(json, "us_per_op");
+  str_append_char(json, ':');
+  str_append_double(json, "%.3lf", (double)cost / n);
+  str_append_char(json, '}');
+  bench->nr++;
+
+  log_info("%-32s %-8s %10.3lfus\n", name, format, (double)cost / n);
+
+  return RET_OK;
+}
+
+static ret_t bench_run_uis(bench_t* bench, const char* format, canvas_t* c, bench_ctx_t* ctx) {
+  uint32_t i = 0;
+  char name[TK_NAME_LEN + 1];
+
+  for (i = 0; i < ARRAY_SIZE(s_uis); i++) {
+    tk_snprintf(name, sizeof(name), "widget_paint:%s", s_uis[i]);
+    if (!bench_match(bench, name, format)) {
+      continue;
+    }
+
+    ctx->win = window_open(s_uis[i]);
+    if (ctx->win == NULL) {
+      log_warn("open %s failed\n", s_uis[i]);
+      continue;
+    }
+
+    widget_move_resize(ctx->win, 0, 0, BENCH_LCD_W, BENCH_LCD_H);
+    widget_layout(ctx->win);
+    bench_run(bench, name, format, c, bench_widget_paint, ctx);
+    window_manager_close_window_force(window_manager(), ctx->win);
+    idle_dispatch();
+    ctx->win = NULL;
+  }
+
+  return RET_OK;
+}
+
+static ret_t bench_run_format(bench_t* bench, const bench_format_t* format, bench_ctx_t* ctx) {
+  canvas_t c;
+  uint32_t i = 0;
+  lcd_t* lcd = NULL;
+  uint32_t size = BENCH_LCD_W * BENCH_LCD_H * format->bpp;
+  uint8_t* fbuff = TKMEM_ALLOC(size);
+  return_value_if_fail(fbuff != NULL, RET_OOM);
+
+  memset(fbuff, 0xff, size);
+  lcd = format->create(BENCH_LCD_W, BENCH_LCD_H, fbuff);
+  canvas_init(&c, lcd, font_manager());
+
+  for (i = 0; i < ARRAY_SIZE(s_cases); i++) {
+    bench_run(bench, s_cases[i].name, format->name, &c, s_cases[i].run, ctx);
+  }
+  bench_run_uis(bench, format->name, &c, ctx);
+
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+  TKMEM_FREE(fbuff);
+
+  return RET_OK;
+}
+
+static ret_t bench_ctx_init(bench_ctx_t* ctx) {
+  memset(ctx, 0x00, sizeof(*ctx));
+
+  return_value_if_fail(
+      image_manager_get_bitmap(image_manager(), "gauge_bg", &(ctx->image)) == RET_OK, RET_FAIL);
+  return_value_if_fail(
+      image_manager_get_bitmap(image_manager(), "1", &(ctx->opaque_image)) == RET_OK, RET_FAIL);
+  return_value_if_fail(
+      image_manager_get_bitmap(image_manager(), "green_btn_n", &(ctx->patch9_image)) == RET_OK,
+      RET_FAIL);
+  gradient_init_from_str(&(ctx->gradient), "linear-gradient(180deg, #FF0000 0%, #0000FF 100%)");
+
+  return RET_OK;
+}
+
+static void show_usage(const char* app) {
+  log_info("Usage: %s [-o render_bench.json] [-t min_time_ms] [-f filter]\n", app);
+  log_info(
+      "  filter: part of the case name(such as draw_image) or a pixel format(such as bgr565)\n");
+}
+
+int main(int argc, char* argv[]) {
+  int i = 0;
+  uint32_t f = 0;
+  bench_t bench;
+  bench_ctx_t ctx;
+  const char* output = BENCH_DEFAULT_OUTPUT;
+
+  memset(&bench, 0x00, sizeof(bench));
+  bench.min_time_us = BENCH_DEFAULT_MIN_TIME_MS * 1000;
+
+  for (i = 1; i < argc; i++) {
+    if (tk_str_eq(argv[i], "-o") && i + 1 < argc) {
+      output = argv[++i];
+    } else if (tk_str_eq(argv[i], "-t") && i + 1 < argc) {
+      bench.min_time_us = (uint64_t)tk_atoi(argv[++i]) * 1000;
+    } else if (tk_str_eq(argv[i], "-f") && i + 1 < argc) {
+      bench.filter = argv[++i];
+    } else {
+      show_usage(argv[0]);
+      return 0;
+    }
+  }
+
+  return_value_if_fail(platform_prepare() == RET_OK, 1);
+  system_info_init(APP_SIMULATOR, NULL, NULL);
+  tk_init_internal();
+  assets_init();
+  tk_init_assets();
+  tk_ext_widgets_init();
+  widget_resize(window_manager(), BENCH_LCD_W, BENCH_LCD_H);
+
+  if (bench_ctx_init(&ctx) == RET_OK) {
+    str_init(&(bench.json), 64 * 1024);
+    str_append_char(&(bench.json), '{');
+    str_append_json_int_pair(&(bench.json), "width", BENCH_LCD_W);
+    str_append_char(&(bench.json), ',');
+    str_append_json_int_pair(&(bench.json), "height", BENCH_LCD_H);
+    str_append_char(&(bench.json), ',');
+    str_append_json_int_pair(&(bench.json), "min_time_ms", (int32_t)(bench.min_time_us / 1000));
+    str_append_char(&(bench.json), ',');
+    str_append_json_str(&(bench.json), "results");
+    str_append(&(bench.json), ":[");
+
+    for (f = 0; f < ARRAY_SIZE(s_formats); f++) {
+      bench_run_format(&bench, s_formats + f, &ctx);
+    }
+    str_append(&(bench.json), "\n]}\n");
+
+    if (file_write(output, bench.json.str, bench.json.size) == RET_OK) {
+      log_info("%u results are written to %s\n", bench.nr, output);
+    } else {
+      log_warn("write %s failed\n", output);
+    }
+    str_reset(&(bench.json));
+  } else {
+    log_warn("load images failed, please run it in the awtk root directory.\n");
+  }
+
+  tk_deinit_internal();
+
+  return 0;
+}
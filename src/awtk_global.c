@@ -21,6 +21,7 @@
 
 #include "awtk.h"
 #include "tkc/mem.h"
+#include "tkc/atom.h"
 #include "tkc/fscript.h"
 #include "base/idle.h"
 #include "base/timer.h"
@@ -32,6 +33,9 @@
 #include "base/font_manager.h"
 #include "base/input_method.h"
 #include "base/image_manager.h"
+#include "base/style_const.h"
+#include "base/glyph_atlas.h"
+#include "base/parallel_paint.h"
 #include "base/window_manager.h"
 #include "base/widget_factory.h"
 #include "base/assets_manager.h"
@@ -188,6 +192,7 @@ ret_t tk_init_internal(void) {
   font_loader_t* font_loader = NULL;
 
   s_ui_thread_id = tk_thread_self();
+  return_value_if_fail(tk_atom_init() == RET_OK, RET_FAIL);
 #ifndef WITHOUT_FSCRIPT
   fscript_global_init();
 #endif
@@ -239,6 +244,12 @@ ret_t tk_init_internal(void) {
   return_value_if_fail(font_manager_set_assets_manager(font_manager(), assets_manager()) == RET_OK,
                        RET_FAIL);
   return_value_if_fail(image_manager_set(image_manager_create()) == RET_OK, RET_FAIL);
+#ifndef WITHOUT_GLYPH_ATLAS
+  return_value_if_fail(
+      glyph_atlas_set(glyph_atlas_create(TK_GLYPH_ATLAS_PAGE_SIZE, TK_GLYPH_ATLAS_MAX_PAGES)) ==
+          RET_OK,
+      RET_FAIL);
+#endif /*WITHOUT_GLYPH_ATLAS*/
 #ifndef WITHOUT_WINDOW_ANIMATORS
   return_value_if_fail(window_animator_factory_set(window_animator_factory_create()) == RET_OK,
                        RET_FAIL);
@@ -297,6 +308,7 @@ ret_t tk_init(wh_t w, wh_t h, app_type_t app_type, const char* app_name, const c
 
 ret_t tk_deinit_internal(void) {
   idle_manager_dispatch(idle_manager());
+  parallel_paint_set_threads(0);
 #ifndef WITHOUT_CLIPBOARD
   clip_board_destroy(clip_board());
   clip_board_set(NULL);
@@ -349,10 +361,16 @@ ret_t tk_deinit_internal(void) {
 
   theme_destroy(theme());
   theme_set(NULL);
+  style_const_cache_clear();
 
   font_manager_destroy(font_manager());
   font_manager_set(NULL);
 
+#ifndef WITHOUT_GLYPH_ATLAS
+  glyph_atlas_destroy(glyph_atlas());
+  glyph_atlas_set(NULL);
+#endif /*WITHOUT_GLYPH_ATLAS*/
+
   locale_info_destroy(locale_info());
   locale_info_set(NULL);
 
@@ -376,6 +394,7 @@ ret_t tk_deinit_internal(void) {
   fscript_global_deinit();
 #endif
   tk_semaphore_destroy(s_clear_cache_semaphore);
+  tk_atom_deinit();
 
   return RET_OK;
 }
@@ -26,6 +26,7 @@
 #include "tkc/action_thread.h"
 #include "tkc/action_thread_pool.h"
 #include "tkc/asset_info.h"
+#include "tkc/atom.h"
 #include "tkc/buffer.h"
 #include "tkc/color.h"
 #include "tkc/color_parser.h"
@@ -74,6 +75,7 @@
 #include "tkc/platform.h"
 #include "tkc/qaction.h"
 #include "tkc/rect.h"
+#include "tkc/region.h"
 #include "tkc/ring_buffer.h"
 #include "tkc/rom_fs.h"
 #include "tkc/semaphore.h"
@@ -26,6 +26,7 @@
 #include "base/locale_info.h"
 #include "base/system_info.h"
 #include "base/assets_manager.h"
+#include "base/parallel_paint.h"
 #include "base/vgcanvas_asset_manager.inc"
 
 #define RAW_DIR "raw"
@@ -675,13 +676,16 @@ const asset_info_t* assets_manager_find_in_cache(assets_manager_t* am, asset_typ
 
 static const asset_info_t* assets_manager_ref_impl(assets_manager_t* am, asset_type_t type,
                                                    uint16_t subtype, const char* name) {
-  const asset_info_t* info = assets_manager_find_in_cache(am, type, subtype, name);
+  const asset_info_t* info = NULL;
 
+  parallel_paint_lock();
+  info = assets_manager_find_in_cache(am, type, subtype, name);
   if (info == NULL) {
     info = assets_manager_load_ex(am, type, subtype, name);
   } else {
     asset_info_ref((asset_info_t*)info);
   }
+  parallel_paint_unlock();
 
   return info;
 }
@@ -741,16 +745,21 @@ const asset_info_t* assets_manager_ref_ex(assets_manager_t* am, asset_type_t typ
 }
 
 ret_t assets_manager_unref(assets_manager_t* am, const asset_info_t* info) {
+  ret_t ret = RET_OK;
+
   if (am == NULL || info == NULL) {
     /*asset manager was destroied*/
     return RET_OK;
   }
 
+  parallel_paint_lock();
   if (info->refcount == 1) {
     assets_manager_dispatch_event(am, EVT_ASSET_MANAGER_UNLOAD_ASSET, (asset_info_t*)info);
   }
+  ret = asset_info_unref((asset_info_t*)info);
+  parallel_paint_unlock();
 
-  return asset_info_unref((asset_info_t*)info);
+  return ret;
 }
 
 ret_t assets_manager_clear_cache_ex(assets_manager_t* am, asset_type_t type, const char* name) {
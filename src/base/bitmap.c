@@ -65,6 +65,10 @@ ret_t bitmap_destroy(bitmap_t* bitmap) {
     TKMEM_FREE(bitmap->data_free_ptr);
   }
 
+  if (bitmap->alpha_runs != NULL && bitmap->alpha_runs->owner == bitmap) {
+    TKMEM_FREE(bitmap->alpha_runs);
+  }
+
   if (bitmap->should_free_handle) {
     memset(bitmap, 0x00, sizeof(bitmap_t));
     TKMEM_FREE(bitmap);
@@ -771,6 +775,14 @@ uint8_t* bitmap_lock_buffer_for_read(bitmap_t* bitmap) {
 uint8_t* bitmap_lock_buffer_for_write(bitmap_t* bitmap) {
   return_value_if_fail(bitmap != NULL, NULL);
 
+  /*数据可能被修改，alpha分段表失效(拷贝共用数据和分段表，分段表由owner释放)*/
+  if (bitmap->alpha_runs != NULL) {
+    bitmap->alpha_runs->invalid = TRUE;
+    if (bitmap->alpha_runs->owner != bitmap) {
+      bitmap->alpha_runs = NULL;
+    }
+  }
+
   if (bitmap->buffer != NULL) {
     if (!graphic_buffer_is_valid_for(bitmap->buffer, bitmap)) {
       assert(!" graphic_buffer is not valid ");
@@ -897,5 +909,127 @@ ret_t bitmap_transform(bitmap_t* bitmap, bitmap_transform_t transform, void* ctx
 uint32_t bitmap_get_mem_size(bitmap_t* bitmap) {
   return_value_if_fail(bitmap != NULL, 0);
 
-  return bitmap->w * bitmap->h * bitmap_get_bpp(bitmap);
+  uint32_t size = bitmap->w * bitmap->h * bitmap_get_bpp(bitmap);
+
+  if (bitmap->alpha_runs != NULL && bitmap->alpha_runs->owner == bitmap) {
+    uint32_t nr = bitmap->alpha_runs->lines[bitmap->h];
+    size += sizeof(bitmap_alpha_runs_t) + (bitmap->h + 1) * sizeof(uint32_t) +
+            nr * sizeof(uint16_t);
+  }
+
+  return size;
+}
+
+/*平均每段的像素个数小于该值时，分段表带来的好处抵不上它的开销*/
+#define BITMAP_ALPHA_RUNS_MIN_AVG_LEN 4
+
+static inline uint32_t bitmap_alpha_run_type(uint8_t a) {
+  if (a == 0) {
+    return BITMAP_ALPHA_RUN_TRANSPARENT;
+  } else if (a > 0xf8) {
+    return BITMAP_ALPHA_RUN_OPAQUE;
+  } else {
+    return BITMAP_ALPHA_RUN_TRANSLUCENT;
+  }
+}
+
+static uint32_t bitmap_alpha_runs_of_line(const uint8_t* p, uint32_t w, uint16_t* runs) {
+  uint32_t x = 0;
+  uint32_t nr = 0;
+
+  while (x < w) {
+    uint32_t len = 1;
+    uint32_t type = bitmap_alpha_run_type(p[x * 4 + 3]);
+
+    while (x + len < w && len < BITMAP_ALPHA_RUN_MAX_LEN &&
+           bitmap_alpha_run_type(p[(x + len) * 4 + 3]) == type) {
+      len++;
+    }
+
+    if (runs != NULL) {
+      runs[nr] = (uint16_t)((type << 14) | len);
+    }
+    nr++;
+    x += len;
+  }
+
+  return nr;
+}
+
+ret_t bitmap_build_alpha_runs(bitmap_t* bitmap) {
+  uint32_t y = 0;
+  uint32_t nr = 0;
+  uint16_t* runs = NULL;
+  uint32_t* lines = NULL;
+  const uint8_t* data = NULL;
+  bitmap_alpha_runs_t* table = NULL;
+  return_value_if_fail(bitmap != NULL && bitmap->buffer != NULL, RET_BAD_PARAMS);
+
+  if (bitmap->alpha_runs != NULL) {
+    if (!bitmap->alpha_runs->invalid) {
+      return RET_OK;
+    }
+
+    if (bitmap->alpha_runs->owner == bitmap) {
+      TKMEM_FREE(bitmap->alpha_runs);
+    }
+    bitmap->alpha_runs = NULL;
+  }
+
+  if ((bitmap->format != BITMAP_FMT_RGBA8888 && bitmap->format != BITMAP_FMT_BGRA8888) ||
+      (bitmap->flags & BITMAP_FLAG_OPAQUE) || bitmap->w == 0 || bitmap->h == 0) {
+    return RET_NOT_IMPL;
+  }
+
+  data = bitmap_lock_buffer_for_read(bitmap);
+  return_value_if_fail(data != NULL, RET_BAD_PARAMS);
+
+  for (y = 0; y < bitmap->h; y++) {
+    nr += bitmap_alpha_runs_of_line(data + y * bitmap->line_length, bitmap->w, NULL);
+  }
+
+  if (nr * BITMAP_ALPHA_RUNS_MIN_AVG_LEN > bitmap->w * bitmap->h) {
+    bitmap_unlock_buffer(bitmap);
+    return RET_NOT_IMPL;
+  }
+
+  table = (bitmap_alpha_runs_t*)TKMEM_ALLOC(
+      sizeof(bitmap_alpha_runs_t) + (bitmap->h + 1) * sizeof(uint32_t) + nr * sizeof(uint16_t));
+  if (table == NULL) {
+    bitmap_unlock_buffer(bitmap);
+    return RET_OOM;
+  }
+
+  nr = 0;
+  lines = (uint32_t*)(table + 1);
+  runs = (uint16_t*)(lines + bitmap->h + 1);
+  for (y = 0; y < bitmap->h; y++) {
+    lines[y] = nr;
+    nr += bitmap_alpha_runs_of_line(data + y * bitmap->line_length, bitmap->w, runs + nr);
+  }
+  lines[bitmap->h] = nr;
+  bitmap_unlock_buffer(bitmap);
+
+  table->owner = bitmap;
+  table->invalid = FALSE;
+  table->lines = lines;
+  table->runs = runs;
+  bitmap->alpha_runs = table;
+
+  return RET_OK;
+}
+
+const uint16_t* bitmap_get_alpha_runs(bitmap_t* bitmap, uint32_t y, uint32_t* nr) {
+  const bitmap_alpha_runs_t* table = NULL;
+  return_value_if_fail(bitmap != NULL && nr != NULL, NULL);
+
+  table = bitmap->alpha_runs;
+  if (table == NULL || table->invalid || y >= bitmap->h) {
+    *nr = 0;
+    return NULL;
+  }
+
+  *nr = table->lines[y + 1] - table->lines[y];
+
+  return table->runs + table->lines[y];
 }
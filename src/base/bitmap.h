@@ -109,6 +109,9 @@ struct _bitmap_t {
   bitmap_destroy_t destroy;
 
   image_manager_t* image_manager;
+
+  /*每一行按alpha分成的段(全透明/不透明/半透明)，用于加速图片合成，为NULL时表示没有。*/
+  struct _bitmap_alpha_runs_t* alpha_runs;
 };
 
 /**
@@ -475,6 +478,32 @@ bool_t rgba_data_is_opaque(const uint8_t* data, uint32_t w, uint32_t h, uint8_t
 
 ret_t bitmap_premulti_alpha(bitmap_t* bitmap);
 
+/*
+ * alpha分段表：每一段用一个uint16_t表示，高2位为类型，低14位为长度。
+ * 全透明(alpha为0)的段可以跳过，不透明(alpha大于0xf8)的段可以直接拷贝，半透明的段需要合成。
+ */
+#define BITMAP_ALPHA_RUN_TRANSPARENT 0
+#define BITMAP_ALPHA_RUN_OPAQUE 1
+#define BITMAP_ALPHA_RUN_TRANSLUCENT 2
+#define BITMAP_ALPHA_RUN_MAX_LEN 0x3fff
+#define BITMAP_ALPHA_RUN_TYPE(run) ((run) >> 14)
+#define BITMAP_ALPHA_RUN_LEN(run) ((run)&BITMAP_ALPHA_RUN_MAX_LEN)
+
+/*
+ * 只有创建分段表的图片(owner)负责释放它，图片的拷贝(如image_manager返回的图片)共用分段表。
+ * 共用的图片数据被任何一个拷贝修改后，分段表标记为失效。
+ */
+typedef struct _bitmap_alpha_runs_t {
+  const bitmap_t* owner;
+  bool_t invalid;
+  /*每一行的第一段在runs中的位置，共h+1项*/
+  uint32_t* lines;
+  uint16_t* runs;
+} bitmap_alpha_runs_t;
+
+ret_t bitmap_build_alpha_runs(bitmap_t* bitmap);
+const uint16_t* bitmap_get_alpha_runs(bitmap_t* bitmap, uint32_t y, uint32_t* nr);
+
 #define TK_BITMAP_MONO_LINE_LENGTH(w) (((w + 15) >> 4) << 1)
 
 uint8_t* bitmap_mono_create_data(uint32_t w, uint32_t h);
@@ -26,6 +26,7 @@
 #include "base/bidi.h"
 #include "base/canvas.h"
 #include "base/vgcanvas.h"
+#include "base/glyph_atlas.h"
 #include "tkc/time_now.h"
 #include "tkc/color_parser.h"
 #include "base/system_info.h"
@@ -278,21 +279,9 @@ ret_t canvas_set_text_align(canvas_t* c, align_h_t align_h, align_v_t align_v) {
 }
 
 static float_t canvas_measure_text_default(canvas_t* c, const wchar_t* str, uint32_t nr) {
-  glyph_t g;
-  float_t w = 0;
-  uint32_t i = 0;
   return_value_if_fail(c != NULL && str != NULL && c->font != NULL, 0);
 
-  for (i = 0; i < nr; i++) {
-    wchar_t chr = str[i];
-    if (font_get_glyph(c->font, chr, c->font_size, &g) == RET_OK) {
-      w += g.advance + 1;
-    } else {
-      w += 4;
-    }
-  }
-
-  return w;
+  return font_manager_measure_text(c->font_manager, c->font, c->font_size, str, nr);
 }
 
 float_t canvas_measure_text(canvas_t* c, const wchar_t* str, uint32_t nr) {
@@ -308,8 +297,15 @@ float_t canvas_measure_text(canvas_t* c, const wchar_t* str, uint32_t nr) {
 float_t canvas_measure_utf8(canvas_t* c, const char* str) {
   wstr_t s;
   float_t ret = 0;
+  wchar_t buff[64];
   return_value_if_fail(c != NULL && c->lcd != NULL && str != NULL, 0);
 
+  /*短字符串直接转换到栈上，不分配内存*/
+  if (strlen(str) < ARRAY_SIZE(buff)) {
+    tk_utf8_to_utf16(str, buff, ARRAY_SIZE(buff));
+    return canvas_measure_text(c, buff, wcslen(buff));
+  }
+
   wstr_init(&s, 0);
   return_value_if_fail(wstr_set_utf8(&s, str) == RET_OK, 0);
 
@@ -670,6 +666,114 @@ ret_t canvas_draw_char(canvas_t* c, wchar_t chr, xy_t x, xy_t y) {
   return canvas_draw_char_impl(c, chr, c->ox + x, c->oy + y);
 }
 
+#ifndef WITHOUT_GLYPH_ATLAS
+static ret_t canvas_flush_glyph_run(canvas_t* c, glyph_run_t* run) {
+  if (run->nr > 0) {
+    lcd_draw_glyph_run(c->lcd, run);
+    run->nr = 0;
+  }
+
+  return RET_OK;
+}
+
+/*裁剪字模并加入字模串，字模串满了先提交给lcd*/
+static ret_t canvas_add_glyph_to_run(canvas_t* c, glyph_run_t* run, const rect_t* clip,
+                                     const glyph_atlas_glyph_t* g, xy_t x, xy_t y) {
+  glyph_run_item_t* item = NULL;
+  const glyph_atlas_page_t* page = g->page;
+  xy_t left = tk_max(x, clip->x);
+  xy_t top = tk_max(y, clip->y);
+  xy_t right = tk_min(x + g->w, clip->x + clip->w);
+  xy_t bottom = tk_min(y + g->h, clip->y + clip->h);
+
+  if (page == NULL || left >= right || top >= bottom) {
+    return RET_OK;
+  }
+
+  if (run->nr >= TK_GLYPH_RUN_MAX_NR) {
+    canvas_flush_glyph_run(c, run);
+  }
+
+  item = run->items + run->nr;
+  item->x = left;
+  item->y = top;
+  item->w = right - left;
+  item->h = bottom - top;
+  item->pitch = page->w;
+  item->data = page->data + (g->page_y + top - y) * page->w + g->page_x + (left - x);
+
+  if (run->nr == 0) {
+    run->bounds = rect_init(item->x, item->y, item->w, item->h);
+  } else {
+    rect_t r = rect_init(item->x, item->y, item->w, item->h);
+    rect_merge(&(run->bounds), &r);
+  }
+  run->nr++;
+
+  return RET_OK;
+}
+
+/*
+ * 通过字模图集绘制文本：字模从图集中查找，不需要复制；
+ * 裁剪区只获取一次，每一行文字作为一个字模串提交给lcd。
+ */
+static ret_t canvas_draw_text_with_atlas(canvas_t* c, glyph_atlas_t* atlas, const wchar_t* str,
+                                         uint32_t nr, xy_t x, xy_t y, bool_t line_breaker) {
+  glyph_t g;
+  rect_t clip;
+  uint32_t i = 0;
+  xy_t left = x;
+  glyph_run_t run;
+  glyph_atlas_glyph_t ag;
+  font_size_t font_size = c->font_size;
+  font_vmetrics_t vmetrics = font_get_vmetrics(c->font, c->font_size);
+  int32_t baseline = vmetrics.ascent;
+
+  run.nr = 0;
+  canvas_get_clip_rect(c, &clip);
+  glyph_atlas_begin(atlas);
+
+  for (i = 0; i < nr; i++) {
+    ret_t ret = RET_OK;
+    wchar_t chr = str[i];
+
+    if (chr == '\r' || chr == '\n') {
+      if ((i + 1) == nr) {
+        break;
+      }
+
+      if (chr == '\r' && str[i + 1] == '\n') {
+        i++;
+      }
+
+      if (line_breaker) {
+        canvas_flush_glyph_run(c, &run);
+        y += font_size;
+        x = left;
+        continue;
+      } else {
+        chr = ' ';
+      }
+    }
+
+    ret = glyph_atlas_get(atlas, c->font, chr, font_size, &ag);
+    if (ret == RET_OK) {
+      canvas_add_glyph_to_run(c, &run, &clip, &ag, x + ag.x, y + ag.y + baseline);
+      x += ag.advance + 1;
+    } else if (ret == RET_NOT_IMPL && font_get_glyph(c->font, chr, font_size, &g) == RET_OK) {
+      /*不能放入图集的字模直接绘制，先提交前面的字模，保持绘制的顺序*/
+      canvas_flush_glyph_run(c, &run);
+      canvas_draw_glyph(c, &g, x + g.x, y + g.y + baseline);
+      x += g.advance + 1;
+    } else {
+      x += 4;
+    }
+  }
+
+  return canvas_flush_glyph_run(c, &run);
+}
+#endif /*WITHOUT_GLYPH_ATLAS*/
+
 static ret_t canvas_draw_text_impl(canvas_t* c, const wchar_t* str, uint32_t nr, xy_t x, xy_t y,
                                    bool_t line_breaker) {
   glyph_t g;
@@ -679,6 +783,12 @@ static ret_t canvas_draw_text_impl(canvas_t* c, const wchar_t* str, uint32_t nr,
   font_size_t font_size = c->font_size;
   int32_t baseline = vmetrics.ascent;
   return_value_if_fail(c->font != NULL, RET_BAD_PARAMS);
+
+#ifndef WITHOUT_GLYPH_ATLAS
+  if (c->lcd->draw_glyph_run != NULL && glyph_atlas() != NULL) {
+    return canvas_draw_text_with_atlas(c, glyph_atlas(), str, nr, x, y, line_breaker);
+  }
+#endif /*WITHOUT_GLYPH_ATLAS*/
   for (i = 0; i < nr; i++) {
     wchar_t chr = str[i];
 
@@ -23,6 +23,7 @@
 #define TK_DIRTY_RECTS_H
 
 #include "tkc/rect.h"
+#include "tkc/region.h"
 
 BEGIN_C_DECLS
 
@@ -30,16 +31,24 @@ BEGIN_C_DECLS
 #define TK_MAX_DIRTY_RECT_NR 10
 #endif /*TK_MAX_DIRTY_RECT_NR*/
 
+/*每多绘制一个脏矩形的固定开销(遍历控件树、设置裁剪区和flush等)，折算成像素个数*/
+#ifndef TK_DIRTY_RECT_COST
+#define TK_DIRTY_RECT_COST 1024
+#endif /*TK_DIRTY_RECT_COST*/
+
 /**
  * @class dirty_rects_t
  * 支持多个脏矩形。
  * > 在通常情况下，脏矩形的个数并不多，而且一般都是不重叠的，
  * > 所以为了降低计算开销、避免内存分配和简化实现。这里采用下列措施：
  *
+ * * 脏矩形之间始终互不重叠，每个像素最多绘制一次。
  * * 如果新的脏矩形是独立的，直接加入进来。
- * * 如果新的脏矩形与某个脏矩形有重叠，则合并到该脏矩形。
- * * 如果脏矩形的个数超出最大个数则进行合并。
- * 
+ * * 如果新的脏矩形与已有的脏矩形有重叠，比较两种做法的开销，选择开销小的：
+ *   合并成一个外接矩形，或者减去重叠部分(用region\_t计算)后把剩下的部分加入进来。
+ * * 如果脏矩形的个数超出最大个数，合并多绘制面积最小的两个矩形(而不是全部合并成一个)。
+ *
+ * 开销按"绘制的像素个数 + 脏矩形个数 * TK\_DIRTY\_RECT\_COST"估算。
  */
 typedef struct _dirty_rects_t {
   /**
@@ -144,14 +153,15 @@ static inline ret_t dirty_rects_remove(dirty_rects_t* dirty_rects, uint32_t inde
  */
 static inline ret_t dirty_rects_fix(dirty_rects_t* dirty_rects) {
   uint32_t i = 0;
+  uint32_t j = 0;
   return_value_if_fail(dirty_rects != NULL, RET_BAD_PARAMS);
 
-  if (dirty_rects->nr > 1) {
-    for (i = 1; i < dirty_rects->nr; i++) {
-      rect_t* iter = dirty_rects->rects + i;
-      if (rect_has_intersect(dirty_rects->rects, iter)) {
-        rect_merge(dirty_rects->rects, iter);
-        dirty_rects_remove(dirty_rects, i);
+  for (i = 0; i < dirty_rects->nr; i++) {
+    for (j = i + 1; j < dirty_rects->nr; j++) {
+      rect_t* iter = dirty_rects->rects + j;
+      if (rect_has_intersect(dirty_rects->rects + i, iter)) {
+        rect_merge(dirty_rects->rects + i, iter);
+        dirty_rects_remove(dirty_rects, j);
 
         return dirty_rects_fix(dirty_rects);
       }
@@ -161,45 +171,195 @@ static inline ret_t dirty_rects_fix(dirty_rects_t* dirty_rects) {
   return RET_OK;
 }
 
+static inline uint32_t dirty_rects_rect_area(const rect_t* r) {
+  return (uint32_t)(r->w) * (uint32_t)(r->h);
+}
+
+static inline bool_t dirty_rects_rect_contains(const rect_t* r, const rect_t* sub) {
+  return sub->x >= r->x && sub->y >= r->y && (sub->x + sub->w) <= (r->x + r->w) &&
+         (sub->y + sub->h) <= (r->y + r->h);
+}
+
 /**
- * @method dirty_rects_add
+ * @method dirty_rects_get_area
  * @export none
- * 增加脏矩形。
- * @param {dirty_rects_t*} dirty_rects dirty_rects对象。
- * @param {rect_t*} r 脏矩形。
+ * 获取脏矩形的总面积(即需要绘制的像素个数)。
+ * @param {const dirty_rects_t*} dirty_rects dirty_rects对象。
  *
- * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ * @return {uint32_t} 返回像素个数。
  */
-static inline ret_t dirty_rects_add(dirty_rects_t* dirty_rects, const rect_t* r) {
+static inline uint32_t dirty_rects_get_area(const dirty_rects_t* dirty_rects) {
   uint32_t i = 0;
-  return_value_if_fail(dirty_rects != NULL && r != NULL, RET_BAD_PARAMS);
+  uint32_t area = 0;
+  return_value_if_fail(dirty_rects != NULL, 0);
 
-  if (r->w == 0 || r->h == 0) {
-    return RET_OK;
+  for (i = 0; i < dirty_rects->nr; i++) {
+    area += dirty_rects_rect_area(dirty_rects->rects + i);
   }
 
-  if (dirty_rects->nr >= TK_MAX_DIRTY_RECT_NR) {
-    for (i = 1; i < dirty_rects->nr; i++) {
-      rect_merge(dirty_rects->rects, dirty_rects->rects + i);
+  return area;
+}
+
+/*
+ * 脏矩形已满时，从已有的脏矩形和r中选出合并后多绘制面积最小的两个进行合并。
+ * 如果选中了r，r变成合并后的矩形，由调用者重新加入。
+ */
+static inline ret_t dirty_rects_reduce(dirty_rects_t* dirty_rects, rect_t* r) {
+  uint32_t i = 0;
+  uint32_t j = 0;
+  uint32_t best_i = 0;
+  uint32_t best_j = 1;
+  int64_t best = -1;
+  uint32_t nr = dirty_rects->nr;
+
+  for (i = 0; i <= nr; i++) {
+    const rect_t* a = i < nr ? dirty_rects->rects + i : r;
+    for (j = i + 1; j <= nr; j++) {
+      int64_t waste = 0;
+      rect_t m = *a;
+      const rect_t* b = j < nr ? dirty_rects->rects + j : r;
+
+      rect_merge(&m, b);
+      waste = (int64_t)dirty_rects_rect_area(&m) - dirty_rects_rect_area(a) -
+              dirty_rects_rect_area(b);
+      if (best < 0 || waste < best) {
+        best = waste;
+        best_i = i;
+        best_j = j;
+      }
     }
-    dirty_rects->nr = 1;
   }
 
-  rect_merge(&(dirty_rects->max), r);
+  if (best_j == nr) {
+    rect_merge(r, dirty_rects->rects + best_i);
+    dirty_rects_remove(dirty_rects, best_i);
+  } else {
+    rect_merge(dirty_rects->rects + best_i, dirty_rects->rects + best_j);
+    dirty_rects_remove(dirty_rects, best_j);
+    dirty_rects_fix(dirty_rects);
+  }
 
-  for (i = 0; i < dirty_rects->nr; i++) {
-    rect_t* iter = dirty_rects->rects + i;
-    if (rect_has_intersect(iter, r)) {
-      rect_merge(iter, r);
-      return dirty_rects_fix(dirty_rects);
+  return RET_OK;
+}
+
+static inline ret_t dirty_rects_append(dirty_rects_t* dirty_rects, const rect_t* r) {
+  uint32_t i = 0;
+  rect_t t = *r;
+
+  while (dirty_rects->nr >= TK_MAX_DIRTY_RECT_NR) {
+    dirty_rects_reduce(dirty_rects, &t);
+
+    /*合并后的矩形可能与其它脏矩形重叠，直接合并*/
+    for (i = 0; i < dirty_rects->nr;) {
+      if (rect_has_intersect(dirty_rects->rects + i, &t)) {
+        rect_merge(&t, dirty_rects->rects + i);
+        dirty_rects_remove(dirty_rects, i);
+        i = 0;
+      } else {
+        i++;
+      }
     }
   }
 
-  dirty_rects->rects[dirty_rects->nr++] = *r;
+  dirty_rects->rects[dirty_rects->nr++] = t;
 
   return RET_OK;
 }
 
+static inline ret_t dirty_rects_add_rect(dirty_rects_t* dirty_rects, const rect_t* r) {
+  int32_t i = 0;
+  region_t rest;
+  rect_t merged = *r;
+  int64_t merge_cost = 0;
+  int64_t separate_cost = 0;
+  uint32_t overlap_nr = 0;
+  uint32_t overlap_area = 0;
+
+  for (i = 0; i < (int32_t)(dirty_rects->nr); i++) {
+    const rect_t* iter = dirty_rects->rects + i;
+    if (rect_has_intersect(iter, r)) {
+      if (dirty_rects_rect_contains(iter, r)) {
+        return RET_OK;
+      }
+      rect_merge(&merged, iter);
+      overlap_area += dirty_rects_rect_area(iter);
+      overlap_nr++;
+    }
+  }
+
+  if (overlap_nr == 0) {
+    return dirty_rects_append(dirty_rects, r);
+  }
+
+  /*合并：用外接矩形替换重叠的脏矩形。分开：只加入不重叠的部分。*/
+  region_init(&rest);
+  region_set_rect(&rest, r);
+  for (i = 0; i < (int32_t)(dirty_rects->nr); i++) {
+    if (rect_has_intersect(dirty_rects->rects + i, r)) {
+      region_subtract_rect(&rest, dirty_rects->rects + i);
+    }
+  }
+  merge_cost = (int64_t)dirty_rects_rect_area(&merged) - overlap_area -
+               (int64_t)(overlap_nr - 1) * TK_DIRTY_RECT_COST;
+  separate_cost = region_get_area(&rest) + (int64_t)(rest.nr) * TK_DIRTY_RECT_COST;
+
+  if (merge_cost <= separate_cost) {
+    int32_t first = -1;
+    bool_t overlap_others = FALSE;
+
+    region_deinit(&rest);
+    for (i = (int32_t)(dirty_rects->nr) - 1; i >= 0; i--) {
+      if (rect_has_intersect(dirty_rects->rects + i, r)) {
+        if (first >= 0) {
+          dirty_rects_remove(dirty_rects, first);
+        }
+        first = i;
+      } else if (rect_has_intersect(dirty_rects->rects + i, &merged)) {
+        overlap_others = TRUE;
+      }
+    }
+
+    if (!overlap_others) {
+      /*保持原来的位置*/
+      dirty_rects->rects[first] = merged;
+      return RET_OK;
+    }
+
+    dirty_rects_remove(dirty_rects, first);
+    return dirty_rects_add_rect(dirty_rects, &merged);
+  } else {
+    ret_t ret = RET_OK;
+
+    for (i = 0; i < (int32_t)(rest.nr) && ret == RET_OK; i++) {
+      ret = dirty_rects_add_rect(dirty_rects, rest.rects + i);
+    }
+    region_deinit(&rest);
+
+    return ret;
+  }
+}
+
+/**
+ * @method dirty_rects_add
+ * @export none
+ * 增加脏矩形。
+ * @param {dirty_rects_t*} dirty_rects dirty_rects对象。
+ * @param {rect_t*} r 脏矩形。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+static inline ret_t dirty_rects_add(dirty_rects_t* dirty_rects, const rect_t* r) {
+  return_value_if_fail(dirty_rects != NULL && r != NULL, RET_BAD_PARAMS);
+
+  if (r->w <= 0 || r->h <= 0) {
+    return RET_OK;
+  }
+
+  rect_merge(&(dirty_rects->max), r);
+
+  return dirty_rects_add_rect(dirty_rects, r);
+}
+
 /**
  * @method dirty_rects_set_debug
  * @export none
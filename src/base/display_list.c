@@ -0,0 +1,864 @@
+﻿/**
+ * File:   display_list.c
+ * Author: AWTK Develop Team
+ * Brief:  record draw calls of a frame and diff them against the previous frame
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "base/canvas.h"
+#include "base/display_list.h"
+
+#define DISPLAY_LIST_MIN_CAPACITY 64
+#define DISPLAY_LIST_HASH_INIT 2166136261u
+
+typedef enum _display_list_cmd_type_t {
+  DISPLAY_LIST_CMD_UNKNOWN = 0,
+  DISPLAY_LIST_CMD_FILL_RECT,
+  DISPLAY_LIST_CMD_CLEAR_RECT,
+  DISPLAY_LIST_CMD_STROKE_RECT,
+  DISPLAY_LIST_CMD_HLINE,
+  DISPLAY_LIST_CMD_VLINE,
+  DISPLAY_LIST_CMD_POINTS,
+  DISPLAY_LIST_CMD_GLYPH,
+  DISPLAY_LIST_CMD_GLYPH_RUN,
+  DISPLAY_LIST_CMD_IMAGE,
+  DISPLAY_LIST_CMD_IMAGE_MATRIX
+} display_list_cmd_type_t;
+
+typedef struct _display_list_cmd_t {
+  uint8_t type;
+  uint8_t global_alpha;
+  /*绘制的内容是否可以通过hash比较*/
+  bool_t stable;
+  color_t color;
+  /*绘制的区域(lcd坐标，已经裁剪)*/
+  rect_t bounds;
+  /*颜色和区域以外的参数及内容的hash*/
+  uint32_t hash;
+
+  union {
+    /*点和字模串保存在data中，字模串的后面是各个字模裁剪后的数据(每行w个字节)*/
+    struct {
+      uint32_t offset;
+      uint32_t nr;
+    } data;
+    /*字模的数据保存在data中*/
+    struct {
+      glyph_t glyph;
+      rect_t src;
+      xy_t x;
+      xy_t y;
+      uint32_t offset;
+    } glyph;
+    struct {
+      bitmap_t img;
+      rectf_t src;
+      rectf_t dst;
+    } image;
+    struct {
+      bitmap_t img;
+      draw_image_info_t info;
+    } matrix;
+  } u;
+} display_list_cmd_t;
+
+/*记录时替换真正的vgcanvas的虚表：状态和路径照常设置，绘制时记录为未知命令*/
+typedef struct _display_list_vgcanvas_vtable_t {
+  vgcanvas_vtable_t vt;
+  display_list_t* list;
+} display_list_vgcanvas_vtable_t;
+
+struct _display_list_t {
+  lcd_t lcd;
+
+  /*private*/
+  lcd_t* impl;
+  canvas_t* canvas;
+  dirty_rects_t area;
+
+  vgcanvas_t* vg;
+  const vgcanvas_vtable_t* vg_vt;
+  display_list_vgcanvas_vtable_t vg_record_vt;
+
+  uint32_t nr;
+  uint32_t capacity;
+  display_list_cmd_t* cmds;
+
+  uint32_t data_size;
+  uint32_t data_capacity;
+  uint8_t* data;
+
+  uint32_t unknown_nr;
+};
+
+#define DISPLAY_LIST(lcd) ((display_list_t*)(lcd))
+
+static uint32_t display_list_hash(uint32_t h, const void* data, uint32_t size) {
+  uint32_t i = 0;
+  const uint8_t* p = (const uint8_t*)data;
+
+  for (i = 0; i < size; i++) {
+    h ^= p[i];
+    h *= 16777619u;
+  }
+
+  return h;
+}
+
+static uint32_t display_list_glyph_rle_size(const glyph_t* g) {
+  uint32_t y = 0;
+  const uint8_t* p = g->data;
+
+  for (y = 0; y < g->h; y++) {
+    uint32_t x = 0;
+
+    while (x < g->w) {
+      uint32_t type = *p >> 6;
+      uint32_t count = (*p & 0x3f) + 1;
+
+      p++;
+      if (type == GLYPH_RLE_LITERAL) {
+        p += count;
+      }
+      x += count;
+    }
+  }
+
+  return p - g->data;
+}
+
+static uint32_t display_list_glyph_size(const glyph_t* g) {
+  if (g->data == NULL) {
+    return 0;
+  }
+
+  switch (g->format) {
+    case GLYPH_FMT_ALPHA: {
+      return g->w * g->h;
+    }
+    case GLYPH_FMT_MONO: {
+      return (g->pitch > 0 ? g->pitch : (g->w + 7) / 8) * g->h;
+    }
+    case GLYPH_FMT_RGBA: {
+      return g->w * g->h * 4;
+    }
+    case GLYPH_FMT_A4:
+    case GLYPH_FMT_A2: {
+      return g->pitch * g->h;
+    }
+    case GLYPH_FMT_RLE: {
+      return display_list_glyph_rle_size(g);
+    }
+    default: {
+      return 0;
+    }
+  }
+}
+
+/*字模的数据可能被字模缓存淘汰后重用，所以比较内容而不是地址*/
+static bool_t display_list_hash_glyph(uint32_t* h, const glyph_t* g, uint32_t size) {
+  uint8_t format = g->format;
+
+  if (format != GLYPH_FMT_ALPHA && format != GLYPH_FMT_A4 && format != GLYPH_FMT_A2 &&
+      format != GLYPH_FMT_RLE) {
+    return FALSE;
+  }
+
+  *h = display_list_hash(*h, &format, sizeof(format));
+  *h = display_list_hash(*h, g->data, size);
+
+  return TRUE;
+}
+
+/*控件一般把位图加载到栈上的bitmap_t中再绘制，所以比较数据和名称而不是bitmap_t的地址*/
+static bool_t display_list_hash_bitmap(uint32_t* h, const bitmap_t* img) {
+  bool_t stable = img->image_manager != NULL || (img->flags & BITMAP_FLAG_IMMUTABLE) != 0;
+
+  *h = display_list_hash(*h, &(img->buffer), sizeof(img->buffer));
+  *h = display_list_hash(*h, &(img->w), sizeof(img->w));
+  *h = display_list_hash(*h, &(img->h), sizeof(img->h));
+  *h = display_list_hash(*h, &(img->format), sizeof(img->format));
+  if (img->name != NULL) {
+    *h = display_list_hash(*h, img->name, strlen(img->name));
+  }
+
+  return stable && (img->flags & BITMAP_FLAG_CHANGED) == 0;
+}
+
+static display_list_cmd_t* display_list_add(display_list_t* list, uint8_t type, color_t color,
+                                            const rect_t* bounds) {
+  display_list_cmd_t* cmd = NULL;
+
+  if (list->nr >= list->capacity) {
+    uint32_t capacity = tk_max(list->capacity * 2, DISPLAY_LIST_MIN_CAPACITY);
+    display_list_cmd_t* cmds = TKMEM_REALLOCT(display_list_cmd_t, list->cmds, capacity);
+    return_value_if_fail(cmds != NULL, NULL);
+
+    list->cmds = cmds;
+    list->capacity = capacity;
+  }
+
+  cmd = list->cmds + list->nr++;
+  memset(cmd, 0x00, sizeof(*cmd));
+  cmd->type = type;
+  cmd->color = color;
+  cmd->bounds = *bounds;
+  cmd->stable = TRUE;
+  cmd->hash = DISPLAY_LIST_HASH_INIT;
+  cmd->global_alpha = list->lcd.global_alpha;
+
+  return cmd;
+}
+
+/*点和字模串的数据按8字节对齐保存，返回偏移量。data为NULL时只分配空间*/
+static int32_t display_list_add_data(display_list_t* list, const void* data, uint32_t size) {
+  uint32_t offset = TK_ROUND_TO8(list->data_size);
+
+  if (offset + size > list->data_capacity) {
+    uint32_t capacity = tk_max(list->data_capacity * 2, offset + size);
+    uint8_t* p = TKMEM_REALLOCT(uint8_t, list->data, capacity);
+    return_value_if_fail(p != NULL, -1);
+
+    list->data = p;
+    list->data_capacity = capacity;
+  }
+
+  if (data != NULL) {
+    memcpy(list->data + offset, data, size);
+  }
+  list->data_size = offset + size;
+
+  return offset;
+}
+
+static rect_t display_list_get_clip(display_list_t* list) {
+  rect_t r = list->lcd.dirty_rect;
+
+  if (list->canvas != NULL) {
+    canvas_get_clip_rect(list->canvas, &r);
+  }
+
+  return r;
+}
+
+static ret_t display_list_add_unknown(display_list_t* list) {
+  display_list_cmd_t* cmd = NULL;
+  rect_t r = display_list_get_clip(list);
+
+  /*vgcanvas的裁剪区可能被控件修改过，取两者的并集*/
+  if (list->vg != NULL) {
+    const rectf_t* vg_clip = list->vg_vt->get_clip_rect(list->vg);
+
+    if (vg_clip != NULL) {
+      rect_t vr = rect_from_rectf(vg_clip);
+      rect_merge(&r, &vr);
+    }
+    r = rect_intersect(&r, &(list->area.max));
+  }
+
+  cmd = display_list_add(list, DISPLAY_LIST_CMD_UNKNOWN, color_init(0, 0, 0, 0), &r);
+  return_value_if_fail(cmd != NULL, RET_OOM);
+
+  cmd->stable = FALSE;
+  list->unknown_nr++;
+
+  return RET_OK;
+}
+
+static ret_t display_list_add_rect(display_list_t* list, uint8_t type, color_t color, xy_t x,
+                                   xy_t y, wh_t w, wh_t h) {
+  rect_t r = rect_init(x, y, w, h);
+
+  return display_list_add(list, type, color, &r) != NULL ? RET_OK : RET_OOM;
+}
+
+static ret_t display_list_begin_frame(lcd_t* lcd, const dirty_rects_t* dirty_rects) {
+  display_list_t* list = DISPLAY_LIST(lcd);
+
+  list->nr = 0;
+  list->data_size = 0;
+  list->unknown_nr = 0;
+  dirty_rects_init(&(list->area));
+  if (dirty_rects != NULL) {
+    list->area = *dirty_rects;
+  } else {
+    dirty_rects_add(&(list->area), &(lcd->dirty_rect));
+  }
+
+  return RET_OK;
+}
+
+static ret_t display_list_end_frame(lcd_t* lcd) {
+  display_list_t* list = DISPLAY_LIST(lcd);
+
+  if (list->vg != NULL) {
+    list->vg->vt = list->vg_vt;
+    list->vg = NULL;
+    list->vg_vt = NULL;
+  }
+
+  return RET_OK;
+}
+
+static ret_t display_list_set_canvas(lcd_t* lcd, canvas_t* c) {
+  DISPLAY_LIST(lcd)->canvas = c;
+
+  return RET_OK;
+}
+
+static ret_t display_list_fill_rect(lcd_t* lcd, xy_t x, xy_t y, wh_t w, wh_t h) {
+  return display_list_add_rect(DISPLAY_LIST(lcd), DISPLAY_LIST_CMD_FILL_RECT, lcd->fill_color, x,
+                               y, w, h);
+}
+
+static ret_t display_list_clear_rect(lcd_t* lcd, xy_t x, xy_t y, wh_t w, wh_t h) {
+  return display_list_add_rect(DISPLAY_LIST(lcd), DISPLAY_LIST_CMD_CLEAR_RECT, lcd->fill_color, x,
+                               y, w, h);
+}
+
+static ret_t display_list_stroke_rect(lcd_t* lcd, xy_t x, xy_t y, wh_t w, wh_t h) {
+  return display_list_add_rect(DISPLAY_LIST(lcd), DISPLAY_LIST_CMD_STROKE_RECT, lcd->stroke_color,
+                               x, y, w, h);
+}
+
+static ret_t display_list_draw_hline(lcd_t* lcd, xy_t x, xy_t y, wh_t w) {
+  return display_list_add_rect(DISPLAY_LIST(lcd), DISPLAY_LIST_CMD_HLINE, lcd->stroke_color, x, y,
+                               w, 1);
+}
+
+static ret_t display_list_draw_vline(lcd_t* lcd, xy_t x, xy_t y, wh_t h) {
+  return display_list_add_rect(DISPLAY_LIST(lcd), DISPLAY_LIST_CMD_VLINE, lcd->stroke_color, x, y,
+                               1, h);
+}
+
+static ret_t display_list_draw_points(lcd_t* lcd, point_t* points, uint32_t nr) {
+  uint32_t i = 0;
+  int32_t offset = 0;
+  rect_t r = rect_init(0, 0, 0, 0);
+  display_list_cmd_t* cmd = NULL;
+  display_list_t* list = DISPLAY_LIST(lcd);
+
+  if (nr == 0) {
+    return RET_OK;
+  }
+
+  for (i = 0; i < nr; i++) {
+    rect_t p = rect_init(points[i].x, points[i].y, 1, 1);
+    rect_merge(&r, &p);
+  }
+
+  offset = display_list_add_data(list, points, nr * sizeof(point_t));
+  return_value_if_fail(offset >= 0, RET_OOM);
+  cmd = display_list_add(list, DISPLAY_LIST_CMD_POINTS, lcd->stroke_color, &r);
+  return_value_if_fail(cmd != NULL, RET_OOM);
+
+  cmd->u.data.offset = offset;
+  cmd->u.data.nr = nr;
+  cmd->hash = display_list_hash(cmd->hash, points, nr * sizeof(point_t));
+
+  return RET_OK;
+}
+
+static ret_t display_list_draw_glyph(lcd_t* lcd, glyph_t* glyph, const rect_t* src, xy_t x,
+                                     xy_t y) {
+  int32_t offset = 0;
+  display_list_cmd_t* cmd = NULL;
+  rect_t r = rect_init(x, y, src->w, src->h);
+  display_list_t* list = DISPLAY_LIST(lcd);
+  uint32_t size = display_list_glyph_size(glyph);
+
+  /*字模的数据在字模缓存中，之后可能被淘汰或者重用，复制一份用于重放*/
+  offset = display_list_add_data(list, glyph->data, size);
+  return_value_if_fail(offset >= 0, RET_OOM);
+  cmd = display_list_add(list, DISPLAY_LIST_CMD_GLYPH, lcd->text_color, &r);
+  return_value_if_fail(cmd != NULL, RET_OOM);
+
+  cmd->u.glyph.glyph = *glyph;
+  cmd->u.glyph.glyph.data = NULL;
+  cmd->u.glyph.src = *src;
+  cmd->u.glyph.x = x;
+  cmd->u.glyph.y = y;
+  cmd->u.glyph.offset = offset;
+  cmd->hash = display_list_hash(cmd->hash, src, sizeof(*src));
+  cmd->stable = display_list_hash_glyph(&(cmd->hash), glyph, size);
+
+  return RET_OK;
+}
+
+static ret_t display_list_draw_glyph_run(lcd_t* lcd, const glyph_run_t* run) {
+  uint32_t i = 0;
+  uint32_t j = 0;
+  uint8_t* p = NULL;
+  int32_t offset = 0;
+  uint32_t size = run->nr * sizeof(glyph_run_item_t);
+  display_list_cmd_t* cmd = NULL;
+  display_list_t* list = DISPLAY_LIST(lcd);
+
+  if (run->nr == 0) {
+    return RET_OK;
+  }
+
+  for (i = 0; i < run->nr; i++) {
+    size += run->items[i].w * run->items[i].h;
+  }
+
+  /*字模的数据在字模缓存或者图集中，之后可能被淘汰或者重用，复制一份用于重放*/
+  offset = display_list_add_data(list, NULL, size);
+  return_value_if_fail(offset >= 0, RET_OOM);
+  cmd = display_list_add(list, DISPLAY_LIST_CMD_GLYPH_RUN, lcd->text_color, &(run->bounds));
+  return_value_if_fail(cmd != NULL, RET_OOM);
+
+  p = list->data + offset;
+  memcpy(p, run->items, run->nr * sizeof(glyph_run_item_t));
+  p += run->nr * sizeof(glyph_run_item_t);
+
+  cmd->u.data.offset = offset;
+  cmd->u.data.nr = run->nr;
+  for (i = 0; i < run->nr; i++) {
+    const glyph_run_item_t* iter = run->items + i;
+
+    cmd->hash = display_list_hash(cmd->hash, &(iter->x), sizeof(iter->x));
+    cmd->hash = display_list_hash(cmd->hash, &(iter->y), sizeof(iter->y));
+    cmd->hash = display_list_hash(cmd->hash, &(iter->w), sizeof(iter->w));
+    cmd->hash = display_list_hash(cmd->hash, &(iter->h), sizeof(iter->h));
+    for (j = 0; j < iter->h; j++) {
+      memcpy(p, iter->data + j * iter->pitch, iter->w);
+      cmd->hash = display_list_hash(cmd->hash, p, iter->w);
+      p += iter->w;
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t display_list_draw_image(lcd_t* lcd, bitmap_t* img, const rectf_t* src,
+                                     const rectf_t* dst) {
+  rect_t r;
+  display_list_cmd_t* cmd = NULL;
+  display_list_t* list = DISPLAY_LIST(lcd);
+
+  r.x = (xy_t)floorf(dst->x);
+  r.y = (xy_t)floorf(dst->y);
+  r.w = (wh_t)ceilf(dst->x + dst->w) - r.x;
+  r.h = (wh_t)ceilf(dst->y + dst->h) - r.y;
+  cmd = display_list_add(list, DISPLAY_LIST_CMD_IMAGE, color_init(0, 0, 0, 0), &r);
+  return_value_if_fail(cmd != NULL, RET_OOM);
+
+  cmd->u.image.img = *img;
+  cmd->u.image.src = *src;
+  cmd->u.image.dst = *dst;
+  cmd->hash = display_list_hash(cmd->hash, src, sizeof(*src));
+  cmd->hash = display_list_hash(cmd->hash, dst, sizeof(*dst));
+  cmd->stable = display_list_hash_bitmap(&(cmd->hash), img);
+
+  return RET_OK;
+}
+
+static ret_t display_list_draw_image_matrix(lcd_t* lcd, draw_image_info_t* info) {
+  rect_t r = info->clip;
+  display_list_cmd_t* cmd = NULL;
+  display_list_t* list = DISPLAY_LIST(lcd);
+
+  rect_fix(&r, lcd->w, lcd->h);
+  cmd = display_list_add(list, DISPLAY_LIST_CMD_IMAGE_MATRIX, color_init(0, 0, 0, 0), &r);
+  return_value_if_fail(cmd != NULL, RET_OOM);
+
+  cmd->u.matrix.img = *(info->img);
+  cmd->u.matrix.info = *info;
+  cmd->hash = display_list_hash(cmd->hash, &(info->src), sizeof(info->src));
+  cmd->hash = display_list_hash(cmd->hash, &(info->dst), sizeof(info->dst));
+  cmd->hash = display_list_hash(cmd->hash, &(info->clip), sizeof(info->clip));
+  cmd->hash = display_list_hash(cmd->hash, &(info->matrix), sizeof(info->matrix));
+  cmd->stable = display_list_hash_bitmap(&(cmd->hash), info->img);
+
+  return RET_OK;
+}
+
+static ret_t display_list_draw_text(lcd_t* lcd, const wchar_t* str, uint32_t nr, xy_t x, xy_t y) {
+  return display_list_add_unknown(DISPLAY_LIST(lcd));
+}
+
+static float_t display_list_measure_text(lcd_t* lcd, const wchar_t* str, uint32_t nr) {
+  return lcd_measure_text(DISPLAY_LIST(lcd)->impl, str, nr);
+}
+
+/*读取的是上一帧的内容，结果不确定*/
+static color_t display_list_get_point_color(lcd_t* lcd, xy_t x, xy_t y) {
+  display_list_t* list = DISPLAY_LIST(lcd);
+
+  display_list_add_unknown(list);
+
+  return list->impl->get_point_color(list->impl, x, y);
+}
+
+#define DISPLAY_LIST_OF_VG(vg) (((display_list_vgcanvas_vtable_t*)((vg)->vt))->list)
+
+static ret_t display_list_vg_clear_rect(vgcanvas_t* vg, float_t x, float_t y, float_t w,
+                                        float_t h, color_t color) {
+  return display_list_add_unknown(DISPLAY_LIST_OF_VG(vg));
+}
+
+static ret_t display_list_vg_fill(vgcanvas_t* vg) {
+  return display_list_add_unknown(DISPLAY_LIST_OF_VG(vg));
+}
+
+static ret_t display_list_vg_stroke(vgcanvas_t* vg) {
+  return display_list_add_unknown(DISPLAY_LIST_OF_VG(vg));
+}
+
+static ret_t display_list_vg_paint(vgcanvas_t* vg, bool_t stroke, bitmap_t* img) {
+  return display_list_add_unknown(DISPLAY_LIST_OF_VG(vg));
+}
+
+static ret_t display_list_vg_fill_text(vgcanvas_t* vg, const char* text, float_t x, float_t y,
+                                       float_t max_width) {
+  return display_list_add_unknown(DISPLAY_LIST_OF_VG(vg));
+}
+
+static ret_t display_list_vg_draw_image(vgcanvas_t* vg, bitmap_t* img, float_t sx, float_t sy,
+                                        float_t sw, float_t sh, float_t dx, float_t dy,
+                                        float_t dw, float_t dh) {
+  return display_list_add_unknown(DISPLAY_LIST_OF_VG(vg));
+}
+
+static ret_t display_list_vg_draw_image_repeat(vgcanvas_t* vg, bitmap_t* img, float_t sx,
+                                               float_t sy, float_t sw, float_t sh, float_t dx,
+                                               float_t dy, float_t dw, float_t dh, float_t dst_w,
+                                               float_t dst_h) {
+  return display_list_add_unknown(DISPLAY_LIST_OF_VG(vg));
+}
+
+/*
+ * 返回真正的vgcanvas(控件经常用它保存和恢复裁剪区)，但是在本帧结束之前替换它的虚表，
+ * 设置状态和路径的函数照常调用，绘制的函数不绘制，而是记录为未知命令。
+ */
+static vgcanvas_t* display_list_get_vgcanvas(lcd_t* lcd) {
+  display_list_t* list = DISPLAY_LIST(lcd);
+  vgcanvas_t* vg = lcd_get_vgcanvas(list->impl);
+  display_list_vgcanvas_vtable_t* record_vt = &(list->vg_record_vt);
+
+  if (vg == NULL || vg->vt == &(record_vt->vt)) {
+    return vg;
+  }
+
+  if (list->vg != NULL) {
+    list->vg->vt = list->vg_vt;
+  }
+
+  list->vg = vg;
+  list->vg_vt = vg->vt;
+  record_vt->vt = *(vg->vt);
+  record_vt->list = list;
+  record_vt->vt.clear_rect = display_list_vg_clear_rect;
+  record_vt->vt.fill = display_list_vg_fill;
+  record_vt->vt.stroke = display_list_vg_stroke;
+  record_vt->vt.paint = display_list_vg_paint;
+  record_vt->vt.fill_text = display_list_vg_fill_text;
+  record_vt->vt.draw_image = display_list_vg_draw_image;
+  record_vt->vt.draw_image_repeat = display_list_vg_draw_image_repeat;
+  vg->vt = &(record_vt->vt);
+
+  return vg;
+}
+
+static bitmap_format_t display_list_get_desired_bitmap_format(lcd_t* lcd) {
+  return lcd_get_desired_bitmap_format(DISPLAY_LIST(lcd)->impl);
+}
+
+display_list_t* display_list_create(lcd_t* impl) {
+  lcd_t* lcd = NULL;
+  display_list_t* list = NULL;
+  return_value_if_fail(impl != NULL, NULL);
+
+  list = TKMEM_ZALLOC(display_list_t);
+  return_value_if_fail(list != NULL, NULL);
+
+  lcd = &(list->lcd);
+  list->impl = impl;
+  lcd->type = impl->type;
+  lcd->support_dirty_rect = TRUE;
+  lcd->global_alpha = 0xff;
+
+  lcd->begin_frame = display_list_begin_frame;
+  lcd->end_frame = display_list_end_frame;
+  lcd->set_canvas = display_list_set_canvas;
+  lcd->fill_rect = display_list_fill_rect;
+  lcd->clear_rect = display_list_clear_rect;
+  lcd->draw_hline = display_list_draw_hline;
+  lcd->draw_vline = display_list_draw_vline;
+  lcd->draw_points = display_list_draw_points;
+  lcd->draw_glyph = display_list_draw_glyph;
+  lcd->draw_image = display_list_draw_image;
+  lcd->draw_image_matrix = display_list_draw_image_matrix;
+  lcd->get_vgcanvas = display_list_get_vgcanvas;
+  lcd->get_desired_bitmap_format = display_list_get_desired_bitmap_format;
+
+  /*和真正的lcd使用相同的绘制方式，记录的命令才能在真正的lcd上重放*/
+  if (impl->stroke_rect != NULL) {
+    lcd->stroke_rect = display_list_stroke_rect;
+  }
+
+  if (impl->draw_glyph_run != NULL) {
+    lcd->draw_glyph_run = display_list_draw_glyph_run;
+  }
+
+  if (impl->draw_text != NULL) {
+    lcd->draw_text = display_list_draw_text;
+  }
+
+  if (impl->measure_text != NULL) {
+    lcd->measure_text = display_list_measure_text;
+  }
+
+  if (impl->get_point_color != NULL) {
+    lcd->get_point_color = display_list_get_point_color;
+  }
+
+  return list;
+}
+
+lcd_t* display_list_get_lcd(display_list_t* list) {
+  lcd_t* lcd = NULL;
+  return_value_if_fail(list != NULL, NULL);
+
+  lcd = &(list->lcd);
+  lcd->ratio = list->impl->ratio;
+  lcd->w = lcd_get_width(list->impl);
+  lcd->h = lcd_get_height(list->impl);
+
+  return lcd;
+}
+
+uint32_t display_list_size(display_list_t* list) {
+  return_value_if_fail(list != NULL, 0);
+
+  return list->nr;
+}
+
+bool_t display_list_has_unknown(display_list_t* list) {
+  return_value_if_fail(list != NULL, FALSE);
+
+  return list->unknown_nr > 0;
+}
+
+static bool_t display_list_rect_eq(const rect_t* a, const rect_t* b) {
+  return a->x == b->x && a->y == b->y && a->w == b->w && a->h == b->h;
+}
+
+static bool_t display_list_area_eq(const dirty_rects_t* a, const dirty_rects_t* b) {
+  uint32_t i = 0;
+
+  if (a->nr != b->nr || a->disable_multiple != b->disable_multiple ||
+      !display_list_rect_eq(&(a->max), &(b->max))) {
+    return FALSE;
+  }
+
+  for (i = 0; i < a->nr; i++) {
+    if (!display_list_rect_eq(a->rects + i, b->rects + i)) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+static bool_t display_list_cmd_eq(const display_list_cmd_t* a, const display_list_cmd_t* b) {
+  return a->stable && b->stable && a->type == b->type && a->hash == b->hash &&
+         a->global_alpha == b->global_alpha && a->color.color == b->color.color &&
+         display_list_rect_eq(&(a->bounds), &(b->bounds));
+}
+
+/*在list[start, end)中查找与cmd相同的命令，返回跳过的命令个数，没有找到返回-1*/
+static int32_t display_list_find(const display_list_t* list, uint32_t start,
+                                 const display_list_cmd_t* cmd) {
+  uint32_t i = 0;
+  uint32_t end = tk_min(list->nr, start + TK_DISPLAY_LIST_DIFF_LOOKAHEAD);
+
+  for (i = start; i < end; i++) {
+    if (display_list_cmd_eq(list->cmds + i, cmd)) {
+      return i - start;
+    }
+  }
+
+  return -1;
+}
+
+static ret_t display_list_damage(dirty_rects_t* damage, const display_list_t* list,
+                                 uint32_t start, uint32_t end) {
+  uint32_t i = 0;
+
+  for (i = start; i < end; i++) {
+    dirty_rects_add(damage, &(list->cmds[i].bounds));
+  }
+
+  return RET_OK;
+}
+
+ret_t display_list_diff(display_list_t* list, display_list_t* prev, dirty_rects_t* damage) {
+  uint32_t i = 0;
+  uint32_t j = 0;
+  return_value_if_fail(list != NULL && damage != NULL, RET_BAD_PARAMS);
+
+  dirty_rects_reset(damage);
+  if (prev == NULL || !display_list_area_eq(&(list->area), &(prev->area))) {
+    for (i = 0; i < list->area.nr; i++) {
+      dirty_rects_add(damage, list->area.rects + i);
+    }
+    return RET_OK;
+  }
+
+  /*
+   * 按顺序匹配相同的命令：匹配的命令在两帧中的顺序相同，所以没有被任何未匹配命令覆盖的像素，
+   * 在两帧中经过的命令序列完全相同，不需要重绘。
+   */
+  while (i < prev->nr && j < list->nr) {
+    int32_t removed = 0;
+    int32_t inserted = 0;
+
+    if (display_list_cmd_eq(prev->cmds + i, list->cmds + j)) {
+      i++;
+      j++;
+      continue;
+    }
+
+    removed = display_list_find(prev, i + 1, list->cmds + j);
+    inserted = display_list_find(list, j + 1, prev->cmds + i);
+    if (removed >= 0 && (inserted < 0 || removed <= inserted)) {
+      display_list_damage(damage, prev, i, i + removed + 1);
+      i += removed + 1;
+    } else if (inserted >= 0) {
+      display_list_damage(damage, list, j, j + inserted + 1);
+      j += inserted + 1;
+    } else {
+      display_list_damage(damage, prev, i, i + 1);
+      display_list_damage(damage, list, j, j + 1);
+      i++;
+      j++;
+    }
+  }
+
+  display_list_damage(damage, prev, i, prev->nr);
+  display_list_damage(damage, list, j, list->nr);
+
+  return RET_OK;
+}
+
+ret_t display_list_replay(display_list_t* list, lcd_t* lcd) {
+  uint32_t i = 0;
+  return_value_if_fail(list != NULL && lcd != NULL, RET_BAD_PARAMS);
+
+  if (list->unknown_nr > 0) {
+    return RET_NOT_IMPL;
+  }
+
+  for (i = 0; i < list->nr; i++) {
+    display_list_cmd_t* cmd = list->cmds + i;
+    const rect_t* r = &(cmd->bounds);
+
+    if (lcd->global_alpha != cmd->global_alpha) {
+      lcd_set_global_alpha(lcd, cmd->global_alpha);
+    }
+
+    switch (cmd->type) {
+      case DISPLAY_LIST_CMD_FILL_RECT: {
+        lcd_set_fill_color(lcd, cmd->color);
+        lcd_fill_rect(lcd, r->x, r->y, r->w, r->h);
+        break;
+      }
+      case DISPLAY_LIST_CMD_CLEAR_RECT: {
+        lcd_set_fill_color(lcd, cmd->color);
+        lcd_clear_rect(lcd, r->x, r->y, r->w, r->h);
+        break;
+      }
+      case DISPLAY_LIST_CMD_STROKE_RECT: {
+        lcd_set_stroke_color(lcd, cmd->color);
+        lcd_stroke_rect(lcd, r->x, r->y, r->w, r->h);
+        break;
+      }
+      case DISPLAY_LIST_CMD_HLINE: {
+        lcd_set_stroke_color(lcd, cmd->color);
+        lcd_draw_hline(lcd, r->x, r->y, r->w);
+        break;
+      }
+      case DISPLAY_LIST_CMD_VLINE: {
+        lcd_set_stroke_color(lcd, cmd->color);
+        lcd_draw_vline(lcd, r->x, r->y, r->h);
+        break;
+      }
+      case DISPLAY_LIST_CMD_POINTS: {
+        lcd_set_stroke_color(lcd, cmd->color);
+        lcd_draw_points(lcd, (point_t*)(list->data + cmd->u.data.offset), cmd->u.data.nr);
+        break;
+      }
+      case DISPLAY_LIST_CMD_GLYPH: {
+        glyph_t glyph = cmd->u.glyph.glyph;
+
+        glyph.data = list->data + cmd->u.glyph.offset;
+        lcd_set_text_color(lcd, cmd->color);
+        lcd_draw_glyph(lcd, &glyph, &(cmd->u.glyph.src), cmd->u.glyph.x, cmd->u.glyph.y);
+        break;
+      }
+      case DISPLAY_LIST_CMD_GLYPH_RUN: {
+        uint32_t k = 0;
+        glyph_run_t run;
+        const uint8_t* p = list->data + cmd->u.data.offset;
+
+        run.nr = cmd->u.data.nr;
+        run.bounds = cmd->bounds;
+        memcpy(run.items, p, run.nr * sizeof(glyph_run_item_t));
+        p += run.nr * sizeof(glyph_run_item_t);
+        for (k = 0; k < run.nr; k++) {
+          run.items[k].data = p;
+          run.items[k].pitch = run.items[k].w;
+          p += run.items[k].w * run.items[k].h;
+        }
+        lcd_set_text_color(lcd, cmd->color);
+        lcd_draw_glyph_run(lcd, &run);
+        break;
+      }
+      case DISPLAY_LIST_CMD_IMAGE: {
+        lcd_draw_image(lcd, &(cmd->u.image.img), &(cmd->u.image.src), &(cmd->u.image.dst));
+        break;
+      }
+      case DISPLAY_LIST_CMD_IMAGE_MATRIX: {
+        draw_image_info_t info = cmd->u.matrix.info;
+
+        info.img = &(cmd->u.matrix.img);
+        lcd_draw_image_matrix(lcd, &info);
+        break;
+      }
+      default: {
+        break;
+      }
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t display_list_destroy(display_list_t* list) {
+  return_value_if_fail(list != NULL, RET_BAD_PARAMS);
+
+  TKMEM_FREE(list->cmds);
+  TKMEM_FREE(list->data);
+  TKMEM_FREE(list->lcd.font_name);
+  TKMEM_FREE(list);
+
+  return RET_OK;
+}
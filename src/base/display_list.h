@@ -0,0 +1,122 @@
+﻿/**
+ * File:   display_list.h
+ * Author: AWTK Develop Team
+ * Brief:  record draw calls of a frame and diff them against the previous frame
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_DISPLAY_LIST_H
+#define TK_DISPLAY_LIST_H
+
+#include "base/lcd.h"
+#include "base/dirty_rects.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class display_list_t
+ * 显示列表。
+ *
+ * 用display\_list\_get\_lcd返回的lcd代替真正的lcd绘制一帧时，绘制命令不会画出来，
+ * 而是(连同颜色、global\_alpha和绘制的区域)记录到显示列表中。
+ *
+ * * 两帧的显示列表可以比较(display\_list\_diff)，只有变化了的命令覆盖的区域才需要重绘。
+ * * 显示列表可以在另外一个lcd上重放(display\_list\_replay)，结果与直接绘制相同。
+ *   字模的数据在记录时复制到显示列表中，重放时不依赖字模缓存；
+ *   位图只记录了引用，它们在重放之前不能释放或改变(一般在同一帧中重放)。
+ * * vgcanvas的绘制和读取像素无法记录，这样的命令记录为未知命令：
+ *   比较时它覆盖的区域(当时的裁剪区)总是需要重绘，包含未知命令的显示列表不能重放。
+ *
+ * 位图只有属于image\_manager或者是IMMUTABLE的，才认为内容不会改变；
+ * 其它位图(比如离线画布的位图)无法确定内容是否改变，绘制它们的命令总是认为已经改变。
+ */
+typedef struct _display_list_t display_list_t;
+
+/**
+ * @method display_list_create
+ * 创建显示列表。
+ * @annotation ["constructor"]
+ * @param {lcd_t*} impl 真正的lcd(用于获取大小和位图格式等)。
+ *
+ * @return {display_list_t*} 返回显示列表。
+ */
+display_list_t* display_list_create(lcd_t* impl);
+
+/**
+ * @method display_list_get_lcd
+ * 获取用于记录的lcd(大小与真正的lcd相同)。
+ * lcd\_begin\_frame时清除以前的命令，并记录本帧绘制的区域。
+ * @param {display_list_t*} list 显示列表。
+ *
+ * @return {lcd_t*} 返回用于记录的lcd。
+ */
+lcd_t* display_list_get_lcd(display_list_t* list);
+
+/**
+ * @method display_list_size
+ * 获取命令的个数。
+ * @param {display_list_t*} list 显示列表。
+ *
+ * @return {uint32_t} 返回命令的个数。
+ */
+uint32_t display_list_size(display_list_t* list);
+
+/**
+ * @method display_list_has_unknown
+ * 检查是否有无法记录的命令(如vgcanvas的绘制)。
+ * @param {display_list_t*} list 显示列表。
+ *
+ * @return {bool_t} 返回TRUE表示有，否则表示没有。
+ */
+bool_t display_list_has_unknown(display_list_t* list);
+
+/**
+ * @method display_list_diff
+ * 与上一帧的显示列表比较，计算需要重绘的区域。
+ *
+ * 两帧绘制的区域相同时，按顺序匹配两个列表中相同的命令(可以跳过插入或删除的命令)，
+ * 没有匹配的命令覆盖的区域需要重绘。绘制的区域不同时，本帧绘制的区域都需要重绘。
+ * @param {display_list_t*} list 本帧的显示列表。
+ * @param {display_list_t*} prev 上一帧的显示列表(可以为NULL)。
+ * @param {dirty_rects_t*} damage 用于返回需要重绘的区域。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t display_list_diff(display_list_t* list, display_list_t* prev, dirty_rects_t* damage);
+
+/**
+ * @method display_list_replay
+ * 在指定的lcd上按顺序执行记录的命令。
+ * @param {display_list_t*} list 显示列表。
+ * @param {lcd_t*} lcd lcd对象(需要已经begin\_frame)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，有未知命令时返回RET_NOT_IMPL(不绘制任何内容)。
+ */
+ret_t display_list_replay(display_list_t* list, lcd_t* lcd);
+
+/**
+ * @method display_list_destroy
+ * 销毁显示列表。
+ * @param {display_list_t*} list 显示列表。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t display_list_destroy(display_list_t* list);
+
+END_C_DECLS
+
+#endif /*TK_DISPLAY_LIST_H*/
@@ -21,11 +21,102 @@
 
 #include "tkc/mem.h"
 #include "base/font.h"
+#include "base/glyph_atlas.h"
+#include "base/parallel_paint.h"
 
 ret_t font_get_glyph(font_t* f, wchar_t chr, font_size_t font_size, glyph_t* g) {
+  ret_t ret = RET_OK;
   return_value_if_fail(f != NULL && f->get_glyph != NULL && g != NULL, RET_BAD_PARAMS);
 
-  return f->get_glyph(f, chr, font_size, g);
+  /*字模缓存不是线程安全的*/
+  parallel_paint_lock();
+  ret = f->get_glyph(f, chr, font_size, g);
+  parallel_paint_unlock();
+
+  return ret;
+}
+
+#define FONT_ASCII_NR 128
+#define FONT_ASCII_TABLES_MAX_NR 4
+#define FONT_ADVANCE_UNKNOWN 0xffff
+#define FONT_ADVANCE_NOT_FOUND 0xfffe
+
+typedef struct _font_ascii_table_t {
+  font_size_t size;
+  uint16_t advances[FONT_ASCII_NR];
+  struct _font_ascii_table_t* next;
+} font_ascii_table_t;
+
+/*查找指定字号的表并移到最前面，没有时创建(超过上限时重用最久没有用到的表)*/
+static font_ascii_table_t* font_get_ascii_table(font_t* f, font_size_t font_size) {
+  uint32_t nr = 0;
+  font_ascii_table_t* prev = NULL;
+  font_ascii_table_t* iter = f->ascii_tables;
+
+  while (iter != NULL) {
+    nr++;
+    if (iter->size == font_size || (iter->next == NULL && nr >= FONT_ASCII_TABLES_MAX_NR)) {
+      break;
+    }
+    prev = iter;
+    iter = iter->next;
+  }
+
+  if (iter == NULL) {
+    iter = TKMEM_ZALLOC(font_ascii_table_t);
+    return_value_if_fail(iter != NULL, NULL);
+    iter->size = font_size + 1;
+  } else if (prev != NULL) {
+    prev->next = iter->next;
+  } else {
+    f->ascii_tables = iter->next;
+  }
+
+  if (iter->size != font_size) {
+    iter->size = font_size;
+    memset(iter->advances, 0xff, sizeof(iter->advances));
+  }
+
+  iter->next = f->ascii_tables;
+  f->ascii_tables = iter;
+
+  return iter;
+}
+
+ret_t font_get_advance(font_t* f, wchar_t chr, font_size_t font_size, uint16_t* advance) {
+  glyph_t g;
+  ret_t ret = RET_OK;
+  return_value_if_fail(f != NULL && f->get_glyph != NULL && advance != NULL, RET_BAD_PARAMS);
+
+  if ((uint32_t)chr < FONT_ASCII_NR) {
+    uint16_t a = FONT_ADVANCE_NOT_FOUND;
+    font_ascii_table_t* table = NULL;
+
+    parallel_paint_lock();
+    table = font_get_ascii_table(f, font_size);
+    if (table != NULL) {
+      a = table->advances[chr];
+      if (a == FONT_ADVANCE_UNKNOWN) {
+        ret = f->get_glyph(f, chr, font_size, &g);
+        a = (ret == RET_OK && g.advance < FONT_ADVANCE_NOT_FOUND) ? g.advance
+                                                                  : FONT_ADVANCE_NOT_FOUND;
+        table->advances[chr] = a;
+      }
+    }
+    parallel_paint_unlock();
+
+    if (table != NULL) {
+      *advance = a;
+      return a != FONT_ADVANCE_NOT_FOUND ? RET_OK : RET_NOT_FOUND;
+    }
+  }
+
+  ret = font_get_glyph(f, chr, font_size, &g);
+  if (ret == RET_OK) {
+    *advance = g.advance;
+  }
+
+  return ret;
 }
 
 ret_t font_shrink_cache(font_t* f, uint32_t cache_size) {
@@ -56,6 +147,16 @@ bool_t font_match(font_t* f, const char* name, font_size_t font_size) {
 ret_t font_destroy(font_t* f) {
   return_value_if_fail(f != NULL && f->destroy != NULL, RET_BAD_PARAMS);
 
+  if (glyph_atlas() != NULL) {
+    glyph_atlas_remove_font(glyph_atlas(), f);
+  }
+
+  while (f->ascii_tables != NULL) {
+    font_ascii_table_t* iter = f->ascii_tables;
+    f->ascii_tables = iter->next;
+    TKMEM_FREE(iter);
+  }
+
   return f->destroy(f);
 }
 
@@ -47,9 +47,33 @@ typedef enum _glyph_format_t {
    * @const GLYPH_FMT_RGBA
    * 每个像素占用4个字节。
    */
-  GLYPH_FMT_RGBA
+  GLYPH_FMT_RGBA,
+  /**
+   * @const GLYPH_FMT_A4
+   * 每个像素占用4个比特(覆盖率v*17)，每行(w+1)/2个字节(pitch)，前面的像素在高位。
+   */
+  GLYPH_FMT_A4,
+  /**
+   * @const GLYPH_FMT_A2
+   * 每个像素占用2个比特(覆盖率v*85)，每行(w+3)/4个字节(pitch)，前面的像素在高位。
+   */
+  GLYPH_FMT_A2,
+  /**
+   * @const GLYPH_FMT_RLE
+   * 按行游程编码的8位覆盖率(无损)。
+   *
+   * 每一行由若干段组成，段不跨行。每段以一个字节开头：高2位为类型，低6位为像素个数减1。
+   * 类型0为全透明，类型1为全不透明，类型2后面跟着相应个数的8位覆盖率。
+   */
+  GLYPH_FMT_RLE
 } glyph_format_t;
 
+/*GLYPH_FMT_RLE的段类型和每段最多的像素个数*/
+#define GLYPH_RLE_TRANSPARENT 0
+#define GLYPH_RLE_OPAQUE 1
+#define GLYPH_RLE_LITERAL 2
+#define GLYPH_RLE_MAX_COUNT 64
+
 struct _font_t;
 typedef struct _font_t font_t;
 
@@ -165,6 +189,10 @@ struct _font_t {
   font_shrink_cache_t shrink_cache;
   font_destroy_t destroy;
   const char* desc;
+
+  /*private*/
+  /*最近用到的几个字号的ASCII字符占位宽度表，由font_get_advance按需填充*/
+  struct _font_ascii_table_t* ascii_tables;
 };
 
 /**
@@ -202,6 +230,21 @@ bool_t font_match(font_t* font, const char* font_name, font_size_t font_size);
  */
 ret_t font_get_glyph(font_t* font, wchar_t chr, font_size_t font_size, glyph_t* glyph);
 
+/**
+ * @method font_get_advance
+ * 获取指定字符和大小的占位宽度。
+ *
+ * ASCII字符的占位宽度保存在字体的表中，之后不需要再获取字模。
+ *
+ * @param {font_t*} font font对象。
+ * @param {wchar_t} chr 字符。
+ * @param {font_size_t} font_size 字体大小。
+ * @param {uint16_t*} advance 返回占位宽度。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t font_get_advance(font_t* font, wchar_t chr, font_size_t font_size, uint16_t* advance);
+
 /**
  * @method font_shrink_cache
  * 清除最近没使用的字模。
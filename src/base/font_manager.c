@@ -24,9 +24,19 @@
 #include "base/events.h"
 #include "base/system_info.h"
 #include "base/font_manager.h"
+#include "base/parallel_paint.h"
 
 static font_manager_t* s_font_manager = NULL;
 
+typedef struct _font_measure_item_t {
+  font_t* font;
+  uint64_t hash;
+  uint32_t nr;
+  uint32_t stamp;
+  font_size_t font_size;
+  float_t width;
+} font_measure_item_t;
+
 typedef struct _font_cmp_info_t {
   const char* name;
   uint32_t size;
@@ -62,6 +72,8 @@ font_manager_t* font_manager_init(font_manager_t* fm, font_loader_t* loader) {
 
   fm->loader = loader;
   fm->assets_manager = NULL;
+  fm->measure_items = NULL;
+  fm->measure_stamp = 0;
 
   return fm;
 }
@@ -172,6 +184,7 @@ font_t* font_manager_get_font(font_manager_t* fm, const char* name, font_size_t
   name = asset_info_get_formatted_name(name);
   return_value_if_fail(fm != NULL, NULL);
 
+  parallel_paint_lock();
   font = font_manager_lookup(fm, name, size);
   if (font == NULL) {
     font = font_manager_load(fm, name, size);
@@ -181,10 +194,112 @@ font_t* font_manager_get_font(font_manager_t* fm, const char* name, font_size_t
       font = font_manager_get_font(fm, default_font, size);
     }
   }
+  parallel_paint_unlock();
 
   return font;
 }
 
+static ret_t font_manager_clear_measure_cache(font_manager_t* fm) {
+  parallel_paint_lock();
+  TKMEM_FREE(fm->measure_items);
+  fm->measure_items = NULL;
+  fm->measure_stamp = 0;
+  parallel_paint_unlock();
+
+  return RET_OK;
+}
+
+static float_t font_measure_text(font_t* font, font_size_t font_size, const wchar_t* str,
+                                 uint32_t nr) {
+  uint32_t i = 0;
+  float_t w = 0;
+  uint16_t advance = 0;
+
+  for (i = 0; i < nr; i++) {
+    if (font_get_advance(font, str[i], font_size, &advance) == RET_OK) {
+      w += advance + 1;
+    } else {
+      w += 4;
+    }
+  }
+
+  return w;
+}
+
+static uint64_t font_measure_hash(const wchar_t* str, uint32_t nr) {
+  uint32_t i = 0;
+  uint64_t hash = 0xcbf29ce484222325ULL;
+
+  for (i = 0; i < nr; i++) {
+    hash ^= (uint32_t)str[i];
+    hash *= 0x100000001b3ULL;
+  }
+
+  return hash;
+}
+
+/*两路组相联：每个字符串可以放在相邻的两个位置，都被占用时替换较早的一个*/
+float_t font_manager_measure_text(font_manager_t* fm, font_t* font, font_size_t font_size,
+                                  const wchar_t* str, uint32_t nr) {
+  uint32_t i = 0;
+  uint64_t hash = 0;
+  float_t width = 0;
+  font_measure_item_t* set = NULL;
+  return_value_if_fail(font != NULL && str != NULL, 0);
+
+  if (fm == NULL || nr < 2 || TK_TEXT_MEASURE_CACHE_NR < 2) {
+    return font_measure_text(font, font_size, str, nr);
+  }
+
+  hash = font_measure_hash(str, nr);
+  i = (uint32_t)(hash ^ (hash >> 32) ^ ((uintptr_t)font >> 4) ^ font_size);
+  i = i & (TK_TEXT_MEASURE_CACHE_NR - 2);
+
+  parallel_paint_lock();
+  if (fm->measure_items == NULL) {
+    fm->measure_items = TKMEM_ZALLOCN(font_measure_item_t, TK_TEXT_MEASURE_CACHE_NR);
+  }
+
+  if (fm->measure_items != NULL) {
+    uint32_t k = 0;
+    set = fm->measure_items + i;
+
+    for (k = 0; k < 2; k++) {
+      font_measure_item_t* iter = set + k;
+      if (iter->font == font && iter->hash == hash && iter->nr == nr &&
+          iter->font_size == font_size) {
+        iter->stamp = ++fm->measure_stamp;
+        width = iter->width;
+        parallel_paint_unlock();
+
+        return width;
+      }
+    }
+  }
+  parallel_paint_unlock();
+
+  width = font_measure_text(font, font_size, str, nr);
+
+  parallel_paint_lock();
+  if (fm->measure_items != NULL) {
+    font_measure_item_t* iter = NULL;
+
+    /*计算期间缓存可能被清除，重新取得位置*/
+    set = fm->measure_items + i;
+    iter = set[0].stamp <= set[1].stamp ? set : set + 1;
+
+    iter->font = font;
+    iter->hash = hash;
+    iter->nr = nr;
+    iter->font_size = font_size;
+    iter->width = width;
+    iter->stamp = ++fm->measure_stamp;
+  }
+  parallel_paint_unlock();
+
+  return width;
+}
+
 ret_t font_manager_unload_font(font_manager_t* fm, const char* name, font_size_t size) {
   ret_t ret = RET_OK;
   font_cmp_info_t info = {name, size};
@@ -204,6 +319,7 @@ ret_t font_manager_unload_font(font_manager_t* fm, const char* name, font_size_t
 #endif
 
   ret = darray_remove(&(fm->fonts), &info);
+  font_manager_clear_measure_cache(fm);
   if (ret == RET_OK) {
     assets_manager_clear_cache_ex(assets_manager(), ASSET_TYPE_FONT, name);
   }
@@ -214,12 +330,16 @@ ret_t font_manager_unload_font(font_manager_t* fm, const char* name, font_size_t
 ret_t font_manager_unload_all(font_manager_t* fm) {
   return_value_if_fail(fm != NULL, RET_FAIL);
 
+  font_manager_clear_measure_cache(fm);
+
   return darray_clear(&(fm->fonts));
 }
 
 ret_t font_manager_deinit(font_manager_t* fm) {
   return_value_if_fail(fm != NULL, RET_BAD_PARAMS);
 
+  font_manager_clear_measure_cache(fm);
+
   return darray_deinit(&(fm->fonts));
 }
 
@@ -51,6 +51,11 @@ typedef struct _font_manager_t {
    * 资源管理器。
    */
   assets_manager_t* assets_manager;
+
+  /*private*/
+  /*文本宽度的缓存，见font_manager_measure_text*/
+  struct _font_measure_item_t* measure_items;
+  uint32_t measure_stamp;
 } font_manager_t;
 
 /**
@@ -154,6 +159,24 @@ ret_t font_manager_unload_font(font_manager_t* fm, const char* name, font_size_t
  */
 ret_t font_manager_shrink_cache(font_manager_t* fm, uint32_t cache_size);
 
+/**
+ * @method font_manager_measure_text
+ * 计算文本的宽度。
+ *
+ * 结果按(字体、字号、字符串)缓存在字体管理器中(最多TK_TEXT_MEASURE_CACHE_NR个)，
+ * 同一个字符串再次计算时不需要获取字模。卸载字体时清除缓存。
+ *
+ * @param {font_manager_t*} fm 字体管理器对象(为NULL时不缓存)。
+ * @param {font_t*} font 字体。
+ * @param {font_size_t} font_size 字体大小。
+ * @param {const wchar_t*} str 字符串。
+ * @param {uint32_t} nr 字符数。
+ *
+ * @return {float_t} 返回文本的宽度。
+ */
+float_t font_manager_measure_text(font_manager_t* fm, font_t* font, font_size_t font_size,
+                                  const wchar_t* str, uint32_t nr);
+
 /**
  * @method font_manager_unload_all
  * 卸载全部字体。
@@ -0,0 +1,456 @@
+﻿/**
+ * File:   glyph_atlas.c
+ * Author: AWTK Develop Team
+ * Brief:  pack glyphs of the same font and size into shared A8 pages
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "base/glyph_atlas.h"
+#include "base/parallel_paint.h"
+
+/*字模之间留1个像素，GPU后端做纹理过滤时不会采样到相邻的字模*/
+#define GLYPH_ATLAS_PADDING 1
+#define GLYPH_ATLAS_MIN_CAPACITY 64
+
+typedef struct _glyph_atlas_entry_t {
+  font_t* font; /*NULL表示空位*/
+  wchar_t code;
+  font_size_t size;
+  /*不能放入图集的字模(非A8格式或者太大)，直接返回RET_NOT_IMPL，不用再调用font_get_glyph*/
+  bool_t rejected;
+  glyph_atlas_glyph_t g;
+} glyph_atlas_entry_t;
+
+struct _glyph_atlas_t {
+  uint32_t page_size;
+  uint32_t max_pages;
+  uint32_t serial;
+
+  uint32_t pages_nr;
+  uint32_t pages_capacity;
+  glyph_atlas_page_t** pages;
+
+  /*开放定址的哈希表，capacity为2的幂*/
+  uint32_t size;
+  uint32_t capacity;
+  glyph_atlas_entry_t* entries;
+};
+
+static glyph_atlas_t* s_glyph_atlas = NULL;
+
+glyph_atlas_t* glyph_atlas(void) {
+  return s_glyph_atlas;
+}
+
+ret_t glyph_atlas_set(glyph_atlas_t* atlas) {
+  s_glyph_atlas = atlas;
+
+  return RET_OK;
+}
+
+glyph_atlas_t* glyph_atlas_create(uint32_t page_size, uint32_t max_pages) {
+  glyph_atlas_t* atlas = NULL;
+  return_value_if_fail(page_size >= 16 && page_size <= 0xffff && max_pages > 0, NULL);
+
+  atlas = TKMEM_ZALLOC(glyph_atlas_t);
+  return_value_if_fail(atlas != NULL, NULL);
+
+  atlas->page_size = page_size;
+  atlas->max_pages = max_pages;
+  atlas->capacity = GLYPH_ATLAS_MIN_CAPACITY;
+  atlas->entries = TKMEM_ZALLOCN(glyph_atlas_entry_t, atlas->capacity);
+  if (atlas->entries == NULL) {
+    TKMEM_FREE(atlas);
+    return NULL;
+  }
+
+  return atlas;
+}
+
+static uint32_t glyph_atlas_hash(font_t* font, wchar_t code, font_size_t size) {
+  uint32_t h = (uint32_t)(((uintptr_t)font) >> 4);
+
+  h = h * 31 + size;
+  h = h * 31 + (uint32_t)code;
+
+  return h * 2654435761u;
+}
+
+static glyph_atlas_entry_t* glyph_atlas_find(glyph_atlas_t* atlas, font_t* font, wchar_t code,
+                                             font_size_t size) {
+  uint32_t mask = atlas->capacity - 1;
+  uint32_t i = glyph_atlas_hash(font, code, size) & mask;
+
+  while (atlas->entries[i].font != NULL) {
+    glyph_atlas_entry_t* iter = atlas->entries + i;
+
+    if (iter->font == font && iter->code == code && iter->size == size) {
+      return iter;
+    }
+    i = (i + 1) & mask;
+  }
+
+  return NULL;
+}
+
+static void glyph_atlas_insert(glyph_atlas_entry_t* entries, uint32_t capacity,
+                               const glyph_atlas_entry_t* entry) {
+  uint32_t mask = capacity - 1;
+  uint32_t i = glyph_atlas_hash(entry->font, entry->code, entry->size) & mask;
+
+  while (entries[i].font != NULL) {
+    i = (i + 1) & mask;
+  }
+  entries[i] = *entry;
+}
+
+/*重建哈希表，同时删除指定页面或者指定字体的字模*/
+static ret_t glyph_atlas_rehash(glyph_atlas_t* atlas, uint32_t capacity,
+                                glyph_atlas_page_t* drop_page, font_t* drop_font) {
+  uint32_t i = 0;
+  uint32_t size = 0;
+  glyph_atlas_entry_t* entries = TKMEM_ZALLOCN(glyph_atlas_entry_t, capacity);
+  return_value_if_fail(entries != NULL, RET_OOM);
+
+  for (i = 0; i < atlas->capacity; i++) {
+    glyph_atlas_entry_t* iter = atlas->entries + i;
+
+    if (iter->font == NULL || iter->font == drop_font ||
+        (drop_page != NULL && iter->g.page == drop_page)) {
+      continue;
+    }
+    glyph_atlas_insert(entries, capacity, iter);
+    size++;
+  }
+
+  TKMEM_FREE(atlas->entries);
+  atlas->entries = entries;
+  atlas->capacity = capacity;
+  atlas->size = size;
+
+  return RET_OK;
+}
+
+static ret_t glyph_atlas_page_reset(glyph_atlas_page_t* page, font_t* font, font_size_t size) {
+  page->font = font;
+  page->size = size;
+  page->shelf_x = 0;
+  page->shelf_y = 0;
+  page->shelf_h = 0;
+  page->generation++;
+
+  return RET_OK;
+}
+
+static glyph_atlas_page_t* glyph_atlas_page_create(glyph_atlas_t* atlas) {
+  glyph_atlas_page_t* page = NULL;
+
+  if (atlas->pages_nr >= atlas->pages_capacity) {
+    uint32_t capacity = atlas->pages_capacity + 4;
+    glyph_atlas_page_t** pages = TKMEM_REALLOCT(glyph_atlas_page_t*, atlas->pages, capacity);
+    return_value_if_fail(pages != NULL, NULL);
+
+    atlas->pages = pages;
+    atlas->pages_capacity = capacity;
+  }
+
+  page = TKMEM_ZALLOC(glyph_atlas_page_t);
+  return_value_if_fail(page != NULL, NULL);
+
+  page->w = atlas->page_size;
+  page->h = atlas->page_size;
+  page->data = (uint8_t*)TKMEM_ALLOC(page->w * page->h);
+  if (page->data == NULL) {
+    TKMEM_FREE(page);
+    return NULL;
+  }
+  memset(page->data, 0x00, page->w * page->h);
+  atlas->pages[atlas->pages_nr++] = page;
+
+  return page;
+}
+
+static ret_t glyph_atlas_page_destroy(glyph_atlas_page_t* page) {
+  TKMEM_FREE(page->data);
+  TKMEM_FREE(page);
+
+  return RET_OK;
+}
+
+/*按行(shelf)依次排列，放不下时换到新的一行*/
+static bool_t glyph_atlas_page_pack(glyph_atlas_page_t* page, uint32_t w, uint32_t h, uint32_t* x,
+                                    uint32_t* y) {
+  w += GLYPH_ATLAS_PADDING;
+  h += GLYPH_ATLAS_PADDING;
+
+  if (page->shelf_x + w > page->w) {
+    page->shelf_y += page->shelf_h;
+    page->shelf_x = 0;
+    page->shelf_h = 0;
+  }
+
+  if (page->shelf_x + w > page->w || page->shelf_y + h > page->h) {
+    return FALSE;
+  }
+
+  *x = page->shelf_x;
+  *y = page->shelf_y;
+  page->shelf_x += w;
+  page->shelf_h = tk_max(page->shelf_h, h);
+
+  return TRUE;
+}
+
+/*删除页面中的字模，并从页面列表中移除(不释放页面)*/
+static ret_t glyph_atlas_detach_page(glyph_atlas_t* atlas, glyph_atlas_page_t* page) {
+  uint32_t i = 0;
+
+  glyph_atlas_rehash(atlas, atlas->capacity, page, NULL);
+  for (i = 0; i < atlas->pages_nr; i++) {
+    if (atlas->pages[i] == page) {
+      memmove(atlas->pages + i, atlas->pages + i + 1,
+              (atlas->pages_nr - i - 1) * sizeof(glyph_atlas_page_t*));
+      atlas->pages_nr--;
+      break;
+    }
+  }
+
+  return RET_OK;
+}
+
+/*找一个可以淘汰的页面：当前字模串没有用到，并且不在多线程绘制期间*/
+static glyph_atlas_page_t* glyph_atlas_find_victim(glyph_atlas_t* atlas) {
+  uint32_t i = 0;
+  glyph_atlas_page_t* victim = NULL;
+
+  if (parallel_paint_is_busy()) {
+    return NULL;
+  }
+
+  for (i = 0; i < atlas->pages_nr; i++) {
+    glyph_atlas_page_t* iter = atlas->pages[i];
+
+    if (iter->last_used == atlas->serial) {
+      continue;
+    }
+
+    if (victim == NULL || iter->last_used < victim->last_used) {
+      victim = iter;
+    }
+  }
+
+  return victim;
+}
+
+static glyph_atlas_page_t* glyph_atlas_alloc(glyph_atlas_t* atlas, font_t* font, font_size_t size,
+                                             uint32_t w, uint32_t h, uint32_t* x, uint32_t* y) {
+  int32_t i = 0;
+  glyph_atlas_page_t* page = NULL;
+
+  /*同一个字体和字号的字模，放在最后分配给它的页面中*/
+  for (i = (int32_t)(atlas->pages_nr) - 1; i >= 0; i--) {
+    page = atlas->pages[i];
+    if (page->font == font && page->size == size) {
+      if (glyph_atlas_page_pack(page, w, h, x, y)) {
+        return page;
+      }
+      break;
+    }
+  }
+
+  page = NULL;
+  while (atlas->pages_nr >= atlas->max_pages) {
+    glyph_atlas_page_t* victim = glyph_atlas_find_victim(atlas);
+    if (victim == NULL) {
+      break;
+    }
+
+    glyph_atlas_detach_page(atlas, victim);
+    if (atlas->pages_nr < atlas->max_pages) {
+      /*重用，放到最后，作为该字体和字号最新的页面*/
+      page = victim;
+      atlas->pages[atlas->pages_nr++] = page;
+      break;
+    } else {
+      /*多线程绘制期间超过了上限，释放多出来的页面*/
+      glyph_atlas_page_destroy(victim);
+    }
+  }
+
+  if (page == NULL) {
+    page = glyph_atlas_page_create(atlas);
+    return_value_if_fail(page != NULL, NULL);
+  }
+
+  glyph_atlas_page_reset(page, font, size);
+  if (!glyph_atlas_page_pack(page, w, h, x, y)) {
+    return NULL;
+  }
+
+  return page;
+}
+
+ret_t glyph_atlas_begin(glyph_atlas_t* atlas) {
+  return_value_if_fail(atlas != NULL, RET_BAD_PARAMS);
+
+  parallel_paint_lock();
+  atlas->serial++;
+  parallel_paint_unlock();
+
+  return RET_OK;
+}
+
+static ret_t glyph_atlas_add(glyph_atlas_t* atlas, font_t* font, wchar_t code, font_size_t size,
+                             glyph_atlas_glyph_t* g) {
+  glyph_t glyph;
+  glyph_atlas_entry_t entry;
+  ret_t ret = font_get_glyph(font, code, size, &glyph);
+
+  if (ret != RET_OK) {
+    return ret;
+  }
+
+  memset(&entry, 0x00, sizeof(entry));
+  entry.font = font;
+  entry.code = code;
+  entry.size = size;
+  entry.g.x = glyph.x;
+  entry.g.y = glyph.y;
+  entry.g.w = glyph.w;
+  entry.g.h = glyph.h;
+  entry.g.advance = glyph.advance;
+
+  if (glyph.data != NULL && glyph.w > 0 && glyph.h > 0) {
+    uint32_t j = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+    glyph_atlas_page_t* page = NULL;
+
+    if (glyph.format != GLYPH_FMT_ALPHA || glyph.w > atlas->page_size / 2 ||
+        glyph.h > atlas->page_size / 2) {
+      entry.rejected = TRUE;
+    } else {
+      page = glyph_atlas_alloc(atlas, font, size, glyph.w, glyph.h, &x, &y);
+      return_value_if_fail(page != NULL, RET_OOM);
+
+      for (j = 0; j < glyph.h; j++) {
+        memcpy(page->data + (y + j) * page->w + x, glyph.data + j * glyph.w, glyph.w);
+      }
+
+      entry.g.page = page;
+      entry.g.page_x = x;
+      entry.g.page_y = y;
+      page->last_used = atlas->serial;
+    }
+  }
+
+  if ((atlas->size + 1) * 2 > atlas->capacity) {
+    return_value_if_fail(glyph_atlas_rehash(atlas, atlas->capacity * 2, NULL, NULL) == RET_OK,
+                         RET_OOM);
+  }
+  glyph_atlas_insert(atlas->entries, atlas->capacity, &entry);
+  atlas->size++;
+
+  if (entry.rejected) {
+    return RET_NOT_IMPL;
+  }
+  *g = entry.g;
+
+  return RET_OK;
+}
+
+ret_t glyph_atlas_get(glyph_atlas_t* atlas, font_t* font, wchar_t code, font_size_t size,
+                      glyph_atlas_glyph_t* g) {
+  ret_t ret = RET_OK;
+  glyph_atlas_entry_t* entry = NULL;
+  return_value_if_fail(atlas != NULL && font != NULL && g != NULL, RET_BAD_PARAMS);
+
+  parallel_paint_lock();
+  entry = glyph_atlas_find(atlas, font, code, size);
+  if (entry != NULL && entry->rejected) {
+    ret = RET_NOT_IMPL;
+  } else if (entry != NULL) {
+    if (entry->g.page != NULL) {
+      entry->g.page->last_used = atlas->serial;
+    }
+    *g = entry->g;
+  } else {
+    ret = glyph_atlas_add(atlas, font, code, size, g);
+  }
+  parallel_paint_unlock();
+
+  return ret;
+}
+
+ret_t glyph_atlas_remove_font(glyph_atlas_t* atlas, font_t* font) {
+  uint32_t i = 0;
+  uint32_t nr = 0;
+  return_value_if_fail(atlas != NULL && font != NULL, RET_BAD_PARAMS);
+
+  glyph_atlas_rehash(atlas, atlas->capacity, NULL, font);
+  for (i = 0; i < atlas->pages_nr; i++) {
+    glyph_atlas_page_t* iter = atlas->pages[i];
+
+    if (iter->font == font) {
+      glyph_atlas_page_destroy(iter);
+    } else {
+      atlas->pages[nr++] = iter;
+    }
+  }
+  atlas->pages_nr = nr;
+
+  return RET_OK;
+}
+
+ret_t glyph_atlas_clear(glyph_atlas_t* atlas) {
+  uint32_t i = 0;
+  return_value_if_fail(atlas != NULL, RET_BAD_PARAMS);
+
+  for (i = 0; i < atlas->pages_nr; i++) {
+    glyph_atlas_page_destroy(atlas->pages[i]);
+  }
+  atlas->pages_nr = 0;
+
+  memset(atlas->entries, 0x00, atlas->capacity * sizeof(glyph_atlas_entry_t));
+  atlas->size = 0;
+
+  return RET_OK;
+}
+
+uint32_t glyph_atlas_get_pages_nr(glyph_atlas_t* atlas) {
+  return_value_if_fail(atlas != NULL, 0);
+
+  return atlas->pages_nr;
+}
+
+glyph_atlas_page_t* glyph_atlas_get_page(glyph_atlas_t* atlas, uint32_t index) {
+  return_value_if_fail(atlas != NULL && index < atlas->pages_nr, NULL);
+
+  return atlas->pages[index];
+}
+
+ret_t glyph_atlas_destroy(glyph_atlas_t* atlas) {
+  return_value_if_fail(atlas != NULL, RET_BAD_PARAMS);
+
+  glyph_atlas_clear(atlas);
+  TKMEM_FREE(atlas->pages);
+  TKMEM_FREE(atlas->entries);
+  TKMEM_FREE(atlas);
+
+  return RET_OK;
+}
@@ -0,0 +1,252 @@
+﻿/**
+ * File:   glyph_atlas.h
+ * Author: AWTK Develop Team
+ * Brief:  pack glyphs of the same font and size into shared A8 pages
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_GLYPH_ATLAS_H
+#define TK_GLYPH_ATLAS_H
+
+#include "base/font.h"
+
+BEGIN_C_DECLS
+
+#ifndef TK_GLYPH_ATLAS_PAGE_SIZE
+#define TK_GLYPH_ATLAS_PAGE_SIZE 256
+#endif /*TK_GLYPH_ATLAS_PAGE_SIZE*/
+
+#ifndef TK_GLYPH_ATLAS_MAX_PAGES
+#define TK_GLYPH_ATLAS_MAX_PAGES 4
+#endif /*TK_GLYPH_ATLAS_MAX_PAGES*/
+
+/**
+ * @class glyph_atlas_page_t
+ * 字模图集的一页(A8格式，w x h字节)。
+ *
+ * 一页只存放同一个字体、同一个字号的字模。
+ */
+typedef struct _glyph_atlas_page_t {
+  /**
+   * @property {uint8_t*} data
+   * @annotation ["readable"]
+   * A8数据。
+   */
+  uint8_t* data;
+  /**
+   * @property {uint32_t} w
+   * @annotation ["readable"]
+   * 宽度(也是每一行的字节数)。
+   */
+  uint32_t w;
+  /**
+   * @property {uint32_t} h
+   * @annotation ["readable"]
+   * 高度。
+   */
+  uint32_t h;
+  /**
+   * @property {uint32_t} generation
+   * @annotation ["readable"]
+   * 内容的版本号，页面被回收重用时递增(GPU后端可据此重新上传纹理)。
+   */
+  uint32_t generation;
+
+  /*private*/
+  font_t* font;
+  font_size_t size;
+  uint32_t shelf_x;
+  uint32_t shelf_y;
+  uint32_t shelf_h;
+  uint32_t last_used;
+} glyph_atlas_page_t;
+
+/**
+ * @class glyph_atlas_glyph_t
+ * 图集中的字模。
+ */
+typedef struct _glyph_atlas_glyph_t {
+  /**
+   * @property {int16_t} x
+   * @annotation ["readable"]
+   * x偏移(同glyph_t)。
+   */
+  int16_t x;
+  /**
+   * @property {int16_t} y
+   * @annotation ["readable"]
+   * y偏移(同glyph_t)。
+   */
+  int16_t y;
+  /**
+   * @property {uint16_t} w
+   * @annotation ["readable"]
+   * 宽度。
+   */
+  uint16_t w;
+  /**
+   * @property {uint16_t} h
+   * @annotation ["readable"]
+   * 高度。
+   */
+  uint16_t h;
+  /**
+   * @property {uint16_t} advance
+   * @annotation ["readable"]
+   * 占位宽度。
+   */
+  uint16_t advance;
+  /**
+   * @property {uint16_t} page_x
+   * @annotation ["readable"]
+   * 在页面中的x坐标。
+   */
+  uint16_t page_x;
+  /**
+   * @property {uint16_t} page_y
+   * @annotation ["readable"]
+   * 在页面中的y坐标。
+   */
+  uint16_t page_y;
+  /**
+   * @property {glyph_atlas_page_t*} page
+   * @annotation ["readable"]
+   * 所在的页面(没有字模数据时为NULL，比如空格)。
+   */
+  glyph_atlas_page_t* page;
+} glyph_atlas_glyph_t;
+
+/**
+ * @class glyph_atlas_t
+ * 字模图集。
+ *
+ * 把同一个字体、同一个字号的A8字模打包到共享的页面中，
+ * 绘制文本时通过哈希表直接找到字模在页面中的位置，不需要每个字符调用font\_get\_glyph复制字模，
+ * 一行文字可以作为一个字模串(glyph\_run\_t)一次提交给lcd。
+ * 页面也可以直接作为GPU后端的纹理。
+ *
+ * 页面个数超过上限时，淘汰最久没有使用的页面。
+ * 当前字模串(glyph\_atlas\_begin之后)用到的页面和多线程绘制期间的页面不会被淘汰，此时允许超过上限。
+ *
+ * 只有GLYPH\_FMT\_ALPHA格式的字模才能放入图集，其它格式由调用者直接绘制。
+ * 不能放入图集的字模也会记下来，再次获取时直接返回RET\_NOT\_IMPL。
+ * 定义WITHOUT\_GLYPH\_ATLAS可以禁用。
+ */
+typedef struct _glyph_atlas_t glyph_atlas_t;
+
+/**
+ * @method glyph_atlas
+ * 获取缺省的字模图集。
+ * @annotation ["constructor"]
+ *
+ * @return {glyph_atlas_t*} 返回字模图集，没有设置时返回NULL。
+ */
+glyph_atlas_t* glyph_atlas(void);
+
+/**
+ * @method glyph_atlas_set
+ * 设置缺省的字模图集。
+ * @param {glyph_atlas_t*} atlas 字模图集。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t glyph_atlas_set(glyph_atlas_t* atlas);
+
+/**
+ * @method glyph_atlas_create
+ * 创建字模图集。
+ * @annotation ["constructor"]
+ * @param {uint32_t} page_size 页面的宽度和高度。
+ * @param {uint32_t} max_pages 页面的最大个数。
+ *
+ * @return {glyph_atlas_t*} 返回字模图集。
+ */
+glyph_atlas_t* glyph_atlas_create(uint32_t page_size, uint32_t max_pages);
+
+/**
+ * @method glyph_atlas_begin
+ * 开始一个新的字模串。此后取得的字模所在的页面，在下一次调用本函数之前不会被淘汰。
+ * @param {glyph_atlas_t*} atlas 字模图集。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t glyph_atlas_begin(glyph_atlas_t* atlas);
+
+/**
+ * @method glyph_atlas_get
+ * 获取字模，不在图集中时从字体中获取并加入图集。
+ * @param {glyph_atlas_t*} atlas 字模图集。
+ * @param {font_t*} font 字体。
+ * @param {wchar_t} code 字符。
+ * @param {font_size_t} size 字号。
+ * @param {glyph_atlas_glyph_t*} g 用于返回字模。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，返回RET_NOT_IMPL表示字模不能放入图集(调用者应该直接绘制)，其它表示失败。
+ */
+ret_t glyph_atlas_get(glyph_atlas_t* atlas, font_t* font, wchar_t code, font_size_t size,
+                      glyph_atlas_glyph_t* g);
+
+/**
+ * @method glyph_atlas_remove_font
+ * 删除指定字体的全部字模(字体销毁时调用)。
+ * @param {glyph_atlas_t*} atlas 字模图集。
+ * @param {font_t*} font 字体。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t glyph_atlas_remove_font(glyph_atlas_t* atlas, font_t* font);
+
+/**
+ * @method glyph_atlas_clear
+ * 清除全部字模，并释放全部页面。
+ * @param {glyph_atlas_t*} atlas 字模图集。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t glyph_atlas_clear(glyph_atlas_t* atlas);
+
+/**
+ * @method glyph_atlas_get_pages_nr
+ * 获取页面的个数。
+ * @param {glyph_atlas_t*} atlas 字模图集。
+ *
+ * @return {uint32_t} 返回页面的个数。
+ */
+uint32_t glyph_atlas_get_pages_nr(glyph_atlas_t* atlas);
+
+/**
+ * @method glyph_atlas_get_page
+ * 获取指定的页面。
+ * @param {glyph_atlas_t*} atlas 字模图集。
+ * @param {uint32_t} index 序数。
+ *
+ * @return {glyph_atlas_page_t*} 返回页面。
+ */
+glyph_atlas_page_t* glyph_atlas_get_page(glyph_atlas_t* atlas, uint32_t index);
+
+/**
+ * @method glyph_atlas_destroy
+ * 销毁字模图集。
+ * @param {glyph_atlas_t*} atlas 字模图集。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t glyph_atlas_destroy(glyph_atlas_t* atlas);
+
+END_C_DECLS
+
+#endif /*TK_GLYPH_ATLAS_H*/
@@ -19,89 +19,305 @@
  *
  */
 
-#define GLYPH_CACHE_FREE_ITEM(cache, item)            \
-  {                                                   \
-    if (cache->destroy_glyph && item->g != NULL) {    \
-      cache->destroy_glyph(item->g);                  \
-      memset(item, 0x00, sizeof(glyph_cache_item_t)); \
-    }                                                 \
-  }
-
 #include "tkc/mem.h"
 #include "tkc/time_now.h"
 #include "base/glyph_cache.h"
+#include "base/parallel_paint.h"
+
+#define GLYPH_CACHE_NIL 0xffffffff
+#define GLYPH_CACHE_ITEM_OVERHEAD (sizeof(glyph_cache_item_t) + sizeof(glyph_t) + sizeof(uint32_t))
+
+static uint32_t glyph_cache_hash(wchar_t code, font_size_t size) {
+  uint32_t h = (uint32_t)code * 31 + size;
+
+  h ^= h >> 16;
+  h *= 0x45d9f3b;
+  h ^= h >> 16;
+
+  return h;
+}
+
+static uint32_t glyph_cache_buckets_nr(uint32_t capacity) {
+  uint32_t buckets_nr = 16;
+
+  while (buckets_nr < capacity) {
+    buckets_nr <<= 1;
+  }
+
+  return buckets_nr;
+}
+
+static uint32_t glyph_cache_glyph_bytes(const glyph_t* g) {
+  uint32_t data_size = 0;
+
+  if (g->data != NULL) {
+    if (g->format == GLYPH_FMT_MONO) {
+      data_size = (g->pitch > 0 ? g->pitch : (g->w + 7) / 8) * g->h;
+    } else if (g->format == GLYPH_FMT_A4 || g->format == GLYPH_FMT_A2) {
+      data_size = g->pitch * g->h;
+    } else if (g->format == GLYPH_FMT_RGBA) {
+      data_size = g->w * g->h * 4;
+    } else {
+      data_size = g->w * g->h;
+    }
+  }
+
+  return data_size + GLYPH_CACHE_ITEM_OVERHEAD;
+}
+
+static ret_t glyph_cache_destroy_item(glyph_cache_t* cache, glyph_cache_item_t* item) {
+  if (cache->destroy_glyph != NULL && item->g != NULL) {
+    cache->destroy_glyph(item->g);
+  }
+  memset(item, 0x00, sizeof(glyph_cache_item_t));
+
+  return RET_OK;
+}
+
+static uint32_t* glyph_cache_bucket(glyph_cache_t* cache, wchar_t code, font_size_t size) {
+  return cache->buckets + (glyph_cache_hash(code, size) & (cache->buckets_nr - 1));
+}
+
+static ret_t glyph_cache_hash_insert(glyph_cache_t* cache, uint32_t i) {
+  glyph_cache_item_t* item = cache->items + i;
+  uint32_t* bucket = glyph_cache_bucket(cache, item->code, item->size);
+
+  item->hash_next = *bucket;
+  *bucket = i;
+
+  return RET_OK;
+}
+
+/*返回指向第i个字模的哈希链接(桶或者前一个字模的hash_next)*/
+static uint32_t* glyph_cache_hash_link(glyph_cache_t* cache, uint32_t i) {
+  glyph_cache_item_t* item = cache->items + i;
+  uint32_t* link = glyph_cache_bucket(cache, item->code, item->size);
+
+  while (*link != i) {
+    link = &(cache->items[*link].hash_next);
+  }
+
+  return link;
+}
+
+static ret_t glyph_cache_rehash(glyph_cache_t* cache, uint32_t buckets_nr) {
+  uint32_t i = 0;
+
+  if (buckets_nr != cache->buckets_nr) {
+    uint32_t* buckets = TKMEM_ALLOC(sizeof(uint32_t) * buckets_nr);
+    return_value_if_fail(buckets != NULL, RET_OOM);
+
+    TKMEM_FREE(cache->buckets);
+    cache->buckets = buckets;
+    cache->buckets_nr = buckets_nr;
+  }
+
+  memset(cache->buckets, 0xff, sizeof(uint32_t) * cache->buckets_nr);
+  for (i = 0; i < cache->size; i++) {
+    glyph_cache_hash_insert(cache, i);
+  }
+
+  return RET_OK;
+}
+
+static ret_t glyph_cache_lru_unlink(glyph_cache_t* cache, uint32_t i) {
+  glyph_cache_item_t* item = cache->items + i;
+
+  if (item->prev != GLYPH_CACHE_NIL) {
+    cache->items[item->prev].next = item->next;
+  } else {
+    cache->lru_head = item->next;
+  }
+
+  if (item->next != GLYPH_CACHE_NIL) {
+    cache->items[item->next].prev = item->prev;
+  } else {
+    cache->lru_tail = item->prev;
+  }
+
+  return RET_OK;
+}
+
+static ret_t glyph_cache_lru_push_front(glyph_cache_t* cache, uint32_t i) {
+  glyph_cache_item_t* item = cache->items + i;
+
+  item->prev = GLYPH_CACHE_NIL;
+  item->next = cache->lru_head;
+  if (cache->lru_head != GLYPH_CACHE_NIL) {
+    cache->items[cache->lru_head].prev = i;
+  } else {
+    cache->lru_tail = i;
+  }
+  cache->lru_head = i;
+
+  return RET_OK;
+}
+
+/*删除第i个字模，并把最后一个字模移到第i个位置，保持items[0, size)连续*/
+static ret_t glyph_cache_remove(glyph_cache_t* cache, uint32_t i) {
+  uint32_t last = cache->size - 1;
+  glyph_cache_item_t* item = cache->items + i;
+
+  *glyph_cache_hash_link(cache, i) = item->hash_next;
+  glyph_cache_lru_unlink(cache, i);
+  cache->bytes -= item->bytes;
+  glyph_cache_destroy_item(cache, item);
+
+  if (i != last) {
+    *glyph_cache_hash_link(cache, last) = i;
+    *item = cache->items[last];
+    memset(cache->items + last, 0x00, sizeof(glyph_cache_item_t));
+
+    if (item->prev != GLYPH_CACHE_NIL) {
+      cache->items[item->prev].next = i;
+    } else {
+      cache->lru_head = i;
+    }
+
+    if (item->next != GLYPH_CACHE_NIL) {
+      cache->items[item->next].prev = i;
+    } else {
+      cache->lru_tail = i;
+    }
+  }
+  cache->size--;
+
+  return RET_OK;
+}
+
+static bool_t glyph_cache_is_full(glyph_cache_t* cache, uint32_t bytes) {
+  if (cache->size == 0) {
+    return FALSE;
+  }
+
+  if (cache->max_bytes > 0) {
+    return cache->bytes + bytes > cache->max_bytes;
+  } else {
+    return cache->size >= cache->max_size;
+  }
+}
+
+/*淘汰最久没有使用的字模，直到可以放下bytes字节的字模*/
+static ret_t glyph_cache_make_room(glyph_cache_t* cache, uint32_t bytes) {
+  while (glyph_cache_is_full(cache, bytes)) {
+    glyph_cache_item_t* oldest = cache->items + cache->lru_tail;
+
+    if (parallel_paint_is_busy() && oldest->last_access_time >= parallel_paint_get_start_time()) {
+      /*缓存中的字模都是本帧用到的，可能正被其它绘制线程使用，不能淘汰，扩容*/
+      break;
+    }
+
+    glyph_cache_remove(cache, cache->lru_tail);
+    cache->evictions++;
+  }
+
+  return RET_OK;
+}
+
+static ret_t glyph_cache_extend(glyph_cache_t* cache, uint32_t capacity) {
+  glyph_cache_item_t* items = TKMEM_REALLOCT(glyph_cache_item_t, cache->items, capacity);
+  return_value_if_fail(items != NULL, RET_OOM);
+
+  cache->items = items;
+  cache->capacity = capacity;
+
+  return RET_OK;
+}
+
+/*多线程绘制期间临时扩大的容量，在淘汰到max_size以下之后收缩回来*/
+static ret_t glyph_cache_trim(glyph_cache_t* cache) {
+  uint32_t buckets_nr = glyph_cache_buckets_nr(cache->max_size);
+
+  if (cache->max_bytes > 0 || cache->capacity <= cache->max_size ||
+      cache->size >= cache->max_size || parallel_paint_is_busy()) {
+    return RET_OK;
+  }
+
+  return_value_if_fail(glyph_cache_extend(cache, cache->max_size) == RET_OK, RET_OOM);
+  if (cache->buckets_nr > buckets_nr) {
+    return glyph_cache_rehash(cache, buckets_nr);
+  }
+
+  return RET_OK;
+}
 
 glyph_cache_t* glyph_cache_init(glyph_cache_t* cache, uint32_t capacity,
                                 tk_destroy_t destroy_glyph) {
   return_value_if_fail(cache != NULL && capacity > 0, NULL);
 
+  memset(cache, 0x00, sizeof(glyph_cache_t));
   cache->items = TKMEM_ZALLOCN(glyph_cache_item_t, capacity);
   return_value_if_fail(cache->items != NULL, NULL);
 
   cache->size = 0;
   cache->capacity = capacity;
+  cache->max_size = capacity;
   cache->destroy_glyph = destroy_glyph;
+  cache->lru_head = GLYPH_CACHE_NIL;
+  cache->lru_tail = GLYPH_CACHE_NIL;
+  if (glyph_cache_rehash(cache, glyph_cache_buckets_nr(capacity)) != RET_OK) {
+    TKMEM_FREE(cache->items);
+    return NULL;
+  }
 
   return cache;
 }
 
-static glyph_cache_item_t* glyph_cache_get_empty(glyph_cache_t* cache) {
+ret_t glyph_cache_add(glyph_cache_t* cache, wchar_t code, font_size_t size, glyph_t* g) {
   uint32_t i = 0;
-  uint32_t nr = 0;
-  uint32_t oldest = 0;
+  uint32_t bytes = 0;
   glyph_cache_item_t* item = NULL;
-  uint32_t oldest_time = 0xffffffff;
+  return_value_if_fail(cache != NULL && cache->items != NULL && g != NULL, RET_BAD_PARAMS);
 
-  return_value_if_fail(cache != NULL && cache->items != NULL, NULL);
+  bytes = glyph_cache_glyph_bytes(g);
+  glyph_cache_make_room(cache, bytes);
+  glyph_cache_trim(cache);
 
-  if (cache->size < cache->capacity) {
-    oldest = cache->size++;
-    return cache->items + oldest;
+  if (cache->size >= cache->capacity) {
+    return_value_if_fail(glyph_cache_extend(cache, cache->capacity * 2) == RET_OK, RET_OOM);
   }
 
-  for (i = 0, nr = cache->size; i < nr; i++) {
-    glyph_cache_item_t* item = cache->items + i;
-    if (item->last_access_time < oldest_time) {
-      oldest_time = item->last_access_time;
-      oldest = i;
-      if (oldest_time == 0) {
-        break;
-      }
-    }
+  if (cache->size >= cache->buckets_nr) {
+    return_value_if_fail(glyph_cache_rehash(cache, cache->buckets_nr * 2) == RET_OK, RET_OOM);
   }
 
-  item = cache->items + oldest;
-  GLYPH_CACHE_FREE_ITEM(cache, item);
-
-  return item;
-}
-
-ret_t glyph_cache_add(glyph_cache_t* cache, wchar_t code, font_size_t size, glyph_t* g) {
-  glyph_cache_item_t* item = glyph_cache_get_empty(cache);
-  return_value_if_fail(cache != NULL && g != NULL && item != NULL, RET_BAD_PARAMS);
-
+  i = cache->size++;
+  item = cache->items + i;
   item->g = g;
   item->size = size;
   item->code = code;
+  item->bytes = bytes;
   item->last_access_time = time_now_ms();
+  cache->bytes += bytes;
+
+  glyph_cache_hash_insert(cache, i);
+  glyph_cache_lru_push_front(cache, i);
 
   return RET_OK;
 }
 
 ret_t glyph_cache_lookup(glyph_cache_t* cache, wchar_t code, font_size_t size, glyph_t* g) {
   uint32_t i = 0;
-  uint32_t nr = 0;
 
   return_value_if_fail(cache != NULL && g != NULL, RET_BAD_PARAMS);
-  for (i = 0, nr = cache->size; i < nr; i++) {
+  return_value_if_fail(cache->buckets != NULL, RET_BAD_PARAMS);
+
+  for (i = *glyph_cache_bucket(cache, code, size); i != GLYPH_CACHE_NIL;
+       i = cache->items[i].hash_next) {
     glyph_cache_item_t* item = cache->items + i;
     if (item->code == code && item->size == size) {
       *g = *(item->g);
       item->last_access_time = time_now_ms();
+      if (cache->lru_head != i) {
+        glyph_cache_lru_unlink(cache, i);
+        glyph_cache_lru_push_front(cache, i);
+      }
+      cache->hits++;
 
       return RET_OK;
     }
   }
+  cache->misses++;
 
   return RET_NOT_FOUND;
 }
@@ -112,41 +328,70 @@ ret_t glyph_cache_deinit(glyph_cache_t* cache) {
 
   return_value_if_fail(cache != NULL, RET_BAD_PARAMS);
 
-  if (cache->destroy_glyph != NULL) {
-    for (i = 0, nr = cache->size; i < nr; i++) {
-      glyph_cache_item_t* item = cache->items + i;
-
-      GLYPH_CACHE_FREE_ITEM(cache, item);
-    }
+  for (i = 0, nr = cache->size; i < nr; i++) {
+    glyph_cache_destroy_item(cache, cache->items + i);
   }
 
   TKMEM_FREE(cache->items);
+  TKMEM_FREE(cache->buckets);
   memset(cache, 0x00, sizeof(glyph_cache_t));
 
   return RET_OK;
 }
 
-static int glyph_cache_item_compare_by_time(const void* a, const void* b) {
-  glyph_cache_item_t* aa = (glyph_cache_item_t*)a;
-  glyph_cache_item_t* bb = (glyph_cache_item_t*)b;
+/*按最近使用的顺序重新排列items，最近使用的字模在最前面*/
+static ret_t glyph_cache_sort_by_lru(glyph_cache_t* cache) {
+  uint32_t i = 0;
+  uint32_t k = 0;
+  glyph_cache_item_t* items = TKMEM_ZALLOCN(glyph_cache_item_t, cache->capacity);
+  return_value_if_fail(items != NULL, RET_OOM);
+
+  for (i = cache->lru_head; i != GLYPH_CACHE_NIL; i = cache->items[i].next, k++) {
+    items[k] = cache->items[i];
+    items[k].prev = k > 0 ? k - 1 : GLYPH_CACHE_NIL;
+    items[k].next = k + 1 < cache->size ? k + 1 : GLYPH_CACHE_NIL;
+  }
 
-  return bb->last_access_time - aa->last_access_time;
+  TKMEM_FREE(cache->items);
+  cache->items = items;
+  cache->lru_head = cache->size > 0 ? 0 : GLYPH_CACHE_NIL;
+  cache->lru_tail = cache->size > 0 ? cache->size - 1 : GLYPH_CACHE_NIL;
+
+  return glyph_cache_rehash(cache, cache->buckets_nr);
 }
 
 ret_t glyph_cache_shrink(glyph_cache_t* cache, uint32_t cache_size) {
   return_value_if_fail(cache != NULL && cache->items != NULL, RET_BAD_PARAMS);
 
   if (cache->size > cache_size) {
-    uint32_t i = 0;
-    qsort(cache->items, cache->size, sizeof(glyph_cache_item_t), glyph_cache_item_compare_by_time);
-
-    for (i = cache_size; i < cache->size; i++) {
-      glyph_cache_item_t* item = cache->items + i;
-      GLYPH_CACHE_FREE_ITEM(cache, item);
+    while (cache->size > cache_size) {
+      glyph_cache_remove(cache, cache->lru_tail);
     }
 
-    cache->size = cache_size;
+    /*内存不足时保持现有顺序即可，不影响查找和淘汰*/
+    glyph_cache_sort_by_lru(cache);
+  }
+
+  return RET_OK;
+}
+
+ret_t glyph_cache_set_max_bytes(glyph_cache_t* cache, uint32_t max_bytes) {
+  return_value_if_fail(cache != NULL && cache->items != NULL, RET_BAD_PARAMS);
+
+  cache->max_bytes = max_bytes;
+  if (max_bytes > 0) {
+    glyph_cache_make_room(cache, 0);
   }
 
   return RET_OK;
 }
+
+ret_t glyph_cache_reset_stats(glyph_cache_t* cache) {
+  return_value_if_fail(cache != NULL, RET_BAD_PARAMS);
+
+  cache->hits = 0;
+  cache->misses = 0;
+  cache->evictions = 0;
+
+  return RET_OK;
+}
@@ -31,17 +31,66 @@ typedef struct _glyph_cache_item_t {
   font_size_t size;
   wchar_t code;
   glyph_t* g;
+
+  /*private*/
+  uint32_t bytes;
+  /*LRU链表(prev更近使用)和哈希链表，存放的是items中的序数*/
+  uint32_t prev;
+  uint32_t next;
+  uint32_t hash_next;
 } glyph_cache_item_t;
 
 /**
  * @class glyph_cache_t
  * glyph cache
+ *
+ * 通过(code, size)的哈希表查找字模，通过LRU链表淘汰最久没有使用的字模，查找和增加都是O(1)。
+ * items[0, size)总是有效的字模，淘汰时用最后一个字模填补空位。
  */
 typedef struct _glyph_cache_t {
   uint32_t size;
   uint32_t capacity;
+  /*按字模个数淘汰时的上限。多线程绘制期间不能淘汰时capacity会临时超过它，之后再收缩回来*/
+  uint32_t max_size;
   glyph_cache_item_t* items;
   tk_destroy_t destroy_glyph;
+
+  /**
+   * @property {uint32_t} hits
+   * @annotation ["readable"]
+   * 查找命中的次数。
+   */
+  uint32_t hits;
+  /**
+   * @property {uint32_t} misses
+   * @annotation ["readable"]
+   * 查找没有命中的次数。
+   */
+  uint32_t misses;
+  /**
+   * @property {uint32_t} evictions
+   * @annotation ["readable"]
+   * 被淘汰的字模个数(不包括glyph\_cache\_shrink释放的字模)。
+   */
+  uint32_t evictions;
+  /**
+   * @property {uint32_t} max_bytes
+   * @annotation ["readable"]
+   * 内存上限(字节)。为0时按字模个数(初始化时的capacity)淘汰。
+   */
+  uint32_t max_bytes;
+  /**
+   * @property {uint32_t} bytes
+   * @annotation ["readable"]
+   * 当前字模占用的内存(估计值，字节)。
+   */
+  uint32_t bytes;
+
+  /*private*/
+  uint32_t* buckets;
+  uint32_t buckets_nr;
+  uint32_t lru_head;
+  uint32_t lru_tail;
 } glyph_cache_t;
 
 /**
@@ -93,6 +142,29 @@ ret_t glyph_cache_lookup(glyph_cache_t* cache, wchar_t code, font_size_t size, g
  */
 ret_t glyph_cache_shrink(glyph_cache_t* cache, uint32_t cache_size);
 
+/**
+ * @method glyph_cache_set_max_bytes
+ * 设置内存上限。
+ *
+ * 设置之后按字模占用的内存(字模数据加上管理开销)淘汰，capacity只是初始容量，不再限制字模个数。
+ * 
+ * @param {glyph_cache_t*} cache cache对象。
+ * @param {uint32_t} max_bytes 内存上限(字节)，为0表示按字模个数淘汰。
+ * 
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t glyph_cache_set_max_bytes(glyph_cache_t* cache, uint32_t max_bytes);
+
+/**
+ * @method glyph_cache_reset_stats
+ * 清除命中、没有命中和淘汰的计数。
+ * 
+ * @param {glyph_cache_t*} cache cache对象。
+ * 
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t glyph_cache_reset_stats(glyph_cache_t* cache);
+
 /**
  * @method glyph_cache_deinit
  * 释放全部cache。
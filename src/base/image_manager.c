@@ -24,6 +24,7 @@
 #include "tkc/time_now.h"
 #include "base/locale_info.h"
 #include "base/image_manager.h"
+#include "base/parallel_paint.h"
 
 typedef struct _bitmap_cache_t {
   bitmap_t image;
@@ -111,6 +112,11 @@ static ret_t image_manager_clear_cache(image_manager_t* imm) {
     return RET_OK;
   }
 
+  /*多线程绘制时，其它线程可能正在使用缓存中的图片，等下次再清理*/
+  if (parallel_paint_is_busy()) {
+    return RET_OK;
+  }
+
   darray_sort(&(imm->images), (tk_compare_t)bitmap_cache_cmp_access_time_dec);
   do {
     iter = (bitmap_cache_t*)darray_pop(&(imm->images));
@@ -123,6 +129,17 @@ static ret_t image_manager_clear_cache(image_manager_t* imm) {
   return RET_OK;
 }
 
+static ret_t image_manager_build_alpha_runs(bitmap_t* image) {
+#ifndef WITHOUT_BITMAP_ALPHA_RUNS
+  /*图片只在加载时扫描一次，之后合成时按分段表跳过透明像素、直接拷贝不透明像素*/
+  if (image->buffer != NULL && image->should_free_data) {
+    return bitmap_build_alpha_runs(image);
+  }
+#endif /*WITHOUT_BITMAP_ALPHA_RUNS*/
+
+  return RET_OK;
+}
+
 ret_t image_manager_add(image_manager_t* imm, const char* name, const bitmap_t* image) {
   bitmap_cache_t* cache = NULL;
   return_value_if_fail(imm != NULL && name != NULL && image != NULL, RET_BAD_PARAMS);
@@ -139,8 +156,13 @@ ret_t image_manager_add(image_manager_t* imm, const char* name, const bitmap_t*
   cache->last_access_time = cache->created_time;
 
   cache->image.image_manager = imm;
+  if (image->alpha_runs != NULL && image->alpha_runs->owner == image) {
+    /*分段表改由缓存中的图片释放，image变成共用分段表的拷贝*/
+    cache->image.alpha_runs->owner = &(cache->image);
+  }
+
   if (image->should_free_data) {
-    imm->mem_size_of_cached_images += bitmap_get_mem_size((bitmap_t*)image);
+    imm->mem_size_of_cached_images += bitmap_get_mem_size(&(cache->image));
     image_manager_clear_cache(imm);
   }
 
@@ -204,8 +226,8 @@ ret_t image_manager_update_specific(image_manager_t* imm, bitmap_t* image) {
   return RET_NOT_FOUND;
 }
 
-static ret_t image_manager_get_bitmap_impl(image_manager_t* imm, const char* name,
-                                           bitmap_t* image) {
+static ret_t image_manager_get_bitmap_unlocked(image_manager_t* imm, const char* name,
+                                              bitmap_t* image) {
   const asset_info_t* res = NULL;
   return_value_if_fail(imm != NULL && name != NULL && image != NULL, RET_BAD_PARAMS);
 
@@ -233,6 +255,7 @@ static ret_t image_manager_get_bitmap_impl(image_manager_t* imm, const char* nam
     image->buffer = GRAPHIC_BUFFER_CREATE_WITH_DATA(header->data, header->w, header->h,
                                                     (bitmap_format_t)(header->format));
     image->should_free_data = image->buffer != NULL;
+    image_manager_build_alpha_runs(image);
     image_manager_add(imm, name, image);
     image->should_free_data = FALSE;
 
@@ -240,6 +263,7 @@ static ret_t image_manager_get_bitmap_impl(image_manager_t* imm, const char* nam
   } else if (res->subtype != ASSET_TYPE_IMAGE_BSVG) {
     ret_t ret = image_loader_load_image(res, image);
     if (ret == RET_OK) {
+      image_manager_build_alpha_runs(image);
       image_manager_add(imm, name, image);
       assets_manager_unref(imm->assets_manager, res);
     }
@@ -250,6 +274,17 @@ static ret_t image_manager_get_bitmap_impl(image_manager_t* imm, const char* nam
   }
 }
 
+static ret_t image_manager_get_bitmap_impl(image_manager_t* imm, const char* name,
+                                           bitmap_t* image) {
+  ret_t ret = RET_OK;
+
+  parallel_paint_lock();
+  ret = image_manager_get_bitmap_unlocked(imm, name, image);
+  parallel_paint_unlock();
+
+  return ret;
+}
+
 typedef struct _imm_expr_info_t {
   image_manager_t* imm;
   bitmap_t* image;
@@ -22,6 +22,7 @@
 #include "tkc/utils.h"
 #include "base/widget.h"
 #include "base/layout.h"
+#include "base/paint_profiler.h"
 #include "base/self_layouter_factory.h"
 #include "base/children_layouter_factory.h"
 
@@ -62,12 +63,16 @@ ret_t widget_auto_adjust_size(widget_t* widget) {
 }
 
 ret_t widget_layout(widget_t* widget) {
+  PAINT_PROFILER_VAR(start)
+  PAINT_PROFILER_BEGIN(start)
+
   widget_layout_self(widget);
   widget_layout_children(widget);
 
   if (widget->auto_adjust_size) {
     widget_auto_adjust_size(widget);
   }
+  PAINT_PROFILER_END(start, widget, PAINT_PROFILER_LAYOUT);
 
   return RET_OK;
 }
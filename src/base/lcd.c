@@ -241,6 +241,16 @@ ret_t lcd_draw_glyph(lcd_t* lcd, glyph_t* glyph, const rect_t* src, xy_t x, xy_t
   return lcd->draw_glyph(lcd, glyph, src, x, y);
 }
 
+ret_t lcd_draw_glyph_run(lcd_t* lcd, const glyph_run_t* run) {
+  return_value_if_fail(lcd != NULL && run != NULL, RET_BAD_PARAMS);
+
+  if (lcd->draw_glyph_run == NULL) {
+    return RET_NOT_IMPL;
+  }
+
+  return lcd->draw_glyph_run(lcd, run);
+}
+
 float_t lcd_measure_text(lcd_t* lcd, const wchar_t* str, uint32_t nr) {
   return_value_if_fail(nr < 10240, 0.0f);
   return_value_if_fail(lcd != NULL && lcd->measure_text != NULL && str != NULL, 0.0f);
@@ -40,6 +40,78 @@ typedef struct _draw_image_info_t {
   matrix_t matrix;
 } draw_image_info_t;
 
+#ifndef TK_GLYPH_RUN_MAX_NR
+#define TK_GLYPH_RUN_MAX_NR 64
+#endif /*TK_GLYPH_RUN_MAX_NR*/
+
+/**
+ * @class glyph_run_item_t
+ * 字模串中的一个字模(已经裁剪)。
+ */
+typedef struct _glyph_run_item_t {
+  /**
+   * @property {const uint8_t*} data
+   * @annotation ["readable"]
+   * 裁剪后左上角的A8数据。
+   */
+  const uint8_t* data;
+  /**
+   * @property {uint32_t} pitch
+   * @annotation ["readable"]
+   * 数据每一行的字节数。
+   */
+  uint32_t pitch;
+  /**
+   * @property {xy_t} x
+   * @annotation ["readable"]
+   * 在lcd上的x坐标。
+   */
+  xy_t x;
+  /**
+   * @property {xy_t} y
+   * @annotation ["readable"]
+   * 在lcd上的y坐标。
+   */
+  xy_t y;
+  /**
+   * @property {wh_t} w
+   * @annotation ["readable"]
+   * 宽度。
+   */
+  wh_t w;
+  /**
+   * @property {wh_t} h
+   * @annotation ["readable"]
+   * 高度。
+   */
+  wh_t h;
+} glyph_run_item_t;
+
+/**
+ * @class glyph_run_t
+ * 字模串(通常是一行文字)，一次提交给lcd绘制。
+ */
+typedef struct _glyph_run_t {
+  /**
+   * @property {uint32_t} nr
+   * @annotation ["readable"]
+   * 字模的个数。
+   */
+  uint32_t nr;
+  /**
+   * @property {rect_t} bounds
+   * @annotation ["readable"]
+   * 包含全部字模的最小矩形。
+   */
+  rect_t bounds;
+  /**
+   * @property {glyph_run_item_t*} items
+   * @annotation ["readable"]
+   * 字模。
+   */
+  glyph_run_item_t items[TK_GLYPH_RUN_MAX_NR];
+} glyph_run_t;
+
 typedef int32_t (*lcd_get_type_t)(lcd_t* lcd);
 typedef bool_t (*lcd_is_support_dirty_rect_t)(lcd_t* lcd);
 typedef ret_t (*lcd_set_vgcanvas_t)(lcd_t* lcd, vgcanvas_t* vg);
@@ -79,6 +151,7 @@ typedef ret_t (*lcd_clear_rect_t)(lcd_t* lcd, xy_t x, xy_t y, wh_t w, wh_t h);
 typedef ret_t (*lcd_stroke_rect_t)(lcd_t* lcd, xy_t x, xy_t y, wh_t w, wh_t h);
 
 typedef ret_t (*lcd_draw_glyph_t)(lcd_t* lcd, glyph_t* glyph, const rect_t* src, xy_t x, xy_t y);
+typedef ret_t (*lcd_draw_glyph_run_t)(lcd_t* lcd, const glyph_run_t* run);
 typedef float_t (*lcd_measure_text_t)(lcd_t* lcd, const wchar_t* str, uint32_t nr);
 typedef ret_t (*lcd_draw_text_t)(lcd_t* lcd, const wchar_t* str, uint32_t nr, xy_t x, xy_t y);
 
@@ -198,6 +271,7 @@ struct _lcd_t {
   lcd_draw_image_t draw_image;
   lcd_draw_image_matrix_t draw_image_matrix;
   lcd_draw_glyph_t draw_glyph;
+  lcd_draw_glyph_run_t draw_glyph_run; /*可选*/
   lcd_draw_text_t draw_text;
   lcd_measure_text_t measure_text;
   lcd_draw_points_t draw_points;
@@ -512,6 +586,16 @@ ret_t lcd_stroke_rect(lcd_t* lcd, xy_t x, xy_t y, wh_t w, wh_t h);
  */
 ret_t lcd_draw_glyph(lcd_t* lcd, glyph_t* glyph, const rect_t* src, xy_t x, xy_t y);
 
+/**
+ * @method lcd_draw_glyph_run
+ * 一次绘制一串A8格式的字模(可选)。
+ * @param {lcd_t*} lcd lcd对象。
+ * @param {const glyph_run_t*} run 字模串(已经裁剪)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，返回RET_NOT_IMPL表示不支持(调用者应该逐个调用lcd\_draw\_glyph)。
+ */
+ret_t lcd_draw_glyph_run(lcd_t* lcd, const glyph_run_t* run);
+
 /**
  * @method lcd_measure_text
  * 测量字符串占用的宽度。
@@ -68,6 +68,17 @@ ret_t lcd_fb_dirty_rects_update_all_fb_dirty_rects(lcd_fb_dirty_rects_t* lcd_fb_
  */
 ret_t lcd_fb_dirty_rects_add_fb_info(lcd_fb_dirty_rects_t* lcd_fb_dirty_rects, uint8_t* fb);
 
+/**
+ * @method lcd_fb_dirty_rects_remove_fb_info
+ * 删除 fb 信息
+ * @export none
+ * @param {lcd_fb_dirty_rects_t*} lcd_fb_dirty_rects lcd_fb_dirty_rects_t对象。
+ * @param {uint8_t*} fb fb 地址。
+ * 
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t lcd_fb_dirty_rects_remove_fb_info(lcd_fb_dirty_rects_t* lcd_fb_dirty_rects, uint8_t* fb);
+
 /**
  * @method lcd_fb_dirty_rects_deinit
  * 清除 lcd_fb_dirty_rects_t 对象数据
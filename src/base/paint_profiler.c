@@ -0,0 +1,273 @@
+﻿/**
+ * File:   paint_profiler.c
+ * Author: AWTK Develop Team
+ * Brief:  per widget paint profiler with chrome trace export
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/fs.h"
+#include "tkc/mem.h"
+#include "tkc/mutex.h"
+#include "tkc/utils.h"
+#include "tkc/thread.h"
+#include "tkc/time_now.h"
+#include "base/widget.h"
+#include "base/paint_profiler.h"
+
+typedef struct _paint_profiler_event_t {
+  uint64_t ts;
+  uint64_t tid;
+  uint32_t dur;
+  /*PAINT_PROFILER_FRAME时为这一帧查询style的次数*/
+  uint32_t style_lookups;
+  paint_profiler_phase_t phase;
+  const char* type;
+  char name[TK_NAME_LEN + 1];
+} paint_profiler_event_t;
+
+typedef struct _paint_profiler_t {
+  paint_profiler_event_t* events;
+  uint32_t capacity;
+  /*写入的总数，下一条记录保存在next % capacity*/
+  uint32_t next;
+  uint32_t style_lookups;
+  uint64_t start_time;
+  tk_mutex_t* mutex;
+} paint_profiler_t;
+
+static paint_profiler_t s_paint_profiler;
+
+static const char* s_phase_names[] = {"frame",    "paint",  "background", "self",
+                                      "children", "border", "layout",     "update_style"};
+
+ret_t paint_profiler_start(uint32_t capacity) {
+  paint_profiler_t* p = &s_paint_profiler;
+
+  paint_profiler_stop();
+  capacity = capacity > 0 ? capacity : TK_PAINT_PROFILER_EVENTS_NR;
+  p->events = TKMEM_ZALLOCN(paint_profiler_event_t, capacity);
+  return_value_if_fail(p->events != NULL, RET_OOM);
+
+  p->capacity = capacity;
+  p->mutex = tk_mutex_create();
+  p->start_time = time_now_us();
+
+  return RET_OK;
+}
+
+ret_t paint_profiler_stop(void) {
+  paint_profiler_t* p = &s_paint_profiler;
+
+  if (p->mutex != NULL) {
+    tk_mutex_destroy(p->mutex);
+  }
+  TKMEM_FREE(p->events);
+  memset(p, 0x00, sizeof(*p));
+
+  return RET_OK;
+}
+
+bool_t paint_profiler_is_started(void) {
+  return s_paint_profiler.events != NULL;
+}
+
+uint64_t paint_profiler_now(void) {
+  return s_paint_profiler.events != NULL ? time_now_us() : 0;
+}
+
+static ret_t paint_profiler_push(widget_t* widget, paint_profiler_phase_t phase, uint64_t start,
+                                 uint32_t style_lookups) {
+  paint_profiler_event_t* e = NULL;
+  paint_profiler_t* p = &s_paint_profiler;
+  uint64_t now = time_now_us();
+  return_value_if_fail(p->events != NULL && start != 0, RET_BAD_PARAMS);
+
+  /*parallel_paint时多个线程同时绘制*/
+  if (p->mutex != NULL) {
+    tk_mutex_lock(p->mutex);
+  }
+
+  e = p->events + (p->next % p->capacity);
+  p->next++;
+
+  e->ts = start;
+  e->tid = tk_thread_self();
+  e->dur = (uint32_t)(now - start);
+  e->style_lookups = style_lookups;
+  e->phase = phase;
+  e->type = NULL;
+  e->name[0] = '\0';
+  if (widget != NULL) {
+    e->type = widget_get_type(widget);
+    if (widget->name != NULL) {
+      tk_strncpy(e->name, widget->name, TK_NAME_LEN);
+    }
+  }
+
+  if (p->mutex != NULL) {
+    tk_mutex_unlock(p->mutex);
+  }
+
+  return RET_OK;
+}
+
+ret_t paint_profiler_record(widget_t* widget, paint_profiler_phase_t phase, uint64_t start) {
+  if (s_paint_profiler.events == NULL || start == 0) {
+    return RET_OK;
+  }
+
+  return paint_profiler_push(widget, phase, start, 0);
+}
+
+ret_t paint_profiler_count_style_lookup(void) {
+  paint_profiler_t* p = &s_paint_profiler;
+
+  if (p->events == NULL) {
+    return RET_OK;
+  }
+
+  /*并行绘制时各个工作线程都会计数*/
+  if (p->mutex != NULL) {
+    tk_mutex_lock(p->mutex);
+  }
+  p->style_lookups++;
+  if (p->mutex != NULL) {
+    tk_mutex_unlock(p->mutex);
+  }
+
+  return RET_OK;
+}
+
+ret_t paint_profiler_end_frame(uint64_t start) {
+  uint32_t style_lookups = 0;
+  paint_profiler_t* p = &s_paint_profiler;
+
+  if (p->events == NULL || start == 0) {
+    return RET_OK;
+  }
+
+  if (p->mutex != NULL) {
+    tk_mutex_lock(p->mutex);
+  }
+  style_lookups = p->style_lookups;
+  p->style_lookups = 0;
+  if (p->mutex != NULL) {
+    tk_mutex_unlock(p->mutex);
+  }
+
+  return paint_profiler_push(NULL, PAINT_PROFILER_FRAME, start, style_lookups);
+}
+
+uint32_t paint_profiler_get_events_nr(void) {
+  paint_profiler_t* p = &s_paint_profiler;
+
+  return tk_min(p->next, p->capacity);
+}
+
+static ret_t paint_profiler_export_event(str_t* str, paint_profiler_event_t* e,
+                                         uint64_t start_time) {
+  uint64_t ts = e->ts > start_time ? e->ts - start_time : 0;
+  const char* name = s_phase_names[e->phase];
+  const char* cat = "paint";
+
+  if (e->phase == PAINT_PROFILER_PAINT && e->type != NULL) {
+    name = e->type;
+  } else if (e->phase == PAINT_PROFILER_FRAME) {
+    cat = "frame";
+  } else if (e->phase == PAINT_PROFILER_LAYOUT) {
+    cat = "layout";
+  } else if (e->phase == PAINT_PROFILER_UPDATE_STYLE) {
+    cat = "style";
+  }
+
+  str_append_char(str, '{');
+  str_append_json_str_pair(str, "name", name);
+  str_append_char(str, ',');
+  str_append_json_str_pair(str, "cat", cat);
+  str_append(str, ",\"ph\":\"X\",\"pid\":1,\"tid\":");
+  str_append_uint64(str, e->tid);
+  str_append(str, ",\"ts\":");
+  str_append_uint64(str, ts);
+  str_append(str, ",\"dur\":");
+  str_append_uint64(str, e->dur);
+
+  if (e->type != NULL) {
+    str_append(str, ",\"args\":{");
+    str_append_json_str_pair(str, "type", e->type);
+    str_append_char(str, ',');
+    str_append_json_str_pair(str, "name", e->name);
+    str_append_char(str, '}');
+  }
+  str_append(str, "}");
+
+  /*每一帧查询style的次数用计数器显示*/
+  if (e->phase == PAINT_PROFILER_FRAME) {
+    str_append(str, ",\n{\"name\":\"style_lookups\",\"ph\":\"C\",\"pid\":1,\"ts\":");
+    str_append_uint64(str, ts);
+    str_append(str, ",\"args\":{");
+    str_append_json_int_pair(str, "count", e->style_lookups);
+    str_append(str, "}}");
+  }
+
+  return RET_OK;
+}
+
+ret_t paint_profiler_export(str_t* str) {
+  uint32_t i = 0;
+  uint32_t nr = 0;
+  uint32_t first = 0;
+  paint_profiler_t* p = &s_paint_profiler;
+  return_value_if_fail(str != NULL, RET_BAD_PARAMS);
+
+  str_append(str, "{\"traceEvents\":[");
+  if (p->events != NULL) {
+    if (p->mutex != NULL) {
+      tk_mutex_lock(p->mutex);
+    }
+
+    nr = tk_min(p->next, p->capacity);
+    first = p->next - nr;
+    for (i = 0; i < nr; i++) {
+      paint_profiler_event_t* e = p->events + ((first + i) % p->capacity);
+
+      str_append(str, i > 0 ? ",\n" : "\n");
+      paint_profiler_export_event(str, e, p->start_time);
+    }
+
+    if (p->mutex != NULL) {
+      tk_mutex_unlock(p->mutex);
+    }
+  }
+  str_append(str, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+  return RET_OK;
+}
+
+ret_t paint_profiler_save(const char* filename) {
+  str_t str;
+  ret_t ret = RET_OK;
+  return_value_if_fail(filename != NULL, RET_BAD_PARAMS);
+
+  str_init(&str, 4096);
+  ret = paint_profiler_export(&str);
+  if (ret == RET_OK) {
+    ret = file_write(filename, str.str, str.size);
+  }
+  str_reset(&str);
+
+  return ret;
+}
@@ -0,0 +1,229 @@
+﻿/**
+ * File:   paint_profiler.h
+ * Author: AWTK Develop Team
+ * Brief:  per widget paint profiler with chrome trace export
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_PAINT_PROFILER_H
+#define TK_PAINT_PROFILER_H
+
+#include "tkc/str.h"
+#include "base/types_def.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @enum paint_profiler_phase_t
+ * @prefix PAINT_PROFILER_
+ * 绘制分析器记录的阶段。
+ */
+typedef enum _paint_profiler_phase_t {
+  /**
+   * @const PAINT_PROFILER_FRAME
+   * 窗口管理器绘制一帧。
+   */
+  PAINT_PROFILER_FRAME = 0,
+  /**
+   * @const PAINT_PROFILER_PAINT
+   * widget\_paint(包括下面的各个阶段)。
+   */
+  PAINT_PROFILER_PAINT,
+  /**
+   * @const PAINT_PROFILER_BACKGROUND
+   * 绘制背景。
+   */
+  PAINT_PROFILER_BACKGROUND,
+  /**
+   * @const PAINT_PROFILER_SELF
+   * 绘制自身。
+   */
+  PAINT_PROFILER_SELF,
+  /**
+   * @const PAINT_PROFILER_CHILDREN
+   * 绘制子控件。
+   */
+  PAINT_PROFILER_CHILDREN,
+  /**
+   * @const PAINT_PROFILER_BORDER
+   * 绘制边框。
+   */
+  PAINT_PROFILER_BORDER,
+  /**
+   * @const PAINT_PROFILER_LAYOUT
+   * widget\_layout。
+   */
+  PAINT_PROFILER_LAYOUT,
+  /**
+   * @const PAINT_PROFILER_UPDATE_STYLE
+   * widget\_update\_style。
+   */
+  PAINT_PROFILER_UPDATE_STYLE
+} paint_profiler_phase_t;
+
+/**
+ * @class paint_profiler_t
+ * @annotation ["fake"]
+ * 绘制分析器。
+ *
+ * 定义WITH\_PAINT\_PROFILER时，widget\_paint的各个阶段(背景、自身、子控件和边框)、
+ * widget\_layout、widget\_update\_style以及窗口管理器的每一帧都会记录开始时间和耗时，
+ * 每一帧还会记录查询style的次数。记录保存在环形缓冲区中(满了覆盖最早的记录)，
+ * 可以导出为Chrome/Perfetto的trace格式(用chrome://tracing或者ui.perfetto.dev打开)，
+ * 从而找出是哪个控件绘制得慢。
+ *
+ * 没有定义WITH\_PAINT\_PROFILER时，控件中的记录代码不会编译进来，没有任何开销。
+ * 定义了但没有调用paint\_profiler\_start时，只多了一次判断。
+ *
+ * ```c
+ * paint_profiler_start(0);
+ * ...
+ * paint_profiler_save("paint.trace.json");
+ * paint_profiler_stop();
+ * ```
+ */
+
+/**
+ * @method paint_profiler_start
+ * 开始记录(清除以前的记录)。
+ * @annotation ["static"]
+ * @param {uint32_t} capacity 最多保存的记录数，为0时使用TK\_PAINT\_PROFILER\_EVENTS\_NR。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t paint_profiler_start(uint32_t capacity);
+
+/**
+ * @method paint_profiler_stop
+ * 停止记录，并释放记录。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t paint_profiler_stop(void);
+
+/**
+ * @method paint_profiler_is_started
+ * 检查是否正在记录。
+ * @annotation ["static"]
+ *
+ * @return {bool_t} 返回TRUE表示正在记录。
+ */
+bool_t paint_profiler_is_started(void);
+
+/**
+ * @method paint_profiler_now
+ * 获取开始时间(没有记录时返回0)。
+ * @annotation ["static"]
+ *
+ * @return {uint64_t} 返回当前时间(微秒)。
+ */
+uint64_t paint_profiler_now(void);
+
+/**
+ * @method paint_profiler_record
+ * 记录一个阶段(结束时间为当前时间)。
+ * @annotation ["static"]
+ * @param {widget_t*} widget 控件(可以为NULL)。
+ * @param {paint_profiler_phase_t} phase 阶段。
+ * @param {uint64_t} start 开始时间(paint\_profiler\_now的返回值，为0时不记录)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t paint_profiler_record(widget_t* widget, paint_profiler_phase_t phase, uint64_t start);
+
+/**
+ * @method paint_profiler_count_style_lookup
+ * 查询style的次数加1。
+ * 多线程绘制时各个线程都会计数，所以用记录事件的锁保护。
+ * > 启用统计时每次style\_get\_*都要加锁，会增加一些开销，统计的耗时也会偏大。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t paint_profiler_count_style_lookup(void);
+
+/**
+ * @method paint_profiler_end_frame
+ * 记录一帧，以及这一帧查询style的次数(然后清零)。
+ * @annotation ["static"]
+ * @param {uint64_t} start 开始时间(paint\_profiler\_now的返回值，为0时不记录)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t paint_profiler_end_frame(uint64_t start);
+
+/**
+ * @method paint_profiler_get_events_nr
+ * 获取保存的记录数。
+ * @annotation ["static"]
+ *
+ * @return {uint32_t} 返回记录数。
+ */
+uint32_t paint_profiler_get_events_nr(void);
+
+/**
+ * @method paint_profiler_export
+ * 把保存的记录(从早到晚)导出为Chrome trace格式的JSON。
+ * @annotation ["static"]
+ * @param {str_t*} str 用于返回JSON(追加到后面)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t paint_profiler_export(str_t* str);
+
+/**
+ * @method paint_profiler_save
+ * 把保存的记录导出为Chrome trace格式的JSON文件。
+ * @annotation ["static"]
+ * @param {const char*} filename 文件名。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t paint_profiler_save(const char* filename);
+
+#ifdef WITH_PAINT_PROFILER
+#define PAINT_PROFILER_VAR(t) uint64_t t = 0;
+#define PAINT_PROFILER_BEGIN(t) t = paint_profiler_now();
+#define PAINT_PROFILER_END(t, widget, phase)   \
+  do {                                         \
+    if (t != 0) {                              \
+      paint_profiler_record(widget, phase, t); \
+    }                                          \
+  } while (0)
+#define PAINT_PROFILER_END_FRAME(t) \
+  do {                              \
+    if (t != 0) {                   \
+      paint_profiler_end_frame(t);  \
+    }                               \
+  } while (0)
+#define PAINT_PROFILER_STYLE_LOOKUP() paint_profiler_count_style_lookup();
+#else
+#define PAINT_PROFILER_VAR(t)
+#define PAINT_PROFILER_BEGIN(t)
+#define PAINT_PROFILER_END(t, widget, phase) \
+  do {                                       \
+  } while (0)
+#define PAINT_PROFILER_END_FRAME(t) \
+  do {                              \
+  } while (0)
+#define PAINT_PROFILER_STYLE_LOOKUP()
+#endif /*WITH_PAINT_PROFILER*/
+
+END_C_DECLS
+
+#endif /*TK_PAINT_PROFILER_H*/
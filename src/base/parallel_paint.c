@@ -0,0 +1,429 @@
+﻿/**
+ * File:   parallel_paint.c
+ * Author: AWTK Develop Team
+ * Brief:  paint dirty rects in horizontal bands on worker threads
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "tkc/time_now.h"
+#include "base/widget.h"
+#include "base/window_base.h"
+#include "base/parallel_paint.h"
+
+/*有线程的桌面平台缺省编译进来，运行时调用parallel_paint_set_threads才启用*/
+#if !defined(WITH_PARALLEL_PAINT) && !defined(WITHOUT_PARALLEL_PAINT) && \
+    (defined(HAS_PTHREAD) || defined(WITH_SDL))
+#define WITH_PARALLEL_PAINT 1
+#endif /*HAS_PTHREAD*/
+
+#if defined(WITH_PARALLEL_PAINT) && !defined(WITH_GPU) && \
+    !defined(FRAGMENT_FRAME_BUFFER_SIZE) && !defined(ENABLE_PERFORMANCE_PROFILE)
+
+#include "tkc/thread.h"
+#include "tkc/semaphore.h"
+#include "tkc/mutex_nest.h"
+#include "lcd/lcd_mem_rgb565.h"
+#include "lcd/lcd_mem_bgr565.h"
+#include "lcd/lcd_mem_rgba8888.h"
+#include "lcd/lcd_mem_bgra8888.h"
+
+#ifdef LINUX
+#include "lcd/lcd_mem_rgb888.h"
+#include "lcd/lcd_mem_bgr888.h"
+#endif /*LINUX*/
+
+typedef struct _parallel_paint_worker_t {
+  tk_thread_t* thread;
+  tk_semaphore_t* start;
+
+  /*绘制到同一个framebuffer的lcd和canvas，每个线程一份*/
+  lcd_t* lcd;
+  canvas_t canvas;
+  rect_t band;
+} parallel_paint_worker_t;
+
+typedef struct _parallel_paint_ctx_t {
+  uint32_t nr;
+  bool_t quit;
+  bool_t busy;
+  uint64_t start_time;
+  tk_mutex_nest_t* mutex;
+  tk_semaphore_t* done;
+
+  /*当前帧*/
+  widget_t* widget;
+  widget_on_paint_t on_paint;
+  rect_t clip;
+  uint32_t rects_nr;
+  rect_t rects[TK_MAX_DIRTY_RECT_NR];
+
+  /*workers[0]不使用，条带0由UI线程用原来的canvas绘制*/
+  parallel_paint_worker_t workers[TK_PARALLEL_PAINT_MAX_THREADS];
+} parallel_paint_ctx_t;
+
+static parallel_paint_ctx_t s_parallel_paint;
+
+static ret_t parallel_paint_band(canvas_t* c, const rect_t* band) {
+  uint32_t i = 0;
+  parallel_paint_ctx_t* ctx = &s_parallel_paint;
+
+  /*按单线程绘制时的顺序绘制每个脏矩形落在本条带内的部分*/
+  for (i = 0; i < ctx->rects_nr; i++) {
+    rect_t r = rect_intersect(ctx->rects + i, band);
+    if (r.w > 0 && r.h > 0) {
+      widget_paint_with_clip(ctx->widget, &r, c, ctx->on_paint);
+    }
+  }
+
+  return RET_OK;
+}
+
+static void* parallel_paint_worker_main(void* args) {
+  parallel_paint_worker_t* worker = (parallel_paint_worker_t*)args;
+  parallel_paint_ctx_t* ctx = &s_parallel_paint;
+
+  while (tk_semaphore_wait(worker->start, 0xffffffff) == RET_OK) {
+    if (ctx->quit) {
+      break;
+    }
+
+    parallel_paint_band(&(worker->canvas), &(worker->band));
+    tk_semaphore_post(ctx->done);
+  }
+
+  return NULL;
+}
+
+static lcd_t* parallel_paint_create_lcd(bitmap_format_t format, wh_t w, wh_t h, uint8_t* fb) {
+  switch (format) {
+    case BITMAP_FMT_RGBA8888: {
+      return lcd_mem_rgba8888_create_single_fb(w, h, fb);
+    }
+    case BITMAP_FMT_BGRA8888: {
+      return lcd_mem_bgra8888_create_single_fb(w, h, fb);
+    }
+    case BITMAP_FMT_BGR565: {
+      return lcd_mem_bgr565_create_single_fb(w, h, fb);
+    }
+    case BITMAP_FMT_RGB565: {
+      return lcd_mem_rgb565_create_single_fb(w, h, fb);
+    }
+#ifdef LINUX
+    case BITMAP_FMT_RGB888: {
+      return lcd_mem_rgb888_create_single_fb(w, h, fb);
+    }
+    case BITMAP_FMT_BGR888: {
+      return lcd_mem_bgr888_create_single_fb(w, h, fb);
+    }
+#endif /*LINUX*/
+    default: {
+      return NULL;
+    }
+  }
+}
+
+static ret_t parallel_paint_worker_reset(parallel_paint_worker_t* worker) {
+  if (worker->lcd != NULL) {
+    canvas_reset(&(worker->canvas));
+    lcd_destroy(worker->lcd);
+    worker->lcd = NULL;
+  }
+
+  return RET_OK;
+}
+
+static ret_t parallel_paint_worker_prepare(parallel_paint_worker_t* worker, canvas_t* c) {
+  lcd_t* lcd = c->lcd;
+  lcd_mem_t* mem = (lcd_mem_t*)lcd;
+  canvas_t* wc = &(worker->canvas);
+
+  if (worker->lcd != NULL) {
+    lcd_mem_t* wmem = (lcd_mem_t*)(worker->lcd);
+    if (worker->lcd->w != lcd->w || worker->lcd->h != lcd->h || wmem->format != mem->format) {
+      parallel_paint_worker_reset(worker);
+    }
+  }
+
+  if (worker->lcd == NULL) {
+    worker->lcd = parallel_paint_create_lcd(mem->format, lcd->w, lcd->h, mem->offline_fb);
+    return_value_if_fail(worker->lcd != NULL, RET_NOT_IMPL);
+
+    canvas_init(wc, worker->lcd, c->font_manager);
+    if (c->assets_manager != NULL) {
+      canvas_set_assets_manager(wc, c->assets_manager);
+    }
+    /*vgcanvas创建时会注册到共享的vgcanvas_asset_manager，在UI线程中先创建好*/
+    canvas_get_vgcanvas(wc);
+  }
+
+  /*双缓冲交换后offline_fb会变化，直接修改，不加入fb的脏矩形列表*/
+  ((lcd_mem_t*)(worker->lcd))->offline_fb = mem->offline_fb;
+  lcd_set_line_length(worker->lcd, mem->line_length);
+  worker->lcd->draw_mode = lcd->draw_mode;
+  lcd_set_canvas(worker->lcd, wc);
+
+  wc->ox = c->ox;
+  wc->oy = c->oy;
+  canvas_set_global_alpha(wc, c->global_alpha);
+  canvas_set_clip_rect(wc, &(s_parallel_paint.clip));
+
+  return RET_OK;
+}
+
+static bool_t parallel_paint_is_disallowed(widget_t* widget) {
+  const widget_vtable_t* vt = widget->vt;
+
+  for (; vt != NULL; vt = vt->parent) {
+    if (vt->disallow_parallel_paint) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/*
+ * 绘制过程中会布局窗口、更新控件的style，先在UI线程中完成，避免多个线程同时修改。
+ * 有绘制时会修改自身状态的控件(如edit和rich_text)时，返回RET_NOT_IMPL，由调用者单线程绘制。
+ */
+static ret_t parallel_paint_prepare(widget_t* widget) {
+  if (!widget->visible) {
+    return RET_OK;
+  }
+
+  if (parallel_paint_is_disallowed(widget)) {
+    return RET_NOT_IMPL;
+  }
+
+  if (widget->vt->is_window && WINDOW_BASE(widget)->need_relayout) {
+    widget_layout(widget);
+    window_base_set_need_relayout(widget, FALSE);
+  }
+
+  if (widget->need_update_style) {
+    widget_update_style(widget);
+  }
+
+  WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
+  if (parallel_paint_prepare(iter) != RET_OK) {
+    return RET_NOT_IMPL;
+  }
+  WIDGET_FOR_EACH_CHILD_END();
+
+  return RET_OK;
+}
+
+static ret_t parallel_paint_worker_start(parallel_paint_worker_t* worker) {
+  worker->start = tk_semaphore_create(0, NULL);
+  return_value_if_fail(worker->start != NULL, RET_OOM);
+
+  worker->thread = tk_thread_create(parallel_paint_worker_main, worker);
+  if (worker->thread != NULL) {
+    tk_thread_set_name(worker->thread, "parallel_paint");
+    if (tk_thread_start(worker->thread) == RET_OK) {
+      return RET_OK;
+    }
+    tk_thread_destroy(worker->thread);
+  }
+
+  tk_semaphore_destroy(worker->start);
+  memset(worker, 0x00, sizeof(*worker));
+
+  return RET_FAIL;
+}
+
+ret_t parallel_paint_set_threads(uint32_t nr) {
+  uint32_t i = 0;
+  parallel_paint_ctx_t* ctx = &s_parallel_paint;
+  return_value_if_fail(nr <= TK_PARALLEL_PAINT_MAX_THREADS && !ctx->busy, RET_BAD_PARAMS);
+
+  if (ctx->nr > 1) {
+    ctx->quit = TRUE;
+    for (i = 1; i < ctx->nr; i++) {
+      parallel_paint_worker_t* worker = ctx->workers + i;
+      tk_semaphore_post(worker->start);
+      tk_thread_join(worker->thread);
+      tk_thread_destroy(worker->thread);
+      tk_semaphore_destroy(worker->start);
+      parallel_paint_worker_reset(worker);
+    }
+  }
+
+  if (ctx->done != NULL) {
+    tk_semaphore_destroy(ctx->done);
+  }
+  if (ctx->mutex != NULL) {
+    tk_mutex_nest_destroy(ctx->mutex);
+  }
+  memset(ctx, 0x00, sizeof(*ctx));
+
+  if (nr < 2) {
+    return RET_OK;
+  }
+
+  ctx->mutex = tk_mutex_nest_create();
+  ctx->done = tk_semaphore_create(0, NULL);
+  goto_error_if_fail(ctx->mutex != NULL && ctx->done != NULL);
+
+  for (i = 1; i < nr; i++) {
+    goto_error_if_fail(parallel_paint_worker_start(ctx->workers + i) == RET_OK);
+    ctx->nr = i + 1;
+  }
+
+  return RET_OK;
+error:
+  parallel_paint_set_threads(0);
+
+  return RET_FAIL;
+}
+
+uint32_t parallel_paint_get_threads(void) {
+  return s_parallel_paint.nr;
+}
+
+ret_t parallel_paint(dirty_rects_t* dirty_rects, widget_t* widget, canvas_t* c,
+                     widget_on_paint_t on_paint) {
+  uint32_t i = 0;
+  uint32_t n = 0;
+  rect_t r_save;
+  rect_t bound = {0, 0, 0, 0};
+  parallel_paint_ctx_t* ctx = &s_parallel_paint;
+  return_value_if_fail(dirty_rects != NULL && widget != NULL && c != NULL, RET_BAD_PARAMS);
+
+  if (ctx->nr < 2 || c->lcd->type != LCD_FRAMEBUFFER || !lcd_is_support_dirty_rect(c->lcd) ||
+      ((lcd_mem_t*)(c->lcd))->offline_fb == NULL || dirty_rects->nr == 0) {
+    return RET_NOT_IMPL;
+  }
+
+  canvas_get_clip_rect(c, &r_save);
+  if (dirty_rects->disable_multiple) {
+    ctx->rects_nr = 1;
+    ctx->rects[0] = dirty_rects->max;
+  } else {
+    ctx->rects_nr = dirty_rects->nr;
+    memcpy(ctx->rects, dirty_rects->rects, dirty_rects->nr * sizeof(rect_t));
+  }
+
+  for (i = 0; i < ctx->rects_nr; i++) {
+    rect_merge(&bound, ctx->rects + i);
+  }
+  bound = rect_intersect(&bound, &r_save);
+
+  n = tk_min(ctx->nr, bound.h / TK_PARALLEL_PAINT_MIN_BAND_H);
+  if (n < 2) {
+    return RET_NOT_IMPL;
+  }
+
+  if (parallel_paint_prepare(widget) != RET_OK) {
+    return RET_NOT_IMPL;
+  }
+
+  ctx->clip = r_save;
+  ctx->widget = widget;
+  ctx->on_paint = on_paint;
+
+  for (i = 1; i < n; i++) {
+    if (parallel_paint_worker_prepare(ctx->workers + i, c) != RET_OK) {
+      return RET_NOT_IMPL;
+    }
+  }
+
+  for (i = 0; i < n; i++) {
+    int32_t top = bound.y + bound.h * i / n;
+    int32_t bottom = bound.y + bound.h * (i + 1) / n;
+    ctx->workers[i].band = rect_init(bound.x, top, bound.w, bottom - top);
+  }
+
+  ctx->busy = TRUE;
+  ctx->start_time = time_now_ms();
+  for (i = 1; i < n; i++) {
+    tk_semaphore_post(ctx->workers[i].start);
+  }
+
+  parallel_paint_band(c, &(ctx->workers[0].band));
+
+  for (i = 1; i < n; i++) {
+    tk_semaphore_wait(ctx->done, 0xffffffff);
+  }
+  ctx->busy = FALSE;
+  ctx->start_time = 0;
+  canvas_set_clip_rect(c, &r_save);
+
+  return RET_OK;
+}
+
+ret_t parallel_paint_lock(void) {
+  if (s_parallel_paint.busy) {
+    return tk_mutex_nest_lock(s_parallel_paint.mutex);
+  }
+
+  return RET_OK;
+}
+
+ret_t parallel_paint_unlock(void) {
+  if (s_parallel_paint.busy) {
+    return tk_mutex_nest_unlock(s_parallel_paint.mutex);
+  }
+
+  return RET_OK;
+}
+
+bool_t parallel_paint_is_busy(void) {
+  return s_parallel_paint.busy;
+}
+
+uint64_t parallel_paint_get_start_time(void) {
+  return s_parallel_paint.start_time;
+}
+
+#else
+ret_t parallel_paint_set_threads(uint32_t nr) {
+  return nr < 2 ? RET_OK : RET_NOT_IMPL;
+}
+
+uint32_t parallel_paint_get_threads(void) {
+  return 0;
+}
+
+ret_t parallel_paint(dirty_rects_t* dirty_rects, widget_t* widget, canvas_t* c,
+                     widget_on_paint_t on_paint) {
+  (void)dirty_rects;
+  (void)widget;
+  (void)c;
+  (void)on_paint;
+
+  return RET_NOT_IMPL;
+}
+
+ret_t parallel_paint_lock(void) {
+  return RET_OK;
+}
+
+ret_t parallel_paint_unlock(void) {
+  return RET_OK;
+}
+
+bool_t parallel_paint_is_busy(void) {
+  return FALSE;
+}
+
+uint64_t parallel_paint_get_start_time(void) {
+  return 0;
+}
+#endif /*WITH_PARALLEL_PAINT*/
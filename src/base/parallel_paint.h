@@ -0,0 +1,133 @@
+﻿/**
+ * File:   parallel_paint.h
+ * Author: AWTK Develop Team
+ * Brief:  paint dirty rects in horizontal bands on worker threads
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_PARALLEL_PAINT_H
+#define TK_PARALLEL_PAINT_H
+
+#include "base/canvas.h"
+#include "base/dirty_rects.h"
+#include "base/widget_vtable.h"
+
+BEGIN_C_DECLS
+
+#ifndef TK_PARALLEL_PAINT_MAX_THREADS
+#define TK_PARALLEL_PAINT_MAX_THREADS 8
+#endif /*TK_PARALLEL_PAINT_MAX_THREADS*/
+
+#ifndef TK_PARALLEL_PAINT_MIN_BAND_H
+#define TK_PARALLEL_PAINT_MIN_BAND_H 32
+#endif /*TK_PARALLEL_PAINT_MIN_BAND_H*/
+
+/**
+ * @class parallel_paint_t
+ * @annotation ["fake"]
+ * 多线程绘制脏矩形。
+ *
+ * 把一帧的脏矩形区域按水平方向切成若干条带，每个条带由一个线程绘制，
+ * 每个线程有自己的canvas和lcd(共享同一个framebuffer)，裁剪区限定在各自的条带内，
+ * 所以各线程写的像素互不重叠，绘制结果与单线程绘制完全一致。
+ *
+ * 限制：
+ *
+ * * 有线程的桌面平台(HAS\_PTHREAD或WITH\_SDL)缺省编译进来(定义WITHOUT\_PARALLEL\_PAINT可以去掉)，
+ *   其它平台需要定义宏WITH\_PARALLEL\_PAINT。调用parallel\_paint\_set\_threads启用(缺省不启用)。
+ * * 只支持基于framebuffer的lcd(lcd\_mem)，不支持GPU、片段lcd(FRAGMENT\_FRAME\_BUFFER\_SIZE)。
+ * * 控件的on\_paint会在多个线程中同时调用，不能在绘制时修改共享的状态。
+ *   内置的字体管理器、字模缓存和图片管理器在绘制期间会加锁，并推迟释放可能正在使用的资源。
+ * * 分条带之前，先在UI线程中完成窗口的布局和控件style的更新。
+ * * 控件树中有绘制时会修改自身状态的控件(vtable的disallow\_parallel\_paint为TRUE，如edit、mledit和rich\_text)时，
+ *   不使用多线程绘制。绘制时需要修改状态的代码，可以用parallel\_paint\_is\_busy检查。
+ */
+
+/**
+ * @method parallel_paint_set_threads
+ * 设置绘制线程的个数(包括UI线程)。0或1表示不启用多线程绘制，并释放已经创建的线程。
+ * @annotation ["static"]
+ * @param {uint32_t} nr 线程的个数(不能超过TK\_PARALLEL\_PAINT\_MAX\_THREADS)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t parallel_paint_set_threads(uint32_t nr);
+
+/**
+ * @method parallel_paint_get_threads
+ * 获取绘制线程的个数。
+ * @annotation ["static"]
+ *
+ * @return {uint32_t} 返回线程的个数，未启用时返回0。
+ */
+uint32_t parallel_paint_get_threads(void);
+
+/**
+ * @method parallel_paint
+ * 多线程绘制脏矩形。
+ * @annotation ["static"]
+ * @param {dirty_rects_t*} dirty_rects 脏矩形。
+ * @param {widget_t*} widget 控件。
+ * @param {canvas_t*} c 画布。
+ * @param {widget_on_paint_t} on_paint 绘制函数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，返回RET_NOT_IMPL表示不能多线程绘制(调用者应该用单线程绘制)。
+ */
+ret_t parallel_paint(dirty_rects_t* dirty_rects, widget_t* widget, canvas_t* c,
+                     widget_on_paint_t on_paint);
+
+/**
+ * @method parallel_paint_lock
+ * 多线程绘制期间，访问共享的缓存(字体、字模和图片)前加锁。没有多线程绘制时什么也不做。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t parallel_paint_lock(void);
+
+/**
+ * @method parallel_paint_unlock
+ * 解锁。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t parallel_paint_unlock(void);
+
+/**
+ * @method parallel_paint_is_busy
+ * 是否正在多线程绘制。
+ * > 此时缓存中的资源可能正在被其它线程使用，不能释放。绘制时不能修改控件和共享的状态。
+ * @annotation ["static"]
+ *
+ * @return {bool_t} 返回TRUE表示正在多线程绘制。
+ */
+bool_t parallel_paint_is_busy(void);
+
+/**
+ * @method parallel_paint_get_start_time
+ * 获取当前多线程绘制开始的时间(毫秒)。
+ * > 在该时间之后访问过的缓存项可能正在被其它线程使用，不能淘汰。
+ * @annotation ["static"]
+ *
+ * @return {uint64_t} 返回开始的时间，没有多线程绘制时返回0。
+ */
+uint64_t parallel_paint_get_start_time(void);
+
+END_C_DECLS
+
+#endif /*TK_PARALLEL_PAINT_H*/
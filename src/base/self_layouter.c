@@ -21,6 +21,7 @@
 
 #include "base/widget.h"
 #include "base/self_layouter.h"
+#include "base/widget_spatial_index.h"
 
 const char* self_layouter_to_string(self_layouter_t* layouter) {
   if (layouter == NULL) {
@@ -35,7 +36,11 @@ const char* self_layouter_to_string(self_layouter_t* layouter) {
 ret_t self_layouter_layout(self_layouter_t* layouter, widget_t* widget, rect_t* area) {
   if (layouter == NULL) {
     if (widget->vt->auto_adjust_size != NULL) {
+      rect_t old = rect_init(widget->x, widget->y, widget->w, widget->h);
+
+      /*auto_adjust_size直接修改控件的大小，需要更新父控件的空间索引*/
       widget->vt->auto_adjust_size(widget);
+      widget_spatial_index_on_child_moved(widget, &old);
     }
 
     return RET_FAIL;
@@ -23,6 +23,7 @@
 #include "tkc/utils.h"
 #include "tkc/value.h"
 #include "base/style.h"
+#include "base/paint_profiler.h"
 
 static ret_t gradient_str_to_value(value_t* v, const char* value) {
   gradient_t g;
@@ -54,12 +55,14 @@ ret_t style_update_state(style_t* s, theme_t* theme, const char* widget_type,
 
 uint32_t style_get_uint(style_t* s, const char* name, uint32_t defval) {
   return_value_if_fail(s != NULL && s->vt != NULL && s->vt->get_int != NULL, defval);
+  PAINT_PROFILER_STYLE_LOOKUP()
 
   return s->vt->get_uint(s, name, defval);
 }
 
 int32_t style_get_int(style_t* s, const char* name, int32_t defval) {
   return_value_if_fail(s != NULL && s->vt != NULL && s->vt->get_int != NULL, defval);
+  PAINT_PROFILER_STYLE_LOOKUP()
 
   return s->vt->get_int(s, name, defval);
 }
@@ -74,18 +77,21 @@ bool_t style_is_valid(style_t* s) {
 
 color_t style_get_color(style_t* s, const char* name, color_t defval) {
   return_value_if_fail(s != NULL && s->vt != NULL && s->vt->get_color != NULL, defval);
+  PAINT_PROFILER_STYLE_LOOKUP()
 
   return s->vt->get_color(s, name, defval);
 }
 
 gradient_t* style_get_gradient(style_t* s, const char* name, gradient_t* gradient) {
   return_value_if_fail(s != NULL && s->vt != NULL && s->vt->get_gradient != NULL, NULL);
+  PAINT_PROFILER_STYLE_LOOKUP()
 
   return s->vt->get_gradient(s, name, gradient);
 }
 
 const char* style_get_str(style_t* s, const char* name, const char* defval) {
   return_value_if_fail(s != NULL && s->vt != NULL && s->vt->get_str != NULL, defval);
+  PAINT_PROFILER_STYLE_LOOKUP()
 
   return s->vt->get_str(s, name, defval);
 }
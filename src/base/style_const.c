@@ -20,8 +20,10 @@
  */
 
 #include "tkc/mem.h"
+#include "tkc/atom.h"
 #include "base/theme.h"
 #include "tkc/utils.h"
+#include "tkc/buffer.h"
 #include "base/widget.h"
 #include "base/style_const.h"
 
@@ -29,53 +31,275 @@ static bool_t is_valid_style_name(const char* str) {
   return str != NULL && *str;
 }
 
-static const void* widget_get_const_style_data_for_state_impl(widget_t* widget,
-                                                              const char* style_name,
-                                                              const char* state) {
-  const void* data = NULL;
-  theme_t* win_theme = NULL;
-  theme_t* default_theme = NULL;
-  const char* type = widget_get_type(widget);
-
-  if (tk_str_eq(type, WIDGET_TYPE_WINDOW_MANAGER)) {
-    return theme_find_style(theme(), type, style_name, state);
+/*查找style用到的主题和键*/
+typedef struct _style_const_key_t {
+  theme_t* win_theme;
+  theme_t* default_theme;
+  const char* type;
+  const char* style_name;
+  const char* state;
+} style_const_key_t;
+
+static ret_t style_const_key_init(style_const_key_t* key, widget_t* widget, const char* state) {
+  memset(key, 0x00, sizeof(style_const_key_t));
+  key->type = widget_get_type(widget);
+  key->style_name = is_valid_style_name(widget->style) ? widget->style : TK_DEFAULT_STYLE;
+  key->state = state;
+
+  if (tk_str_eq(key->type, WIDGET_TYPE_WINDOW_MANAGER)) {
+    key->default_theme = theme();
+    return RET_OK;
   }
 
-  return_value_if_fail(widget_get_window_theme(widget, &win_theme, &default_theme) == RET_OK, NULL);
-  if (win_theme != NULL) {
-    data = theme_find_style(win_theme, type, style_name, state);
+  return widget_get_window_theme(widget, &(key->win_theme), &(key->default_theme));
+}
+
+static const uint8_t* widget_get_const_style_data_for_state_impl(const style_const_key_t* key,
+                                                                 const char* style_name,
+                                                                 const char* state) {
+  const uint8_t* data = NULL;
+
+  if (key->win_theme != NULL) {
+    data = theme_find_style(key->win_theme, key->type, style_name, state);
   }
 
   if (data == NULL) {
-    data = theme_find_style(default_theme, type, style_name, state);
+    data = theme_find_style(key->default_theme, key->type, style_name, state);
   }
 
   return data;
 }
 
-static const void* widget_get_const_style_data_for_style(widget_t* widget, style_t* s,
-                                                         const char* style_name) {
-  const void* data = NULL;
-  style_const_t* style = (style_const_t*)s;
-  data = widget_get_const_style_data_for_state_impl(widget, style_name, style->state);
-  if (data == NULL && !tk_str_eq(style->state, WIDGET_STATE_NORMAL)) {
-    data = widget_get_const_style_data_for_state_impl(widget, style_name, WIDGET_STATE_NORMAL);
+static const uint8_t* widget_get_const_style_data_for_style(const style_const_key_t* key,
+                                                            const char* style_name) {
+  const uint8_t* data = NULL;
+  data = widget_get_const_style_data_for_state_impl(key, style_name, key->state);
+  if (data == NULL && !tk_str_eq(key->state, WIDGET_STATE_NORMAL)) {
+    data = widget_get_const_style_data_for_state_impl(key, style_name, WIDGET_STATE_NORMAL);
   }
 
   return data;
 }
 
-static const void* widget_get_const_style_data(widget_t* widget, style_t* s) {
-  const char* style_name = is_valid_style_name(widget->style) ? widget->style : TK_DEFAULT_STYLE;
-  const void* data = widget_get_const_style_data_for_style(widget, s, style_name);
+static const uint8_t* widget_get_const_style_data(const style_const_key_t* key) {
+  const uint8_t* data = widget_get_const_style_data_for_style(key, key->style_name);
 
-  if (data == NULL && !tk_str_eq(style_name, TK_DEFAULT_STYLE)) {
-    data = widget_get_const_style_data_for_style(widget, s, TK_DEFAULT_STYLE);
+  if (data == NULL && !tk_str_eq(key->style_name, TK_DEFAULT_STYLE)) {
+    data = widget_get_const_style_data_for_style(key, TK_DEFAULT_STYLE);
   }
 
   return data;
 }
 
+/*预定义属性解析后的值，type为VALUE_TYPE_INVALID表示不存在*/
+typedef struct _style_const_value_t {
+  uint32_t type;
+  union {
+    uint32_t u;
+    const char* str;
+  } v;
+} style_const_value_t;
+
+typedef struct _style_const_entry_t {
+  uint32_t refs;
+  uint32_t hash;
+  bool_t cached;
+  theme_t* win_theme;
+  theme_t* default_theme;
+  const char* type;
+  const char* style_name;
+  const char* state;
+  const uint8_t* data;
+  style_const_value_t values[STYLE_PROP_NR];
+  struct _style_const_entry_t* next;
+} style_const_entry_t;
+
+#define STYLE_CONST_CACHE_BUCKETS 64
+
+static uint32_t s_style_const_cache_size;
+static uint32_t s_style_const_cache_generation;
+static style_const_entry_t* s_style_const_cache[STYLE_CONST_CACHE_BUCKETS];
+
+static uint32_t style_const_hash_str(uint32_t h, const char* str) {
+  if (str != NULL) {
+    while (*str) {
+      h ^= (uint8_t)(*str++);
+      h *= 16777619u;
+    }
+  }
+
+  h ^= 0xff;
+  return h * 16777619u;
+}
+
+static uint32_t style_const_key_hash(const style_const_key_t* key) {
+  uint32_t h = 2166136261u;
+
+  h = (h ^ (uint32_t)((uintptr_t)(key->win_theme) >> 3)) * 16777619u;
+  h = (h ^ (uint32_t)((uintptr_t)(key->default_theme) >> 3)) * 16777619u;
+  h = style_const_hash_str(h, key->type);
+  h = style_const_hash_str(h, key->style_name);
+
+  return style_const_hash_str(h, key->state);
+}
+
+static bool_t style_const_entry_match(style_const_entry_t* entry, const style_const_key_t* key,
+                                      uint32_t hash) {
+  /*entry中的字符串是原子字符串，控件的style和state也是，通常比较指针就可以了*/
+  return entry->hash == hash && entry->win_theme == key->win_theme &&
+         entry->default_theme == key->default_theme &&
+         (entry->type == key->type || tk_str_eq(entry->type, key->type)) &&
+         (entry->style_name == key->style_name || tk_str_eq(entry->style_name, key->style_name)) &&
+         (entry->state == key->state || tk_str_eq(entry->state, key->state));
+}
+
+static style_const_entry_t* style_const_entry_create(const style_const_key_t* key, uint32_t hash,
+                                                     const uint8_t* data) {
+  uint32_t i = 0;
+  style_const_entry_t* entry = TKMEM_ZALLOC(style_const_entry_t);
+  return_value_if_fail(entry != NULL, NULL);
+
+  entry->type = tk_atom(key->type != NULL ? key->type : "");
+  entry->style_name = tk_atom(key->style_name);
+  entry->state = tk_atom(key->state != NULL ? key->state : "");
+
+  entry->hash = hash;
+  entry->win_theme = key->win_theme;
+  entry->default_theme = key->default_theme;
+  entry->data = data;
+
+  for (i = 0; i < STYLE_PROP_NR && data != NULL; i++) {
+    const style_name_value_t* nv = style_data_get(data, style_prop_name_from_id(i));
+
+    if (nv != NULL) {
+      const uint8_t* v = (const uint8_t*)(nv->name) + nv->name_size;
+      style_const_value_t* iter = entry->values + i;
+
+      iter->type = nv->type;
+      if (nv->type == VALUE_TYPE_UINT32 || nv->type == VALUE_TYPE_INT32) {
+        load_uint32(v, iter->v.u);
+      } else if (nv->type == VALUE_TYPE_STRING) {
+        iter->v.str = (const char*)v;
+      }
+    }
+  }
+
+  return entry;
+}
+
+static ret_t style_const_entry_destroy(style_const_entry_t* entry) {
+  tk_atom_unref(entry->type);
+  tk_atom_unref(entry->style_name);
+  tk_atom_unref(entry->state);
+  TKMEM_FREE(entry);
+
+  return RET_OK;
+}
+
+static ret_t style_const_entry_unref(style_const_entry_t* entry) {
+  if (entry != NULL) {
+    assert(entry->refs > 0);
+    entry->refs--;
+    if (entry->refs == 0 && !entry->cached) {
+      style_const_entry_destroy(entry);
+    }
+  }
+
+  return RET_OK;
+}
+
+/*只释放没有控件引用的，force为TRUE时全部移出缓存*/
+static ret_t style_const_cache_purge(bool_t force) {
+  uint32_t i = 0;
+
+  for (i = 0; i < STYLE_CONST_CACHE_BUCKETS; i++) {
+    style_const_entry_t** pp = s_style_const_cache + i;
+
+    while (*pp != NULL) {
+      style_const_entry_t* iter = *pp;
+
+      if (force || iter->refs == 0) {
+        *pp = iter->next;
+        iter->next = NULL;
+        iter->cached = FALSE;
+        s_style_const_cache_size--;
+        if (iter->refs == 0) {
+          style_const_entry_destroy(iter);
+        }
+      } else {
+        pp = &(iter->next);
+      }
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t style_const_cache_clear(void) {
+  return style_const_cache_purge(TRUE);
+}
+
+uint32_t style_const_cache_get_size(void) {
+  return s_style_const_cache_size;
+}
+
+static style_const_entry_t* style_const_cache_get(const style_const_key_t* key) {
+  uint32_t hash = 0;
+  style_const_entry_t* iter = NULL;
+  style_const_entry_t** bucket = NULL;
+
+  if (TK_STYLE_CONST_CACHE_NR == 0) {
+    return NULL;
+  }
+
+  if (s_style_const_cache_generation != theme_get_generation()) {
+    style_const_cache_clear();
+    s_style_const_cache_generation = theme_get_generation();
+  }
+
+  hash = style_const_key_hash(key);
+  bucket = s_style_const_cache + hash % STYLE_CONST_CACHE_BUCKETS;
+  for (iter = *bucket; iter != NULL; iter = iter->next) {
+    if (style_const_entry_match(iter, key, hash)) {
+      iter->refs++;
+      return iter;
+    }
+  }
+
+  if (s_style_const_cache_size >= TK_STYLE_CONST_CACHE_NR) {
+    style_const_cache_purge(FALSE);
+  }
+
+  iter = style_const_entry_create(key, hash, widget_get_const_style_data(key));
+  return_value_if_fail(iter != NULL, NULL);
+
+  iter->refs = 1;
+  iter->cached = TRUE;
+  iter->next = *bucket;
+  *bucket = iter;
+  s_style_const_cache_size++;
+
+  return iter;
+}
+
+static ret_t style_const_set_entry(style_const_t* style, style_const_entry_t* entry) {
+  style_const_entry_unref(style->entry);
+  style->entry = entry;
+
+  return RET_OK;
+}
+
+static const style_const_value_t* style_const_get_value(style_const_t* style, const char* name) {
+  uint32_t id = 0;
+
+  if (style->entry == NULL) {
+    return NULL;
+  }
+
+  id = style_prop_id_from_name(name);
+  return id < STYLE_PROP_NR ? style->entry->values + id : NULL;
+}
+
 static ret_t style_const_apply_props(style_t* s, widget_t* widget) {
   const char* self_layout = style_get_str(s, STYLE_ID_SELF_LAYOUT, NULL);
   const char* children_layout = style_get_str(s, STYLE_ID_CHILDREN_LAYOUT, NULL);
@@ -109,11 +333,17 @@ static ret_t style_const_notify_widget_state_changed(style_t* s, widget_t* widge
   const char* state = NULL;
   const void* old_data = NULL;
   style_const_t* style = (style_const_t*)s;
+  style_const_key_t key;
+  style_const_entry_t* entry = NULL;
   return_value_if_fail(style != NULL && widget != NULL, RET_BAD_PARAMS);
   old_data = style->data;
   state = widget_get_prop_str(widget, WIDGET_PROP_STATE_FOR_STYLE, widget->state);
   style->state = tk_str_copy(style->state, state);
-  style->data = widget_get_const_style_data(widget, s);
+  return_value_if_fail(style_const_key_init(&key, widget, style->state) == RET_OK, RET_FAIL);
+
+  entry = style_const_cache_get(&key);
+  style_const_set_entry(style, entry);
+  style->data = entry != NULL ? entry->data : widget_get_const_style_data(&key);
 
   if (old_data != style->data) {
     style_const_apply_props(s, widget);
@@ -127,6 +357,7 @@ static ret_t style_const_update_state(style_t* s, theme_t* theme, const char* wi
   style_const_t* style = (style_const_t*)s;
   const uint8_t* data = theme_find_style(theme, widget_type, style_name, widget_state);
   return_value_if_fail(data != NULL, RET_NOT_FOUND);
+  style_const_set_entry(style, NULL);
   style->data = data;
   style->state = tk_str_copy(style->state, widget_state);
   return RET_OK;
@@ -140,20 +371,31 @@ static bool_t style_const_is_valid(style_t* s) {
 
 static int32_t style_const_get_int(style_t* s, const char* name, int32_t defval) {
   style_const_t* style = (style_const_t*)s;
+  const style_const_value_t* v = style_const_get_value(style, name);
+
+  if (v != NULL) {
+    return (v->type == VALUE_TYPE_UINT32 || v->type == VALUE_TYPE_INT32) ? (int32_t)(v->v.u)
+                                                                         : defval;
+  }
 
   return style_data_get_int(style->data, name, defval);
 }
 
 static uint32_t style_const_get_uint(style_t* s, const char* name, uint32_t defval) {
   style_const_t* style = (style_const_t*)s;
+  const style_const_value_t* v = style_const_get_value(style, name);
+
+  if (v != NULL) {
+    return v->type == VALUE_TYPE_UINT32 ? v->v.u : defval;
+  }
 
   return style_data_get_uint(style->data, name, defval);
 }
 
 static color_t style_const_get_color(style_t* s, const char* name, color_t defval) {
-  style_const_t* style = (style_const_t*)s;
+  defval.color = style_const_get_uint(s, name, defval.color);
 
-  return style_data_get_color(style->data, name, defval);
+  return defval;
 }
 
 static gradient_t* style_const_get_gradient(style_t* s, const char* name, gradient_t* gradient) {
@@ -164,6 +406,11 @@ static gradient_t* style_const_get_gradient(style_t* s, const char* name, gradie
 
 static const char* style_const_get_str(style_t* s, const char* name, const char* defval) {
   style_const_t* style = (style_const_t*)s;
+  const style_const_value_t* v = style_const_get_value(style, name);
+
+  if (v != NULL) {
+    return v->type == VALUE_TYPE_STRING ? v->v.str : defval;
+  }
 
   return style_data_get_str(style->data, name, defval);
 }
@@ -171,6 +418,7 @@ static const char* style_const_get_str(style_t* s, const char* name, const char*
 static ret_t style_const_set_style_data(style_t* s, const uint8_t* data, const char* state) {
   style_const_t* style = (style_const_t*)s;
   return_value_if_fail(style != NULL, RET_BAD_PARAMS);
+  style_const_set_entry(style, NULL);
   style->data = data;
   if (state != NULL) {
     style->state = tk_str_copy(style->state, state);
@@ -197,6 +445,7 @@ static ret_t style_const_destroy(style_t* s) {
   if (style->state != NULL) {
     TKMEM_FREE(style->state);
   }
+  style_const_set_entry(style, NULL);
 
   memset(s, 0x00, sizeof(style_t));
 
@@ -39,6 +39,10 @@ typedef struct _style_const_t {
   style_t style;
   char* state;
   const uint8_t* data;
+
+  /*private*/
+  /*共享的已解析style，由控件状态变化时设置，为NULL时直接从data中读取*/
+  struct _style_const_entry_t* entry;
 } style_const_t;
 
 /**
@@ -51,6 +55,26 @@ typedef struct _style_const_t {
  */
 style_t* style_const_create(void);
 
+/**
+ * @method style_const_cache_clear
+ * 清除共享的已解析style(仍被控件引用的，在不再引用时释放)。
+ *
+ * 同样的控件类型、style名称、状态和主题，查找的结果相同。为了避免每个控件重复查找和解析，
+ * 结果保存在全局的缓存中，由控件共享，预定义的属性(STYLE\_ID\_*)在加入缓存时一次解析完成。
+ * 主题数据变化时缓存自动失效。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t style_const_cache_clear(void);
+
+/**
+ * @method style_const_cache_get_size
+ * 获取共享的已解析style的个数。
+ *
+ * @return {uint32_t} 返回个数。
+ */
+uint32_t style_const_cache_get_size(void);
+
 END_C_DECLS
 
 #endif /*TK_STYLE_CONST_H*/
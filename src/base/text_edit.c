@@ -31,6 +31,7 @@
 #include "base/text_edit.h"
 #include "base/line_break.h"
 #include "base/clip_board.h"
+#include "base/parallel_paint.h"
 #include "base/input_method.h"
 
 #define CHAR_SPACING 1
@@ -831,6 +832,8 @@ ret_t text_edit_paint(text_edit_t* text_edit, canvas_t* c) {
   DECL_IMPL(text_edit);
   text_layout_info_t* layout_info = &(impl->layout_info);
   style_t* style = text_edit->widget->astyle;
+  /*绘制时会重新布局，不能多线程绘制(edit和mledit设置了disallow_parallel_paint)*/
+  return_value_if_fail(!parallel_paint_is_busy(), RET_BUSY);
 
   if (impl->is_first_time_layout) {
     text_edit_layout(text_edit);
@@ -22,15 +22,182 @@
 #include "tkc/mem.h"
 #include "tkc/utils.h"
 #include "base/theme.h"
+#include "base/style.h"
 #include "tkc/buffer.h"
 
+/*属性ID就是在本表中的位置，已经生成的主题数据依赖它，只能在最后追加*/
+static const char* s_style_prop_names[STYLE_PROP_NR] = {STYLE_ID_BG_COLOR,
+                                                        STYLE_ID_FG_COLOR,
+                                                        STYLE_ID_MASK_COLOR,
+                                                        STYLE_ID_FONT_NAME,
+                                                        STYLE_ID_FONT_SIZE,
+                                                        STYLE_ID_FONT_STYLE,
+                                                        STYLE_ID_TEXT_COLOR,
+                                                        STYLE_ID_HIGHLIGHT_FONT_NAME,
+                                                        STYLE_ID_HIGHLIGHT_FONT_SIZE,
+                                                        STYLE_ID_HIGHLIGHT_TEXT_COLOR,
+                                                        STYLE_ID_TIPS_TEXT_COLOR,
+                                                        STYLE_ID_TEXT_ALIGN_H,
+                                                        STYLE_ID_TEXT_ALIGN_V,
+                                                        STYLE_ID_BORDER_COLOR,
+                                                        STYLE_ID_BORDER_WIDTH,
+                                                        STYLE_ID_BORDER,
+                                                        STYLE_ID_BG_IMAGE,
+                                                        STYLE_ID_BG_IMAGE_DRAW_TYPE,
+                                                        STYLE_ID_ICON,
+                                                        STYLE_ID_FG_IMAGE,
+                                                        STYLE_ID_FG_IMAGE_DRAW_TYPE,
+                                                        STYLE_ID_SPACER,
+                                                        STYLE_ID_MARGIN,
+                                                        STYLE_ID_MARGIN_LEFT,
+                                                        STYLE_ID_MARGIN_RIGHT,
+                                                        STYLE_ID_MARGIN_TOP,
+                                                        STYLE_ID_MARGIN_BOTTOM,
+                                                        STYLE_ID_ICON_AT,
+                                                        STYLE_ID_ACTIVE_ICON,
+                                                        STYLE_ID_X_OFFSET,
+                                                        STYLE_ID_Y_OFFSET,
+                                                        STYLE_ID_SELECTED_BG_COLOR,
+                                                        STYLE_ID_SELECTED_FG_COLOR,
+                                                        STYLE_ID_SELECTED_TEXT_COLOR,
+                                                        STYLE_ID_ROUND_RADIUS,
+                                                        STYLE_ID_ROUND_RADIUS_TOP_LETF,
+                                                        STYLE_ID_ROUND_RADIUS_TOP_RIGHT,
+                                                        STYLE_ID_ROUND_RADIUS_BOTTOM_LETF,
+                                                        STYLE_ID_ROUND_RADIUS_BOTTOM_RIGHT,
+                                                        STYLE_ID_CHILDREN_LAYOUT,
+                                                        STYLE_ID_SELF_LAYOUT,
+                                                        STYLE_ID_FOCUSABLE,
+                                                        STYLE_ID_FEEDBACK};
+
+#define STYLE_PROP_SLOTS_NR 128
+
+/*两个开放地址哈希表，存放的是ID+1(0表示空)：一个按名称字符串的地址，一个按名称字符串的内容*/
+static uint8_t s_style_prop_ptr_slots[STYLE_PROP_SLOTS_NR];
+static uint8_t s_style_prop_str_slots[STYLE_PROP_SLOTS_NR];
+static bool_t s_style_prop_slots_inited = FALSE;
+
+static uint32_t style_prop_ptr_hash(const char* name) {
+  uint32_t h = (uint32_t)((uintptr_t)name);
+
+  return ((h ^ (h >> 11)) * 2654435761u) >> 16;
+}
+
+static uint32_t style_prop_str_hash(const char* name) {
+  uint32_t h = 2166136261u;
+
+  while (*name) {
+    h ^= (uint8_t)(*name++);
+    h *= 16777619u;
+  }
+
+  return h;
+}
+
+static void style_prop_slots_insert(uint8_t* slots, uint32_t h, uint32_t id) {
+  while (slots[h % STYLE_PROP_SLOTS_NR] != 0) {
+    h++;
+  }
+  slots[h % STYLE_PROP_SLOTS_NR] = id + 1;
+}
+
+static void style_prop_slots_init(void) {
+  uint32_t i = 0;
+
+  for (i = 0; i < ARRAY_SIZE(s_style_prop_names); i++) {
+    const char* name = s_style_prop_names[i];
+    style_prop_slots_insert(s_style_prop_ptr_slots, style_prop_ptr_hash(name), i);
+    style_prop_slots_insert(s_style_prop_str_slots, style_prop_str_hash(name), i);
+  }
+  s_style_prop_slots_inited = TRUE;
+}
+
+/*
+ * 调用者通常直接使用STYLE_ID_*常量，链接器合并相同的字符串常量后，地址与本表中的相同，
+ * 此时按地址就能找到，不需要比较字符串。否则按内容的哈希值查找，只需要比较一次。
+ */
+uint32_t style_prop_id_from_name(const char* name) {
+  uint32_t h = 0;
+  uint32_t id = 0;
+
+  if (name == NULL) {
+    return STYLE_PROP_ID_INVALID;
+  }
+
+  if (!s_style_prop_slots_inited) {
+    style_prop_slots_init();
+  }
+
+  for (h = style_prop_ptr_hash(name);; h++) {
+    id = s_style_prop_ptr_slots[h % STYLE_PROP_SLOTS_NR];
+    if (id == 0) {
+      break;
+    } else if (s_style_prop_names[id - 1] == name) {
+      return id - 1;
+    }
+  }
+
+  for (h = style_prop_str_hash(name);; h++) {
+    id = s_style_prop_str_slots[h % STYLE_PROP_SLOTS_NR];
+    if (id == 0) {
+      break;
+    } else if (tk_str_eq(s_style_prop_names[id - 1], name)) {
+      return id - 1;
+    }
+  }
+
+  return STYLE_PROP_ID_INVALID;
+}
+
+const char* style_prop_name_from_id(uint32_t id) {
+  return id < ARRAY_SIZE(s_style_prop_names) ? s_style_prop_names[id] : NULL;
+}
+
+static uint32_t style_popcount(uint32_t v) {
+  v = v - ((v >> 1) & 0x55555555);
+  v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+
+  return (((v + (v >> 4)) & 0x0f0f0f0f) * 0x01010101) >> 24;
+}
+
 color_t style_data_get_color(const uint8_t* s, const char* name, color_t defval) {
   defval.color = style_data_get_uint(s, name, defval.color);
 
   return defval;
 }
 
-static const style_name_value_t* style_data_get(const uint8_t* s, const char* name) {
+/*p指向位图，返回ID为id的属性，不存在时返回NULL*/
+static const style_name_value_t* style_data_get_by_id(const uint8_t* s, const uint8_t* p,
+                                                      uint32_t words, uint32_t id) {
+  uint32_t i = 0;
+  uint32_t bits = 0;
+  uint32_t rank = 0;
+  uint32_t offset = 0;
+  uint32_t word = id >> 5;
+  uint32_t mask = 1u << (id & 0x1f);
+
+  if (word >= words) {
+    return NULL;
+  }
+
+  for (i = 0; i < word; i++) {
+    load_uint32(p, bits);
+    rank += style_popcount(bits);
+  }
+
+  load_uint32(p, bits);
+  if ((bits & mask) == 0) {
+    return NULL;
+  }
+  rank += style_popcount(bits & (mask - 1));
+
+  p += (words - word - 1) * 4 + rank * 2;
+  load_uint16(p, offset);
+
+  return (const style_name_value_t*)(s + offset);
+}
+
+const style_name_value_t* style_data_get(const uint8_t* s, const char* name) {
   uint32_t i = 0;
   uint32_t nr = 0;
   const uint8_t* p = s;
@@ -40,6 +207,26 @@ static const style_name_value_t* style_data_get(const uint8_t* s, const char* na
   }
 
   load_uint32(p, nr);
+  if (nr & STYLE_DATA_INDEXED) {
+    uint32_t words = 0;
+    uint32_t count = 0;
+    uint32_t id = style_prop_id_from_name(name);
+
+    load_uint32(p, words);
+    if (id != STYLE_PROP_ID_INVALID) {
+      return style_data_get_by_id(s, p, words, id);
+    }
+
+    /*不是预定义的属性，跳过索引后按名称查找*/
+    for (i = 0; i < words; i++) {
+      uint32_t bits = 0;
+      load_uint32(p, bits);
+      count += style_popcount(bits);
+    }
+    p += TK_ROUND_TO(count * 2, 4);
+    nr &= ~STYLE_DATA_INDEXED;
+  }
+
   for (i = 0; i < nr; i++) {
     const style_name_value_t* iter = (const style_name_value_t*)p;
 
@@ -109,6 +296,104 @@ const char* style_data_get_str(const uint8_t* s, const char* name, const char* d
   return value;
 }
 
+/*
+ * 开放地址哈希表，槽中存放theme_item_t的序数+1(0表示空)。
+ * 按插入顺序线性探测，同样的键先找到前面的项，与逐项比较的结果一致。
+ */
+typedef struct _theme_index_t {
+  const uint8_t* data;
+  uint32_t mask;
+  uint16_t slots[1];
+} theme_index_t;
+
+#define THEME_INDEX_MAX_ITEMS 0xfffe
+
+static uint32_t theme_index_hash(const char* widget_type, const char* name,
+                                 const char* widget_state) {
+  uint32_t h = 2166136261u;
+  const char* strs[3] = {widget_type, name, widget_state};
+  uint32_t i = 0;
+
+  for (i = 0; i < ARRAY_SIZE(strs); i++) {
+    const char* p = strs[i];
+    while (*p) {
+      h ^= (uint8_t)(*p++);
+      h *= 16777619u;
+    }
+    h ^= 0xff;
+    h *= 16777619u;
+  }
+
+  return h;
+}
+
+static ret_t theme_index_destroy(theme_t* theme) {
+  TKMEM_FREE(theme->index);
+  theme->index = NULL;
+
+  return RET_OK;
+}
+
+static ret_t theme_index_build(theme_t* theme) {
+  uint32_t i = 0;
+  uint32_t size = 4;
+  theme_index_t* index = NULL;
+  const theme_item_t* iter = NULL;
+  const theme_header_t* header = (const theme_header_t*)(theme->data);
+
+  theme_index_destroy(theme);
+  if (header == NULL || header->magic != THEME_MAGIC || header->nr > THEME_INDEX_MAX_ITEMS) {
+    return RET_OK;
+  }
+
+  while (size < header->nr * 2) {
+    size <<= 1;
+  }
+
+  index = (theme_index_t*)TKMEM_CALLOC(1, sizeof(theme_index_t) + size * sizeof(uint16_t));
+  return_value_if_fail(index != NULL, RET_OOM);
+
+  index->data = theme->data;
+  index->mask = size - 1;
+  iter = (const theme_item_t*)(theme->data + sizeof(theme_header_t));
+  for (i = 0; i < header->nr; i++, iter++) {
+    uint32_t h = theme_index_hash(iter->widget_type, iter->name, iter->state);
+    while (index->slots[h & index->mask] != 0) {
+      h++;
+    }
+    index->slots[h & index->mask] = i + 1;
+  }
+  theme->index = index;
+
+  return RET_OK;
+}
+
+static const uint8_t* theme_index_find(theme_index_t* index, const char* widget_type,
+                                       const char* name, const char* widget_state) {
+  uint32_t h = 0;
+  uint32_t slot = 0;
+  const theme_item_t* items = (const theme_item_t*)(index->data + sizeof(theme_header_t));
+
+  if (widget_type == NULL || widget_state == NULL) {
+    return NULL;
+  }
+
+  for (h = theme_index_hash(widget_type, name, widget_state);; h++) {
+    const theme_item_t* iter = NULL;
+
+    slot = index->slots[h & index->mask];
+    if (slot == 0) {
+      return NULL;
+    }
+
+    iter = items + slot - 1;
+    if (tk_str_eq(widget_type, iter->widget_type) && tk_str_eq(iter->state, widget_state) &&
+        tk_str_eq(iter->name, name)) {
+      return index->data + iter->offset;
+    }
+  }
+}
+
 const uint8_t* theme_find_style(theme_t* theme, const char* widget_type, const char* name,
                                 const char* widget_state) {
   return_value_if_fail(theme != NULL, NULL);
@@ -125,6 +410,11 @@ const uint8_t* theme_find_style(theme_t* theme, const char* widget_type, const c
       name = TK_DEFAULT_STYLE;
     }
 
+    /*直接修改theme->data时索引已经失效，逐项比较*/
+    if (theme->index != NULL && theme->index->data == theme->data) {
+      return theme_index_find(theme->index, widget_type, name, widget_state);
+    }
+
     iter = (const theme_item_t*)(theme->data + sizeof(theme_header_t));
     for (i = 0; i < header->nr; i++) {
       if (tk_str_eq(widget_type, iter->widget_type)) {
@@ -147,14 +437,21 @@ const char* theme_get_style_type(theme_t* theme) {
   }
 }
 
+static uint32_t s_theme_generation;
+
+uint32_t theme_get_generation(void) {
+  return s_theme_generation;
+}
+
 ret_t theme_set_theme_data(theme_t* theme, const uint8_t* data) {
   return_value_if_fail(theme != NULL, RET_BAD_PARAMS);
+  s_theme_generation++;
   if (theme->set_style_data != NULL) {
     return theme->set_style_data(theme, data);
   } else {
     return_value_if_fail(data != NULL, RET_BAD_PARAMS);
     theme->data = data;
-    return RET_OK;
+    return theme_index_build(theme);
   }
 }
 
@@ -166,6 +463,10 @@ theme_t* theme(void) {
 
 ret_t theme_set(theme_t* theme) {
   s_theme = theme;
+  s_theme_generation++;
+  if (!s_style_prop_slots_inited) {
+    style_prop_slots_init();
+  }
 
   return RET_OK;
 }
@@ -174,15 +475,24 @@ theme_t* theme_default_create(const uint8_t* data) {
   theme_t* theme = TKMEM_ZALLOC(theme_t);
   return_value_if_fail(theme != NULL, NULL);
   theme->data = data;
+  theme_index_build(theme);
+
+  /*在UI线程中初始化属性ID表，避免多线程绘制时才初始化*/
+  if (!s_style_prop_slots_inited) {
+    style_prop_slots_init();
+  }
+
   return theme;
 }
 
 ret_t theme_destroy(theme_t* theme) {
   return_value_if_fail(theme != NULL, RET_BAD_PARAMS);
+  s_theme_generation++;
   if (theme->theme_destroy != NULL) {
     return theme->theme_destroy(theme);
   } else {
     theme->data = NULL;
+    theme_index_destroy(theme);
     TKMEM_FREE(theme);
     return RET_OK;
   }
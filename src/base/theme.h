@@ -56,6 +56,10 @@ struct _theme_t {
 
   theme_set_theme_data_t set_style_data;
   theme_get_style_type_t get_style_type;
+
+  /*private*/
+  /*(widget_type, name, state)到theme_item_t的哈希索引，由theme_default_create/theme_set_theme_data建立*/
+  struct _theme_index_t* index;
 };
 
 /**
@@ -171,6 +175,60 @@ typedef struct _style_name_value_t {
 #define STYLE_NAME_SIZE_MAX 255
 #define STYLE_VALUE_SIZE_MAX 1023
 
+/*
+ * theme_gen生成的style数据带有按属性ID的索引，nr的最高位为STYLE_DATA_INDEXED：
+ *   uint32_t nr | STYLE_DATA_INDEXED;
+ *   uint32_t words;                   位图的个数
+ *   uint32_t bitmap[words];           第id位表示存在ID为id的属性
+ *   uint16_t offsets[存在的属性个数];  按ID排列，属性相对于style数据开头的偏移
+ *   填充到4字节对齐
+ *   style_name_value_t[nr];           与没有索引时相同
+ * 没有索引的style数据(旧的主题文件)仍然按名称逐个比较。
+ */
+#define STYLE_DATA_INDEXED 0x80000000u
+#define STYLE_PROP_ID_INVALID 0xffff
+#define STYLE_PROP_NR 43
+
+/**
+ * @method style_prop_id_from_name
+ * 获取style属性名(STYLE\_ID\_*)对应的数字ID。
+ * @annotation ["private"]
+ * @param {const char*} name 属性名。
+ *
+ * @return {uint32_t} 返回ID，不是预定义的属性时返回STYLE\_PROP\_ID\_INVALID。
+ */
+uint32_t style_prop_id_from_name(const char* name);
+
+/**
+ * @method style_prop_name_from_id
+ * 获取数字ID对应的style属性名(STYLE\_ID\_*)。
+ * @annotation ["private"]
+ * @param {uint32_t} id 属性ID。
+ *
+ * @return {const char*} 返回属性名，ID无效时返回NULL。
+ */
+const char* style_prop_name_from_id(uint32_t id);
+
+/**
+ * @method style_data_get
+ * 在style数据中查找属性。
+ * @annotation ["private"]
+ * @param {const uint8_t*} s style数据。
+ * @param {const char*} name 属性名。
+ *
+ * @return {const style_name_value_t*} 返回属性，不存在时返回NULL。
+ */
+const style_name_value_t* style_data_get(const uint8_t* s, const char* name);
+
+/**
+ * @method theme_get_generation
+ * 获取主题数据的版本号。创建、销毁窗体样式对象或者修改窗体样式数据时递增，用于让缓存失效。
+ * @annotation ["private"]
+ *
+ * @return {uint32_t} 返回版本号。
+ */
+uint32_t theme_get_generation(void);
+
 END_C_DECLS
 
 #endif /*TK_THEME_H*/
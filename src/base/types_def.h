@@ -258,6 +258,11 @@ typedef enum _app_type_t {
 #define WITH_VGCANVAS 1
 #endif /*defined(WITH_NANOVG_SOFT) || defined(WITH_NANOVG_GPU)*/
 
+/*GPU模式下图片由GPU合成，不需要alpha分段表*/
+#if defined(WITH_GPU) && !defined(WITHOUT_BITMAP_ALPHA_RUNS)
+#define WITHOUT_BITMAP_ALPHA_RUNS 1
+#endif /*WITH_GPU*/
+
 #ifndef TK_DEFAULT_FONT_SIZE
 #define TK_DEFAULT_FONT_SIZE 18
 #endif /*TK_DEFAULT_FONT_SIZE*/
@@ -375,6 +380,51 @@ typedef struct _system_info_t system_info_t;
 #error " TK_GLYPH_CACHE_NR must > 0 "
 #endif
 
+/*字模缓存的内存上限(字节)，为0时按TK_GLYPH_CACHE_NR(字模个数)淘汰*/
+#ifndef TK_GLYPH_CACHE_MAX_BYTES
+#define TK_GLYPH_CACHE_MAX_BYTES 0
+#endif /*TK_GLYPH_CACHE_MAX_BYTES*/
+
+/*文本宽度缓存的个数(2的幂)，为0时不缓存*/
+#ifndef TK_TEXT_MEASURE_CACHE_NR
+#define TK_TEXT_MEASURE_CACHE_NR 128
+#endif /*TK_TEXT_MEASURE_CACHE_NR*/
+
+/*共享的已解析style的个数上限(超过时淘汰没有控件引用的)，为0时不共享*/
+#ifndef TK_STYLE_CONST_CACHE_NR
+#define TK_STYLE_CONST_CACHE_NR 256
+#endif /*TK_STYLE_CONST_CACHE_NR*/
+
+/*子控件个数达到这个值时建立空间索引，用于加速绘制子控件和查找点击目标，为0时不建立*/
+#ifndef TK_WIDGET_SPATIAL_INDEX_MIN_CHILDREN
+#define TK_WIDGET_SPATIAL_INDEX_MIN_CHILDREN 64
+#endif /*TK_WIDGET_SPATIAL_INDEX_MIN_CHILDREN*/
+
+/*cache_as_bitmap的控件缓存位图占用内存的上限(字节)，超过时淘汰最久没有使用的*/
+#ifndef TK_WIDGET_LAYER_CACHE_MAX_SIZE
+#define TK_WIDGET_LAYER_CACHE_MAX_SIZE (1024 * 1024)
+#endif /*TK_WIDGET_LAYER_CACHE_MAX_SIZE*/
+
+/*比较两帧的显示列表时，为了匹配相同的命令，最多跳过的插入或删除的命令个数*/
+#ifndef TK_DISPLAY_LIST_DIFF_LOOKAHEAD
+#define TK_DISPLAY_LIST_DIFF_LOOKAHEAD 16
+#endif /*TK_DISPLAY_LIST_DIFF_LOOKAHEAD*/
+
+/*启用WITH_DISPLAY_LIST时，有无法记录的命令(如vgcanvas)，之后这么多帧不再记录显示列表*/
+#ifndef TK_DISPLAY_LIST_RETRY_FRAMES
+#define TK_DISPLAY_LIST_RETRY_FRAMES 60
+#endif /*TK_DISPLAY_LIST_RETRY_FRAMES*/
+
+/*绘制分析器(paint_profiler)缺省最多保存的记录数，满了覆盖最早的记录*/
+#ifndef TK_PAINT_PROFILER_EVENTS_NR
+#define TK_PAINT_PROFILER_EVENTS_NR 16384
+#endif /*TK_PAINT_PROFILER_EVENTS_NR*/
+
+/*窗口动画截图的缓冲区池中最多保留的缓冲区个数(前后两个窗口各一个)，为0时不使用池*/
+#ifndef TK_WINDOW_SNAPSHOT_POOL_MAX_NR
+#define TK_WINDOW_SNAPSHOT_POOL_MAX_NR 2
+#endif /*TK_WINDOW_SNAPSHOT_POOL_MAX_NR*/
+
 #if defined(WITH_STB_FONT) || defined(WITH_FT_FONT)
 #define WITH_TRUETYPE_FONT 1
 #endif /*WITH_STB_FONT or WITH_FT_FONT*/
@@ -20,6 +20,7 @@
  */
 
 #include "tkc/mem.h"
+#include "tkc/atom.h"
 #include "tkc/utf8.h"
 #include "tkc/utils.h"
 #include "tkc/fscript.h"
@@ -44,6 +45,10 @@
 #include "base/widget_animator_manager.h"
 #include "base/widget_animator_factory.h"
 #include "base/window_base.h"
+#include "base/widget_name_index.h"
+#include "base/widget_spatial_index.h"
+#include "base/widget_layer_cache.h"
+#include "base/paint_profiler.h"
 #include "blend/image_g2d.h"
 
 ret_t widget_focus_up(widget_t* widget);
@@ -62,8 +67,29 @@ static ret_t widget_on_paint_end(widget_t* widget, canvas_t* c);
 typedef widget_t* (*widget_find_wanted_focus_widget_t)(widget_t* widget, darray_t* all_focusable);
 static ret_t widget_move_focus(widget_t* widget, widget_find_wanted_focus_widget_t find);
 
-static ret_t widget_set_x(widget_t* widget, xy_t x, bool_t update_layout) {
+/*父控件有空间索引时，子控件的位置和大小变化需要更新索引*/
+static ret_t widget_set_geometry(widget_t* widget, xy_t x, xy_t y, wh_t w, wh_t h) {
+  if (widget->parent != NULL && widget->parent->with_spatial_index) {
+    rect_t old = rect_init(widget->x, widget->y, widget->w, widget->h);
+
+    widget->x = x;
+    widget->y = y;
+    widget->w = w;
+    widget->h = h;
+
+    return widget_spatial_index_on_child_moved(widget, &old);
+  }
+
   widget->x = x;
+  widget->y = y;
+  widget->w = w;
+  widget->h = h;
+
+  return RET_OK;
+}
+
+static ret_t widget_set_x(widget_t* widget, xy_t x, bool_t update_layout) {
+  widget_set_geometry(widget, x, widget->y, widget->w, widget->h);
   if (update_layout && widget->self_layout != NULL) {
     self_layouter_set_param_str(widget->self_layout, "x", "n");
   }
@@ -71,7 +97,7 @@ static ret_t widget_set_x(widget_t* widget, xy_t x, bool_t update_layout) {
 }
 
 static ret_t widget_set_y(widget_t* widget, xy_t y, bool_t update_layout) {
-  widget->y = y;
+  widget_set_geometry(widget, widget->x, y, widget->w, widget->h);
   if (update_layout && widget->self_layout != NULL) {
     self_layouter_set_param_str(widget->self_layout, "y", "n");
   }
@@ -79,7 +105,7 @@ static ret_t widget_set_y(widget_t* widget, xy_t y, bool_t update_layout) {
 }
 
 static ret_t widget_set_w(widget_t* widget, wh_t w, bool_t update_layout) {
-  widget->w = w;
+  widget_set_geometry(widget, widget->x, widget->y, w, widget->h);
   if (update_layout && widget->self_layout != NULL) {
     self_layouter_set_param_str(widget->self_layout, "w", "n");
   }
@@ -87,7 +113,7 @@ static ret_t widget_set_w(widget_t* widget, wh_t w, bool_t update_layout) {
 }
 
 static ret_t widget_set_h(widget_t* widget, xy_t h, bool_t update_layout) {
-  widget->h = h;
+  widget_set_geometry(widget, widget->x, widget->y, widget->w, h);
   if (update_layout && widget->self_layout != NULL) {
     self_layouter_set_param_str(widget->self_layout, "h", "n");
   }
@@ -141,13 +167,37 @@ ret_t widget_update_style(widget_t* widget) {
   return_value_if_fail(widget != NULL && widget->astyle != NULL, RET_BAD_PARAMS);
 
   if (widget->need_update_style) {
+    ret_t ret = RET_OK;
+    PAINT_PROFILER_VAR(start)
+    PAINT_PROFILER_BEGIN(start)
+
     widget->need_update_style = FALSE;
-    return style_notify_widget_state_changed(widget->astyle, widget);
+    ret = style_notify_widget_state_changed(widget->astyle, widget);
+    PAINT_PROFILER_END(start, widget, PAINT_PROFILER_UPDATE_STYLE);
+
+    return ret;
   }
 
   return RET_OK;
 }
 
+/*
+ * name/style/state等字符串属性使用原子字符串，相同的字符串只保存一份，比较时直接比较指针。
+ * 与tk_str_copy一致：str为NULL时，原来有值则变为空字符串。
+ */
+static const char* widget_atom_copy(const char* old, const char* str) {
+  const char* atom = NULL;
+
+  if (str != NULL) {
+    atom = tk_atom(str);
+  } else if (old != NULL) {
+    atom = tk_atom("");
+  }
+  tk_atom_unref(old);
+
+  return atom;
+}
+
 static ret_t widget_real_destroy(widget_t* widget) {
   ENSURE(widget->ref_count == 1);
 
@@ -155,12 +205,12 @@ static ret_t widget_real_destroy(widget_t* widget) {
     widget->vt->on_destroy(widget);
   }
 
-  TKMEM_FREE(widget->name);
-  TKMEM_FREE(widget->state);
-  TKMEM_FREE(widget->style);
-  TKMEM_FREE(widget->tr_text);
-  TKMEM_FREE(widget->animation);
-  TKMEM_FREE(widget->pointer_cursor);
+  tk_atom_unref(widget->name);
+  tk_atom_unref(widget->state);
+  tk_atom_unref(widget->style);
+  tk_atom_unref(widget->tr_text);
+  tk_atom_unref(widget->animation);
+  tk_atom_unref(widget->pointer_cursor);
   OBJECT_UNREF(widget->custom_props);
   wstr_reset(&(widget->text));
   style_destroy(widget->astyle);
@@ -413,7 +463,7 @@ ret_t widget_use_style(widget_t* widget, const char* value) {
   return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
 
   widget_set_need_update_style(widget);
-  widget->style = tk_str_copy(widget->style, value);
+  widget->style = widget_atom_copy(widget->style, value);
 
   if (widget_is_window_opened(widget)) {
     widget_update_style(widget);
@@ -546,7 +596,7 @@ ret_t widget_set_tr_text(widget_t* widget, const char* text) {
   widget_t* win = widget_get_window(widget);
   return_value_if_fail(widget != NULL && text != NULL, RET_OK);
 
-  widget->tr_text = tk_str_copy(widget->tr_text, text);
+  widget->tr_text = widget_atom_copy(widget->tr_text, text);
   if (win != NULL) {
     tr_text = locale_info_tr(widget_get_locale_info(widget), text);
     widget_set_prop(widget, WIDGET_PROP_TEXT, value_set_str(&v, tr_text));
@@ -583,10 +633,136 @@ const wchar_t* widget_get_text(widget_t* widget) {
   return widget_get_prop(widget, WIDGET_PROP_TEXT, &v) == RET_OK ? value_wstr(&v) : 0;
 }
 
+#ifndef WITHOUT_WIDGET_NAME_INDEX
+/*子控件较少时直接遍历更快*/
+#define WIDGET_NAME_INDEX_MIN_CHILDREN 16
+/*同名控件较多时，比较它们遍历顺序的开销超过直接遍历*/
+#define WIDGET_NAME_INDEX_MAX_SAME_NAME 8
+
+/*返回FALSE表示子树中有窗口，窗口中的控件由它自己的索引管理，外层窗口不能再使用索引*/
+static bool_t widget_name_index_add_tree(widget_name_index_t* index, widget_t* widget) {
+  if (widget_is_window(widget)) {
+    return FALSE;
+  }
+
+  widget_name_index_add(index, widget);
+  WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
+  if (!widget_name_index_add_tree(index, iter)) {
+    return FALSE;
+  }
+  WIDGET_FOR_EACH_CHILD_END();
+
+  return TRUE;
+}
+
+static ret_t widget_name_index_remove_tree(widget_name_index_t* index, widget_t* widget) {
+  widget_name_index_remove(index, widget, widget->name);
+  WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
+  widget_name_index_remove_tree(index, iter);
+  WIDGET_FOR_EACH_CHILD_END();
+
+  return RET_OK;
+}
+
+static ret_t widget_drop_name_index(widget_t* win, bool_t disable) {
+  window_base_t* window_base = WINDOW_BASE(win);
+
+  if (window_base->name_index != NULL) {
+    widget_name_index_destroy(window_base->name_index);
+    window_base->name_index = NULL;
+  }
+
+  if (disable) {
+    window_base->no_name_index = TRUE;
+  }
+
+  return RET_OK;
+}
+
+/*返回widget所在窗口已经建立的索引，没有创建任何索引时不用查找窗口*/
+static widget_name_index_t* widget_get_name_index(widget_t* widget, widget_t** win) {
+  *win = NULL;
+  if (widget_name_index_get_count() == 0) {
+    return NULL;
+  }
+
+  *win = widget_get_window(widget);
+
+  return *win != NULL ? WINDOW_BASE(*win)->name_index : NULL;
+}
+
+/*索引在窗口中第一次查找时建立，此后在增加/删除子控件和修改名称时维护*/
+static widget_name_index_t* widget_ensure_name_index(widget_t* widget) {
+  widget_t* win = widget_get_window(widget);
+  window_base_t* window_base = NULL;
+
+  if (win == NULL || win->destroying) {
+    return NULL;
+  }
+
+  window_base = WINDOW_BASE(win);
+  if (window_base->name_index == NULL && !window_base->no_name_index) {
+    window_base->name_index = widget_name_index_create();
+    return_value_if_fail(window_base->name_index != NULL, NULL);
+
+    WIDGET_FOR_EACH_CHILD_BEGIN(win, iter, i)
+    if (!widget_name_index_add_tree(window_base->name_index, iter)) {
+      widget_drop_name_index(win, TRUE);
+      return NULL;
+    }
+    WIDGET_FOR_EACH_CHILD_END();
+  }
+
+  return window_base->name_index;
+}
+
+static ret_t widget_name_index_on_add_child(widget_t* widget, widget_t* child) {
+  widget_t* win = NULL;
+  widget_name_index_t* index = widget_get_name_index(widget, &win);
+
+  if (index != NULL && !widget_name_index_add_tree(index, child)) {
+    widget_drop_name_index(win, TRUE);
+  }
+
+  return RET_OK;
+}
+
+static ret_t widget_name_index_on_remove_child(widget_t* widget, widget_t* child) {
+  widget_t* win = NULL;
+  widget_name_index_t* index = widget_get_name_index(widget, &win);
+
+  if (index != NULL) {
+    widget_name_index_remove_tree(index, child);
+  }
+
+  return RET_OK;
+}
+
+static ret_t widget_name_index_on_rename(widget_t* widget, const char* old_name) {
+  widget_t* win = NULL;
+  widget_name_index_t* index = widget_get_name_index(widget, &win);
+
+  /*old_name可能已经释放，只用来比较地址*/
+  if (index != NULL && win != widget) {
+    widget_name_index_remove(index, widget, old_name);
+    widget_name_index_add(index, widget);
+  }
+
+  return RET_OK;
+}
+#endif /*WITHOUT_WIDGET_NAME_INDEX*/
+
 ret_t widget_set_name(widget_t* widget, const char* name) {
+  const char* old_name = NULL;
   return_value_if_fail(widget != NULL && name != NULL, RET_BAD_PARAMS);
 
-  widget->name = tk_str_copy(widget->name, name);
+  old_name = widget->name;
+  widget->name = widget_atom_copy(widget->name, name);
+#ifndef WITHOUT_WIDGET_NAME_INDEX
+  if (widget->name != old_name) {
+    widget_name_index_on_rename(widget, old_name);
+  }
+#endif /*WITHOUT_WIDGET_NAME_INDEX*/
 
   return RET_OK;
 }
@@ -631,7 +807,7 @@ ret_t widget_set_theme(widget_t* widget, const char* name) {
 ret_t widget_set_pointer_cursor(widget_t* widget, const char* cursor) {
   return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
 
-  widget->pointer_cursor = tk_str_copy(widget->pointer_cursor, cursor);
+  widget->pointer_cursor = widget_atom_copy(widget->pointer_cursor, cursor);
 
   return RET_OK;
 }
@@ -640,7 +816,7 @@ ret_t widget_set_pointer_cursor(widget_t* widget, const char* cursor) {
 ret_t widget_set_animation(widget_t* widget, const char* animation) {
   return_value_if_fail(widget != NULL && animation != NULL, RET_BAD_PARAMS);
 
-  widget->animation = tk_str_copy(widget->animation, animation);
+  widget->animation = widget_atom_copy(widget->animation, animation);
 
   return widget_create_animator(widget, animation);
 }
@@ -822,7 +998,7 @@ ret_t widget_set_state(widget_t* widget, const char* state) {
 
   if (!tk_str_eq(widget->state, state)) {
     widget_invalidate_force(widget, NULL);
-    widget->state = tk_str_copy(widget->state, state);
+    widget->state = widget_atom_copy(widget->state, state);
     widget_set_need_update_style(widget);
     widget_invalidate_force(widget, NULL);
   }
@@ -883,11 +1059,14 @@ const char* widget_get_state_for_style(widget_t* widget, bool_t active, bool_t c
   return state;
 }
 
+static ret_t widget_invalidate_impl(widget_t* widget, const rect_t* r, bool_t keep_layer_cache);
+
 ret_t widget_set_opacity(widget_t* widget, uint8_t opacity) {
   return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
 
   widget->opacity = opacity;
-  widget_invalidate(widget, NULL);
+  /*缓存的位图是按不透明绘制的，绘制缓存时才使用opacity，只需要重绘屏幕上的区域*/
+  widget_invalidate_impl(widget, NULL, TRUE);
 
   return RET_OK;
 }
@@ -901,6 +1080,19 @@ ret_t widget_set_dirty_rect_tolerance(widget_t* widget, uint16_t dirty_rect_tole
   return RET_OK;
 }
 
+ret_t widget_set_cache_as_bitmap(widget_t* widget, bool_t cache_as_bitmap) {
+  return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+
+  widget->cache_as_bitmap = cache_as_bitmap;
+#ifndef WITHOUT_WIDGET_LAYER_CACHE
+  if (!cache_as_bitmap && widget->with_layer_cache) {
+    widget_layer_cache_remove(widget);
+  }
+#endif /*WITHOUT_WIDGET_LAYER_CACHE*/
+
+  return RET_OK;
+}
+
 ret_t widget_destroy_children(widget_t* widget) {
   return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
 
@@ -992,6 +1184,12 @@ ret_t widget_add_child(widget_t* widget, widget_t* child) {
   }
 
   ENSURE(darray_push(widget->children, child) == RET_OK);
+  if (widget->with_spatial_index) {
+    widget_spatial_index_invalidate(widget);
+  }
+#ifndef WITHOUT_WIDGET_NAME_INDEX
+  widget_name_index_on_add_child(widget, child);
+#endif /*WITHOUT_WIDGET_NAME_INDEX*/
 
   if (!widget_is_window_manager(widget)) {
     widget_set_need_relayout_children(widget);
@@ -1010,6 +1208,13 @@ ret_t widget_add_child(widget_t* widget, widget_t* child) {
 ret_t widget_remove_child_prepare(widget_t* widget, widget_t* child) {
   return_value_if_fail(widget != NULL && child != NULL, RET_BAD_PARAMS);
 
+#ifndef WITHOUT_WIDGET_NAME_INDEX
+  widget_name_index_on_remove_child(widget, child);
+#endif /*WITHOUT_WIDGET_NAME_INDEX*/
+  if (widget->with_spatial_index) {
+    widget_spatial_index_invalidate(widget);
+  }
+
   if (!widget_is_window_manager(widget)) {
     widget_set_need_relayout_children(widget);
   }
@@ -1095,6 +1300,9 @@ ret_t widget_restack(widget_t* widget, uint32_t index) {
     }
   }
   children[index] = widget;
+  if (widget->parent->with_spatial_index) {
+    widget_spatial_index_invalidate(widget->parent);
+  }
 
   return RET_OK;
 }
@@ -1102,8 +1310,24 @@ ret_t widget_restack(widget_t* widget, uint32_t index) {
 static widget_t* widget_lookup_child(widget_t* widget, const char* name) {
   return_value_if_fail(widget != NULL && name != NULL, NULL);
 
+  /*控件的名称是原子字符串，没有对应的原子字符串时，肯定没有控件使用这个名称*/
+  name = tk_atom_find(name);
+  if (name == NULL) {
+    return NULL;
+  }
+
+#ifndef WITHOUT_WIDGET_NAME_INDEX
+  if (widget_count_children(widget) >= WIDGET_NAME_INDEX_MIN_CHILDREN) {
+    widget_name_index_t* index = widget_ensure_name_index(widget);
+    if (index != NULL &&
+        widget_name_index_count(index, name) <= WIDGET_NAME_INDEX_MAX_SAME_NAME) {
+      return widget_name_index_find(index, widget, name, FALSE);
+    }
+  }
+#endif /*WITHOUT_WIDGET_NAME_INDEX*/
+
   WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
-  if (iter->name != NULL && tk_str_eq(iter->name, name)) {
+  if (iter->name == name) {
     return iter;
   }
   WIDGET_FOR_EACH_CHILD_END()
@@ -1134,14 +1358,12 @@ widget_t* widget_get_focused_widget(widget_t* widget) {
   return NULL;
 }
 
-static widget_t* widget_lookup_all(widget_t* widget, const char* name) {
-  return_value_if_fail(widget != NULL && name != NULL, NULL);
-
+static widget_t* widget_lookup_all(widget_t* widget, const char* atom) {
   WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
-  if (iter->name != NULL && tk_str_eq(iter->name, name)) {
+  if (iter->name == atom) {
     return iter;
   } else {
-    iter = widget_lookup_all(iter, name);
+    iter = widget_lookup_all(iter, atom);
     if (iter != NULL) {
       return iter;
     }
@@ -1153,7 +1375,25 @@ static widget_t* widget_lookup_all(widget_t* widget, const char* name) {
 
 widget_t* widget_lookup(widget_t* widget, const char* name, bool_t recursive) {
   if (recursive) {
-    return widget_lookup_all(widget, name);
+    const char* atom = NULL;
+    return_value_if_fail(widget != NULL && name != NULL, NULL);
+
+    atom = tk_atom_find(name);
+    if (atom == NULL) {
+      return NULL;
+    }
+
+#ifndef WITHOUT_WIDGET_NAME_INDEX
+    if (widget->children != NULL) {
+      widget_name_index_t* index = widget_ensure_name_index(widget);
+      if (index != NULL &&
+          widget_name_index_count(index, atom) <= WIDGET_NAME_INDEX_MAX_SAME_NAME) {
+        return widget_name_index_find(index, widget, atom, TRUE);
+      }
+    }
+#endif /*WITHOUT_WIDGET_NAME_INDEX*/
+
+    return widget_lookup_all(widget, atom);
   } else {
     return widget_lookup_child(widget, name);
   }
@@ -1718,6 +1958,7 @@ static ret_t widget_paint_impl(widget_t* widget, canvas_t* c) {
   int32_t ox = widget->x;
   int32_t oy = widget->y;
   uint8_t save_alpha = c->global_alpha;
+  PAINT_PROFILER_VAR(start)
 
   if (widget->opacity < TK_OPACITY_ALPHA) {
     canvas_set_global_alpha(c, (widget->opacity * save_alpha) / 0xff);
@@ -1730,10 +1971,18 @@ static ret_t widget_paint_impl(widget_t* widget, canvas_t* c) {
 
   canvas_translate(c, ox, oy);
   widget_on_paint_begin(widget, c);
+  PAINT_PROFILER_BEGIN(start)
   widget_on_paint_background(widget, c);
+  PAINT_PROFILER_END(start, widget, PAINT_PROFILER_BACKGROUND);
+  PAINT_PROFILER_BEGIN(start)
   widget_on_paint_self(widget, c);
+  PAINT_PROFILER_END(start, widget, PAINT_PROFILER_SELF);
+  PAINT_PROFILER_BEGIN(start)
   widget_on_paint_children(widget, c);
+  PAINT_PROFILER_END(start, widget, PAINT_PROFILER_CHILDREN);
+  PAINT_PROFILER_BEGIN(start)
   widget_on_paint_border(widget, c);
+  PAINT_PROFILER_END(start, widget, PAINT_PROFILER_BORDER);
   widget_on_paint_end(widget, c);
 
   canvas_untranslate(c, ox, oy);
@@ -1747,6 +1996,7 @@ static ret_t widget_paint_impl(widget_t* widget, canvas_t* c) {
 }
 
 ret_t widget_paint(widget_t* widget, canvas_t* c) {
+  PAINT_PROFILER_VAR(start)
   return_value_if_fail(widget != NULL && c != NULL, RET_BAD_PARAMS);
 
   if (!widget->visible || widget->opacity <= 0x08 || widget->w <= 0 || widget->h <= 0) {
@@ -1754,15 +2004,25 @@ ret_t widget_paint(widget_t* widget, canvas_t* c) {
     return RET_OK;
   }
 
+  PAINT_PROFILER_BEGIN(start)
   if (widget->need_update_style) {
     widget_update_style(widget);
   }
 
+#ifndef WITHOUT_WIDGET_LAYER_CACHE
+  if (widget->cache_as_bitmap && widget_layer_cache_paint(widget, c) == RET_OK) {
+    widget->dirty = FALSE;
+    PAINT_PROFILER_END(start, widget, PAINT_PROFILER_PAINT);
+    return RET_OK;
+  }
+#endif /*WITHOUT_WIDGET_LAYER_CACHE*/
+
   canvas_save(c);
   widget_paint_impl(widget, c);
   canvas_restore(c);
 
   widget->dirty = FALSE;
+  PAINT_PROFILER_END(start, widget, PAINT_PROFILER_PAINT);
 
   return RET_OK;
 }
@@ -1910,15 +2170,34 @@ static ret_t widget_free_code(void* ctx, event_t* evt) {
   return RET_REMOVE;
 }
 
+static const widget_prop_desc_t* widget_find_prop_desc(widget_t* widget, widget_prop_id_t id) {
+  const widget_prop_desc_t* iter = widget->vt->props;
+
+  if (iter == NULL || id == WIDGET_PROP_ID_NONE) {
+    return NULL;
+  }
+
+  for (; iter->id != WIDGET_PROP_ID_NONE; iter++) {
+    if (iter->id == id) {
+      return iter;
+    }
+  }
+
+  return NULL;
+}
+
 #define STR_ANIMATE_PREFIX "animate."
 #define TK_ANIMATING_TIME 500 /* 单位：毫秒（ms） */
 ret_t widget_set_prop(widget_t* widget, const char* name, const value_t* v) {
   ret_t ret = RET_OK;
   prop_change_event_t e;
+  widget_prop_id_t id = WIDGET_PROP_ID_NONE;
+  const widget_prop_desc_t* desc = NULL;
   return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
   return_value_if_fail(widget->vt != NULL, RET_BAD_PARAMS);
 
-  if (tk_str_eq(name, WIDGET_PROP_EXEC)) {
+  id = widget_prop_id_from_name(name);
+  if (id == WIDGET_PROP_ID_EXEC) {
     ret = widget_exec(widget, value_str(v));
     if (ret != RET_NOT_FOUND) {
       return ret;
@@ -1930,58 +2209,112 @@ ret_t widget_set_prop(widget_t* widget, const char* name, const value_t* v) {
   e.e = event_init(EVT_PROP_WILL_CHANGE, widget);
   widget_dispatch(widget, (event_t*)&e);
 
-  if (tk_str_eq(name, WIDGET_PROP_X)) {
-    widget_set_x(widget, (xy_t)value_int(v), TRUE);
-  } else if (tk_str_eq(name, WIDGET_PROP_Y)) {
-    widget_set_y(widget, (xy_t)value_int(v), TRUE);
-  } else if (tk_str_eq(name, WIDGET_PROP_W)) {
-    widget_set_w(widget, (wh_t)value_int(v), TRUE);
-  } else if (tk_str_eq(name, WIDGET_PROP_H)) {
-    widget_set_h(widget, (wh_t)value_int(v), TRUE);
-  } else if (tk_str_eq(name, WIDGET_PROP_OPACITY)) {
-    widget->opacity = (uint8_t)value_int(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_VISIBLE)) {
-    widget_set_visible(widget, value_bool(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_SENSITIVE)) {
-    widget->sensitive = value_bool(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_FLOATING)) {
-    widget->floating = value_bool(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_FOCUSABLE)) {
-    widget->focusable = value_bool(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_WITH_FOCUS_STATE)) {
-    widget->with_focus_state = value_bool(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_DIRTY_RECT_TOLERANCE)) {
-    widget->dirty_rect_tolerance = value_int(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_STYLE)) {
-    const char* name = value_str(v);
-    return widget_use_style(widget, name);
-  } else if (tk_str_eq(name, WIDGET_PROP_ENABLE)) {
-    widget_set_enable(widget, value_bool(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_FEEDBACK)) {
-    widget->feedback = value_bool(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_AUTO_ADJUST_SIZE)) {
-    widget_set_auto_adjust_size(widget, value_bool(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_NAME)) {
-    widget_set_name(widget, value_str(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_TR_TEXT)) {
-    widget_set_tr_text(widget, value_str(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_ANIMATION)) {
-    widget_set_animation(widget, value_str(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_SELF_LAYOUT)) {
-    widget_set_self_layout(widget, value_str(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_LAYOUT) || tk_str_eq(name, WIDGET_PROP_CHILDREN_LAYOUT)) {
-    widget_set_children_layout(widget, value_str(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_POINTER_CURSOR)) {
-    widget_set_pointer_cursor(widget, value_str(v));
-  } else {
-    ret = RET_NOT_FOUND;
+  switch (id) {
+    case WIDGET_PROP_ID_X: {
+      widget_set_x(widget, (xy_t)value_int(v), TRUE);
+      break;
+    }
+    case WIDGET_PROP_ID_Y: {
+      widget_set_y(widget, (xy_t)value_int(v), TRUE);
+      break;
+    }
+    case WIDGET_PROP_ID_W: {
+      widget_set_w(widget, (wh_t)value_int(v), TRUE);
+      break;
+    }
+    case WIDGET_PROP_ID_H: {
+      widget_set_h(widget, (wh_t)value_int(v), TRUE);
+      break;
+    }
+    case WIDGET_PROP_ID_OPACITY: {
+      widget->opacity = (uint8_t)value_int(v);
+      break;
+    }
+    case WIDGET_PROP_ID_VISIBLE: {
+      widget_set_visible(widget, value_bool(v));
+      break;
+    }
+    case WIDGET_PROP_ID_SENSITIVE: {
+      widget->sensitive = value_bool(v);
+      break;
+    }
+    case WIDGET_PROP_ID_FLOATING: {
+      widget->floating = value_bool(v);
+      break;
+    }
+    case WIDGET_PROP_ID_FOCUSABLE: {
+      widget->focusable = value_bool(v);
+      break;
+    }
+    case WIDGET_PROP_ID_WITH_FOCUS_STATE: {
+      widget->with_focus_state = value_bool(v);
+      break;
+    }
+    case WIDGET_PROP_ID_DIRTY_RECT_TOLERANCE: {
+      widget->dirty_rect_tolerance = value_int(v);
+      break;
+    }
+    case WIDGET_PROP_ID_STYLE: {
+      return widget_use_style(widget, value_str(v));
+    }
+    case WIDGET_PROP_ID_ENABLE: {
+      widget_set_enable(widget, value_bool(v));
+      break;
+    }
+    case WIDGET_PROP_ID_FEEDBACK: {
+      widget->feedback = value_bool(v);
+      break;
+    }
+    case WIDGET_PROP_ID_CACHE_AS_BITMAP: {
+      widget_set_cache_as_bitmap(widget, value_bool(v));
+      break;
+    }
+    case WIDGET_PROP_ID_AUTO_ADJUST_SIZE: {
+      widget_set_auto_adjust_size(widget, value_bool(v));
+      break;
+    }
+    case WIDGET_PROP_ID_NAME: {
+      widget_set_name(widget, value_str(v));
+      break;
+    }
+    case WIDGET_PROP_ID_TR_TEXT: {
+      widget_set_tr_text(widget, value_str(v));
+      break;
+    }
+    case WIDGET_PROP_ID_ANIMATION: {
+      widget_set_animation(widget, value_str(v));
+      break;
+    }
+    case WIDGET_PROP_ID_SELF_LAYOUT: {
+      widget_set_self_layout(widget, value_str(v));
+      break;
+    }
+    case WIDGET_PROP_ID_LAYOUT:
+    case WIDGET_PROP_ID_CHILDREN_LAYOUT: {
+      widget_set_children_layout(widget, value_str(v));
+      break;
+    }
+    case WIDGET_PROP_ID_POINTER_CURSOR: {
+      widget_set_pointer_cursor(widget, value_str(v));
+      break;
+    }
+    default: {
+      ret = RET_NOT_FOUND;
+      break;
+    }
   }
 
-  if (widget->vt->set_prop) {
+  desc = widget_find_prop_desc(widget, id);
+  if (desc != NULL && desc->set != NULL) {
+    ret_t ret1 = desc->set(widget, v);
+    if (ret == RET_NOT_FOUND) {
+      ret = ret1;
+    }
+  } else if (widget->vt->set_prop != NULL || widget->vt->props != NULL) {
     if (tk_str_start_with(name, STR_ANIMATE_PREFIX)) {
       return widget_animate_prop_float_to(widget, name + strlen(STR_ANIMATE_PREFIX),
                                           value_float32(v), TK_ANIMATING_TIME);
-    } else {
+    } else if (widget->vt->set_prop != NULL) {
       ret_t ret1 = widget->vt->set_prop(widget, name, v);
       if (ret == RET_NOT_FOUND) {
         ret = ret1;
@@ -1990,13 +2323,13 @@ ret_t widget_set_prop(widget_t* widget, const char* name, const value_t* v) {
   }
 
   if (ret == RET_NOT_FOUND) {
-    if (tk_str_eq(name, WIDGET_PROP_FOCUSED) || tk_str_eq(name, WIDGET_PROP_FOCUS)) {
+    if (id == WIDGET_PROP_ID_FOCUSED || id == WIDGET_PROP_ID_FOCUS) {
       widget_set_focused(widget, value_bool(v));
       ret = RET_OK;
-    } else if (tk_str_eq(name, WIDGET_PROP_TEXT)) {
+    } else if (id == WIDGET_PROP_ID_TEXT) {
       wstr_from_value(&(widget->text), v);
       ret = RET_OK;
-    } else if (tk_str_eq(name, WIDGET_PROP_EXEC)) {
+    } else if (id == WIDGET_PROP_ID_EXEC) {
       ret = RET_NOT_FOUND;
     } else if (tk_str_start_with(name, "style:") || tk_str_start_with(name, "style.")) {
       return widget_set_style(widget, name + 6, v);
@@ -2005,7 +2338,7 @@ ret_t widget_set_prop(widget_t* widget, const char* name, const value_t* v) {
         widget->custom_props = object_default_create();
       }
 
-      if (tk_str_eq(name, WIDGET_PROP_GRAB_KEYS)) {
+      if (id == WIDGET_PROP_ID_GRAB_KEYS) {
         window_manager_t* wm = WINDOW_MANAGER(widget_get_window_manager(widget));
 
         if (value_bool(v)) {
@@ -2050,83 +2383,138 @@ ret_t widget_set_prop(widget_t* widget, const char* name, const value_t* v) {
 
 ret_t widget_get_prop(widget_t* widget, const char* name, value_t* v) {
   ret_t ret = RET_OK;
+  widget_prop_id_t id = WIDGET_PROP_ID_NONE;
   return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
   return_value_if_fail(widget->vt != NULL, RET_BAD_PARAMS);
 
-  if (tk_str_eq(name, WIDGET_PROP_X)) {
-    value_set_int32(v, widget->x);
-  } else if (tk_str_eq(name, WIDGET_PROP_Y)) {
-    value_set_int32(v, widget->y);
-  } else if (tk_str_eq(name, WIDGET_PROP_W)) {
-    value_set_int32(v, widget->w);
-  } else if (tk_str_eq(name, WIDGET_PROP_H)) {
-    value_set_int32(v, widget->h);
-  } else if (tk_str_eq(name, WIDGET_PROP_OPACITY)) {
-    value_set_int32(v, widget->opacity);
-  } else if (tk_str_eq(name, WIDGET_PROP_VISIBLE)) {
-    value_set_bool(v, widget->visible);
-  } else if (tk_str_eq(name, WIDGET_PROP_SENSITIVE)) {
-    value_set_bool(v, widget->sensitive);
-  } else if (tk_str_eq(name, WIDGET_PROP_FLOATING)) {
-    value_set_bool(v, widget->floating);
-  } else if (tk_str_eq(name, WIDGET_PROP_FOCUSABLE)) {
-    value_set_bool(v, widget_is_focusable(widget));
-  } else if (tk_str_eq(name, WIDGET_PROP_FOCUSED)) {
-    value_set_bool(v, widget->focused);
-  } else if (tk_str_eq(name, WIDGET_PROP_WITH_FOCUS_STATE)) {
-    value_set_bool(v, widget->with_focus_state);
-  } else if (tk_str_eq(name, WIDGET_PROP_DIRTY_RECT_TOLERANCE)) {
-    value_set_int(v, widget->dirty_rect_tolerance);
-  } else if (tk_str_eq(name, WIDGET_PROP_STYLE)) {
-    value_set_str(v, widget->style);
-  } else if (tk_str_eq(name, WIDGET_PROP_ENABLE)) {
-    value_set_bool(v, widget->enable);
-  } else if (tk_str_eq(name, WIDGET_PROP_FEEDBACK)) {
-    value_set_bool(v, widget->feedback);
-  } else if (tk_str_eq(name, WIDGET_PROP_AUTO_ADJUST_SIZE)) {
-    value_set_bool(v, widget->auto_adjust_size);
-  } else if (tk_str_eq(name, WIDGET_PROP_NAME)) {
-    value_set_str(v, widget->name);
-  } else if (tk_str_eq(name, WIDGET_PROP_ANIMATION)) {
-    value_set_str(v, widget->animation);
-  } else if (tk_str_eq(name, WIDGET_PROP_POINTER_CURSOR)) {
-    value_set_str(v, widget->pointer_cursor);
-  } else if (tk_str_eq(name, WIDGET_PROP_SELF_LAYOUT)) {
-    if (widget->self_layout != NULL) {
-      value_set_str(v, self_layouter_to_string(widget->self_layout));
-    } else {
-      ret = RET_NOT_FOUND;
+  id = widget_prop_id_from_name(name);
+  switch (id) {
+    case WIDGET_PROP_ID_X: {
+      value_set_int32(v, widget->x);
+      break;
     }
-  } else if (tk_str_eq(name, WIDGET_PROP_CHILDREN_LAYOUT)) {
-    if (widget->children_layout != NULL) {
-      value_set_str(v, children_layouter_to_string(widget->children_layout));
-    } else {
-      ret = RET_NOT_FOUND;
+    case WIDGET_PROP_ID_Y: {
+      value_set_int32(v, widget->y);
+      break;
     }
-  } else {
-    if (widget->vt->get_prop) {
-      ret = widget->vt->get_prop(widget, name, v);
-    } else {
-      ret = RET_NOT_FOUND;
+    case WIDGET_PROP_ID_W: {
+      value_set_int32(v, widget->w);
+      break;
+    }
+    case WIDGET_PROP_ID_H: {
+      value_set_int32(v, widget->h);
+      break;
+    }
+    case WIDGET_PROP_ID_OPACITY: {
+      value_set_int32(v, widget->opacity);
+      break;
+    }
+    case WIDGET_PROP_ID_VISIBLE: {
+      value_set_bool(v, widget->visible);
+      break;
+    }
+    case WIDGET_PROP_ID_SENSITIVE: {
+      value_set_bool(v, widget->sensitive);
+      break;
+    }
+    case WIDGET_PROP_ID_FLOATING: {
+      value_set_bool(v, widget->floating);
+      break;
+    }
+    case WIDGET_PROP_ID_FOCUSABLE: {
+      value_set_bool(v, widget_is_focusable(widget));
+      break;
+    }
+    case WIDGET_PROP_ID_FOCUSED: {
+      value_set_bool(v, widget->focused);
+      break;
+    }
+    case WIDGET_PROP_ID_WITH_FOCUS_STATE: {
+      value_set_bool(v, widget->with_focus_state);
+      break;
+    }
+    case WIDGET_PROP_ID_DIRTY_RECT_TOLERANCE: {
+      value_set_int(v, widget->dirty_rect_tolerance);
+      break;
+    }
+    case WIDGET_PROP_ID_STYLE: {
+      value_set_str(v, widget->style);
+      break;
+    }
+    case WIDGET_PROP_ID_ENABLE: {
+      value_set_bool(v, widget->enable);
+      break;
+    }
+    case WIDGET_PROP_ID_FEEDBACK: {
+      value_set_bool(v, widget->feedback);
+      break;
+    }
+    case WIDGET_PROP_ID_CACHE_AS_BITMAP: {
+      value_set_bool(v, widget->cache_as_bitmap);
+      break;
+    }
+    case WIDGET_PROP_ID_AUTO_ADJUST_SIZE: {
+      value_set_bool(v, widget->auto_adjust_size);
+      break;
+    }
+    case WIDGET_PROP_ID_NAME: {
+      value_set_str(v, widget->name);
+      break;
+    }
+    case WIDGET_PROP_ID_ANIMATION: {
+      value_set_str(v, widget->animation);
+      break;
+    }
+    case WIDGET_PROP_ID_POINTER_CURSOR: {
+      value_set_str(v, widget->pointer_cursor);
+      break;
+    }
+    case WIDGET_PROP_ID_SELF_LAYOUT: {
+      if (widget->self_layout != NULL) {
+        value_set_str(v, self_layouter_to_string(widget->self_layout));
+      } else {
+        ret = RET_NOT_FOUND;
+      }
+      break;
+    }
+    case WIDGET_PROP_ID_CHILDREN_LAYOUT: {
+      if (widget->children_layout != NULL) {
+        value_set_str(v, children_layouter_to_string(widget->children_layout));
+      } else {
+        ret = RET_NOT_FOUND;
+      }
+      break;
+    }
+    default: {
+      const widget_prop_desc_t* desc = widget_find_prop_desc(widget, id);
+
+      if (desc != NULL && desc->get != NULL) {
+        ret = desc->get(widget, v);
+      } else if (widget->vt->get_prop) {
+        ret = widget->vt->get_prop(widget, name, v);
+      } else {
+        ret = RET_NOT_FOUND;
+      }
+      break;
     }
   }
 
   /*default*/
   if (ret == RET_NOT_FOUND) {
-    if (tk_str_eq(name, WIDGET_PROP_LAYOUT_W)) {
+    if (id == WIDGET_PROP_ID_LAYOUT_W) {
       value_set_int32(v, widget->w);
       ret = RET_OK;
-    } else if (tk_str_eq(name, WIDGET_PROP_LAYOUT_H)) {
+    } else if (id == WIDGET_PROP_ID_LAYOUT_H) {
       value_set_int32(v, widget->h);
       ret = RET_OK;
-    } else if (tk_str_eq(name, WIDGET_PROP_TEXT)) {
+    } else if (id == WIDGET_PROP_ID_TEXT) {
       wchar_t* text = widget->text.str;
       if (text != NULL) {
         text[widget->text.size] = 0;
       }
       value_set_wstr(v, text);
       ret = RET_OK;
-    } else if (tk_str_eq(name, WIDGET_PROP_STATE_FOR_STYLE)) {
+    } else if (id == WIDGET_PROP_ID_STATE_FOR_STYLE) {
       value_set_str(v, widget_get_state_for_style(widget, FALSE, FALSE));
       ret = RET_OK;
     }
@@ -2139,7 +2527,7 @@ ret_t widget_get_prop(widget_t* widget, const char* name, value_t* v) {
   }
 
   if (ret == RET_NOT_FOUND) {
-    if (tk_str_eq(name, WIDGET_PROP_TYPE)) {
+    if (id == WIDGET_PROP_ID_TYPE) {
       value_set_str(v, widget->vt->type);
       ret = RET_OK;
     }
@@ -3234,6 +3622,23 @@ static ret_t widget_destroy_sync(widget_t* widget) {
     widget->emitter = NULL;
   }
 
+#ifndef WITHOUT_WIDGET_NAME_INDEX
+  /*窗口销毁时不需要逐个维护索引*/
+  if (widget_is_window(widget)) {
+    widget_drop_name_index(widget, TRUE);
+  }
+#endif /*WITHOUT_WIDGET_NAME_INDEX*/
+
+  if (widget->with_spatial_index) {
+    widget_spatial_index_remove(widget);
+  }
+
+#ifndef WITHOUT_WIDGET_LAYER_CACHE
+  if (widget->with_layer_cache) {
+    widget_layer_cache_remove(widget);
+  }
+#endif /*WITHOUT_WIDGET_LAYER_CACHE*/
+
   if (widget->children != NULL) {
     widget_destroy_children(widget);
     darray_destroy(widget->children);
@@ -3303,10 +3708,17 @@ static ret_t widget_set_parent_not_dirty(widget_t* widget) {
   return RET_OK;
 }
 
-ret_t widget_invalidate(widget_t* widget, const rect_t* r) {
+static ret_t widget_invalidate_impl(widget_t* widget, const rect_t* r, bool_t keep_layer_cache) {
   rect_t rself;
   return_value_if_fail(widget != NULL && widget->vt != NULL, RET_BAD_PARAMS);
 
+#ifndef WITHOUT_WIDGET_LAYER_CACHE
+  /*子控件已经标记为dirty时也要通知，缓存可能是在它变化之后才更新的*/
+  widget_layer_cache_invalidate(keep_layer_cache ? widget->parent : widget);
+#else
+  (void)keep_layer_cache;
+#endif /*WITHOUT_WIDGET_LAYER_CACHE*/
+
   if (widget->dirty) {
     return RET_OK;
   }
@@ -3326,6 +3738,10 @@ ret_t widget_invalidate(widget_t* widget, const rect_t* r) {
   }
 }
 
+ret_t widget_invalidate(widget_t* widget, const rect_t* r) {
+  return widget_invalidate_impl(widget, r, FALSE);
+}
+
 ret_t widget_invalidate_force(widget_t* widget, const rect_t* r) {
   return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
 
@@ -3353,7 +3769,7 @@ widget_t* widget_init(widget_t* widget, widget_t* parent, const widget_vtable_t*
   widget->emitter = NULL;
   widget->children = NULL;
   widget->initializing = TRUE;
-  widget->state = tk_strdup(WIDGET_STATE_NORMAL);
+  widget->state = tk_atom(WIDGET_STATE_NORMAL);
   widget->target = NULL;
   widget->key_target = NULL;
   widget->grab_widget = NULL;
@@ -3436,6 +3852,8 @@ ret_t widget_get_prop_default_value(widget_t* widget, const char* name, value_t*
     value_set_bool(v, FALSE);
   } else if (tk_str_eq(name, WIDGET_PROP_AUTO_ADJUST_SIZE)) {
     value_set_bool(v, FALSE);
+  } else if (tk_str_eq(name, WIDGET_PROP_CACHE_AS_BITMAP)) {
+    value_set_bool(v, FALSE);
   } else {
     if (widget->vt->get_prop_default_value) {
       ret = widget->vt->get_prop_default_value(widget, name, v);
@@ -3592,6 +4010,7 @@ static const char* const s_widget_persistent_props[] = {WIDGET_PROP_NAME,
                                                         WIDGET_PROP_FOCUSABLE,
                                                         WIDGET_PROP_SENSITIVE,
                                                         WIDGET_PROP_WITH_FOCUS_STATE,
+                                                        WIDGET_PROP_CACHE_AS_BITMAP,
                                                         NULL};
 
 const char* const* widget_get_persistent_props(void) {
@@ -3599,9 +4018,19 @@ const char* const* widget_get_persistent_props(void) {
 }
 
 static ret_t widget_copy_base_props(widget_t* widget, widget_t* other) {
-  widget->state = tk_str_copy(widget->state, other->state);
-  widget->name = tk_str_copy(widget->name, other->name);
-  widget->style = tk_str_copy(widget->style, other->style);
+  const char* old_name = widget->name;
+
+  tk_atom_unref(widget->state);
+  tk_atom_unref(widget->name);
+  tk_atom_unref(widget->style);
+  widget->state = tk_atom_ref(other->state);
+  widget->name = tk_atom_ref(other->name);
+  widget->style = tk_atom_ref(other->style);
+#ifndef WITHOUT_WIDGET_NAME_INDEX
+  if (widget->name != old_name) {
+    widget_name_index_on_rename(widget, old_name);
+  }
+#endif /*WITHOUT_WIDGET_NAME_INDEX*/
 
   if (other->text.str != NULL) {
     widget_set_text(widget, other->text.str);
@@ -3622,6 +4051,7 @@ static ret_t widget_copy_base_props(widget_t* widget, widget_t* other) {
   widget->auto_created = other->auto_created;
   widget->with_focus_state = other->with_focus_state;
   widget->dirty_rect_tolerance = other->dirty_rect_tolerance;
+  widget->cache_as_bitmap = other->cache_as_bitmap;
 
   if (other->animation != NULL && *(other->animation)) {
     widget_set_animation(widget, other->animation);
@@ -43,6 +43,7 @@
 #include "base/locale_info.h"
 #include "base/image_manager.h"
 #include "base/widget_consts.h"
+#include "base/widget_prop_ids.h"
 #include "base/self_layouter.h"
 #include "base/widget_animator.h"
 #include "base/children_layouter.h"
@@ -92,6 +93,19 @@ typedef struct _widget_cmd_t {
   widget_exec_t exec;
 } widget_cmd_t;
 
+typedef ret_t (*widget_prop_get_t)(widget_t* widget, value_t* v);
+typedef ret_t (*widget_prop_set_t)(widget_t* widget, const value_t* v);
+
+/*
+ * 控件属性的描述，id为WIDGET_PROP_ID_*。get/set为NULL表示不支持读/写。
+ * 数组以id为WIDGET_PROP_ID_NONE的项结束。
+ */
+typedef struct _widget_prop_desc_t {
+  widget_prop_id_t id;
+  widget_prop_get_t get;
+  widget_prop_set_t set;
+} widget_prop_desc_t;
+
 struct _widget_vtable_t {
   uint32_t size;
   const char* type;
@@ -154,6 +168,12 @@ struct _widget_vtable_t {
    */
   uint32_t allow_draw_outside : 1;
 
+  /**
+   * 绘制时是否会修改控件的状态(如在on\_paint中布局)，有这样的控件时不能多线程绘制。
+   * 子类的vtable没有设置时，使用父类的设置。
+   */
+  uint32_t disallow_parallel_paint : 1;
+
   /**
    * parent class vtable
    */
@@ -162,6 +182,13 @@ struct _widget_vtable_t {
    * cursor image name
    */
   const char* pointer_cursor;
+  /**
+   * 内置属性(WIDGET\_PROP\_*)的描述。
+   *
+   * widget\_get\_prop/widget\_set\_prop按属性ID直接调用其中的get/set，找不到时再调用get\_prop/set\_prop。
+   * 只查找本vtable的描述，子类的get\_prop/set\_prop直接调用父类的函数时，父类不要使用描述。
+   */
+  const widget_prop_desc_t* props;
 
   widget_create_t create;
   widget_get_prop_t get_prop;
@@ -261,6 +288,9 @@ struct _widget_vtable_t {
  *  widget_on(button, EVT_CLICK, on_click, NULL);
  * ```
  *
+ * > name、style、state、tr\_text、animation和pointer\_cursor是原子字符串(参考tk\_atom)，
+ * 只能通过对应的函数设置，不能直接修改或释放。
+ *
  */
 struct _widget_t {
   /**
@@ -292,31 +322,31 @@ struct _widget_t {
    * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
    * 控件名字。
    */
-  char* name;
+  const char* name;
   /**
    * @property {char*} pointer_cursor
    * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
    * 鼠标光标图片名称。
    */
-  char* pointer_cursor;
+  const char* pointer_cursor;
   /**
    * @property {char*} tr_text
    * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
    * 保存用于翻译的字符串。
    */
-  char* tr_text;
+  const char* tr_text;
   /**
    * @property {char*} style
    * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
    * style的名称。
    */
-  char* style;
+  const char* style;
   /**
    * @property {char*} animation
    * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
    * 动画参数。请参考[控件动画](https://github.com/zlgopen/awtk/blob/master/docs/widget_animator.md)
    */
-  char* animation;
+  const char* animation;
   /**
    * @property {bool_t} enable
    * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
@@ -366,6 +396,15 @@ struct _widget_t {
    */
   uint8_t auto_adjust_size : 1;
 
+  /**
+   * @property {bool_t} cache_as_bitmap
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 是否把控件(包括子控件)绘制到位图中缓存起来，没有变化时直接绘制缓存的位图。
+   *
+   *> 适用于复杂但很少变化的控件(如图表的背景、仪表的表盘)。缓存占用的内存请参考TK\_WIDGET\_LAYER\_CACHE\_MAX\_SIZE。
+   */
+  uint8_t cache_as_bitmap : 1;
+
   /**
    * @property {bool_t} focused
    * @annotation ["readable"]
@@ -421,12 +460,24 @@ struct _widget_t {
    * 标识控件正在被销毁。
    */
   uint8_t destroying : 1;
+  /**
+   * @property {bool_t} with_spatial_index
+   * @annotation ["readable"]
+   * 标识子控件已经建立空间索引(子控件很多时自动建立，参考widget\_spatial\_index\_t)。
+   */
+  uint8_t with_spatial_index : 1;
+  /**
+   * @property {bool_t} with_layer_cache
+   * @annotation ["readable"]
+   * 标识控件有缓存的位图(参考widget\_layer\_cache\_t)。
+   */
+  uint8_t with_layer_cache : 1;
   /**
    * @property {uint8_t} state
    * @annotation ["readable"]
    * 控件的状态(取值参考widget_state_t)。
    */
-  char* state;
+  const char* state;
   /**
    * @property {uint8_t} opacity
    * @annotation ["readable"]
@@ -1433,6 +1484,18 @@ ret_t widget_set_opacity(widget_t* widget, uint8_t opacity);
  */
 ret_t widget_set_dirty_rect_tolerance(widget_t* widget, uint16_t dirty_rect_tolerance);
 
+/**
+ * @method widget_set_cache_as_bitmap
+ * 设置是否把控件(包括子控件)缓存到位图中。
+ *
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget 控件对象。
+ * @param {bool_t} cache_as_bitmap 是否缓存到位图中。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_set_cache_as_bitmap(widget_t* widget, bool_t cache_as_bitmap);
+
 /**
  * @method widget_destroy_children
  * 销毁全部子控件。
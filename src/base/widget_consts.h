@@ -137,6 +137,12 @@ BEGIN_C_DECLS
  */
 #define WIDGET_PROP_DIRTY_RECT_TOLERANCE "dirty_rect_tolerance"
 
+/**
+ * @const WIDGET_PROP_CACHE_AS_BITMAP
+ * 是否把控件(包括子控件)缓存到位图中。
+ */
+#define WIDGET_PROP_CACHE_AS_BITMAP "cache_as_bitmap"
+
 /**
  * @const WIDGET_PROP_BIDI
  * bidi type(rtl,ltr,auto,wrtl,wltr,lro,rlo)。
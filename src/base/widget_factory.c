@@ -19,10 +19,65 @@
  *
  */
 
+#include "tkc/atom.h"
 #include "base/widget_factory.h"
 
 static widget_factory_t* s_widget_factory = NULL;
 
+/*
+ * 类型名为原子字符串时(比如ui_builder_default)，按地址缓存创建函数，不需要二分查找。
+ * 缓存持有原子字符串的引用，保证地址不会被其它字符串重用。
+ */
+#define WIDGET_FACTORY_CACHE_NR 32
+
+typedef struct _widget_factory_cache_item_t {
+  widget_factory_t* factory;
+  const char* type;
+  widget_create_t create;
+} widget_factory_cache_item_t;
+
+static widget_factory_cache_item_t s_widget_factory_cache[WIDGET_FACTORY_CACHE_NR];
+
+static widget_factory_cache_item_t* widget_factory_cache_item(const char* type) {
+  uintptr_t addr = (uintptr_t)type;
+
+  return s_widget_factory_cache + ((addr ^ (addr >> 7)) % WIDGET_FACTORY_CACHE_NR);
+}
+
+static ret_t widget_factory_cache_clear(widget_factory_t* factory) {
+  uint32_t i = 0;
+
+  for (i = 0; i < WIDGET_FACTORY_CACHE_NR; i++) {
+    widget_factory_cache_item_t* item = s_widget_factory_cache + i;
+
+    if (item->factory == factory) {
+      tk_atom_unref(item->type);
+      memset(item, 0x00, sizeof(*item));
+    }
+  }
+
+  return RET_OK;
+}
+
+static widget_create_t widget_factory_find(widget_factory_t* factory, const char* type) {
+  widget_create_t create = NULL;
+  widget_factory_cache_item_t* item = widget_factory_cache_item(type);
+
+  if (item->type == type && item->factory == factory) {
+    return item->create;
+  }
+
+  create = (widget_create_t)general_factory_find(factory, type);
+  if (create != NULL && tk_atom_find(type) == type) {
+    tk_atom_unref(item->type);
+    item->factory = factory;
+    item->type = tk_atom_ref(type);
+    item->create = create;
+  }
+
+  return create;
+}
+
 widget_factory_t* widget_factory(void) {
   return s_widget_factory;
 }
@@ -34,11 +89,13 @@ widget_factory_t* widget_factory_create(void) {
 ret_t widget_factory_register(widget_factory_t* factory, const char* type, widget_create_t create) {
   return_value_if_fail(factory != NULL && type != NULL && create != NULL, RET_BAD_PARAMS);
 
+  widget_factory_cache_clear(factory);
   return general_factory_register(factory, type, (tk_create_t)create);
 }
 
 ret_t widget_factory_register_multi(widget_factory_t* factory,
                                     const general_factory_table_t* table) {
+  widget_factory_cache_clear(factory);
   return general_factory_register_table(factory, table);
 }
 
@@ -47,7 +104,7 @@ widget_t* widget_factory_create_widget(widget_factory_t* factory, const char* ty
   widget_create_t create = NULL;
   return_value_if_fail(factory != NULL && type != NULL, NULL);
 
-  create = (widget_create_t)general_factory_find(factory, type);
+  create = widget_factory_find(factory, type);
   return_value_if_fail(create != NULL, NULL);
 
   return create(parent, x, y, w, h);
@@ -63,5 +120,7 @@ ret_t widget_factory_destroy(widget_factory_t* factory) {
   if (s_widget_factory == factory) {
     s_widget_factory = NULL;
   }
+  widget_factory_cache_clear(factory);
+
   return general_factory_destroy(factory);
 }
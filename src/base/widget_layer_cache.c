@@ -0,0 +1,322 @@
+﻿/**
+ * File:   widget_layer_cache.c
+ * Author: AWTK Develop Team
+ * Brief:  cache widgets (and their children) as bitmaps
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "base/canvas_offline.h"
+#include "base/parallel_paint.h"
+#include "base/widget_layer_cache.h"
+
+#if defined(WITH_GPU) || !defined(WITH_BITMAP_BGRA)
+#define WIDGET_LAYER_CACHE_FORMAT BITMAP_FMT_RGBA8888
+#else
+#define WIDGET_LAYER_CACHE_FORMAT BITMAP_FMT_BGRA8888
+#endif /*WITH_GPU*/
+
+typedef struct _widget_layer_cache_entry_t {
+  struct _widget_layer_cache_entry_t* prev;
+  struct _widget_layer_cache_entry_t* next;
+  widget_t* widget;
+  canvas_t* canvas;
+  uint32_t size;
+  bool_t valid;
+  bool_t painting;
+} widget_layer_cache_entry_t;
+
+/*按最近使用的顺序排列，head最近使用，tail最久没有使用*/
+static widget_layer_cache_entry_t* s_head = NULL;
+static widget_layer_cache_entry_t* s_tail = NULL;
+static uint32_t s_size = 0;
+static uint32_t s_max_size = TK_WIDGET_LAYER_CACHE_MAX_SIZE;
+
+static widget_layer_cache_entry_t* widget_layer_cache_find(widget_t* widget) {
+  widget_layer_cache_entry_t* iter = NULL;
+
+  if (!widget->with_layer_cache) {
+    return NULL;
+  }
+
+  for (iter = s_head; iter != NULL; iter = iter->next) {
+    if (iter->widget == widget) {
+      return iter;
+    }
+  }
+
+  return NULL;
+}
+
+static ret_t widget_layer_cache_unlink(widget_layer_cache_entry_t* entry) {
+  if (entry->prev != NULL) {
+    entry->prev->next = entry->next;
+  } else {
+    s_head = entry->next;
+  }
+
+  if (entry->next != NULL) {
+    entry->next->prev = entry->prev;
+  } else {
+    s_tail = entry->prev;
+  }
+  entry->prev = NULL;
+  entry->next = NULL;
+
+  return RET_OK;
+}
+
+static ret_t widget_layer_cache_link_head(widget_layer_cache_entry_t* entry) {
+  entry->prev = NULL;
+  entry->next = s_head;
+  if (s_head != NULL) {
+    s_head->prev = entry;
+  } else {
+    s_tail = entry;
+  }
+  s_head = entry;
+
+  return RET_OK;
+}
+
+static ret_t widget_layer_cache_release_canvas(widget_layer_cache_entry_t* entry) {
+  if (entry->canvas != NULL) {
+    canvas_offline_destroy(entry->canvas);
+    entry->canvas = NULL;
+    s_size -= entry->size;
+    entry->size = 0;
+  }
+  entry->valid = FALSE;
+
+  return RET_OK;
+}
+
+static ret_t widget_layer_cache_destroy_entry(widget_layer_cache_entry_t* entry) {
+  widget_layer_cache_release_canvas(entry);
+  widget_layer_cache_unlink(entry);
+  entry->widget->with_layer_cache = FALSE;
+  TKMEM_FREE(entry);
+
+  return RET_OK;
+}
+
+/*淘汰最久没有使用的缓存，直到可以再放入size字节(不淘汰keep)*/
+static bool_t widget_layer_cache_reserve(uint32_t size, widget_layer_cache_entry_t* keep) {
+  widget_layer_cache_entry_t* iter = s_tail;
+
+  while (iter != NULL && s_size + size > s_max_size) {
+    widget_layer_cache_entry_t* prev = iter->prev;
+
+    if (iter != keep && !iter->painting) {
+      widget_layer_cache_destroy_entry(iter);
+    }
+    iter = prev;
+  }
+
+  return s_size + size <= s_max_size;
+}
+
+static ret_t widget_layer_cache_check_draw_outside(void* ctx, const void* data) {
+  widget_t* widget = WIDGET(data);
+
+  if (widget->vt->allow_draw_outside) {
+    *(bool_t*)ctx = FALSE;
+    return RET_STOP;
+  }
+
+  return RET_OK;
+}
+
+static bool_t widget_layer_cache_is_cacheable(widget_t* widget) {
+  bool_t cacheable = TRUE;
+
+  widget_foreach(widget, widget_layer_cache_check_draw_outside, &cacheable);
+
+  return cacheable;
+}
+
+static ret_t widget_layer_cache_render(widget_layer_cache_entry_t* entry, int32_t tolerance) {
+  widget_t* widget = entry->widget;
+  canvas_t* c = entry->canvas;
+  uint8_t opacity = widget->opacity;
+  xy_t dx = tolerance - widget->x;
+  xy_t dy = tolerance - widget->y;
+
+  /*绘制过程中控件再调用widget_invalidate，说明下次需要重新绘制*/
+  entry->valid = TRUE;
+  entry->painting = TRUE;
+
+  canvas_offline_begin_draw(c);
+  canvas_offline_clear_canvas(c);
+  canvas_translate(c, dx, dy);
+  widget->opacity = 0xff;
+  widget_paint(widget, c);
+  widget->opacity = opacity;
+  canvas_untranslate(c, dx, dy);
+  canvas_offline_end_draw(c);
+
+  entry->painting = FALSE;
+
+  return RET_OK;
+}
+
+static widget_layer_cache_entry_t* widget_layer_cache_update(widget_layer_cache_entry_t* entry,
+                                                             widget_t* widget, int32_t tolerance) {
+  uint32_t w = widget->w + 2 * tolerance;
+  uint32_t h = widget->h + 2 * tolerance;
+  uint32_t size = w * h * bitmap_get_bpp_of_format(WIDGET_LAYER_CACHE_FORMAT);
+
+  if (!widget_layer_cache_is_cacheable(widget) || size > s_max_size) {
+    if (entry != NULL) {
+      widget_layer_cache_destroy_entry(entry);
+    }
+    return NULL;
+  }
+
+  if (entry == NULL) {
+    entry = TKMEM_ZALLOC(widget_layer_cache_entry_t);
+    return_value_if_fail(entry != NULL, NULL);
+
+    entry->widget = widget;
+    widget->with_layer_cache = TRUE;
+    widget_layer_cache_link_head(entry);
+  }
+
+  /*控件的大小改变了*/
+  if (entry->canvas != NULL) {
+    bitmap_t* bitmap = canvas_offline_get_bitmap(entry->canvas);
+    float_t ratio = entry->canvas->lcd->ratio;
+
+    if (bitmap->w != (wh_t)(w * ratio) || bitmap->h != (wh_t)(h * ratio)) {
+      widget_layer_cache_release_canvas(entry);
+    }
+  }
+
+  if (entry->canvas == NULL) {
+    bitmap_t* bitmap = NULL;
+
+    if (widget_layer_cache_reserve(size, entry)) {
+      entry->canvas = canvas_offline_create(w, h, WIDGET_LAYER_CACHE_FORMAT);
+    }
+
+    if (entry->canvas == NULL) {
+      widget_layer_cache_destroy_entry(entry);
+      return NULL;
+    }
+
+    bitmap = canvas_offline_get_bitmap(entry->canvas);
+    entry->size = bitmap->line_length * bitmap->h;
+    s_size += entry->size;
+    widget_layer_cache_reserve(0, entry);
+  }
+
+  widget_layer_cache_render(entry, tolerance);
+
+  return entry;
+}
+
+ret_t widget_layer_cache_paint(widget_t* widget, canvas_t* c) {
+  rect_t src;
+  rect_t dst;
+  bitmap_t* bitmap = NULL;
+  uint8_t save_alpha = 0;
+  widget_layer_cache_entry_t* entry = NULL;
+  int32_t tolerance = 0;
+  return_value_if_fail(widget != NULL && c != NULL, RET_BAD_PARAMS);
+
+  entry = widget_layer_cache_find(widget);
+  if (entry != NULL && entry->painting) {
+    /*正在绘制到缓存中*/
+    return RET_NOT_IMPL;
+  }
+
+  tolerance = widget->dirty_rect_tolerance;
+  if (parallel_paint_is_busy()) {
+    /*多线程并行绘制时只使用有效的缓存，不更新缓存，也不调整淘汰顺序*/
+    if (entry == NULL || !entry->valid) {
+      return RET_NOT_IMPL;
+    }
+  } else if (entry == NULL || !entry->valid) {
+    entry = widget_layer_cache_update(entry, widget, tolerance);
+    if (entry == NULL) {
+      return RET_NOT_IMPL;
+    }
+  }
+
+  if (entry != s_head && !parallel_paint_is_busy()) {
+    widget_layer_cache_unlink(entry);
+    widget_layer_cache_link_head(entry);
+  }
+
+  bitmap = canvas_offline_get_bitmap(entry->canvas);
+  src = rect_init(0, 0, bitmap->w, bitmap->h);
+  dst = rect_init(widget->x - tolerance, widget->y - tolerance, widget->w + 2 * tolerance,
+                  widget->h + 2 * tolerance);
+
+  save_alpha = c->global_alpha;
+  if (widget->opacity < TK_OPACITY_ALPHA) {
+    canvas_set_global_alpha(c, (widget->opacity * save_alpha) / 0xff);
+  }
+  canvas_draw_image(c, bitmap, &src, &dst);
+  canvas_set_global_alpha(c, save_alpha);
+
+  return RET_OK;
+}
+
+ret_t widget_layer_cache_invalidate(widget_t* widget) {
+  widget_t* iter = widget;
+
+  if (s_head == NULL) {
+    return RET_OK;
+  }
+
+  while (iter != NULL) {
+    if (iter->with_layer_cache) {
+      widget_layer_cache_entry_t* entry = widget_layer_cache_find(iter);
+
+      if (entry != NULL) {
+        entry->valid = FALSE;
+      }
+    }
+    iter = iter->parent;
+  }
+
+  return RET_OK;
+}
+
+ret_t widget_layer_cache_remove(widget_t* widget) {
+  widget_layer_cache_entry_t* entry = NULL;
+  return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+
+  entry = widget_layer_cache_find(widget);
+  if (entry != NULL) {
+    widget_layer_cache_destroy_entry(entry);
+  }
+
+  return RET_OK;
+}
+
+ret_t widget_layer_cache_set_max_size(uint32_t max_size) {
+  s_max_size = max_size;
+  widget_layer_cache_reserve(0, NULL);
+
+  return RET_OK;
+}
+
+uint32_t widget_layer_cache_get_size(void) {
+  return s_size;
+}
@@ -0,0 +1,90 @@
+﻿/**
+ * File:   widget_layer_cache.h
+ * Author: AWTK Develop Team
+ * Brief:  cache widgets (and their children) as bitmaps
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_WIDGET_LAYER_CACHE_H
+#define TK_WIDGET_LAYER_CACHE_H
+
+#include "base/widget.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class widget_layer_cache_t
+ * 控件的位图缓存。
+ *
+ * cache\_as\_bitmap为TRUE的控件，第一次绘制时用离线画布(canvas\_offline)把控件和子控件绘制到位图中，
+ * 之后直接绘制缓存的位图，直到控件或子控件调用widget\_invalidate。
+ *
+ * * 缓存的区域包括dirty\_rect\_tolerance。控件或子控件允许在自身范围外绘制(allow\_draw\_outside)时不缓存。
+ * * 缓存时不包括控件自身的opacity，绘制位图时再使用，修改opacity不影响缓存的内容。
+ * * 全部位图占用的内存不超过TK\_WIDGET\_LAYER\_CACHE\_MAX\_SIZE，超过时淘汰最久没有使用的。
+ * * 无法创建离线画布时(如没有原生窗口)，照常绘制控件。
+ * * 多线程并行绘制时只绘制已经有效的缓存，不创建或更新缓存(照常绘制控件)。
+ */
+
+/**
+ * @method widget_layer_cache_paint
+ * 用缓存的位图绘制控件(缓存失效时先更新缓存)。
+ * @param {widget_t*} widget 控件。
+ * @param {canvas_t*} c 画布。
+ *
+ * @return {ret_t} 返回RET_OK表示已经绘制，否则调用者需要照常绘制控件。
+ */
+ret_t widget_layer_cache_paint(widget_t* widget, canvas_t* c);
+
+/**
+ * @method widget_layer_cache_invalidate
+ * 控件需要重绘时调用，标记控件自身和父控件的缓存失效。
+ * @param {widget_t*} widget 控件。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_layer_cache_invalidate(widget_t* widget);
+
+/**
+ * @method widget_layer_cache_remove
+ * 删除控件的缓存(控件销毁或者不再缓存时调用)。
+ * @param {widget_t*} widget 控件。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_layer_cache_remove(widget_t* widget);
+
+/**
+ * @method widget_layer_cache_set_max_size
+ * 设置全部缓存位图占用内存的上限(会立即淘汰超出的部分)。
+ * @param {uint32_t} max_size 上限(字节)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_layer_cache_set_max_size(uint32_t max_size);
+
+/**
+ * @method widget_layer_cache_get_size
+ * 获取全部缓存位图占用的内存。
+ *
+ * @return {uint32_t} 返回占用的内存(字节)。
+ */
+uint32_t widget_layer_cache_get_size(void);
+
+END_C_DECLS
+
+#endif /*TK_WIDGET_LAYER_CACHE_H*/
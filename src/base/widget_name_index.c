@@ -0,0 +1,297 @@
+﻿/**
+ * File:   widget_name_index.c
+ * Author: AWTK Develop Team
+ * Brief:  index widgets of a window by name
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "base/widget_name_index.h"
+
+#define WIDGET_NAME_INDEX_MIN_CAPACITY 32
+
+typedef struct _widget_name_entry_t {
+  struct _widget_name_entry_t* next;
+  const char* name;
+  widget_t* widget;
+} widget_name_entry_t;
+
+struct _widget_name_index_t {
+  widget_name_entry_t** buckets;
+  uint32_t capacity;
+  uint32_t size;
+};
+
+static uint32_t s_widget_name_index_count = 0;
+
+/*名称是原子字符串，直接用地址计算哈希值*/
+static uint32_t widget_name_index_hash(const char* name) {
+  uint32_t h = (uint32_t)((uintptr_t)name >> 3);
+
+  h ^= h >> 16;
+  h *= 0x45d9f3bu;
+  h ^= h >> 16;
+
+  return h;
+}
+
+static widget_name_entry_t** widget_name_index_bucket(widget_name_index_t* index,
+                                                      const char* name) {
+  return index->buckets + (widget_name_index_hash(name) & (index->capacity - 1));
+}
+
+static ret_t widget_name_index_rehash(widget_name_index_t* index, uint32_t capacity) {
+  uint32_t i = 0;
+  widget_name_entry_t** buckets = TKMEM_ZALLOCN(widget_name_entry_t*, capacity);
+  return_value_if_fail(buckets != NULL, RET_OOM);
+
+  for (i = 0; i < index->capacity; i++) {
+    widget_name_entry_t* iter = index->buckets[i];
+
+    while (iter != NULL) {
+      widget_name_entry_t* next = iter->next;
+      widget_name_entry_t** head =
+          buckets + (widget_name_index_hash(iter->name) & (capacity - 1));
+
+      iter->next = *head;
+      *head = iter;
+      iter = next;
+    }
+  }
+
+  TKMEM_FREE(index->buckets);
+  index->buckets = buckets;
+  index->capacity = capacity;
+
+  return RET_OK;
+}
+
+widget_name_index_t* widget_name_index_create(void) {
+  widget_name_index_t* index = TKMEM_ZALLOC(widget_name_index_t);
+  return_value_if_fail(index != NULL, NULL);
+
+  index->buckets = TKMEM_ZALLOCN(widget_name_entry_t*, WIDGET_NAME_INDEX_MIN_CAPACITY);
+  if (index->buckets == NULL) {
+    TKMEM_FREE(index);
+    return NULL;
+  }
+  index->capacity = WIDGET_NAME_INDEX_MIN_CAPACITY;
+  s_widget_name_index_count++;
+
+  return index;
+}
+
+ret_t widget_name_index_add(widget_name_index_t* index, widget_t* widget) {
+  widget_name_entry_t* iter = NULL;
+  widget_name_entry_t** head = NULL;
+  return_value_if_fail(index != NULL && widget != NULL, RET_BAD_PARAMS);
+
+  if (widget->name == NULL) {
+    return RET_OK;
+  }
+
+  head = widget_name_index_bucket(index, widget->name);
+  for (iter = *head; iter != NULL; iter = iter->next) {
+    if (iter->widget == widget && iter->name == widget->name) {
+      return RET_OK;
+    }
+  }
+
+  iter = TKMEM_ZALLOC(widget_name_entry_t);
+  return_value_if_fail(iter != NULL, RET_OOM);
+
+  iter->name = widget->name;
+  iter->widget = widget;
+  iter->next = *head;
+  *head = iter;
+  index->size++;
+
+  if (index->size > index->capacity) {
+    widget_name_index_rehash(index, index->capacity << 1);
+  }
+
+  return RET_OK;
+}
+
+ret_t widget_name_index_remove(widget_name_index_t* index, widget_t* widget, const char* name) {
+  widget_name_entry_t* iter = NULL;
+  widget_name_entry_t** prev = NULL;
+  return_value_if_fail(index != NULL && widget != NULL, RET_BAD_PARAMS);
+
+  if (name == NULL) {
+    return RET_OK;
+  }
+
+  prev = widget_name_index_bucket(index, name);
+  for (iter = *prev; iter != NULL; prev = &(iter->next), iter = iter->next) {
+    if (iter->widget == widget && iter->name == name) {
+      *prev = iter->next;
+      index->size--;
+      TKMEM_FREE(iter);
+
+      return RET_OK;
+    }
+  }
+
+  return RET_NOT_FOUND;
+}
+
+static uint32_t widget_depth(widget_t* widget) {
+  uint32_t depth = 0;
+
+  while (widget->parent != NULL) {
+    depth++;
+    widget = widget->parent;
+  }
+
+  return depth;
+}
+
+/*a和b是parent的子控件，只遍历一次子控件，先遇到的排在前面*/
+static bool_t widget_is_before_sibling(widget_t* parent, widget_t* a, widget_t* b) {
+  WIDGET_FOR_EACH_CHILD_BEGIN(parent, iter, i)
+  if (iter == a) {
+    return TRUE;
+  } else if (iter == b) {
+    return FALSE;
+  }
+  WIDGET_FOR_EACH_CHILD_END();
+
+  return FALSE;
+}
+
+/*同一棵树中的两个控件，a在先序深度优先遍历中是否排在b的前面*/
+static bool_t widget_is_before(widget_t* a, widget_t* b) {
+  uint32_t da = widget_depth(a);
+  uint32_t db = widget_depth(b);
+
+  while (da > db) {
+    if (a->parent == b) {
+      return FALSE;
+    }
+    a = a->parent;
+    da--;
+  }
+
+  while (db > da) {
+    if (b->parent == a) {
+      return TRUE;
+    }
+    b = b->parent;
+    db--;
+  }
+
+  while (a->parent != b->parent) {
+    a = a->parent;
+    b = b->parent;
+  }
+
+  return widget_is_before_sibling(a->parent, a, b);
+}
+
+static bool_t widget_is_descendant_of(widget_t* widget, widget_t* root) {
+  widget_t* iter = widget->parent;
+
+  while (iter != NULL && iter != root) {
+    iter = iter->parent;
+  }
+
+  return iter == root;
+}
+
+widget_t* widget_name_index_find(widget_name_index_t* index, widget_t* root, const char* name,
+                                 bool_t recursive) {
+  widget_t* found = NULL;
+  widget_name_entry_t* iter = NULL;
+  return_value_if_fail(index != NULL && root != NULL, NULL);
+
+  if (name == NULL) {
+    return NULL;
+  }
+
+  for (iter = *widget_name_index_bucket(index, name); iter != NULL; iter = iter->next) {
+    widget_t* widget = iter->widget;
+
+    if (iter->name != name) {
+      continue;
+    }
+
+    if (recursive) {
+      if (!widget_is_descendant_of(widget, root)) {
+        continue;
+      }
+    } else if (widget->parent != root) {
+      continue;
+    }
+
+    /*名称重复时，返回遍历查找时先遇到的控件*/
+    if (found == NULL || widget_is_before(widget, found)) {
+      found = widget;
+    }
+  }
+
+  return found;
+}
+
+uint32_t widget_name_index_count(widget_name_index_t* index, const char* name) {
+  uint32_t count = 0;
+  widget_name_entry_t* iter = NULL;
+  return_value_if_fail(index != NULL, 0);
+
+  if (name == NULL) {
+    return 0;
+  }
+
+  for (iter = *widget_name_index_bucket(index, name); iter != NULL; iter = iter->next) {
+    if (iter->name == name) {
+      count++;
+    }
+  }
+
+  return count;
+}
+
+uint32_t widget_name_index_size(widget_name_index_t* index) {
+  return_value_if_fail(index != NULL, 0);
+
+  return index->size;
+}
+
+uint32_t widget_name_index_get_count(void) {
+  return s_widget_name_index_count;
+}
+
+ret_t widget_name_index_destroy(widget_name_index_t* index) {
+  uint32_t i = 0;
+  return_value_if_fail(index != NULL, RET_BAD_PARAMS);
+
+  for (i = 0; i < index->capacity; i++) {
+    widget_name_entry_t* iter = index->buckets[i];
+
+    while (iter != NULL) {
+      widget_name_entry_t* next = iter->next;
+      TKMEM_FREE(iter);
+      iter = next;
+    }
+  }
+
+  TKMEM_FREE(index->buckets);
+  TKMEM_FREE(index);
+  s_widget_name_index_count--;
+
+  return RET_OK;
+}
@@ -0,0 +1,125 @@
+﻿/**
+ * File:   widget_name_index.h
+ * Author: AWTK Develop Team
+ * Brief:  index widgets of a window by name
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_WIDGET_NAME_INDEX_H
+#define TK_WIDGET_NAME_INDEX_H
+
+#include "base/widget.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class widget_name_index_t
+ * 控件名称索引。
+ *
+ * 以控件名称(原子字符串)的地址为键，记录窗口中全部有名称的控件，用于加速widget\_lookup。
+ * 允许多个控件使用相同的名称，此时按照与遍历查找相同的顺序(先序深度优先)返回第一个。
+ *
+ * 由widget.c在窗口第一次递归查找时创建，并在增加/删除子控件、修改名称时维护，
+ * 定义WITHOUT\_WIDGET\_NAME\_INDEX可以禁用。
+ */
+typedef struct _widget_name_index_t widget_name_index_t;
+
+/**
+ * @method widget_name_index_create
+ * 创建控件名称索引。
+ * @annotation ["constructor"]
+ *
+ * @return {widget_name_index_t*} 返回控件名称索引。
+ */
+widget_name_index_t* widget_name_index_create(void);
+
+/**
+ * @method widget_name_index_add
+ * 增加控件(控件没有名称时忽略，重复增加同一个控件时只记录一次)。
+ * @param {widget_name_index_t*} index 控件名称索引。
+ * @param {widget_t*} widget 控件。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_name_index_add(widget_name_index_t* index, widget_t* widget);
+
+/**
+ * @method widget_name_index_remove
+ * 删除控件。
+ * @param {widget_name_index_t*} index 控件名称索引。
+ * @param {widget_t*} widget 控件。
+ * @param {const char*} name 增加控件时控件的名称(原子字符串)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_name_index_remove(widget_name_index_t* index, widget_t* widget, const char* name);
+
+/**
+ * @method widget_name_index_find
+ * 查找root下指定名称的控件。
+ * @param {widget_name_index_t*} index 控件名称索引。
+ * @param {widget_t*} root 从这个控件开始查找(不包括它自己)。
+ * @param {const char*} name 控件的名称(原子字符串)。
+ * @param {bool_t} recursive 是否递归查找全部子控件。
+ *
+ * @return {widget_t*} 返回控件，没有找到时返回NULL。
+ */
+widget_t* widget_name_index_find(widget_name_index_t* index, widget_t* root, const char* name,
+                                 bool_t recursive);
+
+/**
+ * @method widget_name_index_count
+ * 获取索引中使用指定名称的控件的个数。
+ *
+ * 同名控件较多时(如列表项中的控件)，widget\_name\_index\_find需要逐个比较它们的遍历顺序，
+ * 此时直接遍历查找更快。
+ * @param {widget_name_index_t*} index 控件名称索引。
+ * @param {const char*} name 控件的名称(原子字符串)。
+ *
+ * @return {uint32_t} 返回控件的个数。
+ */
+uint32_t widget_name_index_count(widget_name_index_t* index, const char* name);
+
+/**
+ * @method widget_name_index_size
+ * 获取索引中控件的个数。
+ * @param {widget_name_index_t*} index 控件名称索引。
+ *
+ * @return {uint32_t} 返回控件的个数。
+ */
+uint32_t widget_name_index_size(widget_name_index_t* index);
+
+/**
+ * @method widget_name_index_get_count
+ * 获取当前存在的控件名称索引的个数(为0时不需要维护索引)。
+ *
+ * @return {uint32_t} 返回控件名称索引的个数。
+ */
+uint32_t widget_name_index_get_count(void);
+
+/**
+ * @method widget_name_index_destroy
+ * 销毁控件名称索引。
+ * @param {widget_name_index_t*} index 控件名称索引。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_name_index_destroy(widget_name_index_t* index);
+
+END_C_DECLS
+
+#endif /*TK_WIDGET_NAME_INDEX_H*/
@@ -0,0 +1,304 @@
+﻿/**
+ * File:   widget_occlusion.c
+ * Author: AWTK Develop Team
+ * Brief:  skip widgets hidden behind opaque siblings
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/region.h"
+#include "base/parallel_paint.h"
+#include "base/widget_occlusion.h"
+
+static bool_t s_enable = TRUE;
+static uint32_t s_culled = 0;
+static uint32_t s_saved_pixels = 0;
+
+static bool_t widget_is_bg_color_opaque(style_t* style) {
+  uint32_t i = 0;
+  gradient_t agradient;
+  gradient_t* gradient = style_get_gradient(style, STYLE_ID_BG_COLOR, &agradient);
+  uint32_t radius = style_get_int(style, STYLE_ID_ROUND_RADIUS, 0);
+
+  if (gradient == NULL || gradient->nr == 0) {
+    return FALSE;
+  }
+
+  for (i = 0; i < gradient->nr; i++) {
+    if (gradient->stops[i].color.rgba.a != 0xff) {
+      return FALSE;
+    }
+  }
+
+  /*与widget_fill_rect一致：圆角不大于3时填充的是矩形*/
+  return style_get_int(style, STYLE_ID_ROUND_RADIUS_TOP_LETF, radius) <= 3 &&
+         style_get_int(style, STYLE_ID_ROUND_RADIUS_TOP_RIGHT, radius) <= 3 &&
+         style_get_int(style, STYLE_ID_ROUND_RADIUS_BOTTOM_LETF, radius) <= 3 &&
+         style_get_int(style, STYLE_ID_ROUND_RADIUS_BOTTOM_RIGHT, radius) <= 3;
+}
+
+static bool_t widget_is_bg_image_opaque(widget_t* widget, style_t* style) {
+  bitmap_t img;
+  const char* image_name = style_get_str(style, STYLE_ID_BG_IMAGE, NULL);
+  int32_t draw_type = style_get_int(style, STYLE_ID_BG_IMAGE_DRAW_TYPE, IMAGE_DRAW_CENTER);
+
+  if (image_name == NULL || *image_name == '\0' || strchr(image_name, '#') != NULL) {
+    return FALSE;
+  }
+
+  /*只有这些方式会铺满整个控件*/
+  switch (draw_type) {
+    case IMAGE_DRAW_SCALE:
+    case IMAGE_DRAW_REPEAT:
+    case IMAGE_DRAW_PATCH9:
+    case IMAGE_DRAW_REPEAT9:
+    case IMAGE_DRAW_PATCH3_X_SCALE_Y:
+    case IMAGE_DRAW_PATCH3_Y_SCALE_X: {
+      break;
+    }
+    default: {
+      return FALSE;
+    }
+  }
+
+  if (widget_load_image(widget, image_name, &img) != RET_OK || img.w == 0 || img.h == 0) {
+    return FALSE;
+  }
+
+  return (img.flags & BITMAP_FLAG_OPAQUE) || img.format == BITMAP_FMT_RGB565 ||
+         img.format == BITMAP_FMT_BGR565;
+}
+
+bool_t widget_is_opaque(widget_t* widget) {
+  style_t* style = NULL;
+  return_value_if_fail(widget != NULL && widget->vt != NULL, FALSE);
+
+  style = widget->astyle;
+  if (!widget->visible || widget->opacity < TK_OPACITY_ALPHA || widget->need_update_style ||
+      widget->vt->on_paint_background != NULL || !style_is_valid(style)) {
+    return FALSE;
+  }
+
+  if (style_get_int(style, STYLE_ID_X_OFFSET, 0) != 0 ||
+      style_get_int(style, STYLE_ID_Y_OFFSET, 0) != 0) {
+    return FALSE;
+  }
+
+  return widget_is_bg_color_opaque(style) || widget_is_bg_image_opaque(widget, style);
+}
+
+static bool_t widget_occlusion_can_cull(canvas_t* c) {
+#ifdef WITHOUT_WIDGET_OCCLUSION
+  return FALSE;
+#else
+  /*LCD_VGCANVAS可能有旋转/缩放等变换，无法用偏移量计算控件的位置*/
+  return s_enable && c->lcd != NULL && c->lcd->type != LCD_VGCANVAS &&
+         c->global_alpha >= TK_OPACITY_ALPHA;
+#endif /*WITHOUT_WIDGET_OCCLUSION*/
+}
+
+static rect_t widget_occlusion_get_clip(canvas_t* c) {
+  return rect_init(c->clip_left, c->clip_top, c->clip_right - c->clip_left + 1,
+                   c->clip_bottom - c->clip_top + 1);
+}
+
+static bool_t rect_is_inside(const rect_t* r, const rect_t* outer) {
+  return r->x >= outer->x && r->y >= outer->y && r->x + r->w <= outer->x + outer->w &&
+         r->y + r->h <= outer->y + outer->h;
+}
+
+static bool_t region_covers_rect(const region_t* region, const rect_t* r) {
+  bool_t covered = FALSE;
+  region_t rest;
+
+  if (region_is_empty(region) || !rect_is_inside(r, &(region->extents))) {
+    return FALSE;
+  }
+
+  region_init(&rest);
+  region_set_rect(&rest, r);
+  region_subtract(&rest, region);
+  covered = region_is_empty(&rest);
+  region_deinit(&rest);
+
+  return covered;
+}
+
+bool_t widget_occlusion_covers_clip(widget_t* widget, canvas_t* c) {
+  rect_t r;
+  rect_t clip;
+  return_value_if_fail(widget != NULL && c != NULL, FALSE);
+
+  if (!widget_occlusion_can_cull(c) || !widget_is_opaque(widget)) {
+    return FALSE;
+  }
+
+  r = rect_init(c->ox + widget->x, c->oy + widget->y, widget->w, widget->h);
+  clip = widget_occlusion_get_clip(c);
+
+  return rect_is_inside(&clip, &r);
+}
+
+/*子控件可能绘制的区域(画布坐标，包括dirty_rect_tolerance和x_offset/y_offset)*/
+static rect_t widget_occlusion_get_paint_rect(widget_t* widget, widget_t* iter, canvas_t* c) {
+  int32_t x = c->ox + iter->x;
+  int32_t y = c->oy + iter->y;
+  int32_t t = tk_max(widget->dirty_rect_tolerance, iter->dirty_rect_tolerance);
+
+  if (iter->astyle != NULL) {
+    x += style_get_int(iter->astyle, STYLE_ID_X_OFFSET, 0);
+    y += style_get_int(iter->astyle, STYLE_ID_Y_OFFSET, 0);
+  }
+
+  return rect_init(x - t, y - t, iter->w + 2 * t, iter->h + 2 * t);
+}
+
+ret_t widget_occlusion_cull_children(widget_occlusion_t* occlusion, widget_t* widget, canvas_t* c,
+                                     const uint32_t* indexes, uint32_t nr) {
+  int32_t i = 0;
+  rect_t clip;
+  region_t covered;
+  return_value_if_fail(occlusion != NULL, RET_BAD_PARAMS);
+  memset(occlusion, 0x00, sizeof(*occlusion));
+  return_value_if_fail(widget != NULL && c != NULL, RET_BAD_PARAMS);
+
+  if (widget->children == NULL) {
+    return RET_OK;
+  }
+
+  if (indexes == NULL) {
+    nr = widget->children->size;
+  }
+
+  if (nr < 2 || !widget_occlusion_can_cull(c)) {
+    return RET_OK;
+  }
+
+  if (nr <= ARRAY_SIZE(occlusion->static_occluded)) {
+    occlusion->occluded = occlusion->static_occluded;
+  } else {
+    occlusion->occluded = TKMEM_ALLOC(nr);
+    return_value_if_fail(occlusion->occluded != NULL, RET_OOM);
+  }
+  occlusion->nr = nr;
+  memset(occlusion->occluded, 0x00, nr);
+
+  clip = widget_occlusion_get_clip(c);
+  region_init(&covered);
+
+  for (i = nr - 1; i >= 0; i--) {
+    rect_t r;
+    widget_t* iter = NULL;
+    uint32_t index = indexes != NULL ? indexes[i] : (uint32_t)i;
+
+    if (index >= widget->children->size) {
+      continue;
+    }
+
+    iter = WIDGET(widget->children->elms[index]);
+    if (!iter->visible || iter->vt->allow_draw_outside) {
+      continue;
+    }
+
+    /*不在裁剪区内的子控件既不会遮住别的控件，也不用剔除(由widget_paint_child跳过)*/
+    r = rect_init(c->ox + iter->x, c->oy + iter->y, iter->w, iter->h);
+    r = rect_intersect(&r, &clip);
+    if (r.w <= 0 || r.h <= 0) {
+      continue;
+    }
+
+    if (!region_is_empty(&covered)) {
+      rect_t paint_r = widget_occlusion_get_paint_rect(widget, iter, c);
+
+      paint_r = rect_intersect(&paint_r, &clip);
+      if (region_covers_rect(&covered, &paint_r)) {
+        occlusion->occluded[i] = TRUE;
+        widget_occlusion_add_culled(c, &paint_r);
+        continue;
+      }
+    }
+
+    /*子控件马上就要绘制，提前更新style(多线程绘制时已经在UI线程中更新好)*/
+    if (iter->need_update_style) {
+      widget_update_style(iter);
+    }
+
+    if (widget_is_opaque(iter)) {
+      region_union_rect(&covered, &r);
+    }
+  }
+
+  region_deinit(&covered);
+
+  return RET_OK;
+}
+
+ret_t widget_occlusion_deinit(widget_occlusion_t* occlusion) {
+  return_value_if_fail(occlusion != NULL, RET_BAD_PARAMS);
+
+  if (occlusion->occluded != NULL && occlusion->occluded != occlusion->static_occluded) {
+    TKMEM_FREE(occlusion->occluded);
+  }
+  occlusion->occluded = NULL;
+  occlusion->nr = 0;
+
+  return RET_OK;
+}
+
+ret_t widget_occlusion_add_culled(canvas_t* c, const rect_t* r) {
+  rect_t clip;
+  rect_t saved;
+  return_value_if_fail(c != NULL && r != NULL, RET_BAD_PARAMS);
+
+  clip = widget_occlusion_get_clip(c);
+  saved = rect_intersect(r, &clip);
+
+  /*多线程并行绘制时在多个线程中统计*/
+  parallel_paint_lock();
+  s_culled++;
+  if (saved.w > 0 && saved.h > 0) {
+    s_saved_pixels += saved.w * saved.h;
+  }
+  parallel_paint_unlock();
+
+  return RET_OK;
+}
+
+ret_t widget_occlusion_set_enable(bool_t enable) {
+  s_enable = enable;
+
+  return RET_OK;
+}
+
+bool_t widget_occlusion_is_enabled(void) {
+  return s_enable;
+}
+
+ret_t widget_occlusion_reset_stats(void) {
+  s_culled = 0;
+  s_saved_pixels = 0;
+
+  return RET_OK;
+}
+
+uint32_t widget_occlusion_get_culled(void) {
+  return s_culled;
+}
+
+uint32_t widget_occlusion_get_saved_pixels(void) {
+  return s_saved_pixels;
+}
@@ -0,0 +1,176 @@
+﻿/**
+ * File:   widget_occlusion.h
+ * Author: AWTK Develop Team
+ * Brief:  skip widgets hidden behind opaque siblings
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_WIDGET_OCCLUSION_H
+#define TK_WIDGET_OCCLUSION_H
+
+#include "base/widget.h"
+
+BEGIN_C_DECLS
+
+#ifndef TK_WIDGET_OCCLUSION_STATIC_NR
+#define TK_WIDGET_OCCLUSION_STATIC_NR 64
+#endif /*TK_WIDGET_OCCLUSION_STATIC_NR*/
+
+/**
+ * @class widget_occlusion_t
+ * 遮挡剔除。
+ *
+ * 绘制子控件之前，从上到下(与绘制顺序相反)检查与裁剪区相交的子控件，
+ * 把不透明子控件的区域加入遮挡区域，完全在遮挡区域内的子控件不用绘制。
+ * 窗口管理器用同样的方法跳过被上面不透明窗口完全遮住的窗口。
+ *
+ * 不透明的控件需要满足：
+ *
+ * * 使用缺省的背景绘制函数，没有x\_offset/y\_offset，opacity和画布的global\_alpha都是0xff。
+ * * 背景颜色是不透明的纯色且圆角不大于3，或者背景图片是不透明的(BITMAP\_FLAG\_OPAQUE)且铺满控件。
+ *
+ * 结果保存在调用者栈上的widget\_occlusion\_t中，不修改控件，所以可以用于多线程绘制(parallel\_paint)。
+ * 画布为LCD\_VGCANVAS(可能有旋转/缩放等变换)时不做遮挡剔除。
+ * 定义WITHOUT\_WIDGET\_OCCLUSION可以去掉遮挡剔除。
+ *
+ * ```c
+ * widget_occlusion_t occlusion;
+ * widget_occlusion_cull_children(&occlusion, widget, c, NULL, 0);
+ * WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
+ * if (!widget_occlusion_is_occluded(&occlusion, i)) {
+ *   widget_paint(iter, c);
+ * }
+ * WIDGET_FOR_EACH_CHILD_END();
+ * widget_occlusion_deinit(&occlusion);
+ * ```
+ */
+typedef struct _widget_occlusion_t {
+  /*private*/
+  uint32_t nr;
+  uint8_t* occluded;
+  uint8_t static_occluded[TK_WIDGET_OCCLUSION_STATIC_NR];
+} widget_occlusion_t;
+
+/**
+ * @method widget_is_opaque
+ * 判断控件的背景是否完全不透明(绘制后完全遮住下面的内容)。
+ * @param {widget_t*} widget 控件。
+ *
+ * @return {bool_t} 返回TRUE表示不透明，否则表示不确定。
+ */
+bool_t widget_is_opaque(widget_t* widget);
+
+/**
+ * @method widget_occlusion_covers_clip
+ * 判断控件是否不透明并且完全覆盖画布当前的裁剪区。
+ * @param {widget_t*} widget 控件。
+ * @param {canvas_t*} c 画布(当前的偏移量是控件的父控件的原点)。
+ *
+ * @return {bool_t} 返回TRUE表示完全覆盖。
+ */
+bool_t widget_occlusion_covers_clip(widget_t* widget, canvas_t* c);
+
+/**
+ * @method widget_occlusion_cull_children
+ * 初始化occlusion，并找出被遮住的子控件。
+ * @param {widget_occlusion_t*} occlusion 遮挡剔除的结果。
+ * @param {widget_t*} widget 父控件。
+ * @param {canvas_t*} c 画布(当前的偏移量是父控件的原点)。
+ * @param {const uint32_t*} indexes 需要绘制的子控件的序数(从小到大排列)，为NULL时表示全部子控件。
+ * @param {uint32_t} nr 序数的个数(indexes为NULL时忽略)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败(此时全部子控件都需要绘制)。
+ */
+ret_t widget_occlusion_cull_children(widget_occlusion_t* occlusion, widget_t* widget, canvas_t* c,
+                                     const uint32_t* indexes, uint32_t nr);
+
+/**
+ * @method widget_occlusion_is_occluded
+ * 判断第i个需要绘制的子控件(indexes为NULL时就是第i个子控件)是否被遮住。
+ * @param {widget_occlusion_t*} occlusion 遮挡剔除的结果。
+ * @param {uint32_t} i 序号。
+ *
+ * @return {bool_t} 返回TRUE表示被遮住，不用绘制。
+ */
+static inline bool_t widget_occlusion_is_occluded(widget_occlusion_t* occlusion, uint32_t i) {
+  return occlusion->occluded != NULL && i < occlusion->nr && occlusion->occluded[i];
+}
+
+/**
+ * @method widget_occlusion_deinit
+ * 释放widget\_occlusion\_cull\_children分配的资源。
+ * @param {widget_occlusion_t*} occlusion 遮挡剔除的结果。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_occlusion_deinit(widget_occlusion_t* occlusion);
+
+/**
+ * @method widget_occlusion_add_culled
+ * 记录一个没有绘制的控件或窗口(用于统计)。
+ * @param {canvas_t*} c 画布。
+ * @param {const rect_t*} r 控件的区域(画布坐标)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_occlusion_add_culled(canvas_t* c, const rect_t* r);
+
+/**
+ * @method widget_occlusion_set_enable
+ * 启用或禁用遮挡剔除(缺省启用，主要用于对比测试)。
+ * @param {bool_t} enable 是否启用。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_occlusion_set_enable(bool_t enable);
+
+/**
+ * @method widget_occlusion_is_enabled
+ * 判断是否启用了遮挡剔除。
+ *
+ * @return {bool_t} 返回TRUE表示启用。
+ */
+bool_t widget_occlusion_is_enabled(void);
+
+/**
+ * @method widget_occlusion_reset_stats
+ * 清除统计数据(窗口管理器在每一帧开始时调用)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_occlusion_reset_stats(void);
+
+/**
+ * @method widget_occlusion_get_culled
+ * 获取上次清除统计数据以来没有绘制的控件和窗口的个数。
+ *
+ * @return {uint32_t} 返回个数。
+ */
+uint32_t widget_occlusion_get_culled(void);
+
+/**
+ * @method widget_occlusion_get_saved_pixels
+ * 获取上次清除统计数据以来没有绘制的控件和窗口在裁剪区内的像素个数(即节省的重复绘制)。
+ * 多线程绘制时统计数据没有加锁，只是近似值。
+ *
+ * @return {uint32_t} 返回像素个数。
+ */
+uint32_t widget_occlusion_get_saved_pixels(void);
+
+END_C_DECLS
+
+#endif /*TK_WIDGET_OCCLUSION_H*/
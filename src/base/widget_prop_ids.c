@@ -0,0 +1,233 @@
+﻿/**
+ * File:   widget_prop_ids.c
+ * Author: AWTK Develop Team
+ * Brief:  ids of builtin widget properties
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+/*本文件由tools/prop_hash_gen根据widget_consts.h生成，请不要手工修改。*/
+
+#include "tkc/utils.h"
+#include "base/widget_prop_ids.h"
+
+#define WIDGET_PROP_HASH_SLOTS_BITS 8
+#define WIDGET_PROP_HASH_BUCKETS_BITS 6
+
+static const char* const s_widget_prop_names[WIDGET_PROP_ID_NR] = {
+    NULL, WIDGET_PROP_EXEC, WIDGET_PROP_X, WIDGET_PROP_Y, WIDGET_PROP_W, WIDGET_PROP_H,
+    WIDGET_PROP_MAX_H, WIDGET_PROP_DESIGN_W, WIDGET_PROP_DESIGN_H,
+    WIDGET_PROP_AUTO_SCALE_CHILDREN_X, WIDGET_PROP_AUTO_SCALE_CHILDREN_Y,
+    WIDGET_PROP_AUTO_SCALE_CHILDREN_W, WIDGET_PROP_AUTO_SCALE_CHILDREN_H, WIDGET_PROP_INPUTING,
+    WIDGET_PROP_ALWAYS_ON_TOP, WIDGET_PROP_CARET_X, WIDGET_PROP_CARET_Y,
+    WIDGET_PROP_DIRTY_RECT_TOLERANCE, WIDGET_PROP_CACHE_AS_BITMAP, WIDGET_PROP_BIDI,
+    WIDGET_PROP_CANVAS, WIDGET_PROP_LOCALIZE_OPTIONS, WIDGET_PROP_NATIVE_WINDOW,
+    WIDGET_PROP_HIGHLIGHT, WIDGET_PROP_BAR_SIZE, WIDGET_PROP_OPACITY, WIDGET_PROP_MIN_W,
+    WIDGET_PROP_MAX_W, WIDGET_PROP_AUTO_ADJUST_SIZE, WIDGET_PROP_SINGLE_INSTANCE,
+    WIDGET_PROP_STRONGLY_FOCUS, WIDGET_PROP_CHILDREN_LAYOUT, WIDGET_PROP_LAYOUT,
+    WIDGET_PROP_SELF_LAYOUT, WIDGET_PROP_LAYOUT_W, WIDGET_PROP_LAYOUT_H, WIDGET_PROP_VIRTUAL_W,
+    WIDGET_PROP_VIRTUAL_H, WIDGET_PROP_NAME, WIDGET_PROP_TYPE, WIDGET_PROP_CLOSABLE,
+    WIDGET_PROP_POINTER_CURSOR, WIDGET_PROP_VALUE, WIDGET_PROP_RADIO, WIDGET_PROP_REVERSE,
+    WIDGET_PROP_LENGTH, WIDGET_PROP_LINE_WRAP, WIDGET_PROP_WORD_WRAP, WIDGET_PROP_TEXT,
+    WIDGET_PROP_TR_TEXT, WIDGET_PROP_STYLE, WIDGET_PROP_ENABLE, WIDGET_PROP_FEEDBACK,
+    WIDGET_PROP_FLOATING, WIDGET_PROP_MARGIN, WIDGET_PROP_SPACING, WIDGET_PROP_LEFT_MARGIN,
+    WIDGET_PROP_RIGHT_MARGIN, WIDGET_PROP_TOP_MARGIN, WIDGET_PROP_BOTTOM_MARGIN, WIDGET_PROP_STEP,
+    WIDGET_PROP_VISIBLE, WIDGET_PROP_SENSITIVE, WIDGET_PROP_ANIMATION, WIDGET_PROP_ANIM_HINT,
+    WIDGET_PROP_FULLSCREEN, WIDGET_PROP_DISABLE_ANIM, WIDGET_PROP_OPEN_ANIM_HINT,
+    WIDGET_PROP_CLOSE_ANIM_HINT, WIDGET_PROP_MIN, WIDGET_PROP_ACTION_TEXT, WIDGET_PROP_TIPS,
+    WIDGET_PROP_TR_TIPS, WIDGET_PROP_INPUT_TYPE, WIDGET_PROP_KEYBOARD,
+    WIDGET_PROP_DEFAULT_FOCUSED_CHILD, WIDGET_PROP_READONLY, WIDGET_PROP_CANCELABLE,
+    WIDGET_PROP_PASSWORD_VISIBLE, WIDGET_PROP_ACTIVE, WIDGET_PROP_CURR_PAGE,
+    WIDGET_PROP_PAGE_MAX_NUMBER, WIDGET_PROP_VERTICAL, WIDGET_PROP_SHOW_TEXT, WIDGET_PROP_XOFFSET,
+    WIDGET_PROP_YOFFSET, WIDGET_PROP_ALIGN_V, WIDGET_PROP_ALIGN_H, WIDGET_PROP_AUTO_PLAY,
+    WIDGET_PROP_LOOP, WIDGET_PROP_AUTO_FIX, WIDGET_PROP_SELECT_NONE_WHEN_FOCUSED,
+    WIDGET_PROP_OPEN_IM_WHEN_FOCUSED, WIDGET_PROP_CLOSE_IM_WHEN_BLURED, WIDGET_PROP_X_MIN,
+    WIDGET_PROP_X_MAX, WIDGET_PROP_Y_MIN, WIDGET_PROP_Y_MAX, WIDGET_PROP_MAX, WIDGET_PROP_GRAB_KEYS,
+    WIDGET_PROP_ROW, WIDGET_PROP_STATE_FOR_STYLE, WIDGET_PROP_THEME, WIDGET_PROP_STAGE,
+    WIDGET_PROP_IMAGE_MANAGER, WIDGET_PROP_ASSETS_MANAGER, WIDGET_PROP_LOCALE_INFO,
+    WIDGET_PROP_FONT_MANAGER, WIDGET_PROP_THEME_OBJ, WIDGET_PROP_DEFAULT_THEME_OBJ,
+    WIDGET_PROP_ITEM_WIDTH, WIDGET_PROP_ITEM_HEIGHT, WIDGET_PROP_DEFAULT_ITEM_HEIGHT,
+    WIDGET_PROP_XSLIDABLE, WIDGET_PROP_YSLIDABLE, WIDGET_PROP_REPEAT, WIDGET_PROP_LONG_PRESS_TIME,
+    WIDGET_PROP_ENABLE_LONG_PRESS, WIDGET_PROP_CLICK_THROUGH, WIDGET_PROP_ANIMATABLE,
+    WIDGET_PROP_AUTO_HIDE, WIDGET_PROP_AUTO_HIDE_SCROLL_BAR, WIDGET_PROP_IMAGE, WIDGET_PROP_FORMAT,
+    WIDGET_PROP_DRAW_TYPE, WIDGET_PROP_SELECTABLE, WIDGET_PROP_CLICKABLE, WIDGET_PROP_SCALE_X,
+    WIDGET_PROP_SCALE_Y, WIDGET_PROP_ANCHOR_X, WIDGET_PROP_ANCHOR_Y, WIDGET_PROP_ROTATION,
+    WIDGET_PROP_COMPACT, WIDGET_PROP_SCROLLABLE, WIDGET_PROP_ICON, WIDGET_PROP_OPTIONS,
+    WIDGET_PROP_SELECTED, WIDGET_PROP_CHECKED, WIDGET_PROP_ACTIVE_ICON, WIDGET_PROP_LOAD_UI,
+    WIDGET_PROP_OPEN_WINDOW, WIDGET_PROP_SELECTED_INDEX, WIDGET_PROP_CLOSE_WHEN_CLICK,
+    WIDGET_PROP_CLOSE_WHEN_CLICK_OUTSIDE, WIDGET_PROP_CLOSE_WHEN_TIMEOUT, WIDGET_PROP_LINE_GAP,
+    WIDGET_PROP_BG_COLOR, WIDGET_PROP_BORDER_COLOR, WIDGET_PROP_DELAY, WIDGET_PROP_IS_KEYBOARD,
+    WIDGET_PROP_FOCUSED, WIDGET_PROP_FOCUS, WIDGET_PROP_FOCUSABLE, WIDGET_PROP_WITH_FOCUS_STATE,
+    WIDGET_PROP_MOVE_FOCUS_PREV_KEY, WIDGET_PROP_MOVE_FOCUS_NEXT_KEY, WIDGET_PROP_MOVE_FOCUS_UP_KEY,
+    WIDGET_PROP_MOVE_FOCUS_DOWN_KEY, WIDGET_PROP_MOVE_FOCUS_LEFT_KEY,
+    WIDGET_PROP_MOVE_FOCUS_RIGHT_KEY};
+
+static const uint8_t s_widget_prop_lens[WIDGET_PROP_ID_NR] = {
+    0, 4, 1, 1, 1, 1, 5, 8, 8, 21, 21, 21, 21, 8, 13, 7, 7, 20, 15, 4, 6, 16, 13, 9, 8, 7, 5, 5, 16,
+    15, 14, 15, 6, 11, 8, 8, 9, 9, 4, 4, 8, 14, 5, 5, 7, 6, 9, 9, 4, 7, 5, 6, 8, 8, 6, 7, 11, 12,
+    10, 13, 4, 7, 9, 9, 9, 10, 12, 14, 15, 3, 11, 4, 7, 10, 8, 21, 8, 10, 16, 6, 9, 15, 8, 9, 7, 7,
+    7, 7, 9, 4, 8, 24, 20, 20, 5, 5, 5, 5, 3, 9, 3, 15, 5, 5, 13, 14, 11, 12, 9, 17, 10, 11, 19, 9,
+    9, 6, 15, 17, 13, 10, 9, 20, 5, 6, 9, 10, 9, 7, 7, 8, 8, 8, 7, 10, 4, 7, 8, 7, 11, 7, 11, 14,
+    16, 24, 18, 8, 8, 12, 5, 11, 7, 5, 9, 16, 19, 19, 17, 19, 19, 20};
+
+static const uint16_t s_widget_prop_seeds[1 << WIDGET_PROP_HASH_BUCKETS_BITS] = {
+    3, 4, 1, 0, 5, 0, 5, 0, 0, 10, 5, 1, 2, 1, 1, 2, 5, 0, 0, 0, 4, 0, 0, 3, 0, 4, 1, 0, 1, 0, 0, 2,
+    3, 1, 1, 2, 1, 9, 0, 12, 2, 2, 1, 5, 2, 1, 0, 3, 0, 1, 1, 0, 0, 2, 0, 2, 2, 4, 14, 5, 4, 1, 0, 1};
+
+static const uint8_t s_widget_prop_slots[1 << WIDGET_PROP_HASH_SLOTS_BITS] = {
+    0, 158, 30, 0, 100, 118, 0, 67, 18, 141, 136, 91, 0, 82, 0, 0, 40, 49, 0, 59, 151, 105, 19, 0,
+    1, 84, 0, 0, 81, 155, 22, 0, 3, 0, 0, 140, 127, 79, 47, 0, 157, 110, 68, 0, 70, 0, 57, 0, 0, 65,
+    0, 32, 0, 0, 0, 2, 20, 16, 17, 72, 38, 126, 0, 44, 62, 113, 24, 66, 0, 15, 138, 124, 116, 147,
+    0, 152, 92, 0, 43, 31, 0, 0, 96, 0, 0, 11, 133, 112, 0, 0, 117, 0, 0, 89, 51, 26, 56, 0, 0, 0,
+    0, 83, 146, 33, 0, 0, 0, 0, 0, 119, 45, 0, 52, 98, 0, 35, 120, 0, 94, 34, 69, 46, 107, 80, 73,
+    115, 125, 93, 0, 150, 61, 145, 131, 135, 0, 0, 122, 97, 0, 0, 48, 154, 0, 0, 0, 25, 0, 0, 0, 0,
+    88, 0, 102, 121, 137, 13, 0, 0, 103, 0, 63, 37, 0, 64, 149, 142, 0, 153, 0, 109, 0, 108, 0, 0,
+    0, 0, 23, 90, 50, 99, 0, 29, 12, 0, 0, 148, 0, 0, 0, 78, 101, 129, 55, 0, 114, 0, 7, 74, 95, 54,
+    143, 77, 128, 134, 27, 86, 104, 5, 9, 60, 8, 0, 71, 0, 111, 14, 76, 75, 0, 123, 0, 139, 0, 6, 0,
+    0, 4, 58, 21, 0, 36, 41, 106, 0, 0, 53, 10, 0, 0, 0, 0, 85, 0, 87, 130, 159, 144, 28, 0, 0, 156,
+    132, 42, 39, 0, 0};
+
+/*
+ * 调用者通常直接使用WIDGET_PROP_*常量，链接器会合并相同的字符串常量，
+ * 所以按地址缓存最近查到的ID。只缓存与s_widget_prop_names中地址相同的名称，
+ * 命中时不需要再比较内容(多线程同时写入也只会导致不命中)。
+ */
+#define WIDGET_PROP_ADDR_CACHE_NR 64
+static uint8_t s_widget_prop_addr_cache[WIDGET_PROP_ADDR_CACHE_NR];
+
+static uint32_t widget_prop_addr_cache_index(const char* name) {
+  uintptr_t addr = (uintptr_t)name;
+
+  return (uint32_t)((addr ^ (addr >> 6)) & (WIDGET_PROP_ADDR_CACHE_NR - 1));
+}
+
+/*最常用的属性按首字符直接比较，不是这些属性时返回WIDGET_PROP_ID_NONE*/
+static widget_prop_id_t widget_prop_id_from_hot_name(const char* name) {
+  switch (name[0]) {
+    case 'x': {
+      if (name[1] == '\0') {
+        return WIDGET_PROP_ID_X;
+      }
+      break;
+    }
+    case 'y': {
+      if (name[1] == '\0') {
+        return WIDGET_PROP_ID_Y;
+      }
+      break;
+    }
+    case 'w': {
+      if (name[1] == '\0') {
+        return WIDGET_PROP_ID_W;
+      }
+      break;
+    }
+    case 'h': {
+      if (name[1] == '\0') {
+        return WIDGET_PROP_ID_H;
+      }
+      break;
+    }
+    case 'v': {
+      if (strcmp(name + 1, WIDGET_PROP_VALUE + 1) == 0) {
+        return WIDGET_PROP_ID_VALUE;
+      }
+      if (strcmp(name + 1, WIDGET_PROP_VISIBLE + 1) == 0) {
+        return WIDGET_PROP_ID_VISIBLE;
+      }
+      break;
+    }
+    case 't': {
+      if (strcmp(name + 1, WIDGET_PROP_TEXT + 1) == 0) {
+        return WIDGET_PROP_ID_TEXT;
+      }
+      break;
+    }
+    case 'e': {
+      if (strcmp(name + 1, WIDGET_PROP_ENABLE + 1) == 0) {
+        return WIDGET_PROP_ID_ENABLE;
+      }
+      break;
+    }
+    case 'c': {
+      if (strcmp(name + 1, WIDGET_PROP_CHECKED + 1) == 0) {
+        return WIDGET_PROP_ID_CHECKED;
+      }
+      break;
+    }
+    case 'n': {
+      if (strcmp(name + 1, WIDGET_PROP_NAME + 1) == 0) {
+        return WIDGET_PROP_ID_NAME;
+      }
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+
+  return WIDGET_PROP_ID_NONE;
+}
+
+widget_prop_id_t widget_prop_id_from_name(const char* name) {
+  uint32_t id = 0;
+  uint32_t key = 0;
+  uint32_t len = 0;
+  uint32_t index = 0;
+  const uint8_t* p = (const uint8_t*)name;
+
+  if (name == NULL || *name == '\0') {
+    return WIDGET_PROP_ID_NONE;
+  }
+
+  index = widget_prop_addr_cache_index(name);
+  id = s_widget_prop_addr_cache[index];
+  if (s_widget_prop_names[id] == name) {
+    return (widget_prop_id_t)id;
+  }
+
+  id = widget_prop_id_from_hot_name(name);
+  if (id != WIDGET_PROP_ID_NONE) {
+    return (widget_prop_id_t)id;
+  }
+
+  len = strlen(name);
+  if (len > 0xff) {
+    return WIDGET_PROP_ID_NONE;
+  }
+
+  /*键只取长度和五个位置的字符，与tools/prop_hash_gen中的keyOf一致*/
+  key = (p[0] | (p[1] << 8) | (p[len >> 1] << 16) | ((uint32_t)p[len - 1] << 24)) ^
+        ((len | (p[(len >> 1) + (len >> 2)] << 8)) * 0x9e3779b1u);
+  key ^= s_widget_prop_seeds[(key * 0x85ebca6bu) >> (32 - WIDGET_PROP_HASH_BUCKETS_BITS)] *
+         0x27d4eb2fu;
+  id = s_widget_prop_slots[(key * 0xc2b2ae35u) >> (32 - WIDGET_PROP_HASH_SLOTS_BITS)];
+
+  if (id != 0 && s_widget_prop_lens[id] == len) {
+    if (s_widget_prop_names[id] == name) {
+      s_widget_prop_addr_cache[index] = (uint8_t)id;
+      return (widget_prop_id_t)id;
+    } else if (memcmp(s_widget_prop_names[id], name, len) == 0) {
+      return (widget_prop_id_t)id;
+    }
+  }
+
+  return WIDGET_PROP_ID_NONE;
+}
+
+const char* widget_prop_name_from_id(widget_prop_id_t id) {
+  return (uint32_t)id < WIDGET_PROP_ID_NR ? s_widget_prop_names[id] : NULL;
+}
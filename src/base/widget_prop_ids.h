@@ -0,0 +1,230 @@
+﻿/**
+ * File:   widget_prop_ids.h
+ * Author: AWTK Develop Team
+ * Brief:  ids of builtin widget properties
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+/*本文件由tools/prop_hash_gen根据widget_consts.h生成，请不要手工修改。*/
+
+#ifndef TK_WIDGET_PROP_IDS_H
+#define TK_WIDGET_PROP_IDS_H
+
+#include "base/widget_consts.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @enum widget_prop_id_t
+ * @prefix WIDGET_PROP_ID_
+ * 内置控件属性(WIDGET\_PROP\_*)的数字ID。
+ *
+ * 用于按ID分发属性，而不是逐个比较属性名。ID只在同一次编译中有效，不要保存。
+ */
+typedef enum _widget_prop_id_t {
+  /**
+   * @const WIDGET_PROP_ID_NONE
+   * 不是内置的属性。
+   */
+  WIDGET_PROP_ID_NONE = 0,
+  WIDGET_PROP_ID_EXEC,
+  WIDGET_PROP_ID_X,
+  WIDGET_PROP_ID_Y,
+  WIDGET_PROP_ID_W,
+  WIDGET_PROP_ID_H,
+  WIDGET_PROP_ID_MAX_H,
+  WIDGET_PROP_ID_DESIGN_W,
+  WIDGET_PROP_ID_DESIGN_H,
+  WIDGET_PROP_ID_AUTO_SCALE_CHILDREN_X,
+  WIDGET_PROP_ID_AUTO_SCALE_CHILDREN_Y,
+  WIDGET_PROP_ID_AUTO_SCALE_CHILDREN_W,
+  WIDGET_PROP_ID_AUTO_SCALE_CHILDREN_H,
+  WIDGET_PROP_ID_INPUTING,
+  WIDGET_PROP_ID_ALWAYS_ON_TOP,
+  WIDGET_PROP_ID_CARET_X,
+  WIDGET_PROP_ID_CARET_Y,
+  WIDGET_PROP_ID_DIRTY_RECT_TOLERANCE,
+  WIDGET_PROP_ID_CACHE_AS_BITMAP,
+  WIDGET_PROP_ID_BIDI,
+  WIDGET_PROP_ID_CANVAS,
+  WIDGET_PROP_ID_LOCALIZE_OPTIONS,
+  WIDGET_PROP_ID_NATIVE_WINDOW,
+  WIDGET_PROP_ID_HIGHLIGHT,
+  WIDGET_PROP_ID_BAR_SIZE,
+  WIDGET_PROP_ID_OPACITY,
+  WIDGET_PROP_ID_MIN_W,
+  WIDGET_PROP_ID_MAX_W,
+  WIDGET_PROP_ID_AUTO_ADJUST_SIZE,
+  WIDGET_PROP_ID_SINGLE_INSTANCE,
+  WIDGET_PROP_ID_STRONGLY_FOCUS,
+  WIDGET_PROP_ID_CHILDREN_LAYOUT,
+  WIDGET_PROP_ID_LAYOUT,
+  WIDGET_PROP_ID_SELF_LAYOUT,
+  WIDGET_PROP_ID_LAYOUT_W,
+  WIDGET_PROP_ID_LAYOUT_H,
+  WIDGET_PROP_ID_VIRTUAL_W,
+  WIDGET_PROP_ID_VIRTUAL_H,
+  WIDGET_PROP_ID_NAME,
+  WIDGET_PROP_ID_TYPE,
+  WIDGET_PROP_ID_CLOSABLE,
+  WIDGET_PROP_ID_POINTER_CURSOR,
+  WIDGET_PROP_ID_VALUE,
+  WIDGET_PROP_ID_RADIO,
+  WIDGET_PROP_ID_REVERSE,
+  WIDGET_PROP_ID_LENGTH,
+  WIDGET_PROP_ID_LINE_WRAP,
+  WIDGET_PROP_ID_WORD_WRAP,
+  WIDGET_PROP_ID_TEXT,
+  WIDGET_PROP_ID_TR_TEXT,
+  WIDGET_PROP_ID_STYLE,
+  WIDGET_PROP_ID_ENABLE,
+  WIDGET_PROP_ID_FEEDBACK,
+  WIDGET_PROP_ID_FLOATING,
+  WIDGET_PROP_ID_MARGIN,
+  WIDGET_PROP_ID_SPACING,
+  WIDGET_PROP_ID_LEFT_MARGIN,
+  WIDGET_PROP_ID_RIGHT_MARGIN,
+  WIDGET_PROP_ID_TOP_MARGIN,
+  WIDGET_PROP_ID_BOTTOM_MARGIN,
+  WIDGET_PROP_ID_STEP,
+  WIDGET_PROP_ID_VISIBLE,
+  WIDGET_PROP_ID_SENSITIVE,
+  WIDGET_PROP_ID_ANIMATION,
+  WIDGET_PROP_ID_ANIM_HINT,
+  WIDGET_PROP_ID_FULLSCREEN,
+  WIDGET_PROP_ID_DISABLE_ANIM,
+  WIDGET_PROP_ID_OPEN_ANIM_HINT,
+  WIDGET_PROP_ID_CLOSE_ANIM_HINT,
+  WIDGET_PROP_ID_MIN,
+  WIDGET_PROP_ID_ACTION_TEXT,
+  WIDGET_PROP_ID_TIPS,
+  WIDGET_PROP_ID_TR_TIPS,
+  WIDGET_PROP_ID_INPUT_TYPE,
+  WIDGET_PROP_ID_KEYBOARD,
+  WIDGET_PROP_ID_DEFAULT_FOCUSED_CHILD,
+  WIDGET_PROP_ID_READONLY,
+  WIDGET_PROP_ID_CANCELABLE,
+  WIDGET_PROP_ID_PASSWORD_VISIBLE,
+  WIDGET_PROP_ID_ACTIVE,
+  WIDGET_PROP_ID_CURR_PAGE,
+  WIDGET_PROP_ID_PAGE_MAX_NUMBER,
+  WIDGET_PROP_ID_VERTICAL,
+  WIDGET_PROP_ID_SHOW_TEXT,
+  WIDGET_PROP_ID_XOFFSET,
+  WIDGET_PROP_ID_YOFFSET,
+  WIDGET_PROP_ID_ALIGN_V,
+  WIDGET_PROP_ID_ALIGN_H,
+  WIDGET_PROP_ID_AUTO_PLAY,
+  WIDGET_PROP_ID_LOOP,
+  WIDGET_PROP_ID_AUTO_FIX,
+  WIDGET_PROP_ID_SELECT_NONE_WHEN_FOCUSED,
+  WIDGET_PROP_ID_OPEN_IM_WHEN_FOCUSED,
+  WIDGET_PROP_ID_CLOSE_IM_WHEN_BLURED,
+  WIDGET_PROP_ID_X_MIN,
+  WIDGET_PROP_ID_X_MAX,
+  WIDGET_PROP_ID_Y_MIN,
+  WIDGET_PROP_ID_Y_MAX,
+  WIDGET_PROP_ID_MAX,
+  WIDGET_PROP_ID_GRAB_KEYS,
+  WIDGET_PROP_ID_ROW,
+  WIDGET_PROP_ID_STATE_FOR_STYLE,
+  WIDGET_PROP_ID_THEME,
+  WIDGET_PROP_ID_STAGE,
+  WIDGET_PROP_ID_IMAGE_MANAGER,
+  WIDGET_PROP_ID_ASSETS_MANAGER,
+  WIDGET_PROP_ID_LOCALE_INFO,
+  WIDGET_PROP_ID_FONT_MANAGER,
+  WIDGET_PROP_ID_THEME_OBJ,
+  WIDGET_PROP_ID_DEFAULT_THEME_OBJ,
+  WIDGET_PROP_ID_ITEM_WIDTH,
+  WIDGET_PROP_ID_ITEM_HEIGHT,
+  WIDGET_PROP_ID_DEFAULT_ITEM_HEIGHT,
+  WIDGET_PROP_ID_XSLIDABLE,
+  WIDGET_PROP_ID_YSLIDABLE,
+  WIDGET_PROP_ID_REPEAT,
+  WIDGET_PROP_ID_LONG_PRESS_TIME,
+  WIDGET_PROP_ID_ENABLE_LONG_PRESS,
+  WIDGET_PROP_ID_CLICK_THROUGH,
+  WIDGET_PROP_ID_ANIMATABLE,
+  WIDGET_PROP_ID_AUTO_HIDE,
+  WIDGET_PROP_ID_AUTO_HIDE_SCROLL_BAR,
+  WIDGET_PROP_ID_IMAGE,
+  WIDGET_PROP_ID_FORMAT,
+  WIDGET_PROP_ID_DRAW_TYPE,
+  WIDGET_PROP_ID_SELECTABLE,
+  WIDGET_PROP_ID_CLICKABLE,
+  WIDGET_PROP_ID_SCALE_X,
+  WIDGET_PROP_ID_SCALE_Y,
+  WIDGET_PROP_ID_ANCHOR_X,
+  WIDGET_PROP_ID_ANCHOR_Y,
+  WIDGET_PROP_ID_ROTATION,
+  WIDGET_PROP_ID_COMPACT,
+  WIDGET_PROP_ID_SCROLLABLE,
+  WIDGET_PROP_ID_ICON,
+  WIDGET_PROP_ID_OPTIONS,
+  WIDGET_PROP_ID_SELECTED,
+  WIDGET_PROP_ID_CHECKED,
+  WIDGET_PROP_ID_ACTIVE_ICON,
+  WIDGET_PROP_ID_LOAD_UI,
+  WIDGET_PROP_ID_OPEN_WINDOW,
+  WIDGET_PROP_ID_SELECTED_INDEX,
+  WIDGET_PROP_ID_CLOSE_WHEN_CLICK,
+  WIDGET_PROP_ID_CLOSE_WHEN_CLICK_OUTSIDE,
+  WIDGET_PROP_ID_CLOSE_WHEN_TIMEOUT,
+  WIDGET_PROP_ID_LINE_GAP,
+  WIDGET_PROP_ID_BG_COLOR,
+  WIDGET_PROP_ID_BORDER_COLOR,
+  WIDGET_PROP_ID_DELAY,
+  WIDGET_PROP_ID_IS_KEYBOARD,
+  WIDGET_PROP_ID_FOCUSED,
+  WIDGET_PROP_ID_FOCUS,
+  WIDGET_PROP_ID_FOCUSABLE,
+  WIDGET_PROP_ID_WITH_FOCUS_STATE,
+  WIDGET_PROP_ID_MOVE_FOCUS_PREV_KEY,
+  WIDGET_PROP_ID_MOVE_FOCUS_NEXT_KEY,
+  WIDGET_PROP_ID_MOVE_FOCUS_UP_KEY,
+  WIDGET_PROP_ID_MOVE_FOCUS_DOWN_KEY,
+  WIDGET_PROP_ID_MOVE_FOCUS_LEFT_KEY,
+  WIDGET_PROP_ID_MOVE_FOCUS_RIGHT_KEY,
+  /**
+   * @const WIDGET_PROP_ID_NR
+   * ID的个数。
+   */
+  WIDGET_PROP_ID_NR
+} widget_prop_id_t;
+
+/**
+ * @method widget_prop_id_from_name
+ * 获取属性名对应的ID(使用完美哈希表，只需要计算一次哈希值和比较一次字符串)。
+ * @param {const char*} name 属性名。
+ *
+ * @return {widget_prop_id_t} 返回ID，不是内置的属性时返回WIDGET\_PROP\_ID\_NONE。
+ */
+widget_prop_id_t widget_prop_id_from_name(const char* name);
+
+/**
+ * @method widget_prop_name_from_id
+ * 获取ID对应的属性名。
+ * @param {widget_prop_id_t} id 属性ID。
+ *
+ * @return {const char*} 返回属性名，ID无效时返回NULL。
+ */
+const char* widget_prop_name_from_id(widget_prop_id_t id);
+
+END_C_DECLS
+
+#endif /*TK_WIDGET_PROP_IDS_H*/
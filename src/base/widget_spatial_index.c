@@ -0,0 +1,449 @@
+﻿/**
+ * File:   widget_spatial_index.c
+ * Author: AWTK Develop Team
+ * Brief:  uniform grid of children for painting and hit testing
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "base/widget_vtable.h"
+#include "base/widget_spatial_index.h"
+
+/*网格的行数和列数上限*/
+#define WIDGET_SPATIAL_INDEX_MAX_DIM 128
+/*跨越的网格太多的子控件放到always中*/
+#define WIDGET_SPATIAL_INDEX_MAX_SPAN 64
+
+typedef struct _widget_spatial_cell_t {
+  uint32_t* items;
+  uint32_t size;
+  uint32_t capacity;
+} widget_spatial_cell_t;
+
+typedef struct _widget_spatial_range_t {
+  uint32_t c0;
+  uint32_t r0;
+  uint32_t c1;
+  uint32_t r1;
+  bool_t always;
+} widget_spatial_range_t;
+
+struct _widget_spatial_index_t {
+  widget_t* widget;
+  struct _widget_spatial_index_t* next;
+  bool_t stale;
+
+  xy_t x;
+  xy_t y;
+  int32_t cell_w;
+  int32_t cell_h;
+  uint32_t cols;
+  uint32_t rows;
+  widget_spatial_cell_t* cells;
+  widget_spatial_cell_t always;
+
+  /*查找时用于去重和返回结果*/
+  uint32_t nr;
+  uint32_t stamp;
+  uint32_t* marks;
+  uint32_t* result;
+};
+
+static widget_spatial_index_t* s_widget_spatial_indexes = NULL;
+
+static ret_t widget_spatial_cell_add(widget_spatial_cell_t* cell, uint32_t i) {
+  if (cell->size >= cell->capacity) {
+    uint32_t capacity = cell->capacity > 0 ? cell->capacity * 2 : 4;
+    uint32_t* items = TKMEM_REALLOCT(uint32_t, cell->items, capacity);
+    return_value_if_fail(items != NULL, RET_OOM);
+
+    cell->items = items;
+    cell->capacity = capacity;
+  }
+  cell->items[cell->size++] = i;
+
+  return RET_OK;
+}
+
+/*删除序数为*i的项，*i为-1时按控件指针查找，并通过i返回它的序数*/
+static ret_t widget_spatial_cell_remove(widget_spatial_cell_t* cell, widget_t** children,
+                                        widget_t* child, uint32_t* i) {
+  uint32_t k = 0;
+
+  for (k = 0; k < cell->size; k++) {
+    uint32_t iter = cell->items[k];
+    if (*i == iter || (*i == (uint32_t)-1 && children[iter] == child)) {
+      *i = iter;
+      cell->items[k] = cell->items[--cell->size];
+      return RET_OK;
+    }
+  }
+
+  return RET_NOT_FOUND;
+}
+
+static uint32_t widget_spatial_index_col(widget_spatial_index_t* index, int32_t x) {
+  int32_t col = x < index->x ? 0 : (x - index->x) / index->cell_w;
+
+  return tk_min((uint32_t)col, index->cols - 1);
+}
+
+static uint32_t widget_spatial_index_row(widget_spatial_index_t* index, int32_t y) {
+  int32_t row = y < index->y ? 0 : (y - index->y) / index->cell_h;
+
+  return tk_min((uint32_t)row, index->rows - 1);
+}
+
+/*区域外的坐标归到边上的网格，这样移动到区域外的子控件仍然能找到*/
+static widget_spatial_range_t widget_spatial_index_range(widget_spatial_index_t* index,
+                                                         const rect_t* r) {
+  widget_spatial_range_t range;
+  int32_t right = r->x + tk_max(r->w, 1) - 1;
+  int32_t bottom = r->y + tk_max(r->h, 1) - 1;
+
+  range.c0 = widget_spatial_index_col(index, r->x);
+  range.r0 = widget_spatial_index_row(index, r->y);
+  range.c1 = widget_spatial_index_col(index, right);
+  range.r1 = widget_spatial_index_row(index, bottom);
+  range.always = FALSE;
+
+  return range;
+}
+
+static widget_spatial_range_t widget_spatial_index_child_range(widget_spatial_index_t* index,
+                                                               widget_t* child, const rect_t* r) {
+  widget_spatial_range_t range = widget_spatial_index_range(index, r);
+  uint32_t span = (range.c1 - range.c0 + 1) * (range.r1 - range.r0 + 1);
+
+  range.always = child->vt->allow_draw_outside || child->vt->is_point_in != NULL ||
+                 span > WIDGET_SPATIAL_INDEX_MAX_SPAN;
+
+  return range;
+}
+
+static bool_t widget_spatial_range_eq(const widget_spatial_range_t* a,
+                                      const widget_spatial_range_t* b) {
+  if (a->always || b->always) {
+    return a->always == b->always;
+  }
+
+  return a->c0 == b->c0 && a->r0 == b->r0 && a->c1 == b->c1 && a->r1 == b->r1;
+}
+
+static ret_t widget_spatial_index_insert(widget_spatial_index_t* index,
+                                         const widget_spatial_range_t* range, uint32_t i) {
+  uint32_t col = 0;
+  uint32_t row = 0;
+
+  if (range->always) {
+    return widget_spatial_cell_add(&(index->always), i);
+  }
+
+  for (row = range->r0; row <= range->r1; row++) {
+    for (col = range->c0; col <= range->c1; col++) {
+      return_value_if_fail(
+          widget_spatial_cell_add(index->cells + row * index->cols + col, i) == RET_OK, RET_OOM);
+    }
+  }
+
+  return RET_OK;
+}
+
+static uint32_t widget_spatial_index_erase(widget_spatial_index_t* index,
+                                           const widget_spatial_range_t* range, widget_t* child) {
+  uint32_t col = 0;
+  uint32_t row = 0;
+  uint32_t i = (uint32_t)-1;
+  widget_t** children = (widget_t**)(index->widget->children->elms);
+
+  if (range->always) {
+    widget_spatial_cell_remove(&(index->always), children, child, &i);
+    return i;
+  }
+
+  for (row = range->r0; row <= range->r1; row++) {
+    for (col = range->c0; col <= range->c1; col++) {
+      widget_spatial_cell_remove(index->cells + row * index->cols + col, children, child, &i);
+    }
+  }
+
+  return i;
+}
+
+static ret_t widget_spatial_index_reset(widget_spatial_index_t* index) {
+  uint32_t i = 0;
+
+  for (i = 0; i < index->cols * index->rows; i++) {
+    TKMEM_FREE(index->cells[i].items);
+  }
+  TKMEM_FREE(index->cells);
+  TKMEM_FREE(index->always.items);
+  TKMEM_FREE(index->marks);
+  TKMEM_FREE(index->result);
+  memset(&(index->always), 0x00, sizeof(index->always));
+  index->cells = NULL;
+  index->marks = NULL;
+  index->result = NULL;
+  index->cols = 0;
+  index->rows = 0;
+  index->nr = 0;
+
+  return RET_OK;
+}
+
+static ret_t widget_spatial_index_build(widget_spatial_index_t* index) {
+  rect_t bounds = rect_init(0, 0, 0, 0);
+  widget_t* widget = index->widget;
+  uint32_t nr = widget_count_children(widget);
+  uint32_t cols = 0;
+  uint32_t rows = 0;
+
+  widget_spatial_index_reset(index);
+
+  WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
+  rect_t r = rect_init(iter->x, iter->y, tk_max(iter->w, 1), tk_max(iter->h, 1));
+  rect_merge(&bounds, &r);
+  WIDGET_FOR_EACH_CHILD_END();
+
+  /*网格的个数与子控件的个数相当，形状与子控件的分布范围相同*/
+  bounds.w = tk_max(bounds.w, 1);
+  bounds.h = tk_max(bounds.h, 1);
+  cols = (uint32_t)sqrt((double)nr * bounds.w / bounds.h);
+  cols = tk_clampi(cols, 1, WIDGET_SPATIAL_INDEX_MAX_DIM);
+  rows = tk_clampi((nr + cols - 1) / cols, 1, WIDGET_SPATIAL_INDEX_MAX_DIM);
+
+  index->x = bounds.x;
+  index->y = bounds.y;
+  index->cols = cols;
+  index->rows = rows;
+  index->cell_w = tk_max((bounds.w + cols - 1) / cols, 1);
+  index->cell_h = tk_max((bounds.h + rows - 1) / rows, 1);
+  index->nr = nr;
+  index->cells = TKMEM_ZALLOCN(widget_spatial_cell_t, cols * rows);
+  index->marks = TKMEM_ZALLOCN(uint32_t, nr);
+  index->result = TKMEM_ZALLOCN(uint32_t, nr);
+  index->stamp = 0;
+  if (index->cells == NULL || index->marks == NULL || index->result == NULL) {
+    index->cols = 0;
+    index->rows = 0;
+    widget_spatial_index_reset(index);
+    return RET_OOM;
+  }
+
+  WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
+  rect_t r = rect_init(iter->x, iter->y, iter->w, iter->h);
+  widget_spatial_range_t range = widget_spatial_index_child_range(index, iter, &r);
+  if (widget_spatial_index_insert(index, &range, i) != RET_OK) {
+    widget_spatial_index_reset(index);
+    return RET_OOM;
+  }
+  WIDGET_FOR_EACH_CHILD_END();
+
+  index->stale = FALSE;
+
+  return RET_OK;
+}
+
+static widget_spatial_index_t* widget_spatial_index_find(widget_t* widget) {
+  widget_spatial_index_t* iter = s_widget_spatial_indexes;
+
+  while (iter != NULL && iter->widget != widget) {
+    iter = iter->next;
+  }
+
+  return iter;
+}
+
+widget_spatial_index_t* widget_spatial_index_get(widget_t* widget) {
+  uint32_t nr = 0;
+  widget_spatial_index_t* index = NULL;
+  return_value_if_fail(widget != NULL, NULL);
+
+  nr = widget_count_children(widget);
+  if (widget->with_spatial_index) {
+    index = widget_spatial_index_find(widget);
+    return_value_if_fail(index != NULL, NULL);
+
+    if (index->stale || index->nr != nr) {
+      if (nr < TK_WIDGET_SPATIAL_INDEX_MIN_CHILDREN) {
+        widget_spatial_index_remove(widget);
+        return NULL;
+      }
+
+      if (widget_spatial_index_build(index) != RET_OK) {
+        widget_spatial_index_remove(widget);
+        return NULL;
+      }
+    }
+
+    return index;
+  }
+
+  if (TK_WIDGET_SPATIAL_INDEX_MIN_CHILDREN == 0 || nr < TK_WIDGET_SPATIAL_INDEX_MIN_CHILDREN ||
+      widget->destroying || widget_is_window_manager(widget)) {
+    return NULL;
+  }
+
+  index = TKMEM_ZALLOC(widget_spatial_index_t);
+  return_value_if_fail(index != NULL, NULL);
+
+  index->widget = widget;
+  if (widget_spatial_index_build(index) != RET_OK) {
+    TKMEM_FREE(index);
+    return NULL;
+  }
+
+  index->next = s_widget_spatial_indexes;
+  s_widget_spatial_indexes = index;
+  widget->with_spatial_index = TRUE;
+
+  return index;
+}
+
+static int widget_spatial_index_cmp(const void* a, const void* b) {
+  uint32_t ia = *(const uint32_t*)a;
+  uint32_t ib = *(const uint32_t*)b;
+
+  return ia < ib ? -1 : (ia > ib ? 1 : 0);
+}
+
+static uint32_t widget_spatial_index_collect(widget_spatial_index_t* index,
+                                             const widget_spatial_cell_t* cell, uint32_t n) {
+  uint32_t k = 0;
+
+  for (k = 0; k < cell->size; k++) {
+    uint32_t i = cell->items[k];
+
+    if (index->marks[i] != index->stamp) {
+      index->marks[i] = index->stamp;
+      index->result[n++] = i;
+    }
+  }
+
+  return n;
+}
+
+const uint32_t* widget_spatial_index_query(widget_spatial_index_t* index, const rect_t* r,
+                                           uint32_t* nr) {
+  uint32_t n = 0;
+  uint32_t col = 0;
+  uint32_t row = 0;
+  widget_spatial_range_t range;
+  return_value_if_fail(index != NULL && r != NULL && nr != NULL && !index->stale, NULL);
+
+  /*覆盖了一半以上的网格时，遍历全部子控件更快*/
+  range = widget_spatial_index_range(index, r);
+  if ((range.c1 - range.c0 + 1) * (range.r1 - range.r0 + 1) * 2 > index->cols * index->rows) {
+    return NULL;
+  }
+
+  index->stamp++;
+  if (index->stamp == 0) {
+    memset(index->marks, 0x00, index->nr * sizeof(uint32_t));
+    index->stamp = 1;
+  }
+
+  for (row = range.r0; row <= range.r1; row++) {
+    for (col = range.c0; col <= range.c1; col++) {
+      n = widget_spatial_index_collect(index, index->cells + row * index->cols + col, n);
+    }
+  }
+  n = widget_spatial_index_collect(index, &(index->always), n);
+
+  if (n > 1) {
+    qsort(index->result, n, sizeof(uint32_t), widget_spatial_index_cmp);
+  }
+  *nr = n;
+
+  return index->result;
+}
+
+ret_t widget_spatial_index_on_child_moved(widget_t* child, const rect_t* old) {
+  uint32_t i = 0;
+  rect_t r;
+  widget_spatial_range_t old_range;
+  widget_spatial_range_t new_range;
+  widget_spatial_index_t* index = NULL;
+  return_value_if_fail(child != NULL && old != NULL, RET_BAD_PARAMS);
+
+  if (child->parent == NULL || !child->parent->with_spatial_index) {
+    return RET_OK;
+  }
+
+  index = widget_spatial_index_find(child->parent);
+  if (index == NULL || index->stale) {
+    return RET_OK;
+  }
+
+  r = rect_init(child->x, child->y, child->w, child->h);
+  old_range = widget_spatial_index_child_range(index, child, old);
+  new_range = widget_spatial_index_child_range(index, child, &r);
+  if (widget_spatial_range_eq(&old_range, &new_range)) {
+    return RET_OK;
+  }
+
+  i = widget_spatial_index_erase(index, &old_range, child);
+  if (i == (uint32_t)-1) {
+    /*不应该出现，重建索引*/
+    index->stale = TRUE;
+    return RET_OK;
+  }
+
+  if (widget_spatial_index_insert(index, &new_range, i) != RET_OK) {
+    index->stale = TRUE;
+  }
+
+  return RET_OK;
+}
+
+ret_t widget_spatial_index_invalidate(widget_t* widget) {
+  widget_spatial_index_t* index = NULL;
+  return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+
+  if (widget->with_spatial_index) {
+    index = widget_spatial_index_find(widget);
+    if (index != NULL) {
+      index->stale = TRUE;
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t widget_spatial_index_remove(widget_t* widget) {
+  widget_spatial_index_t* iter = s_widget_spatial_indexes;
+  widget_spatial_index_t** prev = &s_widget_spatial_indexes;
+  return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+
+  if (!widget->with_spatial_index) {
+    return RET_OK;
+  }
+
+  while (iter != NULL) {
+    if (iter->widget == widget) {
+      *prev = iter->next;
+      widget_spatial_index_reset(iter);
+      TKMEM_FREE(iter);
+      break;
+    }
+    prev = &(iter->next);
+    iter = iter->next;
+  }
+  widget->with_spatial_index = FALSE;
+
+  return RET_OK;
+}
@@ -0,0 +1,96 @@
+﻿/**
+ * File:   widget_spatial_index.h
+ * Author: AWTK Develop Team
+ * Brief:  uniform grid of children for painting and hit testing
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_WIDGET_SPATIAL_INDEX_H
+#define TK_WIDGET_SPATIAL_INDEX_H
+
+#include "base/widget.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class widget_spatial_index_t
+ * 子控件的空间索引(均匀网格)。
+ *
+ * 子控件个数达到TK\_WIDGET\_SPATIAL\_INDEX\_MIN\_CHILDREN时，在第一次绘制或查找点击目标时自动创建。
+ * 绘制子控件和查找点击目标时只需要检查与裁剪区/点击位置所在网格相交的子控件，
+ * 并按子控件的序数(Z序)排序，结果与遍历全部子控件相同。
+ *
+ * 子控件移动/改变大小时增量更新，增加/删除/调整子控件顺序时标记为失效，下次使用时重建。
+ * 允许在自身范围外绘制(allow\_draw\_outside)或有自定义is\_point\_in的子控件总是被检查。
+ *
+ * > 直接修改子控件的x/y/w/h(比如在auto\_adjust\_size中)之后，需要调用widget\_spatial\_index\_on\_child\_moved。
+ * > 索引只能在GUI线程中使用，多线程并行绘制时遍历全部子控件。
+ */
+typedef struct _widget_spatial_index_t widget_spatial_index_t;
+
+/**
+ * @method widget_spatial_index_get
+ * 获取控件的子控件空间索引(需要时创建或重建)。
+ * @param {widget_t*} widget 控件。
+ *
+ * @return {widget_spatial_index_t*} 返回空间索引，子控件太少时返回NULL。
+ */
+widget_spatial_index_t* widget_spatial_index_get(widget_t* widget);
+
+/**
+ * @method widget_spatial_index_query
+ * 查找可能与指定区域相交的子控件。
+ * @param {widget_spatial_index_t*} index 空间索引。
+ * @param {const rect_t*} r 区域(相对于父控件)。
+ * @param {uint32_t*} nr 用于返回子控件的个数。
+ *
+ * @return {const uint32_t*} 返回子控件的序数(从小到大排列，下次查找之前有效)，区域太大时返回NULL(此时调用者应该遍历全部子控件)。
+ */
+const uint32_t* widget_spatial_index_query(widget_spatial_index_t* index, const rect_t* r,
+                                           uint32_t* nr);
+
+/**
+ * @method widget_spatial_index_on_child_moved
+ * 子控件移动或改变大小后调用，更新父控件的空间索引。
+ * @param {widget_t*} child 子控件。
+ * @param {const rect_t*} old 原来的位置和大小。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_spatial_index_on_child_moved(widget_t* child, const rect_t* old);
+
+/**
+ * @method widget_spatial_index_invalidate
+ * 增加/删除/调整子控件的顺序后调用，标记空间索引失效。
+ * @param {widget_t*} widget 控件。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_spatial_index_invalidate(widget_t* widget);
+
+/**
+ * @method widget_spatial_index_remove
+ * 删除控件的空间索引(控件销毁时调用)。
+ * @param {widget_t*} widget 控件。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_spatial_index_remove(widget_t* widget);
+
+END_C_DECLS
+
+#endif /*TK_WIDGET_SPATIAL_INDEX_H*/
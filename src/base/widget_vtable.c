@@ -20,6 +20,9 @@
  */
 
 #include "base/widget_vtable.h"
+#include "base/parallel_paint.h"
+#include "base/widget_spatial_index.h"
+#include "base/widget_occlusion.h"
 #include "tkc/mem.h"
 
 ret_t widget_invalidate_default(widget_t* widget, const rect_t* rect) {
@@ -97,14 +100,10 @@ ret_t widget_on_paint_self_default(widget_t* widget, canvas_t* c) {
   return RET_OK;
 }
 
-ret_t widget_on_paint_children_default(widget_t* widget, canvas_t* c) {
-  return_value_if_fail(widget != NULL && c != NULL, RET_BAD_PARAMS);
-
-  WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
-
+static ret_t widget_paint_child(widget_t* widget, widget_t* iter, canvas_t* c) {
   if (!iter->visible) {
     iter->dirty = FALSE;
-    continue;
+    return RET_OK;
   }
 
   if (!(iter->vt->allow_draw_outside)) {
@@ -116,12 +115,79 @@ ret_t widget_on_paint_children_default(widget_t* widget, canvas_t* c) {
 
     if (!canvas_is_rect_in_clip_rect(c, left, top, right, bottom)) {
       iter->dirty = FALSE;
-      continue;
+      return RET_OK;
     }
   }
 
-  widget_paint(iter, c);
+  return widget_paint(iter, c);
+}
+
+/*
+ * 子控件很多时，通过空间索引只绘制与裁剪区相交的子控件(按Z序)。
+ * 不在裁剪区内的子控件没有被访问，它们的dirty标志在下次被绘制时才清除。
+ *
+ * 索引在使用时才建立，查找结果也保存在索引中，多线程并行绘制时直接遍历全部子控件。
+ */
+static ret_t widget_paint_children_with_index(widget_t* widget, canvas_t* c) {
+  rect_t r;
+  uint32_t i = 0;
+  uint32_t nr = 0;
+  widget_occlusion_t occlusion;
+  const uint32_t* indexes = NULL;
+  widget_spatial_index_t* index = NULL;
+  int32_t tolerance = widget->dirty_rect_tolerance + 1;
+
+  if (parallel_paint_is_busy()) {
+    return RET_NOT_IMPL;
+  }
+
+  index = widget_spatial_index_get(widget);
+  if (index == NULL) {
+    return RET_NOT_IMPL;
+  }
+
+  r.x = c->clip_left - c->ox - tolerance;
+  r.y = c->clip_top - c->oy - tolerance;
+  r.w = c->clip_right - c->clip_left + 1 + 2 * tolerance;
+  r.h = c->clip_bottom - c->clip_top + 1 + 2 * tolerance;
+  indexes = widget_spatial_index_query(index, &r, &nr);
+  if (indexes == NULL) {
+    return RET_NOT_IMPL;
+  }
+
+  widget_occlusion_cull_children(&occlusion, widget, c, indexes, nr);
+  for (i = 0; i < nr && indexes[i] < widget->children->size; i++) {
+    widget_t* iter = WIDGET(widget->children->elms[indexes[i]]);
+
+    if (widget_occlusion_is_occluded(&occlusion, i)) {
+      iter->dirty = FALSE;
+    } else {
+      widget_paint_child(widget, iter, c);
+    }
+  }
+  widget_occlusion_deinit(&occlusion);
+
+  return RET_OK;
+}
+
+ret_t widget_on_paint_children_default(widget_t* widget, canvas_t* c) {
+  widget_occlusion_t occlusion;
+  return_value_if_fail(widget != NULL && c != NULL, RET_BAD_PARAMS);
+
+  if (widget->children != NULL && widget_paint_children_with_index(widget, c) == RET_OK) {
+    return RET_OK;
+  }
+
+  /*被上面不透明的兄弟控件完全遮住的子控件不用绘制*/
+  widget_occlusion_cull_children(&occlusion, widget, c, NULL, 0);
+  WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
+  if (widget_occlusion_is_occluded(&occlusion, i)) {
+    iter->dirty = FALSE;
+  } else {
+    widget_paint_child(widget, iter, c);
+  }
   WIDGET_FOR_EACH_CHILD_END();
+  widget_occlusion_deinit(&occlusion);
 
   return RET_OK;
 }
@@ -168,10 +234,17 @@ ret_t widget_set_prop_default(widget_t* widget, const char* name, const value_t*
   return RET_NOT_FOUND;
 }
 
+static bool_t widget_is_target(widget_t* iter, const point_t* p) {
+  if (!iter->sensitive || !iter->enable) {
+    return FALSE;
+  }
+
+  return widget_is_point_in(iter, p->x - iter->x, p->y - iter->y, TRUE);
+}
+
 widget_t* widget_find_target_default(widget_t* widget, xy_t x, xy_t y) {
-  xy_t xx = 0;
-  xy_t yy = 0;
   point_t p = {x, y};
+  widget_spatial_index_t* index = NULL;
   return_value_if_fail(widget != NULL, NULL);
 
   if (widget->grab_widget != NULL) {
@@ -179,17 +252,38 @@ widget_t* widget_find_target_default(widget_t* widget, xy_t x, xy_t y) {
   }
 
   widget_to_local(widget, &p);
-  WIDGET_FOR_EACH_CHILD_BEGIN_R(widget, iter, i)
-  if (!iter->sensitive || !iter->enable) {
-    continue;
+  if (widget->children != NULL) {
+    index = widget_spatial_index_get(widget);
   }
 
-  xx = p.x - iter->x;
-  yy = p.y - iter->y;
-  if (!widget_is_point_in(iter, xx, yy, TRUE)) {
-    continue;
+  if (index != NULL) {
+    uint32_t nr = 0;
+    rect_t r = rect_init(p.x, p.y, 1, 1);
+    const uint32_t* indexes = widget_spatial_index_query(index, &r, &nr);
+
+    if (indexes != NULL) {
+      while (nr > 0) {
+        widget_t* iter = NULL;
+
+        /*和绘制时一样，跳过索引中已经不存在的子控件*/
+        if (indexes[--nr] >= widget->children->size) {
+          continue;
+        }
+
+        iter = WIDGET(widget->children->elms[indexes[nr]]);
+        if (widget_is_target(iter, &p)) {
+          return iter;
+        }
+      }
+
+      return NULL;
+    }
+  }
+
+  WIDGET_FOR_EACH_CHILD_BEGIN_R(widget, iter, i)
+  if (widget_is_target(iter, &p)) {
+    return iter;
   }
-  return iter;
   WIDGET_FOR_EACH_CHILD_END();
 
   return NULL;
@@ -304,6 +304,11 @@ ret_t window_base_on_destroy(widget_t* widget) {
     window_base->save_focus_widget = NULL;
   }
 
+  if (window_base->name_index != NULL) {
+    widget_name_index_destroy(window_base->name_index);
+    window_base->name_index = NULL;
+  }
+
   TKMEM_FREE(window_base->theme);
   TKMEM_FREE(window_base->open_anim_hint);
   TKMEM_FREE(window_base->close_anim_hint);
@@ -24,6 +24,7 @@
 
 #include "base/widget.h"
 #include "base/native_window.h"
+#include "base/widget_name_index.h"
 
 BEGIN_C_DECLS
 
@@ -256,6 +257,9 @@ typedef struct _window_base_t {
   bool_t need_relayout;
   bool_t moving_focus_mode;
   bool_t pressed;
+  /*控件名称索引(见widget_lookup)*/
+  widget_name_index_t* name_index;
+  bool_t no_name_index;
 } window_base_t;
 
 /**
@@ -0,0 +1,270 @@
+﻿/**
+ * File:   window_snapshot_pool.c
+ * Author: AWTK Develop Team
+ * Brief:  reusable snapshot buffers for window animations
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "blend/image_g2d.h"
+#include "base/system_info.h"
+#include "base/canvas_offline.h"
+#include "base/window_snapshot_pool.h"
+
+#if !defined(WITH_GPU) && !defined(AWTK_WEB) && !defined(WITH_CANVAS_OFFLINE_CUSTION) && \
+    TK_WINDOW_SNAPSHOT_POOL_MAX_NR > 0
+#define WINDOW_SNAPSHOT_POOL_ENABLED 1
+#endif
+
+#ifdef WINDOW_SNAPSHOT_POOL_ENABLED
+typedef struct _window_snapshot_pool_entry_t {
+  canvas_t* canvas;
+  /*截图的位图还没有释放*/
+  bool_t busy;
+  /*window_snapshot_pool_clear时正在使用，释放位图时销毁*/
+  bool_t discard;
+} window_snapshot_pool_entry_t;
+
+static window_snapshot_pool_entry_t s_entries[TK_WINDOW_SNAPSHOT_POOL_MAX_NR];
+
+static ret_t window_snapshot_pool_destroy_entry(window_snapshot_pool_entry_t* entry) {
+  canvas_offline_t* canvas = (canvas_offline_t*)(entry->canvas);
+  system_info_t* info = system_info();
+
+  /*canvas_offline_destroy会恢复创建时的LCD大小，期间LCD大小可能已经改变*/
+  canvas->lcd_w = info->lcd_w;
+  canvas->lcd_h = info->lcd_h;
+  canvas_offline_destroy(entry->canvas);
+  memset(entry, 0x00, sizeof(*entry));
+
+  return RET_OK;
+}
+
+static window_snapshot_pool_entry_t* window_snapshot_pool_acquire(uint32_t w, uint32_t h,
+                                                                  bitmap_format_t format) {
+  uint32_t i = 0;
+  window_snapshot_pool_entry_t* idle = NULL;
+  window_snapshot_pool_entry_t* empty = NULL;
+
+  for (i = 0; i < ARRAY_SIZE(s_entries); i++) {
+    window_snapshot_pool_entry_t* iter = s_entries + i;
+
+    if (iter->canvas == NULL) {
+      if (empty == NULL) {
+        empty = iter;
+      }
+    } else if (!iter->busy) {
+      bitmap_t* bitmap = canvas_offline_get_bitmap(iter->canvas);
+
+      if (bitmap->w == w && bitmap->h == h && bitmap->format == format) {
+        iter->busy = TRUE;
+        return iter;
+      }
+
+      if (idle == NULL) {
+        idle = iter;
+      }
+    }
+  }
+
+  /*没有空位时，替换大小或格式不同的空闲缓冲区(如LCD大小改变了)*/
+  if (empty == NULL && idle != NULL) {
+    window_snapshot_pool_destroy_entry(idle);
+    empty = idle;
+  }
+
+  if (empty != NULL) {
+    empty->canvas = canvas_offline_create(w, h, format);
+    if (empty->canvas != NULL) {
+      empty->busy = TRUE;
+      return empty;
+    }
+  }
+
+  return NULL;
+}
+
+static window_snapshot_pool_entry_t* window_snapshot_pool_find_by_canvas(canvas_t* canvas) {
+  uint32_t i = 0;
+
+  for (i = 0; i < ARRAY_SIZE(s_entries); i++) {
+    if (s_entries[i].canvas != NULL && s_entries[i].canvas == canvas) {
+      return s_entries + i;
+    }
+  }
+
+  return NULL;
+}
+
+static window_snapshot_pool_entry_t* window_snapshot_pool_find_by_bitmap(bitmap_t* img) {
+  uint32_t i = 0;
+
+  for (i = 0; i < ARRAY_SIZE(s_entries); i++) {
+    window_snapshot_pool_entry_t* iter = s_entries + i;
+
+    if (iter->canvas != NULL && canvas_offline_get_bitmap(iter->canvas)->buffer == img->buffer) {
+      return iter;
+    }
+  }
+
+  return NULL;
+}
+
+static ret_t window_snapshot_pool_on_bitmap_destroy(bitmap_t* img) {
+  window_snapshot_pool_entry_t* entry = window_snapshot_pool_find_by_bitmap(img);
+
+  if (entry != NULL) {
+    entry->busy = FALSE;
+    if (entry->discard) {
+      window_snapshot_pool_destroy_entry(entry);
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t window_snapshot_pool_clear_rect(canvas_t* canvas, const rect_t* r) {
+  bitmap_t* bitmap = canvas_offline_get_bitmap(canvas);
+  rect_t all = rect_init(0, 0, bitmap->w, bitmap->h);
+  rect_t dirty = rect_intersect(&all, r);
+
+  /*只清除需要截图的区域，其它区域动画不会使用*/
+  if (dirty.w > 0 && dirty.h > 0) {
+    image_clear(bitmap, &dirty, color_init(0, 0, 0, 0));
+  }
+
+  return RET_OK;
+}
+#endif /*WINDOW_SNAPSHOT_POOL_ENABLED*/
+
+bitmap_format_t window_snapshot_pool_get_format(lcd_t* lcd) {
+  bitmap_format_t format = lcd_get_desired_bitmap_format(lcd);
+
+#if defined(WITH_WINDOW_SNAPSHOT_RGB565) && !defined(WITH_GPU)
+  /*截图是不透明的，16位足够显示动画过程*/
+  switch (format) {
+    case BITMAP_FMT_BGRA8888:
+    case BITMAP_FMT_BGR888: {
+      format = BITMAP_FMT_BGR565;
+      break;
+    }
+    case BITMAP_FMT_RGBA8888:
+    case BITMAP_FMT_RGB888: {
+      format = BITMAP_FMT_RGB565;
+      break;
+    }
+    default:
+      break;
+  }
+#endif /*WITH_WINDOW_SNAPSHOT_RGB565*/
+
+  return format;
+}
+
+canvas_t* window_snapshot_pool_begin(uint32_t w, uint32_t h, bitmap_format_t format,
+                                     const rect_t* r) {
+  canvas_t* canvas = NULL;
+  return_value_if_fail(r != NULL, NULL);
+
+#ifdef WINDOW_SNAPSHOT_POOL_ENABLED
+  {
+    window_snapshot_pool_entry_t* entry = window_snapshot_pool_acquire(w, h, format);
+
+    if (entry != NULL) {
+      canvas = entry->canvas;
+      window_snapshot_pool_clear_rect(canvas, r);
+    }
+  }
+#endif /*WINDOW_SNAPSHOT_POOL_ENABLED*/
+
+  if (canvas == NULL) {
+    canvas = canvas_offline_create(w, h, format);
+    return_value_if_fail(canvas != NULL, NULL);
+  }
+
+  canvas_offline_begin_draw(canvas);
+  canvas_set_clip_rect(canvas, r);
+
+  return canvas;
+}
+
+ret_t window_snapshot_pool_end(canvas_t* canvas, bitmap_t* img) {
+  ret_t ret = RET_OK;
+  return_value_if_fail(canvas != NULL && img != NULL, RET_BAD_PARAMS);
+
+  canvas_offline_end_draw(canvas);
+
+#ifdef WINDOW_SNAPSHOT_POOL_ENABLED
+  if (window_snapshot_pool_find_by_canvas(canvas) != NULL) {
+    bool_t should_free_handle = img->should_free_handle;
+
+    /*共享离线画布的缓冲区，bitmap_destroy时放回池中*/
+    canvas_offline_flush_bitmap(canvas);
+    memcpy(img, canvas_offline_get_bitmap(canvas), sizeof(bitmap_t));
+    img->should_free_data = FALSE;
+    img->should_free_handle = should_free_handle;
+    img->destroy = window_snapshot_pool_on_bitmap_destroy;
+    img->flags = BITMAP_FLAG_IMMUTABLE | BITMAP_FLAG_OPAQUE;
+
+    return RET_OK;
+  }
+#endif /*WINDOW_SNAPSHOT_POOL_ENABLED*/
+
+  ret = canvas_offline_bitmap_move_to_new_bitmap(canvas, img);
+  canvas_offline_destroy(canvas);
+  img->flags |= BITMAP_FLAG_OPAQUE;
+
+  return ret;
+}
+
+ret_t window_snapshot_pool_clear(void) {
+#ifdef WINDOW_SNAPSHOT_POOL_ENABLED
+  uint32_t i = 0;
+
+  for (i = 0; i < ARRAY_SIZE(s_entries); i++) {
+    window_snapshot_pool_entry_t* iter = s_entries + i;
+
+    if (iter->canvas != NULL) {
+      if (iter->busy) {
+        iter->discard = TRUE;
+      } else {
+        window_snapshot_pool_destroy_entry(iter);
+      }
+    }
+  }
+#endif /*WINDOW_SNAPSHOT_POOL_ENABLED*/
+
+  return RET_OK;
+}
+
+uint32_t window_snapshot_pool_get_size(void) {
+  uint32_t size = 0;
+#ifdef WINDOW_SNAPSHOT_POOL_ENABLED
+  uint32_t i = 0;
+
+  for (i = 0; i < ARRAY_SIZE(s_entries); i++) {
+    window_snapshot_pool_entry_t* iter = s_entries + i;
+
+    if (iter->canvas != NULL) {
+      bitmap_t* bitmap = canvas_offline_get_bitmap(iter->canvas);
+      size += bitmap->line_length * bitmap->h;
+    }
+  }
+#endif /*WINDOW_SNAPSHOT_POOL_ENABLED*/
+
+  return size;
+}
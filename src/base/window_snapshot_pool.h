@@ -0,0 +1,113 @@
+﻿/**
+ * File:   window_snapshot_pool.h
+ * Author: AWTK Develop Team
+ * Brief:  reusable snapshot buffers for window animations
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_WINDOW_SNAPSHOT_POOL_H
+#define TK_WINDOW_SNAPSHOT_POOL_H
+
+#include "base/lcd.h"
+#include "base/canvas.h"
+#include "base/bitmap.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class window_snapshot_pool_t
+ * @annotation ["fake"]
+ * 窗口动画截图的缓冲区池。
+ *
+ * 窗口打开和关闭的动画需要把前后两个窗口截图，每次都创建和释放全屏的位图，
+ * 在分辨率较高的设备上，会导致动画的第一帧明显卡顿。
+ *
+ * * 截图使用的离线画布(canvas\_offline)在动画结束后放回池中，下次动画直接使用，
+ *   最多保留TK\_WINDOW\_SNAPSHOT\_POOL\_MAX\_NR个。
+ * * 截图仍然使用屏幕坐标(窗口动画和对话框高亮策略不需要修改)，但是只清除和绘制窗口所在的区域，
+ *   对于popup之类只占一部分屏幕的窗口，只需要处理这一部分。
+ * * 定义WITH\_WINDOW\_SNAPSHOT\_RGB565时，32位和24位LCD的截图使用16位格式，内存和带宽减半，
+ *   动画过程中颜色精度略有降低。
+ * * 使用GPU、AWTK\_WEB或者自定义的离线画布时，不使用池，每次都创建新的位图。
+ *
+ * 截图的位图用bitmap\_destroy释放(放回池中)。
+ *
+ * ```c
+ * canvas_t* canvas = window_snapshot_pool_begin(w, h, format, &r);
+ * widget_paint(win, canvas);
+ * window_snapshot_pool_end(canvas, &img);
+ * ...
+ * bitmap_destroy(&img);
+ * ```
+ */
+
+/**
+ * @method window_snapshot_pool_get_format
+ * 获取截图使用的位图格式。
+ * @annotation ["static"]
+ * @param {lcd_t*} lcd lcd对象。
+ *
+ * @return {bitmap_format_t} 返回位图格式。
+ */
+bitmap_format_t window_snapshot_pool_get_format(lcd_t* lcd);
+
+/**
+ * @method window_snapshot_pool_begin
+ * 获取用于截图的离线画布(优先使用池中宽高和格式相同的)，清除r所在的区域，并把r设置为裁剪区。
+ * @annotation ["static"]
+ * @param {uint32_t} w 宽度。
+ * @param {uint32_t} h 高度。
+ * @param {bitmap_format_t} format 位图格式。
+ * @param {const rect_t*} r 需要截图的区域。
+ *
+ * @return {canvas_t*} 返回离线画布，失败返回NULL。
+ */
+canvas_t* window_snapshot_pool_begin(uint32_t w, uint32_t h, bitmap_format_t format,
+                                     const rect_t* r);
+
+/**
+ * @method window_snapshot_pool_end
+ * 结束截图，通过img返回截图的位图(不再使用时调用bitmap\_destroy)。
+ * @annotation ["static"]
+ * @param {canvas_t*} canvas window\_snapshot\_pool\_begin返回的离线画布。
+ * @param {bitmap_t*} img 用于返回截图的位图。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t window_snapshot_pool_end(canvas_t* canvas, bitmap_t* img);
+
+/**
+ * @method window_snapshot_pool_clear
+ * 释放池中空闲的缓冲区(正在使用的缓冲区在bitmap\_destroy时释放)。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t window_snapshot_pool_clear(void);
+
+/**
+ * @method window_snapshot_pool_get_size
+ * 获取池中缓冲区(包括正在使用的)占用的内存(字节)。
+ * @annotation ["static"]
+ *
+ * @return {uint32_t} 返回占用的内存。
+ */
+uint32_t window_snapshot_pool_get_size(void);
+
+END_C_DECLS
+
+#endif /*TK_WINDOW_SNAPSHOT_POOL_H*/
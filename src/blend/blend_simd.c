@@ -0,0 +1,846 @@
+﻿/**
+ * File:   blend_simd.c
+ * Author: AWTK Develop Team
+ * Brief:  simd kernels for image blending
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#include "blend/blend_simd.h"
+
+#ifndef WITHOUT_BLEND_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BLEND_SIMD_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BLEND_SIMD_AVX2 1
+#include <immintrin.h>
+#endif /*__GNUC__*/
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(__aarch64__)
+#define BLEND_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+#endif /*WITHOUT_BLEND_SIMD*/
+
+static inline bool_t blend_simd_alpha_in(const uint8_t* src, uint8_t lo, uint8_t hi) {
+  return src[3] >= lo && src[3] <= hi;
+}
+
+static inline uint32_t blend_simd_swap_rb(uint32_t c) {
+  return (c & 0xff00ff00) | ((c & 0xff) << 16) | ((c >> 16) & 0xff);
+}
+
+static inline uint16_t blend_simd_to_565(uint32_t c, bool_t swap_rb) {
+  if (swap_rb) {
+    return ((c >> 8) & 0xf800) | ((c >> 5) & 0x07e0) | ((c >> 3) & 0x001f);
+  } else {
+    return ((c << 8) & 0xf800) | ((c >> 5) & 0x07e0) | ((c >> 19) & 0x001f);
+  }
+}
+
+static uint32_t blend_simd_count_alpha_tail(const uint8_t* src, uint32_t i, uint32_t n, uint8_t lo,
+                                            uint8_t hi) {
+  while (i < n && blend_simd_alpha_in(src + i * 4, lo, hi)) {
+    i++;
+  }
+
+  return i;
+}
+
+static uint32_t blend_simd_count_u8_tail(const uint8_t* src, uint32_t i, uint32_t n, uint8_t lo,
+                                         uint8_t hi) {
+  while (i < n && src[i] >= lo && src[i] <= hi) {
+    i++;
+  }
+
+  return i;
+}
+
+static void blend_simd_copy_8888_tail(uint8_t* dst, const uint8_t* src, uint32_t i, uint32_t n,
+                                      bool_t swap_rb) {
+  uint32_t* d = (uint32_t*)dst;
+  const uint32_t* s = (const uint32_t*)src;
+
+  for (; i < n; i++) {
+    d[i] = swap_rb ? blend_simd_swap_rb(s[i]) : s[i];
+  }
+}
+
+static void blend_simd_pack_565_tail(uint8_t* dst, const uint8_t* src, uint32_t i, uint32_t n,
+                                     bool_t swap_rb) {
+  uint16_t* d = (uint16_t*)dst;
+  const uint32_t* s = (const uint32_t*)src;
+
+  for (; i < n; i++) {
+    d[i] = blend_simd_to_565(s[i], swap_rb);
+  }
+}
+
+static inline uint32_t blend_simd_from_565(uint16_t p) {
+  return 0xff000000 | ((p >> 8) & 0xf8) | ((p << 5) & 0xfc00) | ((p << 19) & 0xf80000);
+}
+
+/*
+ * 按blend_a的方法合成一个像素(第4个字节为alpha)。
+ * skip为目标是565时的8：a不大于skip时不处理。目标半透明时stop为TRUE，由调用者处理。
+ */
+static inline uint32_t blend_simd_blend_pixel(uint32_t d, uint32_t s, uint8_t alpha,
+                                              bool_t premulti_alpha, uint32_t skip,
+                                              bool_t* stop) {
+  uint32_t i = 0;
+  uint32_t r = 0xff000000;
+  uint32_t da = d >> 24;
+  uint32_t sa = s >> 24;
+  uint32_t a = alpha == 0xff ? sa : ((sa * alpha) >> 8);
+
+  *stop = FALSE;
+  if (a > 0xf8) {
+    return s;
+  } else if (a <= skip) {
+    return d;
+  } else if (da == 0) {
+    return (s & 0x00ffffff) | (a << 24);
+  } else if (da <= 0xf4) {
+    *stop = TRUE;
+    return d;
+  }
+
+  for (i = 0; i < 24; i += 8) {
+    uint32_t dc = (d >> i) & 0xff;
+    uint32_t sc = (s >> i) & 0xff;
+
+    if (premulti_alpha) {
+      if (alpha <= 0xf8) {
+        sc = (sc * alpha) >> 8;
+      }
+      r |= ((((dc * (0xff - a)) >> 8) + sc) & 0xff) << i;
+    } else {
+      r |= ((dc * (0xff - a) + sc * a) >> 8) << i;
+    }
+  }
+
+  return r;
+}
+
+static uint32_t blend_simd_blend_8888_tail(uint8_t* dst, const uint8_t* src, uint32_t i,
+                                           uint32_t n, uint8_t alpha, bool_t premulti_alpha,
+                                           bool_t swap_rb) {
+  bool_t stop = FALSE;
+  uint32_t* d = (uint32_t*)dst;
+  const uint32_t* s = (const uint32_t*)src;
+
+  for (; i < n; i++) {
+    uint32_t c = swap_rb ? blend_simd_swap_rb(s[i]) : s[i];
+    uint32_t p = blend_simd_blend_pixel(d[i], c, alpha, premulti_alpha, 0, &stop);
+
+    if (stop) {
+      break;
+    }
+    d[i] = p;
+  }
+
+  return i;
+}
+
+static void blend_simd_blend_565_tail(uint8_t* dst, const uint8_t* src, uint32_t i, uint32_t n,
+                                      uint8_t alpha, bool_t premulti_alpha, bool_t swap_rb) {
+  bool_t stop = FALSE;
+  uint16_t* d = (uint16_t*)dst;
+  const uint32_t* s = (const uint32_t*)src;
+
+  for (; i < n; i++) {
+    uint32_t c = swap_rb ? blend_simd_swap_rb(s[i]) : s[i];
+    uint32_t p = blend_simd_blend_pixel(blend_simd_from_565(d[i]), c, alpha, premulti_alpha, 8,
+                                        &stop);
+
+    d[i] = blend_simd_to_565(p, FALSE);
+  }
+}
+
+static inline uint32_t blend_simd_first_zero_bit(uint32_t bits) {
+  uint32_t i = 0;
+
+  while (bits & 1) {
+    bits >>= 1;
+    i++;
+  }
+
+  return i;
+}
+
+#ifdef BLEND_SIMD_SSE2
+static inline __m128i blend_simd_sse2_swap_rb(__m128i v) {
+  __m128i ag = _mm_and_si128(v, _mm_set1_epi32(0xff00ff00));
+  __m128i rb = _mm_and_si128(v, _mm_set1_epi32(0x00ff00ff));
+
+  rb = _mm_shufflehi_epi16(_mm_shufflelo_epi16(rb, 0xb1), 0xb1);
+
+  return _mm_or_si128(ag, rb);
+}
+
+static uint32_t blend_simd_sse2_count_alpha(const uint8_t* src, uint32_t n, uint8_t lo,
+                                            uint8_t hi) {
+  uint32_t i = 0;
+  __m128i vlo = _mm_set1_epi8((char)lo);
+  __m128i vhi = _mm_set1_epi8((char)hi);
+
+  for (; i + 4 <= n; i += 4) {
+    __m128i v = _mm_loadu_si128((const __m128i*)(src + i * 4));
+    __m128i in = _mm_and_si128(_mm_cmpeq_epi8(_mm_max_epu8(v, vlo), v),
+                               _mm_cmpeq_epi8(_mm_min_epu8(v, vhi), v));
+    uint32_t mask = _mm_movemask_epi8(in) & 0x8888;
+
+    if (mask != 0x8888) {
+      return i + blend_simd_first_zero_bit(((mask >> 3) & 0x1) | ((mask >> 6) & 0x2) |
+                                           ((mask >> 9) & 0x4) | ((mask >> 12) & 0x8));
+    }
+  }
+
+  return blend_simd_count_alpha_tail(src, i, n, lo, hi);
+}
+
+static uint32_t blend_simd_sse2_count_u8(const uint8_t* src, uint32_t n, uint8_t lo, uint8_t hi) {
+  uint32_t i = 0;
+  __m128i vlo = _mm_set1_epi8((char)lo);
+  __m128i vhi = _mm_set1_epi8((char)hi);
+
+  for (; i + 16 <= n; i += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+    __m128i in = _mm_and_si128(_mm_cmpeq_epi8(_mm_max_epu8(v, vlo), v),
+                               _mm_cmpeq_epi8(_mm_min_epu8(v, vhi), v));
+    uint32_t mask = _mm_movemask_epi8(in);
+
+    if (mask != 0xffff) {
+      return i + blend_simd_first_zero_bit(mask);
+    }
+  }
+
+  return blend_simd_count_u8_tail(src, i, n, lo, hi);
+}
+
+static void blend_simd_sse2_copy_8888(uint8_t* dst, const uint8_t* src, uint32_t n,
+                                      bool_t swap_rb) {
+  uint32_t i = 0;
+
+  if (!swap_rb) {
+    memcpy(dst, src, n * 4);
+    return;
+  }
+
+  for (; i + 4 <= n; i += 4) {
+    __m128i v = _mm_loadu_si128((const __m128i*)(src + i * 4));
+    _mm_storeu_si128((__m128i*)(dst + i * 4), blend_simd_sse2_swap_rb(v));
+  }
+
+  blend_simd_copy_8888_tail(dst, src, i, n, swap_rb);
+}
+
+static void blend_simd_sse2_pack_565(uint8_t* dst, const uint8_t* src, uint32_t n,
+                                     bool_t swap_rb) {
+  uint32_t i = 0;
+  __m128i mask_r = _mm_set1_epi32(0xf800);
+  __m128i mask_g = _mm_set1_epi32(0x07e0);
+  __m128i mask_b = _mm_set1_epi32(0x001f);
+
+  for (; i + 8 <= n; i += 8) {
+    __m128i v0 = _mm_loadu_si128((const __m128i*)(src + i * 4));
+    __m128i v1 = _mm_loadu_si128((const __m128i*)(src + i * 4 + 16));
+
+    if (swap_rb) {
+      v0 = blend_simd_sse2_swap_rb(v0);
+      v1 = blend_simd_sse2_swap_rb(v1);
+    }
+
+    v0 = _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_slli_epi32(v0, 8), mask_r),
+                                   _mm_and_si128(_mm_srli_epi32(v0, 5), mask_g)),
+                      _mm_and_si128(_mm_srli_epi32(v0, 19), mask_b));
+    v1 = _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_slli_epi32(v1, 8), mask_r),
+                                   _mm_and_si128(_mm_srli_epi32(v1, 5), mask_g)),
+                      _mm_and_si128(_mm_srli_epi32(v1, 19), mask_b));
+
+    /*sign extend so that _mm_packs_epi32 does not saturate.*/
+    v0 = _mm_srai_epi32(_mm_slli_epi32(v0, 16), 16);
+    v1 = _mm_srai_epi32(_mm_slli_epi32(v1, 16), 16);
+    _mm_storeu_si128((__m128i*)(dst + i * 2), _mm_packs_epi32(v0, v1));
+  }
+
+  blend_simd_pack_565_tail(dst, src, i, n, swap_rb);
+}
+
+static inline __m128i blend_simd_sse2_select(__m128i mask, __m128i a, __m128i b) {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static inline __m128i blend_simd_sse2_blend_channels(__m128i d, __m128i s, __m128i a,
+                                                     uint8_t alpha, bool_t premulti_alpha) {
+  __m128i ia = _mm_sub_epi16(_mm_set1_epi16(0xff), a);
+
+  if (premulti_alpha) {
+    if (alpha <= 0xf8) {
+      s = _mm_srli_epi16(_mm_mullo_epi16(s, _mm_set1_epi16(alpha)), 8);
+    }
+    d = _mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(d, ia), 8), s);
+    return _mm_and_si128(d, _mm_set1_epi16(0xff));
+  } else {
+    return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(d, ia), _mm_mullo_epi16(s, a)), 8);
+  }
+}
+
+/*
+ * 按blend_a的方法合成4个像素，与blend_simd_blend_pixel一致。
+ * stop返回目标像素半透明、需要由调用者处理的像素的掩码(每个像素1位)。
+ */
+static inline __m128i blend_simd_sse2_blend(__m128i d, __m128i s, uint8_t alpha,
+                                            bool_t premulti_alpha, int32_t skip,
+                                            uint32_t* stop) {
+  __m128i a4;
+  __m128i ret;
+  __m128i zero = _mm_setzero_si128();
+  __m128i mask_a = _mm_set1_epi32(0xff000000);
+  __m128i da = _mm_srli_epi32(d, 24);
+  __m128i a = _mm_srli_epi32(s, 24);
+  __m128i copy, live, dzero, dopaque;
+
+  if (alpha != 0xff) {
+    a = _mm_srli_epi32(_mm_mullo_epi16(a, _mm_set1_epi32(alpha)), 8);
+  }
+
+  copy = _mm_cmpgt_epi32(a, _mm_set1_epi32(0xf8));
+  live = _mm_cmpgt_epi32(a, _mm_set1_epi32(skip));
+  dzero = _mm_cmpeq_epi32(da, zero);
+  dopaque = _mm_cmpgt_epi32(da, _mm_set1_epi32(0xf4));
+  *stop = _mm_movemask_ps(_mm_castsi128_ps(
+      _mm_andnot_si128(_mm_or_si128(_mm_or_si128(copy, dzero), dopaque), live)));
+
+  a4 = _mm_or_si128(a, _mm_slli_epi32(a, 8));
+  a4 = _mm_or_si128(a4, _mm_slli_epi32(a4, 16));
+  ret = _mm_packus_epi16(blend_simd_sse2_blend_channels(_mm_unpacklo_epi8(d, zero),
+                                                        _mm_unpacklo_epi8(s, zero),
+                                                        _mm_unpacklo_epi8(a4, zero), alpha,
+                                                        premulti_alpha),
+                         blend_simd_sse2_blend_channels(_mm_unpackhi_epi8(d, zero),
+                                                        _mm_unpackhi_epi8(s, zero),
+                                                        _mm_unpackhi_epi8(a4, zero), alpha,
+                                                        premulti_alpha));
+  ret = _mm_or_si128(ret, mask_a);
+  ret = blend_simd_sse2_select(
+      dzero, _mm_or_si128(_mm_andnot_si128(mask_a, s), _mm_slli_epi32(a, 24)), ret);
+  ret = blend_simd_sse2_select(copy, s, ret);
+
+  return blend_simd_sse2_select(live, ret, d);
+}
+
+static uint32_t blend_simd_sse2_blend_8888(uint8_t* dst, const uint8_t* src, uint32_t n,
+                                           uint8_t alpha, bool_t premulti_alpha, bool_t swap_rb) {
+  uint32_t i = 0;
+  uint32_t stop = 0;
+
+  for (; i + 4 <= n; i += 4) {
+    __m128i d = _mm_loadu_si128((const __m128i*)(dst + i * 4));
+    __m128i s = _mm_loadu_si128((const __m128i*)(src + i * 4));
+
+    if (swap_rb) {
+      s = blend_simd_sse2_swap_rb(s);
+    }
+
+    d = blend_simd_sse2_blend(d, s, alpha, premulti_alpha, 0, &stop);
+    if (stop != 0) {
+      break;
+    }
+    _mm_storeu_si128((__m128i*)(dst + i * 4), d);
+  }
+
+  return blend_simd_blend_8888_tail(dst, src, i, n, alpha, premulti_alpha, swap_rb);
+}
+
+static void blend_simd_sse2_blend_565(uint8_t* dst, const uint8_t* src, uint32_t n,
+                                      uint8_t alpha, bool_t premulti_alpha, bool_t swap_rb) {
+  uint32_t i = 0;
+  uint32_t stop = 0;
+  __m128i zero = _mm_setzero_si128();
+  __m128i mask_r = _mm_set1_epi32(0xf800);
+  __m128i mask_g = _mm_set1_epi32(0x07e0);
+  __m128i mask_b = _mm_set1_epi32(0x001f);
+
+  for (; i + 4 <= n; i += 4) {
+    __m128i p = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)(dst + i * 2)), zero);
+    __m128i s = _mm_loadu_si128((const __m128i*)(src + i * 4));
+    __m128i d = _mm_set1_epi32(0xff000000);
+
+    d = _mm_or_si128(d, _mm_and_si128(_mm_srli_epi32(p, 8), _mm_set1_epi32(0xf8)));
+    d = _mm_or_si128(d, _mm_and_si128(_mm_slli_epi32(p, 5), _mm_set1_epi32(0xfc00)));
+    d = _mm_or_si128(d, _mm_and_si128(_mm_slli_epi32(p, 19), _mm_set1_epi32(0xf80000)));
+    if (swap_rb) {
+      s = blend_simd_sse2_swap_rb(s);
+    }
+
+    d = blend_simd_sse2_blend(d, s, alpha, premulti_alpha, 8, &stop);
+    d = _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_slli_epi32(d, 8), mask_r),
+                                  _mm_and_si128(_mm_srli_epi32(d, 5), mask_g)),
+                     _mm_and_si128(_mm_srli_epi32(d, 19), mask_b));
+    d = _mm_srai_epi32(_mm_slli_epi32(d, 16), 16);
+    _mm_storel_epi64((__m128i*)(dst + i * 2), _mm_packs_epi32(d, d));
+  }
+
+  blend_simd_blend_565_tail(dst, src, i, n, alpha, premulti_alpha, swap_rb);
+}
+
+static void blend_simd_sse2_transpose_32(uint8_t* dst, int32_t dst_stride, const uint8_t* src,
+                                         int32_t src_stride, bool_t reverse) {
+  uint32_t j = 0;
+  __m128i c[4];
+  __m128i r0 = _mm_loadu_si128((const __m128i*)(src));
+  __m128i r1 = _mm_loadu_si128((const __m128i*)(src + src_stride));
+  __m128i r2 = _mm_loadu_si128((const __m128i*)(src + src_stride * 2));
+  __m128i r3 = _mm_loadu_si128((const __m128i*)(src + src_stride * 3));
+  __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+  __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+  __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+  __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+
+  c[0] = _mm_unpacklo_epi64(t0, t1);
+  c[1] = _mm_unpackhi_epi64(t0, t1);
+  c[2] = _mm_unpacklo_epi64(t2, t3);
+  c[3] = _mm_unpackhi_epi64(t2, t3);
+
+  for (j = 0; j < 4; j++) {
+    __m128i v = reverse ? _mm_shuffle_epi32(c[j], 0x1b) : c[j];
+    _mm_storeu_si128((__m128i*)(dst + dst_stride * (int32_t)j), v);
+  }
+}
+
+static void blend_simd_sse2_transpose_16(uint8_t* dst, int32_t dst_stride, const uint8_t* src,
+                                         int32_t src_stride, bool_t reverse) {
+  uint32_t j = 0;
+  __m128i r[8];
+  __m128i a[8];
+  __m128i b[8];
+
+  for (j = 0; j < 8; j++) {
+    r[j] = _mm_loadu_si128((const __m128i*)(src + src_stride * (int32_t)j));
+  }
+
+  for (j = 0; j < 4; j++) {
+    a[j] = _mm_unpacklo_epi16(r[j * 2], r[j * 2 + 1]);
+    a[j + 4] = _mm_unpackhi_epi16(r[j * 2], r[j * 2 + 1]);
+  }
+
+  for (j = 0; j < 2; j++) {
+    b[j * 4] = _mm_unpacklo_epi32(a[j * 4], a[j * 4 + 1]);
+    b[j * 4 + 1] = _mm_unpacklo_epi32(a[j * 4 + 2], a[j * 4 + 3]);
+    b[j * 4 + 2] = _mm_unpackhi_epi32(a[j * 4], a[j * 4 + 1]);
+    b[j * 4 + 3] = _mm_unpackhi_epi32(a[j * 4 + 2], a[j * 4 + 3]);
+  }
+
+  for (j = 0; j < 4; j++) {
+    r[j * 2] = _mm_unpacklo_epi64(b[j * 2], b[j * 2 + 1]);
+    r[j * 2 + 1] = _mm_unpackhi_epi64(b[j * 2], b[j * 2 + 1]);
+  }
+
+  for (j = 0; j < 8; j++) {
+    __m128i v = r[j];
+    if (reverse) {
+      v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0x1b), 0x1b);
+      v = _mm_shuffle_epi32(v, 0x4e);
+    }
+    _mm_storeu_si128((__m128i*)(dst + dst_stride * (int32_t)j), v);
+  }
+}
+
+static const blend_simd_t s_blend_simd_sse2 = {
+    "sse2",
+    blend_simd_sse2_count_alpha,
+    blend_simd_sse2_count_u8,
+    blend_simd_sse2_copy_8888,
+    blend_simd_sse2_pack_565,
+    blend_simd_sse2_blend_8888,
+    blend_simd_sse2_blend_565,
+    blend_simd_sse2_transpose_32,
+    blend_simd_sse2_transpose_16,
+};
+#endif /*BLEND_SIMD_SSE2*/
+
+#ifdef BLEND_SIMD_AVX2
+#define BLEND_SIMD_AVX2_FUNC __attribute__((target("avx2")))
+
+BLEND_SIMD_AVX2_FUNC static uint32_t blend_simd_avx2_count_alpha(const uint8_t* src, uint32_t n,
+                                                                 uint8_t lo, uint8_t hi) {
+  uint32_t i = 0;
+  __m256i vlo = _mm256_set1_epi8((char)lo);
+  __m256i vhi = _mm256_set1_epi8((char)hi);
+
+  for (; i + 8 <= n; i += 8) {
+    __m256i v = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+    __m256i in = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(v, vlo), v),
+                                  _mm256_cmpeq_epi8(_mm256_min_epu8(v, vhi), v));
+    uint32_t mask = (uint32_t)_mm256_movemask_epi8(in) & 0x88888888u;
+
+    if (mask != 0x88888888u) {
+      uint32_t k = 0;
+      while (mask & (0x8u << (k * 4))) {
+        k++;
+      }
+      return i + k;
+    }
+  }
+
+  return blend_simd_count_alpha_tail(src, i, n, lo, hi);
+}
+
+BLEND_SIMD_AVX2_FUNC static uint32_t blend_simd_avx2_count_u8(const uint8_t* src, uint32_t n,
+                                                              uint8_t lo, uint8_t hi) {
+  uint32_t i = 0;
+  __m256i vlo = _mm256_set1_epi8((char)lo);
+  __m256i vhi = _mm256_set1_epi8((char)hi);
+
+  for (; i + 32 <= n; i += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+    __m256i in = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(v, vlo), v),
+                                  _mm256_cmpeq_epi8(_mm256_min_epu8(v, vhi), v));
+    uint32_t mask = (uint32_t)_mm256_movemask_epi8(in);
+
+    if (mask != 0xffffffffu) {
+      return i + blend_simd_first_zero_bit(mask);
+    }
+  }
+
+  return blend_simd_count_u8_tail(src, i, n, lo, hi);
+}
+
+BLEND_SIMD_AVX2_FUNC static void blend_simd_avx2_copy_8888(uint8_t* dst, const uint8_t* src,
+                                                           uint32_t n, bool_t swap_rb) {
+  uint32_t i = 0;
+  __m256i shuffle =
+      _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4,
+                       7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+  if (!swap_rb) {
+    memcpy(dst, src, n * 4);
+    return;
+  }
+
+  for (; i + 8 <= n; i += 8) {
+    __m256i v = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+    _mm256_storeu_si256((__m256i*)(dst + i * 4), _mm256_shuffle_epi8(v, shuffle));
+  }
+
+  blend_simd_copy_8888_tail(dst, src, i, n, swap_rb);
+}
+
+BLEND_SIMD_AVX2_FUNC static void blend_simd_avx2_pack_565(uint8_t* dst, const uint8_t* src,
+                                                          uint32_t n, bool_t swap_rb) {
+  uint32_t i = 0;
+  __m256i mask_r = _mm256_set1_epi32(0xf800);
+  __m256i mask_g = _mm256_set1_epi32(0x07e0);
+  __m256i mask_b = _mm256_set1_epi32(0x001f);
+  __m256i shuffle =
+      _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4,
+                       7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+  for (; i + 16 <= n; i += 16) {
+    __m256i v0 = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+    __m256i v1 = _mm256_loadu_si256((const __m256i*)(src + i * 4 + 32));
+
+    if (swap_rb) {
+      v0 = _mm256_shuffle_epi8(v0, shuffle);
+      v1 = _mm256_shuffle_epi8(v1, shuffle);
+    }
+
+    v0 = _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(_mm256_slli_epi32(v0, 8), mask_r),
+                                         _mm256_and_si256(_mm256_srli_epi32(v0, 5), mask_g)),
+                         _mm256_and_si256(_mm256_srli_epi32(v0, 19), mask_b));
+    v1 = _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(_mm256_slli_epi32(v1, 8), mask_r),
+                                         _mm256_and_si256(_mm256_srli_epi32(v1, 5), mask_g)),
+                         _mm256_and_si256(_mm256_srli_epi32(v1, 19), mask_b));
+
+    /*packus works on 128 bits lanes, so the result needs a permute.*/
+    v0 = _mm256_permute4x64_epi64(_mm256_packus_epi32(v0, v1), 0xd8);
+    _mm256_storeu_si256((__m256i*)(dst + i * 2), v0);
+  }
+
+  blend_simd_pack_565_tail(dst, src, i, n, swap_rb);
+}
+
+static const blend_simd_t s_blend_simd_avx2 = {
+    "avx2",
+    blend_simd_avx2_count_alpha,
+    blend_simd_avx2_count_u8,
+    blend_simd_avx2_copy_8888,
+    blend_simd_avx2_pack_565,
+    /*半透明的段通常很短，转置的块也很小，AVX2没有明显的优势，使用SSE2的版本。*/
+    blend_simd_sse2_blend_8888,
+    blend_simd_sse2_blend_565,
+    blend_simd_sse2_transpose_32,
+    blend_simd_sse2_transpose_16,
+};
+#endif /*BLEND_SIMD_AVX2*/
+
+#ifdef BLEND_SIMD_NEON
+static uint32_t blend_simd_neon_count_alpha(const uint8_t* src, uint32_t n, uint8_t lo,
+                                            uint8_t hi) {
+  uint32_t i = 0;
+  uint8x8_t vlo = vdup_n_u8(lo);
+  uint8x8_t vhi = vdup_n_u8(hi);
+
+  for (; i + 8 <= n; i += 8) {
+    uint8x8x4_t v = vld4_u8(src + i * 4);
+    uint8x8_t in = vand_u8(vcge_u8(v.val[3], vlo), vcle_u8(v.val[3], vhi));
+    uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(in), 0);
+
+    if (mask != 0xffffffffffffffffull) {
+      uint32_t k = 0;
+      while ((mask >> (k * 8)) & 0xff) {
+        k++;
+      }
+      return i + k;
+    }
+  }
+
+  return blend_simd_count_alpha_tail(src, i, n, lo, hi);
+}
+
+static uint32_t blend_simd_neon_count_u8(const uint8_t* src, uint32_t n, uint8_t lo, uint8_t hi) {
+  uint32_t i = 0;
+  uint8x8_t vlo = vdup_n_u8(lo);
+  uint8x8_t vhi = vdup_n_u8(hi);
+
+  for (; i + 8 <= n; i += 8) {
+    uint8x8_t v = vld1_u8(src + i);
+    uint8x8_t in = vand_u8(vcge_u8(v, vlo), vcle_u8(v, vhi));
+    uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(in), 0);
+
+    if (mask != 0xffffffffffffffffull) {
+      uint32_t k = 0;
+      while ((mask >> (k * 8)) & 0xff) {
+        k++;
+      }
+      return i + k;
+    }
+  }
+
+  return blend_simd_count_u8_tail(src, i, n, lo, hi);
+}
+
+static void blend_simd_neon_copy_8888(uint8_t* dst, const uint8_t* src, uint32_t n,
+                                      bool_t swap_rb) {
+  uint32_t i = 0;
+
+  if (!swap_rb) {
+    memcpy(dst, src, n * 4);
+    return;
+  }
+
+  for (; i + 16 <= n; i += 16) {
+    uint8x16x4_t v = vld4q_u8(src + i * 4);
+    uint8x16_t t = v.val[0];
+
+    v.val[0] = v.val[2];
+    v.val[2] = t;
+    vst4q_u8(dst + i * 4, v);
+  }
+
+  blend_simd_copy_8888_tail(dst, src, i, n, swap_rb);
+}
+
+static void blend_simd_neon_pack_565(uint8_t* dst, const uint8_t* src, uint32_t n,
+                                     bool_t swap_rb) {
+  uint32_t i = 0;
+
+  for (; i + 8 <= n; i += 8) {
+    uint8x8x4_t v = vld4_u8(src + i * 4);
+    uint8x8_t h = swap_rb ? v.val[2] : v.val[0];
+    uint8x8_t l = swap_rb ? v.val[0] : v.val[2];
+    uint16x8_t p = vshlq_n_u16(vmovl_u8(vshr_n_u8(h, 3)), 11);
+
+    p = vorrq_u16(p, vshlq_n_u16(vmovl_u8(vshr_n_u8(v.val[1], 2)), 5));
+    p = vorrq_u16(p, vmovl_u8(vshr_n_u8(l, 3)));
+    vst1q_u16((uint16_t*)(dst + i * 2), p);
+  }
+
+  blend_simd_pack_565_tail(dst, src, i, n, swap_rb);
+}
+
+static inline uint8x8_t blend_simd_neon_blend_channel(uint8x8_t d, uint8x8_t s, uint8x8_t a,
+                                                      uint8_t alpha, bool_t premulti_alpha) {
+  uint8x8_t ia = vmvn_u8(a);
+
+  if (premulti_alpha) {
+    if (alpha <= 0xf8) {
+      s = vshrn_n_u16(vmull_u8(s, vdup_n_u8(alpha)), 8);
+    }
+    return vadd_u8(vshrn_n_u16(vmull_u8(d, ia), 8), s);
+  } else {
+    return vshrn_n_u16(vmlal_u8(vmull_u8(d, ia), s, a), 8);
+  }
+}
+
+/*
+ * 按blend_a的方法合成8个像素，与blend_simd_blend_pixel一致。
+ * 返回目标像素半透明、需要由调用者处理的像素的掩码。
+ */
+static inline uint64_t blend_simd_neon_blend(uint8x8x4_t* d, uint8x8x4_t* s, uint8_t alpha,
+                                             bool_t premulti_alpha, uint8_t skip) {
+  uint32_t i = 0;
+  uint8x8_t a = s->val[3];
+  uint8x8_t copy, live, dzero, dopaque, stop;
+
+  if (alpha != 0xff) {
+    a = vshrn_n_u16(vmull_u8(a, vdup_n_u8(alpha)), 8);
+  }
+
+  copy = vcgt_u8(a, vdup_n_u8(0xf8));
+  live = vcgt_u8(a, vdup_n_u8(skip));
+  dzero = vceq_u8(d->val[3], vdup_n_u8(0));
+  dopaque = vcgt_u8(d->val[3], vdup_n_u8(0xf4));
+  stop = vbic_u8(live, vorr_u8(vorr_u8(copy, dzero), dopaque));
+
+  for (i = 0; i < 3; i++) {
+    uint8x8_t c = blend_simd_neon_blend_channel(d->val[i], s->val[i], a, alpha, premulti_alpha);
+
+    c = vbsl_u8(vorr_u8(copy, dzero), s->val[i], c);
+    d->val[i] = vbsl_u8(live, c, d->val[i]);
+  }
+  a = vbsl_u8(copy, s->val[3], vbsl_u8(dzero, a, vdup_n_u8(0xff)));
+  d->val[3] = vbsl_u8(live, a, d->val[3]);
+
+  return vget_lane_u64(vreinterpret_u64_u8(stop), 0);
+}
+
+static uint32_t blend_simd_neon_blend_8888(uint8_t* dst, const uint8_t* src, uint32_t n,
+                                           uint8_t alpha, bool_t premulti_alpha, bool_t swap_rb) {
+  uint32_t i = 0;
+
+  for (; i + 8 <= n; i += 8) {
+    uint8x8x4_t d = vld4_u8(dst + i * 4);
+    uint8x8x4_t s = vld4_u8(src + i * 4);
+
+    if (swap_rb) {
+      uint8x8_t t = s.val[0];
+      s.val[0] = s.val[2];
+      s.val[2] = t;
+    }
+
+    if (blend_simd_neon_blend(&d, &s, alpha, premulti_alpha, 0) != 0) {
+      break;
+    }
+    vst4_u8(dst + i * 4, d);
+  }
+
+  return blend_simd_blend_8888_tail(dst, src, i, n, alpha, premulti_alpha, swap_rb);
+}
+
+static void blend_simd_neon_blend_565(uint8_t* dst, const uint8_t* src, uint32_t n,
+                                      uint8_t alpha, bool_t premulti_alpha, bool_t swap_rb) {
+  uint32_t i = 0;
+
+  for (; i + 8 <= n; i += 8) {
+    uint8x8x4_t d;
+    uint16x8_t p = vld1q_u16((const uint16_t*)(dst + i * 2));
+    uint8x8x4_t s = vld4_u8(src + i * 4);
+
+    if (swap_rb) {
+      uint8x8_t t = s.val[0];
+      s.val[0] = s.val[2];
+      s.val[2] = t;
+    }
+
+    d.val[0] = vand_u8(vmovn_u16(vshrq_n_u16(p, 8)), vdup_n_u8(0xf8));
+    d.val[1] = vand_u8(vmovn_u16(vshrq_n_u16(p, 3)), vdup_n_u8(0xfc));
+    d.val[2] = vand_u8(vmovn_u16(vshlq_n_u16(p, 3)), vdup_n_u8(0xf8));
+    d.val[3] = vdup_n_u8(0xff);
+    blend_simd_neon_blend(&d, &s, alpha, premulti_alpha, 8);
+
+    p = vshlq_n_u16(vmovl_u8(vshr_n_u8(d.val[0], 3)), 11);
+    p = vorrq_u16(p, vshlq_n_u16(vmovl_u8(vshr_n_u8(d.val[1], 2)), 5));
+    p = vorrq_u16(p, vmovl_u8(vshr_n_u8(d.val[2], 3)));
+    vst1q_u16((uint16_t*)(dst + i * 2), p);
+  }
+
+  blend_simd_blend_565_tail(dst, src, i, n, alpha, premulti_alpha, swap_rb);
+}
+
+static void blend_simd_neon_transpose_32(uint8_t* dst, int32_t dst_stride, const uint8_t* src,
+                                         int32_t src_stride, bool_t reverse) {
+  uint32_t j = 0;
+  uint32x4_t c[4];
+  uint32x4x2_t t01 = vtrnq_u32(vld1q_u32((const uint32_t*)(src)),
+                               vld1q_u32((const uint32_t*)(src + src_stride)));
+  uint32x4x2_t t23 = vtrnq_u32(vld1q_u32((const uint32_t*)(src + src_stride * 2)),
+                               vld1q_u32((const uint32_t*)(src + src_stride * 3)));
+
+  c[0] = vcombine_u32(vget_low_u32(t01.val[0]), vget_low_u32(t23.val[0]));
+  c[1] = vcombine_u32(vget_low_u32(t01.val[1]), vget_low_u32(t23.val[1]));
+  c[2] = vcombine_u32(vget_high_u32(t01.val[0]), vget_high_u32(t23.val[0]));
+  c[3] = vcombine_u32(vget_high_u32(t01.val[1]), vget_high_u32(t23.val[1]));
+
+  for (j = 0; j < 4; j++) {
+    uint32x4_t v = c[j];
+    if (reverse) {
+      v = vrev64q_u32(v);
+      v = vcombine_u32(vget_high_u32(v), vget_low_u32(v));
+    }
+    vst1q_u32((uint32_t*)(dst + dst_stride * (int32_t)j), v);
+  }
+}
+
+static const blend_simd_t s_blend_simd_neon = {
+    "neon",
+    blend_simd_neon_count_alpha,
+    blend_simd_neon_count_u8,
+    blend_simd_neon_copy_8888,
+    blend_simd_neon_pack_565,
+    blend_simd_neon_blend_8888,
+    blend_simd_neon_blend_565,
+    blend_simd_neon_transpose_32,
+    NULL,
+};
+#endif /*BLEND_SIMD_NEON*/
+
+static bool_t s_blend_simd_inited = FALSE;
+static bool_t s_blend_simd_enable = TRUE;
+static const blend_simd_t* s_blend_simd = NULL;
+
+static const blend_simd_t* blend_simd_detect(void) {
+#ifdef BLEND_SIMD_AVX2
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return &s_blend_simd_avx2;
+  }
+#endif /*BLEND_SIMD_AVX2*/
+
+#ifdef BLEND_SIMD_SSE2
+  return &s_blend_simd_sse2;
+#elif defined(BLEND_SIMD_NEON)
+  return &s_blend_simd_neon;
+#else
+  return NULL;
+#endif
+}
+
+const blend_simd_t* blend_simd(void) {
+  if (!s_blend_simd_inited) {
+    s_blend_simd = blend_simd_detect();
+    s_blend_simd_inited = TRUE;
+  }
+
+  return s_blend_simd_enable ? s_blend_simd : NULL;
+}
+
+ret_t blend_simd_set_enable(bool_t enable) {
+  s_blend_simd_enable = enable;
+
+  return RET_OK;
+}
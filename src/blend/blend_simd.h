@@ -0,0 +1,117 @@
+﻿/**
+ * File:   blend_simd.h
+ * Author: AWTK Develop Team
+ * Brief:  simd kernels for image blending
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_BLEND_SIMD_H
+#define TK_BLEND_SIMD_H
+
+#include "tkc/types_def.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class blend_simd_t
+ * 图片合成的SIMD内核。
+ *
+ * 运行时根据CPU特性(SSE2/AVX2/NEON)选择，不支持时blend_simd返回NULL，使用原有的逐像素实现。
+ *
+ * 内核按blend\_a的方法跳过全透明像素、拷贝不透明像素，并合成半透明像素，
+ * 合成结果与逐像素实现完全一致。目标像素半透明时合成需要除法，仍由blend\_a处理。
+ *
+ * 32位像素的第4个字节为alpha通道(RGBA8888/BGRA8888)。
+ */
+typedef struct _blend_simd_t {
+  /**
+   * @property {const char*} name
+   * @annotation ["readable"]
+   * 名称。
+   */
+  const char* name;
+
+  /**
+   * 从src开始，计算连续的alpha在[lo, hi]之间的32位像素的个数。
+   */
+  uint32_t (*count_alpha)(const uint8_t* src, uint32_t n, uint8_t lo, uint8_t hi);
+
+  /**
+   * 从src开始，计算连续的值在[lo, hi]之间的字节的个数(用于A8的字模)。
+   */
+  uint32_t (*count_u8)(const uint8_t* src, uint32_t n, uint8_t lo, uint8_t hi);
+
+  /**
+   * 拷贝32位像素。swap_rb为TRUE时交换第1和第3个字节。
+   */
+  void (*copy_8888)(uint8_t* dst, const uint8_t* src, uint32_t n, bool_t swap_rb);
+
+  /**
+   * 把32位像素转换成16位565像素。
+   * swap_rb为FALSE时，第1个字节放在高5位，第3个字节放在低5位；为TRUE时相反。
+   */
+  void (*pack_565)(uint8_t* dst, const uint8_t* src, uint32_t n, bool_t swap_rb);
+
+  /**
+   * 把32位源像素按alpha合成到32位目标像素上，swap_rb为TRUE时先交换源像素的第1和第3个字节。
+   * 遇到目标像素半透明(alpha在[1, 0xf4]之间)且需要合成的像素时停止，返回已经处理的像素个数。
+   */
+  uint32_t (*blend_8888)(uint8_t* dst, const uint8_t* src, uint32_t n, uint8_t alpha,
+                         bool_t premulti_alpha, bool_t swap_rb);
+
+  /**
+   * 把32位源像素按alpha合成到16位565目标像素上，swap_rb同pack_565。
+   */
+  void (*blend_565)(uint8_t* dst, const uint8_t* src, uint32_t n, uint8_t alpha,
+                    bool_t premulti_alpha, bool_t swap_rb);
+
+  /**
+   * 转置4x4个32位像素(用于旋转)：dst的第j行(dst + j * dst_stride)为src的第j列。
+   * reverse为TRUE时，dst每一行的像素顺序反转。stride的单位为字节，dst_stride可以为负数。
+   */
+  void (*transpose_32)(uint8_t* dst, int32_t dst_stride, const uint8_t* src, int32_t src_stride,
+                       bool_t reverse);
+
+  /**
+   * 转置8x8个16位像素，参数同transpose_32。不支持时为NULL。
+   */
+  void (*transpose_16)(uint8_t* dst, int32_t dst_stride, const uint8_t* src, int32_t src_stride,
+                       bool_t reverse);
+} blend_simd_t;
+
+/**
+ * @method blend_simd
+ * 获取当前CPU可用的SIMD内核。
+ * @annotation ["global"]
+ *
+ * @return {const blend_simd_t*} 返回SIMD内核，不支持或被禁用时返回NULL。
+ */
+const blend_simd_t* blend_simd(void);
+
+/**
+ * @method blend_simd_set_enable
+ * 启用/禁用SIMD内核(主要用于测试和性能对比)。
+ * @annotation ["global"]
+ * @param {bool_t} enable 是否启用。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t blend_simd_set_enable(bool_t enable);
+
+END_C_DECLS
+
+#endif /*TK_BLEND_SIMD_H*/
@@ -1080,6 +1080,7 @@ const char* s_mledit_properties[] = {WIDGET_PROP_READONLY,
 
 TK_DECL_VTABLE(mledit) = {.size = sizeof(mledit_t),
                           .type = WIDGET_TYPE_MLEDIT,
+                          .disallow_parallel_paint = TRUE,
                           .focusable = TRUE,
                           .inputable = TRUE,
                           .pointer_cursor = WIDGET_CURSOR_EDIT,
@@ -23,6 +23,7 @@
 #include "base/timer.h"
 #include "tkc/utils.h"
 #include "base/image_manager.h"
+#include "base/parallel_paint.h"
 #include "rich_text/rich_text.h"
 #include "rich_text/rich_text_parser.h"
 #include "widget_animators/widget_animator_scroll.h"
@@ -246,6 +247,8 @@ static ret_t rich_text_ensure_render_node(widget_t* widget, canvas_t* c) {
 }
 
 static ret_t rich_text_on_paint_self(widget_t* widget, canvas_t* c) {
+  /*绘制时会重新布局，不能多线程绘制(设置了disallow_parallel_paint)*/
+  return_value_if_fail(!parallel_paint_is_busy(), RET_BUSY);
   rich_text_get_margin(widget);
   if (rich_text_ensure_render_node(widget, c) == RET_OK) {
     return rich_text_on_paint_text(widget, c);
@@ -586,6 +589,7 @@ static const char* s_rich_text_clone_properties[] = {WIDGET_PROP_MARGIN, WIDGET_
                                                      NULL};
 TK_DECL_VTABLE(rich_text) = {.size = sizeof(rich_text_t),
                              .type = "rich_text",
+                             .disallow_parallel_paint = TRUE,
                              .parent = TK_PARENT_VTABLE(widget),
                              .create = rich_text_create,
                              .clone_properties = s_rich_text_clone_properties,
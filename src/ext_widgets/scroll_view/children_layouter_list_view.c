@@ -24,6 +24,7 @@
 #include "base/layout.h"
 #include "base/widget.h"
 #include "tkc/tokenizer.h"
+#include "base/widget_spatial_index.h"
 #include "scroll_view/scroll_bar.h"
 #include "scroll_view/scroll_view.h"
 #include "scroll_view/list_view.h"
@@ -213,6 +214,7 @@ static ret_t children_layouter_list_view_for_list_view_children_layout_h(
   children = (widget_t**)children_for_layout->elms;
   for (i = 0; i < n; i++) {
     widget_t* iter = children[i];
+    rect_t old = rect_init(iter->x, iter->y, iter->w, iter->h);
 
     if (iter->w == 0) {
       iter->w = iter->parent->w;
@@ -220,6 +222,7 @@ static ret_t children_layouter_list_view_for_list_view_children_layout_h(
     if (iter->h == 0) {
       iter->h = item_height;
     }
+    widget_spatial_index_on_child_moved(iter, &old);
 
     if (iter->self_layout != NULL || iter->auto_adjust_size) {
       widget_layout(iter);
@@ -390,6 +393,33 @@ static ret_t children_layouter_list_view_for_list_view_set_scroll_bar_info(widge
   return RET_OK;
 }
 
+/*虚拟模式：只布局可见的列表项，虚拟高度由行数计算*/
+static int32_t children_layouter_list_view_for_list_view_virtual_layout(
+    children_layouter_list_view_t* l, widget_t* widget, list_view_t* list_view, int32_t item_height,
+    int32_t default_item_height) {
+  int32_t h = item_height;
+  int32_t virtual_h = 0;
+  int32_t scroll_view_w = 0;
+
+  if (h <= 0) {
+    h = list_view->item_template->h;
+  }
+  if (h <= 0) {
+    h = default_item_height;
+  }
+  h = tk_max(h, 1);
+
+  widget_layout_floating_children(widget);
+  virtual_h = l->y_margin + (int32_t)(list_view->virtual_rows) * (h + l->spacing);
+  scroll_view_w =
+      children_layouter_list_view_for_list_view_get_scroll_view_w(list_view, widget, virtual_h);
+  widget_move_resize_ex(widget, widget->x, widget->y, scroll_view_w, widget->h, FALSE);
+  list_view_layout_virtual_items(WIDGET(list_view), l->x_margin, l->y_margin,
+                                 scroll_view_w - 2 * l->x_margin, h, l->spacing);
+
+  return virtual_h;
+}
+
 static ret_t children_layouter_list_view_for_list_view_layout(children_layouter_t* layouter,
                                                               widget_t* widget) {
   int32_t virtual_h = 0;
@@ -407,7 +437,10 @@ static ret_t children_layouter_list_view_for_list_view_layout(children_layouter_
   default_item_height =
       list_view->default_item_height ? list_view->default_item_height : l->default_item_height;
 
-  if (widget->children != NULL) {
+  if (list_view->is_virtual) {
+    virtual_h = children_layouter_list_view_for_list_view_virtual_layout(
+        l, widget, list_view, item_height, default_item_height);
+  } else if (widget->children != NULL) {
     int32_t scroll_view_w = 0;
     darray_t children_for_layout;
     uint32_t cols = l->cols <= 1 ? 1 : l->cols;
@@ -30,8 +30,13 @@
 #define LIST_VIEW_FLOATING_SCROLL_BAR_HIDE_TIME 500
 #define LIST_VIEW_FLOATING_SCROLL_BAR_SHOW_TIME 300
 
+/*虚拟模式下，可见行之外上下各预留的列表项个数*/
+#define LIST_VIEW_VIRTUAL_OVERSCAN 2
+
 static ret_t list_view_on_add_child(widget_t* widget, widget_t* child);
 static ret_t list_view_on_remove_child(widget_t* widget, widget_t* child);
+static ret_t list_view_update_virtual_items(list_view_t* list_view);
+static ret_t list_view_on_destroy(widget_t* widget);
 
 static ret_t list_view_on_paint_self(widget_t* widget, canvas_t* c) {
   return widget_paint_helper(widget, c, NULL, NULL);
@@ -205,7 +210,8 @@ TK_DECL_VTABLE(list_view) = {.type = WIDGET_TYPE_LIST_VIEW,
                              .on_event = list_view_on_event,
                              .on_add_child = list_view_on_add_child,
                              .on_remove_child = list_view_on_remove_child,
-                             .on_paint_self = list_view_on_paint_self};
+                             .on_paint_self = list_view_on_paint_self,
+                             .on_destroy = list_view_on_destroy};
 
 static int32_t scroll_bar_to_scroll_view(list_view_t* list_view, int32_t v) {
   int32_t range = 0;
@@ -233,6 +239,7 @@ static ret_t list_view_on_scroll_bar_value_changed(void* ctx, event_t* e) {
   scroll_bar = SCROLL_BAR(list_view->scroll_bar);
   offset = scroll_bar_to_scroll_view(list_view, scroll_bar->value);
   scroll_view_set_offset(list_view->scroll_view, 0, offset);
+  list_view_update_virtual_items(list_view);
 
   return RET_OK;
 }
@@ -258,6 +265,7 @@ static ret_t list_view_on_scroll_view_scroll(widget_t* widget, int32_t xoffset,
   list_view_t* list_view = LIST_VIEW(widget->parent);
   return_value_if_fail(list_view != NULL, RET_BAD_PARAMS);
 
+  list_view_update_virtual_items(list_view);
   if (list_view->scroll_bar != NULL) {
     int32_t value = scroll_view_to_scroll_bar(list_view, yoffset);
     scroll_bar_set_value_only(list_view->scroll_bar, value);
@@ -306,7 +314,10 @@ static ret_t list_view_on_scroll_view_paint_children(widget_t* widget, canvas_t*
   int32_t right = 0;
   int32_t max_w = canvas_get_width(c);
   int32_t max_h = canvas_get_height(c);
+  list_view_t* list_view = LIST_VIEW(widget->parent);
+  bool_t is_virtual = list_view != NULL && list_view->is_virtual;
 
+  /*虚拟模式下的列表项在滚动和布局时绑定，绘制时(可能在多个线程中)只绘制已经绑定的列表项*/
   WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
 
   if (!iter->visible) {
@@ -320,6 +331,11 @@ static ret_t list_view_on_scroll_view_paint_children(widget_t* widget, canvas_t*
   right = left + iter->w;
 
   if (top > max_h || left > max_w) {
+    /*虚拟模式下列表项循环使用，不是按位置排列的*/
+    if (is_virtual) {
+      iter->dirty = FALSE;
+      continue;
+    }
     break;
   }
 
@@ -491,3 +507,231 @@ widget_t* list_view_cast(widget_t* widget) {
 
   return widget;
 }
+
+static ret_t list_view_reset_virtual_items(list_view_t* list_view) {
+  uint32_t i = 0;
+
+  for (i = 0; i < list_view->items_nr; i++) {
+    list_view->item_rows[i] = -1;
+  }
+
+  return RET_OK;
+}
+
+static ret_t list_view_update_virtual_items(list_view_t* list_view) {
+  int32_t r = 0;
+  int32_t first = 0;
+  int32_t pitch = 0;
+  scroll_view_t* scroll_view = NULL;
+  return_value_if_fail(list_view != NULL, RET_BAD_PARAMS);
+
+  /*列表项个数改变后，等重新布局时再绑定*/
+  if (!list_view->is_virtual || list_view->items_nr == 0 || list_view->scroll_view == NULL ||
+      widget_count_children(list_view->scroll_view) != list_view->items_nr) {
+    return RET_OK;
+  }
+
+  scroll_view = SCROLL_VIEW(list_view->scroll_view);
+  return_value_if_fail(scroll_view != NULL, RET_BAD_PARAMS);
+
+  pitch = tk_max(list_view->item_h + list_view->item_spacing, 1);
+  first = (scroll_view->yoffset - list_view->item_y_margin) / pitch - LIST_VIEW_VIRTUAL_OVERSCAN;
+  first = tk_min(first, (int32_t)(list_view->virtual_rows - list_view->items_nr));
+  first = tk_max(first, 0);
+
+  /*第r行总是使用第(r % items_nr)个列表项，滚动一行只需要重新绑定一个列表项*/
+  for (r = first; r < first + (int32_t)(list_view->items_nr); r++) {
+    uint32_t slot = r % list_view->items_nr;
+
+    if (list_view->item_rows[slot] != r) {
+      widget_t* item = widget_get_child(WIDGET(scroll_view), slot);
+
+      list_view->item_rows[slot] = r;
+      widget_move(item, list_view->item_x, list_view->item_y_margin + r * pitch);
+      list_view->bind_item(list_view->bind_item_ctx, item, r);
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t list_view_layout_virtual_items(widget_t* widget, int32_t x, int32_t y_margin, int32_t w,
+                                     int32_t h, int32_t spacing) {
+  uint32_t n = 0;
+  uint32_t nr = 0;
+  widget_t* scroll_view = NULL;
+  list_view_t* list_view = LIST_VIEW(widget);
+  return_value_if_fail(list_view != NULL && list_view->is_virtual, RET_BAD_PARAMS);
+  return_value_if_fail(list_view->scroll_view != NULL && list_view->item_template != NULL,
+                       RET_BAD_PARAMS);
+
+  scroll_view = list_view->scroll_view;
+  list_view->item_x = x;
+  list_view->item_w = w;
+  list_view->item_h = tk_max(h, 1);
+  list_view->item_spacing = spacing;
+  list_view->item_y_margin = y_margin;
+
+  n = scroll_view->h / (list_view->item_h + spacing) + 2 + 2 * LIST_VIEW_VIRTUAL_OVERSCAN;
+  n = tk_min(n, list_view->virtual_rows);
+
+  nr = widget_count_children(scroll_view);
+  while (nr > n) {
+    widget_destroy(widget_get_child(scroll_view, --nr));
+  }
+  while (nr < n) {
+    return_value_if_fail(widget_clone(list_view->item_template, scroll_view) != NULL, RET_OOM);
+    nr++;
+  }
+
+  if (n != list_view->items_nr) {
+    int32_t* item_rows = TKMEM_REALLOCT(int32_t, list_view->item_rows, tk_max(n, 1));
+    return_value_if_fail(item_rows != NULL, RET_OOM);
+
+    list_view->item_rows = item_rows;
+    list_view->items_nr = n;
+    list_view_reset_virtual_items(list_view);
+  }
+
+  WIDGET_FOR_EACH_CHILD_BEGIN(scroll_view, iter, i)
+  if (iter->w != list_view->item_w || iter->h != list_view->item_h) {
+    widget_resize(iter, list_view->item_w, list_view->item_h);
+    widget_layout_children(iter);
+  }
+  if (iter->x != list_view->item_x) {
+    widget_move(iter, list_view->item_x, iter->y);
+  }
+  WIDGET_FOR_EACH_CHILD_END();
+
+  return list_view_update_virtual_items(list_view);
+}
+
+static ret_t list_view_bind_value(widget_t* widget, const value_t* v) {
+  if (v->type == VALUE_TYPE_STRING || v->type == VALUE_TYPE_WSTRING ||
+      widget_set_prop(widget, WIDGET_PROP_VALUE, v) != RET_OK) {
+    return widget_set_prop(widget, WIDGET_PROP_TEXT, v);
+  }
+
+  return RET_OK;
+}
+
+static ret_t list_view_bind_child_with_object(void* ctx, const void* data) {
+  value_t v;
+  object_t* obj = OBJECT(ctx);
+  widget_t* iter = WIDGET(data);
+
+  if (iter->name != NULL && object_get_prop(obj, iter->name, &v) == RET_OK) {
+    list_view_bind_value(iter, &v);
+  }
+
+  return RET_OK;
+}
+
+static ret_t list_view_bind_item_with_data_source(void* ctx, widget_t* item, uint32_t index) {
+  value_t v;
+  char name[TK_NUM_MAX_LEN + 3];
+  list_view_t* list_view = LIST_VIEW(ctx);
+  return_value_if_fail(list_view != NULL && list_view->data_source != NULL, RET_BAD_PARAMS);
+
+  tk_snprintf(name, sizeof(name), "[%u]", index);
+  return_value_if_fail(object_get_prop(list_view->data_source, name, &v) == RET_OK,
+                       RET_NOT_FOUND);
+
+  if (v.type == VALUE_TYPE_OBJECT && value_object(&v) != NULL) {
+    return widget_foreach(item, list_view_bind_child_with_object, value_object(&v));
+  } else {
+    return list_view_bind_value(item, &v);
+  }
+}
+
+static ret_t list_view_on_data_source_changed(void* ctx, event_t* e) {
+  list_view_t* list_view = LIST_VIEW(ctx);
+  return_value_if_fail(list_view != NULL && list_view->data_source != NULL, RET_REMOVE);
+
+  list_view_set_virtual_rows(WIDGET(list_view),
+                             object_get_prop_int(list_view->data_source, OBJECT_PROP_SIZE, 0));
+
+  return RET_OK;
+}
+
+static ret_t list_view_detach_data_source(list_view_t* list_view) {
+  if (list_view->data_source != NULL) {
+    emitter_off(EMITTER(list_view->data_source), list_view->data_source_changed_id);
+    OBJECT_UNREF(list_view->data_source);
+    list_view->data_source_changed_id = TK_INVALID_ID;
+  }
+
+  return RET_OK;
+}
+
+ret_t list_view_set_virtual(widget_t* widget, uint32_t rows, list_view_bind_item_t bind_item,
+                            void* ctx) {
+  list_view_t* list_view = LIST_VIEW(widget);
+  return_value_if_fail(list_view != NULL && bind_item != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(list_view->scroll_view != NULL, RET_BAD_PARAMS);
+
+  if (list_view->item_template == NULL) {
+    widget_t* scroll_view = list_view->scroll_view;
+    widget_t* item_template = widget_get_child(scroll_view, 0);
+    return_value_if_fail(item_template != NULL, RET_BAD_PARAMS);
+
+    widget_remove_child(scroll_view, item_template);
+    widget_destroy_children(scroll_view);
+    list_view->item_template = item_template;
+  }
+
+  if (bind_item != list_view_bind_item_with_data_source) {
+    list_view_detach_data_source(list_view);
+  }
+
+  list_view->is_virtual = TRUE;
+  list_view->bind_item = bind_item;
+  list_view->bind_item_ctx = ctx;
+
+  return list_view_set_virtual_rows(widget, rows);
+}
+
+ret_t list_view_set_virtual_data_source(widget_t* widget, object_t* data_source) {
+  uint32_t rows = 0;
+  list_view_t* list_view = LIST_VIEW(widget);
+  return_value_if_fail(list_view != NULL && data_source != NULL, RET_BAD_PARAMS);
+
+  if (list_view->data_source != data_source) {
+    object_ref(data_source);
+    list_view_detach_data_source(list_view);
+    list_view->data_source = data_source;
+    list_view->data_source_changed_id = emitter_on(
+        EMITTER(data_source), EVT_ITEMS_CHANGED, list_view_on_data_source_changed, widget);
+  }
+
+  rows = object_get_prop_int(data_source, OBJECT_PROP_SIZE, 0);
+
+  return list_view_set_virtual(widget, rows, list_view_bind_item_with_data_source, widget);
+}
+
+ret_t list_view_set_virtual_rows(widget_t* widget, uint32_t rows) {
+  list_view_t* list_view = LIST_VIEW(widget);
+  return_value_if_fail(list_view != NULL && list_view->is_virtual, RET_BAD_PARAMS);
+
+  list_view->virtual_rows = rows;
+  list_view_reset_virtual_items(list_view);
+  widget_set_need_relayout_children(list_view->scroll_view);
+  widget_invalidate_force(widget, NULL);
+
+  return RET_OK;
+}
+
+static ret_t list_view_on_destroy(widget_t* widget) {
+  list_view_t* list_view = LIST_VIEW(widget);
+  return_value_if_fail(list_view != NULL, RET_BAD_PARAMS);
+
+  list_view_detach_data_source(list_view);
+  if (list_view->item_template != NULL) {
+    widget_destroy(list_view->item_template);
+    list_view->item_template = NULL;
+  }
+  TKMEM_FREE(list_view->item_rows);
+  list_view->item_rows = NULL;
+
+  return RET_OK;
+}
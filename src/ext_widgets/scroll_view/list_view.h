@@ -22,10 +22,14 @@
 #ifndef TK_LIST_VIEW_H
 #define TK_LIST_VIEW_H
 
+#include "tkc/object.h"
 #include "base/widget.h"
 
 BEGIN_C_DECLS
 
+/*虚拟列表中，把第index行的数据绑定到列表项item上*/
+typedef ret_t (*list_view_bind_item_t)(void* ctx, widget_t* item, uint32_t index);
+
 /**
  * @class list_view_t
  * @parent widget_t
@@ -85,6 +89,20 @@ BEGIN_C_DECLS
  * 如果 floating_scroll_bar 属性为 FALSE 和 auto_hide_scroll_bar 属性为 FALSE，如果 scroll_view 的高比虚拟高要大的话，滚动条变成不可用，scroll_view 宽不会变。
  * 如果 floating_scroll_bar 属性为 FALSE 和 auto_hide_scroll_bar 属性为 TRUE，如果 scroll_view 的高比虚拟高要大的话，滚动条变成不可见，scroll_view 宽会合并原来滚动条的宽。
  *
+ * 虚拟列表：行数很多时(比如几万行的日志)，可以调用list\_view\_set\_virtual或list\_view\_set\_virtual\_data\_source
+ * 进入虚拟模式。此时scroll\_view的第一个子控件作为列表项的模板，只创建可见行(再加上少量预留行)所需的列表项，
+ * 滚动时回收并重新绑定数据，创建和布局的开销与行数无关。虚拟模式下所有行使用相同的高度，不支持多列。
+ *
+ * ```c
+ * static ret_t on_bind_item(void* ctx, widget_t* item, uint32_t index) {
+ *   char text[32];
+ *   tk_snprintf(text, sizeof(text), "row %u", index);
+ *   return widget_set_text_utf8(widget_lookup(item, "title", TRUE), text);
+ * }
+ *
+ * list_view_set_virtual(list_view, 50000, on_bind_item, NULL);
+ * ```
+ *
  */
 typedef struct _list_view_t {
   widget_t widget;
@@ -119,6 +137,22 @@ typedef struct _list_view_t {
   widget_t* scroll_view;
   widget_t* scroll_bar;
   uint32_t wheel_before_id;
+
+  /*虚拟模式*/
+  bool_t is_virtual;
+  uint32_t virtual_rows;
+  list_view_bind_item_t bind_item;
+  void* bind_item_ctx;
+  object_t* data_source;
+  uint32_t data_source_changed_id;
+  widget_t* item_template;
+  int32_t* item_rows;
+  uint32_t items_nr;
+  int32_t item_x;
+  int32_t item_w;
+  int32_t item_h;
+  int32_t item_spacing;
+  int32_t item_y_margin;
 } list_view_t;
 
 /**
@@ -199,6 +233,61 @@ widget_t* list_view_cast(widget_t* widget);
  */
 ret_t list_view_reinit(widget_t* widget);
 
+/**
+ * @method list_view_set_virtual
+ * 设置为虚拟列表。
+ *
+ * scroll\_view的第一个子控件作为列表项的模板(从scroll\_view中移出)，其它子控件被删除。
+ * 列表项需要显示第index行时，调用bind\_item把数据绑定到列表项上。
+ * @param {widget_t*} widget 控件对象。
+ * @param {uint32_t} rows 行数。
+ * @param {list_view_bind_item_t} bind_item 绑定数据的回调函数。
+ * @param {void*} ctx 回调函数的上下文。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t list_view_set_virtual(widget_t* widget, uint32_t rows, list_view_bind_item_t bind_item,
+                            void* ctx);
+
+/**
+ * @method list_view_set_virtual_data_source
+ * 设置为虚拟列表，数据来自对象(如object\_array)。
+ *
+ * 行数为对象的"#size"属性，第index行的数据为对象的"[index]"属性。
+ * 如果行数据是对象，把它的属性绑定到列表项中同名的子控件上，否则绑定到列表项本身。
+ * 字符串绑定为控件的文本，其它类型绑定为控件的值。对象的列表项改变时自动更新。
+ * @param {widget_t*} widget 控件对象。
+ * @param {object_t*} data_source 数据源对象(列表视图会增加它的引用计数)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t list_view_set_virtual_data_source(widget_t* widget, object_t* data_source);
+
+/**
+ * @method list_view_set_virtual_rows
+ * 设置虚拟列表的行数，并重新绑定可见的列表项。
+ * @param {widget_t*} widget 控件对象。
+ * @param {uint32_t} rows 行数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t list_view_set_virtual_rows(widget_t* widget, uint32_t rows);
+
+/**
+ * @method list_view_layout_virtual_items
+ * 布局虚拟列表的列表项(供children\_layouter\_list\_view使用)。
+ * @param {widget_t*} widget 控件对象。
+ * @param {int32_t} x 列表项的x坐标。
+ * @param {int32_t} y_margin 第一行的y坐标。
+ * @param {int32_t} w 列表项的宽度。
+ * @param {int32_t} h 列表项的高度。
+ * @param {int32_t} spacing 行间距。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t list_view_layout_virtual_items(widget_t* widget, int32_t x, int32_t y_margin, int32_t w,
+                                     int32_t h, int32_t spacing);
+
 #define LIST_VIEW(widget) ((list_view_t*)(list_view_cast(WIDGET(widget))))
 
 #define LIST_VIEW_PROP_FLOATING_SCROLL_BAR "floating_scroll_bar"
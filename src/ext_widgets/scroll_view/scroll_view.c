@@ -104,8 +104,14 @@ static ret_t scroll_view_on_layout_children(widget_t* widget) {
     scroll_view->xoffset_end = scroll_view->xoffset;
     scroll_view->yoffset_end = scroll_view->yoffset;
     scroll_view->fix_end_offset(widget);
-    scroll_view->xoffset = scroll_view->xoffset_end;
-    scroll_view->yoffset = scroll_view->yoffset_end;
+    if (scroll_view->xoffset != scroll_view->xoffset_end ||
+        scroll_view->yoffset != scroll_view->yoffset_end) {
+      scroll_view->xoffset = scroll_view->xoffset_end;
+      scroll_view->yoffset = scroll_view->yoffset_end;
+      if (scroll_view->on_scroll) {
+        scroll_view->on_scroll(widget, scroll_view->xoffset, scroll_view->yoffset);
+      }
+    }
     if (scroll_view->curr_page != curr_page || scroll_view->max_page != max_page) {
       scroll_view->max_page = max_page;
       scroll_view->curr_page = curr_page;
@@ -267,6 +273,9 @@ ret_t scroll_view_scroll_to(widget_t* widget, int32_t xoffset_end, int32_t yoffs
 #else
   scroll_view->xoffset = xoffset_end;
   scroll_view->yoffset = yoffset_end;
+  if (scroll_view->on_scroll) {
+    scroll_view->on_scroll(widget, scroll_view->xoffset, scroll_view->yoffset);
+  }
   scroll_view_on_scroll_done(widget, NULL);
 #endif /*WITHOUT_WIDGET_ANIMATORS*/
   return RET_OK;
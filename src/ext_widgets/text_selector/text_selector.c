@@ -20,6 +20,7 @@
  */
 
 #include "tkc/mem.h"
+#include "tkc/atom.h"
 #include "tkc/utf8.h"
 #include "tkc/utils.h"
 #include "tkc/easing.h"
@@ -497,7 +498,10 @@ static ret_t text_selector_set_selected_index_only(text_selector_t* text_selecto
       text_selector->last_selected_index = text_selector->selected_index;
       text_selector->selected_index = index;
       if (widget->tr_text != NULL) {
-        widget->tr_text = tk_str_copy(widget->tr_text, option->tr_text);
+        /*widget->tr_text是原子字符串*/
+        const char* tr_text = tk_atom(option->tr_text != NULL ? option->tr_text : "");
+        tk_atom_unref(widget->tr_text);
+        widget->tr_text = tr_text;
       }
       evt.e.type = EVT_VALUE_CHANGED;
       widget_dispatch(widget, (event_t*)&evt);
@@ -55,6 +55,7 @@ font_t* font_bitmap_create(const char* name, const uint8_t* buff, uint32_t buff_
  * 适合低端嵌入式平台。
  *
  * tools/font_gen用于把矢量字体(如truetype)转换成位图字体。
+ * 字模可以是压缩格式(GLYPH\_FMT\_A4/GLYPH\_FMT\_A2/GLYPH\_FMT\_RLE)，由lcd在绘制时直接解码。
  *
  * @annotation["fake"]
  *
@@ -197,6 +197,7 @@ static font_t* font_ft_create_ex(const char* name, const uint8_t* buff, uint32_t
   tk_strncpy(f->base.name, name, TK_NAME_LEN);
 
   glyph_cache_init(&(f->cache), TK_GLYPH_CACHE_NR, destroy_glyph);
+  glyph_cache_set_max_bytes(&(f->cache), TK_GLYPH_CACHE_MAX_BYTES);
 
   return &(f->base);
 }
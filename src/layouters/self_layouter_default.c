@@ -22,6 +22,7 @@
 #include "tkc/utils.h"
 #include "base/widget.h"
 #include "tkc/tokenizer.h"
+#include "base/widget_spatial_index.h"
 #include "tkc/func_call_parser.h"
 #include "layouters/self_layouter_default.h"
 
@@ -386,6 +387,7 @@ static ret_t widget_layout_calc(self_layouter_default_t* layout, rect_t* r, wh_t
 
 ret_t widget_layout_self_with_rect(self_layouter_t* layouter, widget_t* widget, rect_t* area) {
   rect_t r = rect_init(widget->x, widget->y, widget->w, widget->h);
+  rect_t old = r;
   self_layouter_default_t* l = (self_layouter_default_t*)layouter;
 
   return_value_if_fail(widget != NULL && area != NULL, RET_BAD_PARAMS);
@@ -397,6 +399,7 @@ ret_t widget_layout_self_with_rect(self_layouter_t* layouter, widget_t* widget,
     /*如果有指定max_w，需要在layout之前，先计算需要的高宽。*/
     if (has_max_w && widget->vt->auto_adjust_size != NULL) {
       widget->vt->auto_adjust_size(widget);
+      widget_spatial_index_on_child_moved(widget, &old);
       r.w = widget->w;
       r.h = widget->h;
       l->w_attr = W_ATTR_UNDEF;
@@ -407,9 +410,12 @@ ret_t widget_layout_self_with_rect(self_layouter_t* layouter, widget_t* widget,
 
     /*如果没有指定max_w，需要在layout之后，根据layout的高宽计算实际需要的高宽。*/
     if (!has_max_w && widget->vt->auto_adjust_size != NULL) {
+      /*auto_adjust_size直接修改控件的大小，之后需要更新父控件的空间索引*/
+      old = rect_init(widget->x, widget->y, widget->w, widget->h);
       widget->w = r.w;
       widget->h = r.h;
       widget->vt->auto_adjust_size(widget);
+      widget_spatial_index_on_child_moved(widget, &old);
       r.w = widget->w;
       r.h = widget->h;
     }
@@ -30,6 +30,8 @@ BEGIN_C_DECLS
 
 typedef ret_t (*lcd_mem_wait_vbi_t)(void* ctx);
 
+typedef struct _lcd_mem_async_flush_t lcd_mem_async_flush_t;
+
 typedef struct _lcd_mem_t {
   lcd_t base;
   uint8_t* offline_fb;
@@ -50,10 +52,59 @@ typedef struct _lcd_mem_t {
   /*VBI: vertical blank interrupt。用于2fb等待当前显示完成，以便把下一帧的数据从offline fb拷贝到online fb，从而避免因为同时访问online fb数据造成闪烁。*/
   lcd_mem_wait_vbi_t wait_vbi;
   void* wait_vbi_ctx;
+
+  /*异步flush(在单独的线程中把offline fb拷贝到online fb)，为NULL时同步flush。*/
+  lcd_mem_async_flush_t* async_flush;
 } lcd_mem_t;
 
 #define lcd_mem_set_line_length(lcd, value) lcd_set_line_length(lcd, value);
 
+/**
+ * @method lcd_mem_set_async_flush
+ * 启用/禁用异步flush。
+ *
+ * 启用后，lcd_mem会额外分配一个offline fb，两个offline fb轮流使用：
+ * flush线程把第N帧从一个offline fb拷贝(或旋转)到online fb的同时，
+ * UI线程在另外一个offline fb中绘制第N+1帧。
+ * 每个offline fb的脏矩形由lcd\_fb\_dirty\_rects分别记录，绘制时会补上该fb错过的帧的脏矩形。
+ *
+ * > 只对有online fb并且需要拷贝的lcd(双缓冲，或者旋转后的三缓冲)有效。
+ * > 启用后wait\_vbi回调函数在flush线程中调用。
+ * > 不支持线程或者创建线程失败时，返回失败并继续使用同步flush。
+ * @export none
+ * @param {lcd_t*} lcd lcd对象。
+ * @param {bool_t} async_flush 是否启用异步flush。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t lcd_mem_set_async_flush(lcd_t* lcd, bool_t async_flush);
+
+/**
+ * @method lcd_mem_async_flush_commit
+ * 提交当前offline fb的flush任务(等待上一个任务完成后再提交)，并切换到另外一个offline fb。
+ * > 由lcd\_mem内部调用。
+ * @export none
+ * @param {lcd_mem_t*} mem lcd_mem对象。
+ * @param {const bitmap_t*} offline_fb 当前offline fb的描述。
+ * @param {const bitmap_t*} online_fb online fb的描述。
+ * @param {lcd_orientation_t} o 旋转方向。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t lcd_mem_async_flush_commit(lcd_mem_t* mem, const bitmap_t* offline_fb,
+                                 const bitmap_t* online_fb, lcd_orientation_t o);
+
+/**
+ * @method lcd_mem_async_flush_wait
+ * 等待正在进行的flush任务完成。没有启用异步flush时什么也不做。
+ * > 在直接访问online fb或者修改lcd的大小之前调用。
+ * @export none
+ * @param {lcd_mem_t*} mem lcd_mem对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t lcd_mem_async_flush_wait(lcd_mem_t* mem);
+
 /**
  * @method lcd_resize
  * 设置等待VBI事件到来的回调函数。
@@ -86,6 +137,9 @@ static inline ret_t lcd_mem_set_wait_vbi(lcd_t* lcd, lcd_mem_wait_vbi_t wait_vbi
 static inline ret_t lcd_mem_deinit(lcd_mem_t* mem) {
   return_value_if_fail(mem != NULL && mem->base.begin_frame != NULL, RET_BAD_PARAMS);
 
+  if (mem->async_flush != NULL) {
+    lcd_mem_set_async_flush((lcd_t*)mem, FALSE);
+  }
   lcd_fb_dirty_rects_deinit(&(mem->fb_dirty_rects_list));
   if (mem->vgcanvas != NULL) {
     vgcanvas_destroy(mem->vgcanvas);
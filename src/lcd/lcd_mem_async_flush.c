@@ -0,0 +1,220 @@
+﻿/**
+ * File:   lcd_mem_async_flush.c
+ * Author: AWTK Develop Team
+ * Brief:  flush offline fb to online fb in a dedicated thread
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/thread.h"
+#include "tkc/semaphore.h"
+#include "lcd/lcd_mem.h"
+#include "blend/image_g2d.h"
+
+struct _lcd_mem_async_flush_t {
+  tk_thread_t* thread;
+  tk_semaphore_t* start;
+  tk_semaphore_t* done;
+  bool_t quit;
+  bool_t busy;
+
+  /*fbs[0]为创建lcd时的offline fb，fbs[1]为额外分配的offline fb*/
+  uint8_t* fbs[2];
+  /*flush线程专用，避免与UI线程共用offline_gb/online_gb*/
+  graphic_buffer_t* src_gb;
+  graphic_buffer_t* dst_gb;
+
+  /*当前的任务*/
+  bitmap_t src;
+  bitmap_t dst;
+  lcd_orientation_t o;
+  uint32_t nr;
+  rect_t rects[TK_MAX_DIRTY_RECT_NR];
+  lcd_mem_wait_vbi_t wait_vbi;
+  void* wait_vbi_ctx;
+};
+
+static void* lcd_mem_async_flush_main(void* args) {
+  uint32_t i = 0;
+  lcd_mem_async_flush_t* af = (lcd_mem_async_flush_t*)args;
+
+  while (tk_semaphore_wait(af->start, 0xffffffff) == RET_OK) {
+    if (af->quit) {
+      break;
+    }
+
+    if (af->wait_vbi != NULL) {
+      af->wait_vbi(af->wait_vbi_ctx);
+    }
+
+    for (i = 0; i < af->nr; i++) {
+      const rect_t* dr = af->rects + i;
+      if (af->o == LCD_ORIENTATION_0) {
+        image_copy(&(af->dst), &(af->src), dr, dr->x, dr->y);
+      } else {
+        image_rotate(&(af->dst), &(af->src), dr, af->o);
+      }
+    }
+
+    tk_semaphore_post(af->done);
+  }
+
+  return NULL;
+}
+
+static ret_t lcd_mem_async_flush_destroy(lcd_mem_async_flush_t* af) {
+  if (af->thread != NULL) {
+    af->quit = TRUE;
+    tk_semaphore_post(af->start);
+    tk_thread_join(af->thread);
+    tk_thread_destroy(af->thread);
+  }
+
+  if (af->start != NULL) {
+    tk_semaphore_destroy(af->start);
+  }
+  if (af->done != NULL) {
+    tk_semaphore_destroy(af->done);
+  }
+
+  graphic_buffer_destroy(af->src_gb);
+  graphic_buffer_destroy(af->dst_gb);
+  TKMEM_FREE(af->fbs[1]);
+  TKMEM_FREE(af);
+
+  return RET_OK;
+}
+
+static lcd_mem_async_flush_t* lcd_mem_async_flush_create(lcd_mem_t* mem) {
+  lcd_t* lcd = (lcd_t*)mem;
+  uint32_t bpp = bitmap_get_bpp_of_format(mem->format);
+  uint32_t size = tk_max(lcd->w * bpp, mem->line_length) * lcd->h;
+  lcd_mem_async_flush_t* af = TKMEM_ZALLOC(lcd_mem_async_flush_t);
+  return_value_if_fail(af != NULL, NULL);
+
+  af->fbs[0] = mem->offline_fb;
+  af->fbs[1] = (uint8_t*)TKMEM_ALLOC(size);
+  af->src_gb = graphic_buffer_create_with_data(NULL, lcd->w, lcd->h, mem->format);
+  af->dst_gb = graphic_buffer_create_with_data(NULL, lcd->w, lcd->h, mem->format);
+  af->start = tk_semaphore_create(0, NULL);
+  af->done = tk_semaphore_create(0, NULL);
+  goto_error_if_fail(af->fbs[1] != NULL && af->start != NULL && af->done != NULL);
+
+  af->thread = tk_thread_create(lcd_mem_async_flush_main, af);
+  goto_error_if_fail(af->thread != NULL);
+  tk_thread_set_name(af->thread, "lcd_flush");
+  if (tk_thread_start(af->thread) != RET_OK) {
+    tk_thread_destroy(af->thread);
+    af->thread = NULL;
+    goto error;
+  }
+
+  return af;
+error:
+  lcd_mem_async_flush_destroy(af);
+  return NULL;
+}
+
+ret_t lcd_mem_set_async_flush(lcd_t* lcd, bool_t async_flush) {
+  lcd_mem_t* mem = (lcd_mem_t*)lcd;
+  return_value_if_fail(mem != NULL && lcd->type == LCD_FRAMEBUFFER, RET_BAD_PARAMS);
+
+  if (async_flush) {
+    return_value_if_fail(mem->online_fb != NULL && mem->offline_fb != NULL, RET_NOT_IMPL);
+    if (mem->async_flush != NULL) {
+      return RET_OK;
+    }
+
+    mem->async_flush = lcd_mem_async_flush_create(mem);
+    return_value_if_fail(mem->async_flush != NULL, RET_FAIL);
+
+    /*新的offline fb需要全部重绘*/
+    return lcd_fb_dirty_rects_add_fb_info(&(mem->fb_dirty_rects_list), mem->async_flush->fbs[1]);
+  } else if (mem->async_flush != NULL) {
+    lcd_mem_async_flush_t* af = mem->async_flush;
+
+    lcd_mem_async_flush_wait(mem);
+    if (mem->offline_fb != af->fbs[0]) {
+      /*切回原来的offline fb，它错过的帧的脏矩形已经记录在lcd_fb_dirty_rects中*/
+      mem->offline_fb = af->fbs[0];
+    }
+    lcd_fb_dirty_rects_remove_fb_info(&(mem->fb_dirty_rects_list), af->fbs[1]);
+    mem->async_flush = NULL;
+
+    return lcd_mem_async_flush_destroy(af);
+  }
+
+  return RET_OK;
+}
+
+ret_t lcd_mem_async_flush_wait(lcd_mem_t* mem) {
+  lcd_mem_async_flush_t* af = NULL;
+  return_value_if_fail(mem != NULL, RET_BAD_PARAMS);
+
+  af = mem->async_flush;
+  if (af != NULL && af->busy) {
+    tk_semaphore_wait(af->done, 0xffffffff);
+    af->busy = FALSE;
+  }
+
+  return RET_OK;
+}
+
+ret_t lcd_mem_async_flush_commit(lcd_mem_t* mem, const bitmap_t* offline_fb,
+                                 const bitmap_t* online_fb, lcd_orientation_t o) {
+  uint32_t i = 0;
+  lcd_mem_async_flush_t* af = NULL;
+  const dirty_rects_t* dirty_rects = NULL;
+  return_value_if_fail(mem != NULL && offline_fb != NULL && online_fb != NULL, RET_BAD_PARAMS);
+  af = mem->async_flush;
+  return_value_if_fail(af != NULL, RET_BAD_PARAMS);
+
+  /*只有一个任务槽，上一帧拷贝完成后，它的offline fb才能用于绘制下一帧*/
+  lcd_mem_async_flush_wait(mem);
+
+  dirty_rects =
+      lcd_fb_dirty_rects_get_dirty_rects_by_fb(&(mem->fb_dirty_rects_list), mem->offline_fb);
+  af->nr = 0;
+  if (dirty_rects != NULL && dirty_rects->nr > 0) {
+    if (dirty_rects->disable_multiple) {
+      af->rects[af->nr++] = dirty_rects->max;
+    } else {
+      for (i = 0; i < dirty_rects->nr; i++) {
+        af->rects[af->nr++] = dirty_rects->rects[i];
+      }
+    }
+  }
+
+  if (af->nr > 0) {
+    af->o = o;
+    af->src = *offline_fb;
+    af->dst = *online_fb;
+    af->src.buffer = af->src_gb;
+    af->dst.buffer = af->dst_gb;
+    graphic_buffer_attach(af->src_gb, mem->offline_fb, offline_fb->w, offline_fb->h);
+    graphic_buffer_attach(af->dst_gb, mem->online_fb, online_fb->w, online_fb->h);
+    af->wait_vbi = mem->wait_vbi;
+    af->wait_vbi_ctx = mem->wait_vbi_ctx;
+
+    af->busy = TRUE;
+    tk_semaphore_post(af->start);
+  }
+
+  mem->offline_fb = mem->offline_fb == af->fbs[0] ? af->fbs[1] : af->fbs[0];
+
+  return RET_OK;
+}
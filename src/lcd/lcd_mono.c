@@ -133,6 +133,9 @@ static ret_t lcd_mono_draw_data(lcd_t* lcd, const uint8_t* buff, uint32_t w, uin
 
 static ret_t lcd_mono_draw_glyph(lcd_t* lcd, glyph_t* glyph, const rect_t* src, xy_t x, xy_t y) {
   pixel_t pixel = color_to_pixel(lcd->text_color);
+  /*压缩格式(A4/A2/RLE)的数据可能比单色位图还小*/
+  return_value_if_fail(glyph->format == GLYPH_FMT_ALPHA || glyph->format == GLYPH_FMT_MONO,
+                       RET_NOT_IMPL);
 
   return lcd_mono_draw_data(lcd, glyph->data, glyph->w, glyph->h, src, x, y, !pixel);
 }
@@ -0,0 +1,294 @@
+﻿/**
+ * File:   atom.c
+ * Author: AWTK Develop Team
+ * Brief:  interned strings (atoms)
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/atom.h"
+#include "tkc/mutex.h"
+#include "tkc/utils.h"
+
+#define TK_ATOM_MIN_CAPACITY 64
+
+/*字符串紧跟在entry后面，原子字符串就是entry + 1的地址*/
+typedef struct _tk_atom_entry_t {
+  struct _tk_atom_entry_t* next;
+  uint32_t hash;
+  uint32_t refs;
+  uint32_t size;
+} tk_atom_entry_t;
+
+typedef struct _tk_atom_table_t {
+  tk_mutex_t* mutex;
+  tk_atom_entry_t** buckets;
+  uint32_t capacity;
+  uint32_t count;
+  uint32_t refs;
+  uint32_t str_size;
+} tk_atom_table_t;
+
+static tk_atom_table_t s_atoms;
+
+#define TK_ATOM_ENTRY(atom) (((tk_atom_entry_t*)(atom)) - 1)
+#define TK_ATOM_STR(entry) ((char*)((entry) + 1))
+
+static uint32_t tk_atom_hash(const char* str, uint32_t* size) {
+  uint32_t h = 2166136261u;
+  const char* p = str;
+
+  while (*p) {
+    h ^= (uint8_t)(*p++);
+    h *= 16777619u;
+  }
+  *size = (uint32_t)(p - str);
+
+  return h;
+}
+
+/*tk_atom_init之前(和tk_atom_deinit之后)只有一个线程，不需要加锁*/
+static ret_t tk_atom_lock(void) {
+  return s_atoms.mutex != NULL ? tk_mutex_lock(s_atoms.mutex) : RET_OK;
+}
+
+static ret_t tk_atom_unlock(void) {
+  return s_atoms.mutex != NULL ? tk_mutex_unlock(s_atoms.mutex) : RET_OK;
+}
+
+static tk_atom_entry_t* tk_atom_lookup(const char* str, uint32_t hash, uint32_t size) {
+  tk_atom_entry_t* iter = NULL;
+
+  if (s_atoms.buckets == NULL) {
+    return NULL;
+  }
+
+  iter = s_atoms.buckets[hash & (s_atoms.capacity - 1)];
+  while (iter != NULL) {
+    if (iter->hash == hash && iter->size == size && memcmp(TK_ATOM_STR(iter), str, size) == 0) {
+      return iter;
+    }
+    iter = iter->next;
+  }
+
+  return NULL;
+}
+
+static ret_t tk_atom_rehash(uint32_t capacity) {
+  uint32_t i = 0;
+  tk_atom_entry_t** buckets = TKMEM_ZALLOCN(tk_atom_entry_t*, capacity);
+  return_value_if_fail(buckets != NULL, RET_OOM);
+
+  for (i = 0; i < s_atoms.capacity; i++) {
+    tk_atom_entry_t* iter = s_atoms.buckets[i];
+
+    while (iter != NULL) {
+      tk_atom_entry_t* next = iter->next;
+      tk_atom_entry_t** head = buckets + (iter->hash & (capacity - 1));
+
+      iter->next = *head;
+      *head = iter;
+      iter = next;
+    }
+  }
+
+  TKMEM_FREE(s_atoms.buckets);
+  s_atoms.buckets = buckets;
+  s_atoms.capacity = capacity;
+
+  return RET_OK;
+}
+
+static tk_atom_entry_t* tk_atom_insert(const char* str, uint32_t hash, uint32_t size) {
+  tk_atom_entry_t** head = NULL;
+  tk_atom_entry_t* entry = NULL;
+
+  if (s_atoms.count >= s_atoms.capacity) {
+    uint32_t capacity = tk_max(s_atoms.capacity * 2, TK_ATOM_MIN_CAPACITY);
+    return_value_if_fail(tk_atom_rehash(capacity) == RET_OK, NULL);
+  }
+
+  entry = (tk_atom_entry_t*)TKMEM_ALLOC(sizeof(tk_atom_entry_t) + size + 1);
+  return_value_if_fail(entry != NULL, NULL);
+
+  memcpy(TK_ATOM_STR(entry), str, size);
+  TK_ATOM_STR(entry)[size] = '\0';
+  entry->hash = hash;
+  entry->size = size;
+  entry->refs = 0;
+
+  head = s_atoms.buckets + (hash & (s_atoms.capacity - 1));
+  entry->next = *head;
+  *head = entry;
+  s_atoms.count++;
+  s_atoms.str_size += size + 1;
+
+  return entry;
+}
+
+static ret_t tk_atom_remove(tk_atom_entry_t* entry) {
+  tk_atom_entry_t** iter = s_atoms.buckets + (entry->hash & (s_atoms.capacity - 1));
+
+  while (*iter != NULL) {
+    if (*iter == entry) {
+      *iter = entry->next;
+      s_atoms.count--;
+      s_atoms.str_size -= entry->size + 1;
+      TKMEM_FREE(entry);
+
+      return RET_OK;
+    }
+    iter = &((*iter)->next);
+  }
+
+  return RET_NOT_FOUND;
+}
+
+static ret_t tk_atom_free_buckets(void) {
+  TKMEM_FREE(s_atoms.buckets);
+  s_atoms.capacity = 0;
+
+  return RET_OK;
+}
+
+ret_t tk_atom_init(void) {
+  if (s_atoms.mutex == NULL) {
+    s_atoms.mutex = tk_mutex_create();
+  }
+
+  return s_atoms.mutex != NULL ? RET_OK : RET_OOM;
+}
+
+const char* tk_atom(const char* str) {
+  uint32_t size = 0;
+  uint32_t hash = 0;
+  tk_atom_entry_t* entry = NULL;
+
+  if (str == NULL) {
+    return NULL;
+  }
+
+  hash = tk_atom_hash(str, &size);
+  tk_atom_lock();
+  entry = tk_atom_lookup(str, hash, size);
+  if (entry == NULL) {
+    entry = tk_atom_insert(str, hash, size);
+  }
+
+  if (entry != NULL) {
+    entry->refs++;
+    s_atoms.refs++;
+  }
+  tk_atom_unlock();
+
+  return entry != NULL ? TK_ATOM_STR(entry) : NULL;
+}
+
+const char* tk_atom_ref(const char* atom) {
+  if (atom != NULL) {
+    tk_atom_entry_t* entry = TK_ATOM_ENTRY(atom);
+
+    tk_atom_lock();
+    assert(entry->refs > 0);
+    entry->refs++;
+    s_atoms.refs++;
+    tk_atom_unlock();
+  }
+
+  return atom;
+}
+
+ret_t tk_atom_unref(const char* atom) {
+  tk_atom_entry_t* entry = NULL;
+
+  if (atom == NULL) {
+    return RET_OK;
+  }
+
+  entry = TK_ATOM_ENTRY(atom);
+  tk_atom_lock();
+  assert(entry->refs > 0);
+  entry->refs--;
+  s_atoms.refs--;
+  if (entry->refs == 0) {
+    tk_atom_remove(entry);
+    if (s_atoms.count == 0 && s_atoms.mutex == NULL) {
+      /*tk_atom_deinit时还有引用没有释放，最后一个释放时再释放哈希表*/
+      tk_atom_free_buckets();
+    }
+  }
+  tk_atom_unlock();
+
+  return RET_OK;
+}
+
+const char* tk_atom_find(const char* str) {
+  uint32_t size = 0;
+  uint32_t hash = 0;
+  tk_atom_entry_t* entry = NULL;
+
+  if (str == NULL) {
+    return NULL;
+  }
+
+  hash = tk_atom_hash(str, &size);
+  tk_atom_lock();
+  entry = tk_atom_lookup(str, hash, size);
+  tk_atom_unlock();
+
+  return entry != NULL ? TK_ATOM_STR(entry) : NULL;
+}
+
+ret_t tk_atom_get_stat(tk_atom_stat_t* stat) {
+  uint32_t i = 0;
+  return_value_if_fail(stat != NULL, RET_BAD_PARAMS);
+
+  memset(stat, 0x00, sizeof(tk_atom_stat_t));
+  tk_atom_lock();
+  stat->count = s_atoms.count;
+  stat->refs = s_atoms.refs;
+  stat->mem_size = s_atoms.capacity * sizeof(tk_atom_entry_t*) +
+                   s_atoms.count * sizeof(tk_atom_entry_t) + s_atoms.str_size;
+
+  for (i = 0; i < s_atoms.capacity; i++) {
+    tk_atom_entry_t* iter = s_atoms.buckets[i];
+
+    while (iter != NULL) {
+      stat->saved_size += (iter->refs - 1) * (iter->size + 1);
+      iter = iter->next;
+    }
+  }
+  tk_atom_unlock();
+
+  return RET_OK;
+}
+
+ret_t tk_atom_deinit(void) {
+  /*没有销毁的控件等还指向原子字符串，不能释放，由它们释放最后一个引用*/
+  if (s_atoms.count > 0) {
+    log_debug("tk_atom_deinit: %u atoms are still referenced\n", s_atoms.count);
+  } else {
+    tk_atom_free_buckets();
+  }
+
+  if (s_atoms.mutex != NULL) {
+    tk_mutex_destroy(s_atoms.mutex);
+    s_atoms.mutex = NULL;
+  }
+
+  return RET_OK;
+}
@@ -0,0 +1,158 @@
+﻿/**
+ * File:   atom.h
+ * Author: AWTK Develop Team
+ * Brief:  interned strings (atoms)
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_ATOM_H
+#define TK_ATOM_H
+
+#include "tkc/types_def.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class tk_atom_stat_t
+ * 原子字符串的内存统计信息。
+ */
+typedef struct _tk_atom_stat_t {
+  /**
+   * @property {uint32_t} count
+   * @annotation ["readable"]
+   * 原子字符串的个数。
+   */
+  uint32_t count;
+  /**
+   * @property {uint32_t} refs
+   * @annotation ["readable"]
+   * 全部原子字符串的引用计数之和。
+   */
+  uint32_t refs;
+  /**
+   * @property {uint32_t} mem_size
+   * @annotation ["readable"]
+   * 原子字符串占用的内存(包括哈希表)。
+   */
+  uint32_t mem_size;
+  /**
+   * @property {uint32_t} saved_size
+   * @annotation ["readable"]
+   * 与每个引用单独复制一份字符串相比，节省的内存。
+   */
+  uint32_t saved_size;
+} tk_atom_stat_t;
+
+/**
+ * @class tk_atom_t
+ * @annotation ["fake"]
+ * 原子字符串(字符串驻留)。
+ *
+ * 内容相同的字符串共享同一份带引用计数的拷贝，在引用计数变为0之前地址保持不变，
+ * 所以两个原子字符串可以直接比较指针，不需要strcmp。
+ *
+ * 控件的name/style/state等属性使用原子字符串，
+ * 窗口中大量控件使用相同的名称和状态时，只保存一份拷贝。
+ *
+ * 示例：
+ *
+ * ```c
+ * const char* a = tk_atom("normal");
+ * const char* b = tk_atom("normal");
+ * assert(a == b);
+ * tk_atom_unref(a);
+ * tk_atom_unref(b);
+ * ```
+ *
+ * > 原子字符串的内容不能修改。可以在多个线程中使用。
+ */
+
+/**
+ * @method tk_atom_init
+ * 初始化原子字符串(创建互斥锁，在其它线程使用原子字符串之前调用)。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t tk_atom_init(void);
+
+/**
+ * @method tk_atom
+ * 获取字符串对应的原子字符串(不存在时创建)，并增加引用计数。
+ * @annotation ["static"]
+ * @param {const char*} str 字符串。
+ *
+ * @return {const char*} 返回原子字符串，str为NULL或者内存不足时返回NULL。
+ */
+const char* tk_atom(const char* str);
+
+/**
+ * @method tk_atom_ref
+ * 增加原子字符串的引用计数(不需要计算哈希值)。
+ * @annotation ["static"]
+ * @param {const char*} atom 原子字符串(必须是tk\_atom返回的)。
+ *
+ * @return {const char*} 返回原子字符串。
+ */
+const char* tk_atom_ref(const char* atom);
+
+/**
+ * @method tk_atom_unref
+ * 减少原子字符串的引用计数，变为0时释放。
+ * @annotation ["static"]
+ * @param {const char*} atom 原子字符串(必须是tk\_atom返回的，可以为NULL)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t tk_atom_unref(const char* atom);
+
+/**
+ * @method tk_atom_find
+ * 查找字符串对应的原子字符串(不增加引用计数)。
+ *
+ * 不存在时返回NULL，此时可以确定没有任何对象使用该字符串(比如按名称查找控件)。
+ * @annotation ["static"]
+ * @param {const char*} str 字符串。
+ *
+ * @return {const char*} 返回原子字符串，不存在时返回NULL。
+ */
+const char* tk_atom_find(const char* str);
+
+/**
+ * @method tk_atom_get_stat
+ * 获取原子字符串的内存统计信息。
+ * @annotation ["static"]
+ * @param {tk_atom_stat_t*} stat 用于返回统计信息。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t tk_atom_get_stat(tk_atom_stat_t* stat);
+
+/**
+ * @method tk_atom_deinit
+ * 释放原子字符串(程序退出时调用)。
+ *
+ * 仍被引用的原子字符串保持有效，在最后一个引用释放时再释放。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t tk_atom_deinit(void);
+
+END_C_DECLS
+
+#endif /*TK_ATOM_H*/
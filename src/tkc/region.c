@@ -0,0 +1,407 @@
+﻿/**
+ * File:   region.c
+ * Author: AWTK Develop Team
+ * Brief:  banded region (set of rects)
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/region.h"
+
+typedef enum _region_op_t { REGION_OP_UNION = 0, REGION_OP_SUBTRACT, REGION_OP_INTERSECT } region_op_t;
+
+#define REGION_INF 0x7fffffff
+
+region_t* region_init(region_t* region) {
+  return_value_if_fail(region != NULL, NULL);
+
+  memset(region, 0x00, sizeof(region_t));
+  region->rects = region->static_rects;
+  region->capacity = TK_REGION_STATIC_NR;
+
+  return region;
+}
+
+ret_t region_deinit(region_t* region) {
+  return_value_if_fail(region != NULL, RET_BAD_PARAMS);
+
+  if (region->rects != region->static_rects) {
+    TKMEM_FREE(region->rects);
+  }
+  region_init(region);
+
+  return RET_OK;
+}
+
+ret_t region_reset(region_t* region) {
+  return_value_if_fail(region != NULL, RET_BAD_PARAMS);
+
+  region->nr = 0;
+  region->extents = rect_init(0, 0, 0, 0);
+
+  return RET_OK;
+}
+
+static ret_t region_extend(region_t* region, uint32_t capacity) {
+  rect_t* rects = NULL;
+
+  if (capacity <= region->capacity) {
+    return RET_OK;
+  }
+
+  capacity = tk_max(capacity, region->capacity + (region->capacity >> 1));
+  if (region->rects == region->static_rects) {
+    rects = TKMEM_ZALLOCN(rect_t, capacity);
+    return_value_if_fail(rects != NULL, RET_OOM);
+    memcpy(rects, region->rects, region->nr * sizeof(rect_t));
+  } else {
+    rects = TKMEM_REALLOCT(rect_t, region->rects, capacity);
+    return_value_if_fail(rects != NULL, RET_OOM);
+  }
+
+  region->rects = rects;
+  region->capacity = capacity;
+
+  return RET_OK;
+}
+
+static ret_t region_append(region_t* region, xy_t x, xy_t y, wh_t w, wh_t h) {
+  return_value_if_fail(region_extend(region, region->nr + 1) == RET_OK, RET_OOM);
+  region->rects[region->nr++] = rect_init(x, y, w, h);
+
+  return RET_OK;
+}
+
+static ret_t region_update_extents(region_t* region) {
+  uint32_t i = 0;
+
+  region->extents = rect_init(0, 0, 0, 0);
+  for (i = 0; i < region->nr; i++) {
+    rect_merge(&(region->extents), region->rects + i);
+  }
+
+  return RET_OK;
+}
+
+ret_t region_set_rect(region_t* region, const rect_t* r) {
+  return_value_if_fail(region != NULL && r != NULL, RET_BAD_PARAMS);
+
+  region_reset(region);
+  if (r->w > 0 && r->h > 0) {
+    region->rects[0] = *r;
+    region->extents = *r;
+    region->nr = 1;
+  }
+
+  return RET_OK;
+}
+
+ret_t region_copy(region_t* region, const region_t* other) {
+  return_value_if_fail(region != NULL && other != NULL, RET_BAD_PARAMS);
+
+  if (region == other) {
+    return RET_OK;
+  }
+
+  return_value_if_fail(region_extend(region, other->nr) == RET_OK, RET_OOM);
+  memcpy(region->rects, other->rects, other->nr * sizeof(rect_t));
+  region->nr = other->nr;
+  region->extents = other->extents;
+
+  return RET_OK;
+}
+
+/*返回从start开始的带的结束位置*/
+static uint32_t region_band_end(const region_t* region, uint32_t start) {
+  uint32_t i = start + 1;
+  xy_t y = region->rects[start].y;
+
+  while (i < region->nr && region->rects[i].y == y) {
+    i++;
+  }
+
+  return i;
+}
+
+static bool_t region_op_inside(region_op_t op, bool_t in_a, bool_t in_b) {
+  switch (op) {
+    case REGION_OP_UNION: {
+      return in_a || in_b;
+    }
+    case REGION_OP_SUBTRACT: {
+      return in_a && !in_b;
+    }
+    default: {
+      return in_a && in_b;
+    }
+  }
+}
+
+/*对一个带内的两组线段做集合运算，结果追加到dst*/
+static ret_t region_op_band(region_t* dst, xy_t y, wh_t h, const rect_t* sa, uint32_t na,
+                            const rect_t* sb, uint32_t nb, region_op_t op) {
+  uint32_t ia = 0;
+  uint32_t ib = 0;
+  xy_t start = 0;
+  bool_t in_a = FALSE;
+  bool_t in_b = FALSE;
+  bool_t inside = FALSE;
+  int32_t xa = na > 0 ? sa[0].x : REGION_INF;
+  int32_t xb = nb > 0 ? sb[0].x : REGION_INF;
+
+  while (xa != REGION_INF || xb != REGION_INF) {
+    bool_t now = FALSE;
+    int32_t x = tk_min(xa, xb);
+
+    if (xa == x) {
+      in_a = !in_a;
+      if (in_a) {
+        xa = sa[ia].x + sa[ia].w;
+      } else {
+        ia++;
+        xa = ia < na ? sa[ia].x : REGION_INF;
+      }
+    }
+
+    if (xb == x) {
+      in_b = !in_b;
+      if (in_b) {
+        xb = sb[ib].x + sb[ib].w;
+      } else {
+        ib++;
+        xb = ib < nb ? sb[ib].x : REGION_INF;
+      }
+    }
+
+    now = region_op_inside(op, in_a, in_b);
+    if (now && !inside) {
+      start = x;
+    } else if (!now && inside) {
+      return_value_if_fail(region_append(dst, start, y, x - start, h) == RET_OK, RET_OOM);
+    }
+    inside = now;
+  }
+
+  return RET_OK;
+}
+
+/*如果新的带与上一个带相邻并且线段完全相同，合并成一个带*/
+static ret_t region_coalesce(region_t* dst, uint32_t prev_start, uint32_t curr_start) {
+  uint32_t i = 0;
+  uint32_t n = curr_start - prev_start;
+  rect_t* prev = dst->rects + prev_start;
+  rect_t* curr = dst->rects + curr_start;
+
+  if (n == 0 || dst->nr - curr_start != n || prev->y + prev->h != curr->y) {
+    return RET_FAIL;
+  }
+
+  for (i = 0; i < n; i++) {
+    if (prev[i].x != curr[i].x || prev[i].w != curr[i].w) {
+      return RET_FAIL;
+    }
+  }
+
+  for (i = 0; i < n; i++) {
+    prev[i].h += curr[0].h;
+  }
+  dst->nr = curr_start;
+
+  return RET_OK;
+}
+
+static ret_t region_op(region_t* region, const region_t* other, region_op_t op) {
+  region_t dst;
+  uint32_t ia = 0;
+  uint32_t ib = 0;
+  int32_t y = REGION_INF;
+  uint32_t prev_start = 0;
+  ret_t ret = RET_OK;
+  const region_t* a = region;
+  const region_t* b = other;
+
+  if (a->nr > 0) {
+    y = a->rects[0].y;
+  }
+  if (b->nr > 0) {
+    y = tk_min(y, b->rects[0].y);
+  }
+
+  region_init(&dst);
+  while (ret == RET_OK && (ia < a->nr || ib < b->nr)) {
+    int32_t y1 = REGION_INF;
+    bool_t in_a = FALSE;
+    bool_t in_b = FALSE;
+    uint32_t ea = 0;
+    uint32_t eb = 0;
+    uint32_t curr_start = dst.nr;
+
+    while (ia < a->nr && a->rects[ia].y + a->rects[ia].h <= y) {
+      ia = region_band_end(a, ia);
+    }
+    while (ib < b->nr && b->rects[ib].y + b->rects[ib].h <= y) {
+      ib = region_band_end(b, ib);
+    }
+
+    if (ia < a->nr) {
+      const rect_t* r = a->rects + ia;
+      in_a = r->y <= y;
+      y1 = tk_min(y1, in_a ? r->y + r->h : r->y);
+      ea = region_band_end(a, ia);
+    }
+
+    if (ib < b->nr) {
+      const rect_t* r = b->rects + ib;
+      in_b = r->y <= y;
+      y1 = tk_min(y1, in_b ? r->y + r->h : r->y);
+      eb = region_band_end(b, ib);
+    }
+
+    if (y1 == REGION_INF) {
+      break;
+    }
+
+    if (in_a || in_b) {
+      ret = region_op_band(&dst, y, y1 - y, a->rects + ia, in_a ? ea - ia : 0, b->rects + ib,
+                           in_b ? eb - ib : 0, op);
+      if (dst.nr > curr_start) {
+        if (region_coalesce(&dst, prev_start, curr_start) != RET_OK) {
+          prev_start = curr_start;
+        }
+      }
+    }
+
+    y = y1;
+  }
+
+  if (ret == RET_OK) {
+    ret = region_copy(region, &dst);
+    region_update_extents(region);
+  }
+  region_deinit(&dst);
+
+  return ret;
+}
+
+ret_t region_union(region_t* region, const region_t* other) {
+  return_value_if_fail(region != NULL && other != NULL, RET_BAD_PARAMS);
+
+  if (other->nr == 0 || region == other) {
+    return RET_OK;
+  }
+
+  if (region->nr == 0) {
+    return region_copy(region, other);
+  }
+
+  return region_op(region, other, REGION_OP_UNION);
+}
+
+ret_t region_subtract(region_t* region, const region_t* other) {
+  return_value_if_fail(region != NULL && other != NULL, RET_BAD_PARAMS);
+
+  if (region == other) {
+    return region_reset(region);
+  }
+
+  if (region->nr == 0 || other->nr == 0 ||
+      !rect_has_intersect(&(region->extents), &(other->extents))) {
+    return RET_OK;
+  }
+
+  return region_op(region, other, REGION_OP_SUBTRACT);
+}
+
+ret_t region_intersect(region_t* region, const region_t* other) {
+  return_value_if_fail(region != NULL && other != NULL, RET_BAD_PARAMS);
+
+  if (region == other) {
+    return RET_OK;
+  }
+
+  if (region->nr == 0 || other->nr == 0 ||
+      !rect_has_intersect(&(region->extents), &(other->extents))) {
+    return region_reset(region);
+  }
+
+  return region_op(region, other, REGION_OP_INTERSECT);
+}
+
+ret_t region_union_rect(region_t* region, const rect_t* r) {
+  region_t other;
+  return_value_if_fail(region != NULL && r != NULL, RET_BAD_PARAMS);
+
+  region_init(&other);
+  region_set_rect(&other, r);
+
+  return region_union(region, &other);
+}
+
+ret_t region_subtract_rect(region_t* region, const rect_t* r) {
+  region_t other;
+  return_value_if_fail(region != NULL && r != NULL, RET_BAD_PARAMS);
+
+  region_init(&other);
+  region_set_rect(&other, r);
+
+  return region_subtract(region, &other);
+}
+
+ret_t region_intersect_rect(region_t* region, const rect_t* r) {
+  region_t other;
+  return_value_if_fail(region != NULL && r != NULL, RET_BAD_PARAMS);
+
+  region_init(&other);
+  region_set_rect(&other, r);
+
+  return region_intersect(region, &other);
+}
+
+bool_t region_is_empty(const region_t* region) {
+  return_value_if_fail(region != NULL, TRUE);
+
+  return region->nr == 0;
+}
+
+bool_t region_contains(const region_t* region, xy_t x, xy_t y) {
+  uint32_t i = 0;
+  return_value_if_fail(region != NULL, FALSE);
+
+  if (region->nr == 0 || !rect_contains(&(region->extents), x, y)) {
+    return FALSE;
+  }
+
+  for (i = 0; i < region->nr; i++) {
+    if (rect_contains(region->rects + i, x, y)) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+uint32_t region_get_area(const region_t* region) {
+  uint32_t i = 0;
+  uint32_t area = 0;
+  return_value_if_fail(region != NULL, 0);
+
+  for (i = 0; i < region->nr; i++) {
+    area += region->rects[i].w * region->rects[i].h;
+  }
+
+  return area;
+}
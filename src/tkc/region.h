@@ -0,0 +1,212 @@
+﻿/**
+ * File:   region.h
+ * Author: AWTK Develop Team
+ * Brief:  banded region (set of rects)
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_REGION_H
+#define TK_REGION_H
+
+#include "tkc/rect.h"
+
+BEGIN_C_DECLS
+
+#ifndef TK_REGION_STATIC_NR
+#define TK_REGION_STATIC_NR 16
+#endif /*TK_REGION_STATIC_NR*/
+
+/**
+ * @class region_t
+ * 区域(由多个矩形组成)。
+ *
+ * 采用带状(banded)表示：
+ *
+ * * 矩形按y、x排序，互不重叠。
+ * * y坐标和高度相同的矩形组成一个带(band)，带内的矩形按x排序，并且互不相邻。
+ * * 相邻的两个带如果包含的矩形的x和宽度完全相同，会合并(coalesce)成一个带。
+ *
+ * 矩形个数不超过TK\_REGION\_STATIC\_NR时不需要分配内存。
+ *
+ * > region\_t内部可能指向自身的缓冲区，不能直接赋值复制，请用region\_copy。
+ */
+typedef struct _region_t {
+  /**
+   * @property {uint32_t} nr
+   * @annotation ["readable"]
+   * 矩形的个数。
+   */
+  uint32_t nr;
+
+  /**
+   * @property {rect_t} extents
+   * @annotation ["readable"]
+   * 包含全部矩形的最小矩形。
+   */
+  rect_t extents;
+
+  /**
+   * @property {rect_t*} rects
+   * @annotation ["readable"]
+   * 矩形。
+   */
+  rect_t* rects;
+
+  /*private*/
+  uint32_t capacity;
+  rect_t static_rects[TK_REGION_STATIC_NR];
+} region_t;
+
+/**
+ * @method region_init
+ * 初始化为空区域。
+ * @param {region_t*} region region对象。
+ *
+ * @return {region_t*} 返回region对象。
+ */
+region_t* region_init(region_t* region);
+
+/**
+ * @method region_deinit
+ * 释放region对象的资源。
+ * @param {region_t*} region region对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t region_deinit(region_t* region);
+
+/**
+ * @method region_reset
+ * 清空区域。
+ * @param {region_t*} region region对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t region_reset(region_t* region);
+
+/**
+ * @method region_set_rect
+ * 设置区域为指定的矩形。
+ * @param {region_t*} region region对象。
+ * @param {const rect_t*} r 矩形。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t region_set_rect(region_t* region, const rect_t* r);
+
+/**
+ * @method region_copy
+ * 复制区域。
+ * @param {region_t*} region region对象。
+ * @param {const region_t*} other 源区域。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t region_copy(region_t* region, const region_t* other);
+
+/**
+ * @method region_union
+ * 求并集(结果保存在region中)。
+ * @param {region_t*} region region对象。
+ * @param {const region_t*} other 另外一个区域。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t region_union(region_t* region, const region_t* other);
+
+/**
+ * @method region_subtract
+ * 求差集(结果保存在region中)。
+ * @param {region_t*} region region对象。
+ * @param {const region_t*} other 另外一个区域。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t region_subtract(region_t* region, const region_t* other);
+
+/**
+ * @method region_intersect
+ * 求交集(结果保存在region中)。
+ * @param {region_t*} region region对象。
+ * @param {const region_t*} other 另外一个区域。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t region_intersect(region_t* region, const region_t* other);
+
+/**
+ * @method region_union_rect
+ * 与矩形求并集。
+ * @param {region_t*} region region对象。
+ * @param {const rect_t*} r 矩形。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t region_union_rect(region_t* region, const rect_t* r);
+
+/**
+ * @method region_subtract_rect
+ * 减去矩形。
+ * @param {region_t*} region region对象。
+ * @param {const rect_t*} r 矩形。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t region_subtract_rect(region_t* region, const rect_t* r);
+
+/**
+ * @method region_intersect_rect
+ * 与矩形求交集。
+ * @param {region_t*} region region对象。
+ * @param {const rect_t*} r 矩形。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t region_intersect_rect(region_t* region, const rect_t* r);
+
+/**
+ * @method region_is_empty
+ * 检查区域是否为空。
+ * @param {const region_t*} region region对象。
+ *
+ * @return {bool_t} 返回TRUE表示为空。
+ */
+bool_t region_is_empty(const region_t* region);
+
+/**
+ * @method region_contains
+ * 检查区域是否包含指定的点。
+ * @param {const region_t*} region region对象。
+ * @param {xy_t} x x坐标。
+ * @param {xy_t} y y坐标。
+ *
+ * @return {bool_t} 返回TRUE表示包含。
+ */
+bool_t region_contains(const region_t* region, xy_t x, xy_t y);
+
+/**
+ * @method region_get_area
+ * 获取区域的面积(像素个数)。
+ * @param {const region_t*} region region对象。
+ *
+ * @return {uint32_t} 返回面积。
+ */
+uint32_t region_get_area(const region_t* region);
+
+END_C_DECLS
+
+#endif /*TK_REGION_H*/
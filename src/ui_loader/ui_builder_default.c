@@ -19,6 +19,7 @@
  *
  */
 
+#include "tkc/atom.h"
 #include "tkc/utf8.h"
 #include "base/enums.h"
 #include "base/dialog.h"
@@ -35,13 +36,15 @@ static ret_t ui_builder_default_on_widget_start(ui_builder_t* b, const widget_de
   wh_t h = layout->h;
   widget_t* widget = NULL;
   widget_t* parent = b->widget;
-  const char* type = desc->type;
+  /*使用原子字符串，widget_factory可以按地址找到创建函数*/
+  const char* type = tk_atom(desc->type);
 
   widget = widget_factory_create_widget(widget_factory(), type, parent, x, y, w, h);
   if (widget == NULL) {
     log_debug("%s: not supported type %s\n", __FUNCTION__, type);
     widget = widget_factory_create_widget(widget_factory(), WIDGET_TYPE_VIEW, parent, x, y, w, h);
   }
+  tk_atom_unref(type);
   return_value_if_fail(widget != NULL, RET_OOM);
 
   b->widget = widget;
@@ -20,6 +20,7 @@
  */
 
 #include "tkc/mem.h"
+#include "tkc/atom.h"
 #include "tkc/utils.h"
 #include "base/layout.h"
 #include "base/window.h"
@@ -106,7 +107,8 @@ static ret_t combo_box_set_text(widget_t* widget, const char* text, const wchar_
   if (value_widget == NULL) {
     value_widget = widget;
   } else {
-    TKMEM_FREE(widget->tr_text);
+    tk_atom_unref(widget->tr_text);
+    widget->tr_text = NULL;
     widget_set_text(widget, L"");
   }
 
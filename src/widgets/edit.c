@@ -1748,6 +1748,7 @@ ret_t edit_on_copy(widget_t* widget, widget_t* other) {
 
 TK_DECL_VTABLE(edit) = {.size = sizeof(edit_t),
                         .type = WIDGET_TYPE_EDIT,
+                        .disallow_parallel_paint = TRUE,
                         .focusable = TRUE,
                         .inputable = TRUE,
                         .pointer_cursor = WIDGET_CURSOR_EDIT,
@@ -24,6 +24,7 @@
 #include "widgets/label.h"
 #include "base/line_parser.h"
 #include "base/widget_vtable.h"
+#include "base/widget_spatial_index.h"
 #include "base/window_manager.h"
 
 static ret_t label_paint_text_mlines(widget_t* widget, canvas_t* c, line_parser_t* p, int32_t x,
@@ -291,12 +292,18 @@ static ret_t label_auto_adjust_size(widget_t* widget) {
 
 ret_t label_resize_to_content(widget_t* widget, uint32_t min_w, uint32_t max_w, uint32_t min_h,
                               uint32_t max_h) {
+  ret_t ret = RET_OK;
+  rect_t old;
   label_t* label = LABEL(widget);
   canvas_t* c = widget_get_canvas(widget);
   return_value_if_fail(label != NULL && c != NULL && widget->astyle != NULL, RET_BAD_PARAMS);
   widget_update_style(widget);
 
-  return label_auto_adjust_size_impl(widget, c, min_w, max_w, min_h, max_h);
+  old = rect_init(widget->x, widget->y, widget->w, widget->h);
+  ret = label_auto_adjust_size_impl(widget, c, min_w, max_w, min_h, max_h);
+  widget_spatial_index_on_child_moved(widget, &old);
+
+  return ret;
 }
 
 static ret_t label_on_event(widget_t* widget, event_t* e) {
@@ -171,53 +171,69 @@ static ret_t progress_bar_on_destroy(widget_t* widget) {
   return RET_OK;
 }
 
-static ret_t progress_bar_get_prop(widget_t* widget, const char* name, value_t* v) {
-  progress_bar_t* progress_bar = PROGRESS_BAR(widget);
-  return_value_if_fail(progress_bar != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
-
-  if (tk_str_eq(name, WIDGET_PROP_VALUE)) {
-    value_set_float(v, progress_bar->value);
-    return RET_OK;
-  } else if (tk_str_eq(name, WIDGET_PROP_MAX)) {
-    value_set_float(v, progress_bar->max);
-    return RET_OK;
-  } else if (tk_str_eq(name, WIDGET_PROP_FORMAT)) {
-    value_set_str(v, progress_bar->format);
-    return RET_OK;
-  } else if (tk_str_eq(name, WIDGET_PROP_VERTICAL)) {
-    value_set_bool(v, progress_bar->vertical);
-    return RET_OK;
-  } else if (tk_str_eq(name, WIDGET_PROP_SHOW_TEXT)) {
-    value_set_bool(v, progress_bar->show_text);
-    return RET_OK;
-  } else if (tk_str_eq(name, WIDGET_PROP_REVERSE)) {
-    value_set_bool(v, progress_bar->reverse);
-    return RET_OK;
-  }
+static ret_t progress_bar_get_value_prop(widget_t* widget, value_t* v) {
+  value_set_float(v, PROGRESS_BAR(widget)->value);
+  return RET_OK;
+}
 
-  return RET_NOT_FOUND;
+static ret_t progress_bar_set_value_prop(widget_t* widget, const value_t* v) {
+  return progress_bar_set_value(widget, value_float(v));
 }
 
-static ret_t progress_bar_set_prop(widget_t* widget, const char* name, const value_t* v) {
-  return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
-
-  if (tk_str_eq(name, WIDGET_PROP_VALUE)) {
-    return progress_bar_set_value(widget, value_float(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_MAX)) {
-    return progress_bar_set_max(widget, value_float(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_FORMAT)) {
-    return progress_bar_set_format(widget, value_str(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_VERTICAL)) {
-    return progress_bar_set_vertical(widget, value_bool(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_SHOW_TEXT)) {
-    return progress_bar_set_show_text(widget, value_bool(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_REVERSE)) {
-    return progress_bar_set_reverse(widget, value_bool(v));
-  }
+static ret_t progress_bar_get_max_prop(widget_t* widget, value_t* v) {
+  value_set_float(v, PROGRESS_BAR(widget)->max);
+  return RET_OK;
+}
+
+static ret_t progress_bar_set_max_prop(widget_t* widget, const value_t* v) {
+  return progress_bar_set_max(widget, value_float(v));
+}
+
+static ret_t progress_bar_get_format_prop(widget_t* widget, value_t* v) {
+  value_set_str(v, PROGRESS_BAR(widget)->format);
+  return RET_OK;
+}
+
+static ret_t progress_bar_set_format_prop(widget_t* widget, const value_t* v) {
+  return progress_bar_set_format(widget, value_str(v));
+}
 
-  return RET_NOT_FOUND;
+static ret_t progress_bar_get_vertical_prop(widget_t* widget, value_t* v) {
+  value_set_bool(v, PROGRESS_BAR(widget)->vertical);
+  return RET_OK;
+}
+
+static ret_t progress_bar_set_vertical_prop(widget_t* widget, const value_t* v) {
+  return progress_bar_set_vertical(widget, value_bool(v));
+}
+
+static ret_t progress_bar_get_show_text_prop(widget_t* widget, value_t* v) {
+  value_set_bool(v, PROGRESS_BAR(widget)->show_text);
+  return RET_OK;
+}
+
+static ret_t progress_bar_set_show_text_prop(widget_t* widget, const value_t* v) {
+  return progress_bar_set_show_text(widget, value_bool(v));
+}
+
+static ret_t progress_bar_get_reverse_prop(widget_t* widget, value_t* v) {
+  value_set_bool(v, PROGRESS_BAR(widget)->reverse);
+  return RET_OK;
 }
 
+static ret_t progress_bar_set_reverse_prop(widget_t* widget, const value_t* v) {
+  return progress_bar_set_reverse(widget, value_bool(v));
+}
+
+static const widget_prop_desc_t s_progress_bar_props[] = {
+    {WIDGET_PROP_ID_VALUE, progress_bar_get_value_prop, progress_bar_set_value_prop},
+    {WIDGET_PROP_ID_MAX, progress_bar_get_max_prop, progress_bar_set_max_prop},
+    {WIDGET_PROP_ID_FORMAT, progress_bar_get_format_prop, progress_bar_set_format_prop},
+    {WIDGET_PROP_ID_VERTICAL, progress_bar_get_vertical_prop, progress_bar_set_vertical_prop},
+    {WIDGET_PROP_ID_SHOW_TEXT, progress_bar_get_show_text_prop, progress_bar_set_show_text_prop},
+    {WIDGET_PROP_ID_REVERSE, progress_bar_get_reverse_prop, progress_bar_set_reverse_prop},
+    {WIDGET_PROP_ID_NONE, NULL, NULL}};
+
 static const char* s_progress_bar_clone_properties[] = {WIDGET_PROP_VALUE,     WIDGET_PROP_MAX,
                                                         WIDGET_PROP_FORMAT,    WIDGET_PROP_VERTICAL,
                                                         WIDGET_PROP_SHOW_TEXT, NULL};
@@ -229,8 +245,7 @@ TK_DECL_VTABLE(progress_bar) = {.size = sizeof(progress_bar_t),
                                 .on_paint_self = progress_bar_on_paint_self,
                                 .on_paint_background = widget_on_paint_null,
                                 .on_destroy = progress_bar_on_destroy,
-                                .get_prop = progress_bar_get_prop,
-                                .set_prop = progress_bar_set_prop};
+                                .props = s_progress_bar_props};
 
 widget_t* progress_bar_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h) {
   widget_t* widget = widget_create(parent, TK_REF_VTABLE(progress_bar), x, y, w, h);
@@ -505,29 +505,85 @@ ret_t slider_set_vertical(widget_t* widget, bool_t vertical) {
   return widget_invalidate(widget, NULL);
 }
 
+static ret_t slider_get_value_prop(widget_t* widget, value_t* v) {
+  value_set_double(v, SLIDER(widget)->value);
+  return RET_OK;
+}
+
+static ret_t slider_set_value_prop(widget_t* widget, const value_t* v) {
+  return slider_set_value(widget, value_double(v));
+}
+
+static ret_t slider_get_vertical_prop(widget_t* widget, value_t* v) {
+  value_set_bool(v, SLIDER(widget)->vertical);
+  return RET_OK;
+}
+
+static ret_t slider_set_vertical_prop(widget_t* widget, const value_t* v) {
+  return slider_set_vertical(widget, value_bool(v));
+}
+
+static ret_t slider_get_min_prop(widget_t* widget, value_t* v) {
+  value_set_double(v, SLIDER(widget)->min);
+  return RET_OK;
+}
+
+static ret_t slider_set_min_prop(widget_t* widget, const value_t* v) {
+  return slider_set_min(widget, value_double(v));
+}
+
+static ret_t slider_get_max_prop(widget_t* widget, value_t* v) {
+  value_set_double(v, SLIDER(widget)->max);
+  return RET_OK;
+}
+
+static ret_t slider_set_max_prop(widget_t* widget, const value_t* v) {
+  return slider_set_max(widget, value_double(v));
+}
+
+static ret_t slider_get_step_prop(widget_t* widget, value_t* v) {
+  value_set_double(v, SLIDER(widget)->step);
+  return RET_OK;
+}
+
+static ret_t slider_set_step_prop(widget_t* widget, const value_t* v) {
+  return slider_set_step(widget, value_double(v));
+}
+
+static ret_t slider_get_bar_size_prop(widget_t* widget, value_t* v) {
+  value_set_uint32(v, SLIDER(widget)->bar_size);
+  return RET_OK;
+}
+
+static ret_t slider_set_bar_size_prop(widget_t* widget, const value_t* v) {
+  return slider_set_bar_size(widget, value_uint32(v));
+}
+
+static ret_t slider_get_inputing_prop(widget_t* widget, value_t* v) {
+  slider_t* slider = SLIDER(widget);
+  int64_t delta = (time_now_ms() - slider->last_user_action_time);
+  bool_t inputing =
+      (delta < TK_INPUTING_TIMEOUT) && (slider->last_user_action_time > 0) && widget->focused;
+
+  value_set_bool(v, inputing || slider->dragging);
+  return RET_OK;
+}
+
+static const widget_prop_desc_t s_slider_props[] = {
+    {WIDGET_PROP_ID_VALUE, slider_get_value_prop, slider_set_value_prop},
+    {WIDGET_PROP_ID_VERTICAL, slider_get_vertical_prop, slider_set_vertical_prop},
+    {WIDGET_PROP_ID_MIN, slider_get_min_prop, slider_set_min_prop},
+    {WIDGET_PROP_ID_MAX, slider_get_max_prop, slider_set_max_prop},
+    {WIDGET_PROP_ID_STEP, slider_get_step_prop, slider_set_step_prop},
+    {WIDGET_PROP_ID_BAR_SIZE, slider_get_bar_size_prop, slider_set_bar_size_prop},
+    {WIDGET_PROP_ID_INPUTING, slider_get_inputing_prop, NULL},
+    {WIDGET_PROP_ID_NONE, NULL, NULL}};
+
 static ret_t slider_get_prop(widget_t* widget, const char* name, value_t* v) {
   slider_t* slider = SLIDER(widget);
   return_value_if_fail(slider != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
 
-  if (tk_str_eq(name, WIDGET_PROP_VALUE)) {
-    value_set_double(v, slider->value);
-    return RET_OK;
-  } else if (tk_str_eq(name, WIDGET_PROP_VERTICAL)) {
-    value_set_bool(v, slider->vertical);
-    return RET_OK;
-  } else if (tk_str_eq(name, WIDGET_PROP_MIN)) {
-    value_set_double(v, slider->min);
-    return RET_OK;
-  } else if (tk_str_eq(name, WIDGET_PROP_MAX)) {
-    value_set_double(v, slider->max);
-    return RET_OK;
-  } else if (tk_str_eq(name, WIDGET_PROP_STEP)) {
-    value_set_double(v, slider->step);
-    return RET_OK;
-  } else if (tk_str_eq(name, WIDGET_PROP_BAR_SIZE)) {
-    value_set_uint32(v, slider->bar_size);
-    return RET_OK;
-  } else if (tk_str_eq(name, SLIDER_PROP_DRAGGER_SIZE)) {
+  if (tk_str_eq(name, SLIDER_PROP_DRAGGER_SIZE)) {
     value_set_uint32(v, slider->dragger_size);
     return RET_OK;
   } else if (tk_str_eq(name, SLIDER_PROP_DRAGGER_ADAPT_TO_ICON)) {
@@ -536,13 +592,6 @@ static ret_t slider_get_prop(widget_t* widget, const char* name, value_t* v) {
   } else if (tk_str_eq(name, SLIDER_PROP_SLIDE_WITH_BAR)) {
     value_set_bool(v, slider->slide_with_bar);
     return RET_OK;
-  } else if (tk_str_eq(name, WIDGET_PROP_INPUTING)) {
-    int64_t delta = (time_now_ms() - slider->last_user_action_time);
-    bool_t inputing =
-        (delta < TK_INPUTING_TIMEOUT) && (slider->last_user_action_time > 0) && widget->focused;
-
-    value_set_bool(v, inputing || slider->dragging);
-    return RET_OK;
   }
 
   return RET_NOT_FOUND;
@@ -552,19 +601,7 @@ static ret_t slider_set_prop(widget_t* widget, const char* name, const value_t*
   slider_t* slider = SLIDER(widget);
   return_value_if_fail(slider != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
 
-  if (tk_str_eq(name, WIDGET_PROP_VALUE)) {
-    return slider_set_value(widget, value_double(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_VERTICAL)) {
-    return slider_set_vertical(widget, value_bool(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_MIN)) {
-    return slider_set_min(widget, value_double(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_MAX)) {
-    return slider_set_max(widget, value_double(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_STEP)) {
-    return slider_set_step(widget, value_double(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_BAR_SIZE)) {
-    return slider_set_bar_size(widget, value_uint32(v));
-  } else if (tk_str_eq(name, SLIDER_PROP_DRAGGER_SIZE)) {
+  if (tk_str_eq(name, SLIDER_PROP_DRAGGER_SIZE)) {
     slider->dragger_size = value_uint32(v);
     return RET_OK;
   } else if (tk_str_eq(name, SLIDER_PROP_DRAGGER_ADAPT_TO_ICON)) {
@@ -600,6 +637,7 @@ TK_DECL_VTABLE(slider) = {.size = sizeof(slider_t),
                           .on_paint_self = slider_on_paint_self,
                           .on_paint_border = widget_on_paint_null,
                           .on_paint_background = widget_on_paint_null,
+                          .props = s_slider_props,
                           .get_prop = slider_get_prop,
                           .set_prop = slider_set_prop};
 
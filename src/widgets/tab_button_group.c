@@ -21,6 +21,7 @@
 
 #include "tkc/mem.h"
 #include "widgets/tab_button_group.h"
+#include "base/widget_spatial_index.h"
 
 static ret_t tab_button_group_on_layout_children_non_compact(widget_t* widget) {
   int32_t x = 0;
@@ -56,7 +57,9 @@ static ret_t tab_button_group_on_layout_children_compact(widget_t* widget) {
   tab_button_group_t* tab_button_group = TAB_BUTTON_GROUP(widget);
 
   WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
+  rect_t old = rect_init(iter->x, iter->y, iter->w, iter->h);
   iter->h = h;
+  widget_spatial_index_on_child_moved(iter, &old);
   if (widget_get_prop(iter, WIDGET_PROP_MIN_W, &v) == RET_OK) {
     w = value_int(&v);
   } else {
@@ -22,6 +22,7 @@
 #include "base/keys.h"
 #include "tkc/mem.h"
 #include "base/idle.h"
+#include "tkc/utf8.h"
 #include "tkc/utils.h"
 #include "base/timer.h"
 #include "base/layout.h"
@@ -30,8 +31,10 @@
 #include "base/locale_info.h"
 #include "base/system_info.h"
 #include "base/image_manager.h"
-#include "base/canvas_offline.h"
 #include "base/dirty_rects.inc"
+#include "base/paint_profiler.h"
+#include "base/widget_occlusion.h"
+#include "base/window_snapshot_pool.h"
 #include "base/dialog_highlighter_factory.h"
 #include "window_manager/window_manager_default.h"
 
@@ -137,16 +140,15 @@ ret_t window_manager_default_snap_curr_window(widget_t* widget, widget_t* curr_w
   r = rect_init(curr_win->x, curr_win->y, curr_win->w, curr_win->h);
 
   canvas_save(c);
-  canvas = canvas_offline_create(canvas_get_width(c), canvas_get_height(c),
-                                 lcd_get_desired_bitmap_format(c->lcd));
-  canvas_offline_begin_draw(canvas);
-  canvas_set_clip_rect(canvas, &r);
+  canvas = window_snapshot_pool_begin(canvas_get_width(c), canvas_get_height(c),
+                                      window_snapshot_pool_get_format(c->lcd), &r);
+  if (canvas == NULL) {
+    canvas_restore(c);
+    return RET_OOM;
+  }
   ENSURE(widget_on_paint_background(widget, canvas) == RET_OK);
   ENSURE(widget_paint(curr_win, canvas) == RET_OK);
-  canvas_offline_end_draw(canvas);
-  ENSURE(canvas_offline_bitmap_move_to_new_bitmap(canvas, img) == RET_OK);
-  ENSURE(canvas_offline_destroy(canvas) == RET_OK);
-  img->flags |= BITMAP_FLAG_OPAQUE;
+  ENSURE(window_snapshot_pool_end(canvas, img) == RET_OK);
   canvas_restore(c);
 #endif
   return RET_OK;
@@ -204,10 +206,12 @@ ret_t window_manager_default_snap_prev_window(widget_t* widget, widget_t* prev_w
   r = rect_init(prev_win->x, prev_win->y, prev_win->w, prev_win->h);
 
   canvas_save(c);
-  canvas = canvas_offline_create(canvas_get_width(c), canvas_get_height(c),
-                                 lcd_get_desired_bitmap_format(c->lcd));
-  canvas_offline_begin_draw(canvas);
-  canvas_set_clip_rect(canvas, &r);
+  canvas = window_snapshot_pool_begin(canvas_get_width(c), canvas_get_height(c),
+                                      window_snapshot_pool_get_format(c->lcd), &r);
+  if (canvas == NULL) {
+    canvas_restore(c);
+    return RET_OOM;
+  }
   ENSURE(widget_on_paint_background(widget, canvas) == RET_OK);
   window_manager_paint_system_bar(widget, canvas);
   {
@@ -235,10 +239,7 @@ ret_t window_manager_default_snap_prev_window(widget_t* widget, widget_t* prev_w
   if (dialog_highlighter != NULL) {
     dialog_highlighter_prepare_ex(dialog_highlighter, c, canvas);
   }
-  canvas_offline_end_draw(canvas);
-  ENSURE(canvas_offline_bitmap_move_to_new_bitmap(canvas, img) == RET_OK);
-  ENSURE(canvas_offline_destroy(canvas) == RET_OK);
-  img->flags |= BITMAP_FLAG_OPAQUE;
+  ENSURE(window_snapshot_pool_end(canvas, img) == RET_OK);
   canvas_restore(c);
 
   if (dialog_highlighter != NULL) {
@@ -630,6 +631,133 @@ static ret_t window_manager_update_cursor(widget_t* widget, int32_t x, int32_t y
   return RET_OK;
 }
 
+#ifndef WITHOUT_WIDGET_OCCLUSION
+#define WINDOW_MANAGER_OCCLUSION_RECT rect_init(0, 30, 160, 30)
+
+/*显示fps时，在fps下面显示本帧因为被遮住而没有绘制的控件个数，以及节省的像素与绘制的像素的比例*/
+static ret_t window_manager_paint_occlusion_stats(widget_t* widget, canvas_t* c) {
+  rect_t r_save;
+  char text[32];
+  wchar_t wtext[32];
+  uint32_t percent = 0;
+  rect_t r = WINDOW_MANAGER_OCCLUSION_RECT;
+  window_manager_default_t* wm = WINDOW_MANAGER_DEFAULT(widget);
+
+  if (!WINDOW_MANAGER(wm)->show_fps || c->lcd->draw_mode != LCD_DRAW_NORMAL) {
+    return RET_OK;
+  }
+
+  if (wm->last_paint_pixels > 0) {
+    percent = (uint64_t)widget_occlusion_get_saved_pixels() * 100 / wm->last_paint_pixels;
+  }
+  tk_snprintf(text, sizeof(text), "culled:%u %u%%", widget_occlusion_get_culled(), percent);
+  tk_utf8_to_utf16(text, wtext, ARRAY_SIZE(wtext));
+
+  canvas_get_clip_rect(c, &r_save);
+  canvas_set_clip_rect(c, &r);
+  canvas_set_font(c, NULL, 16);
+  canvas_set_text_color(c, color_init(0xf0, 0xf0, 0xf0, 0xff));
+  canvas_set_fill_color(c, color_init(0x20, 0x20, 0x20, 0xff));
+  canvas_fill_rect(c, r.x, r.y, r.w, r.h);
+  canvas_draw_text(c, wtext, wcslen(wtext), r.x + 8, r.y + 8);
+  canvas_set_clip_rect(c, &r_save);
+
+  return RET_OK;
+}
+#endif /*WITHOUT_WIDGET_OCCLUSION*/
+
+#ifdef WITH_DISPLAY_LIST
+static ret_t window_manager_reset_display_list(widget_t* widget) {
+  window_manager_default_t* wm = WINDOW_MANAGER_DEFAULT(widget);
+
+  if (wm->display_list != NULL) {
+    display_list_destroy(wm->display_list);
+    wm->display_list = NULL;
+  }
+
+  if (wm->prev_display_list != NULL) {
+    display_list_destroy(wm->prev_display_list);
+    wm->prev_display_list = NULL;
+  }
+
+  return RET_OK;
+}
+
+/*
+ * 先把本帧记录到显示列表(不绘制)，与上一帧的显示列表比较，
+ * 把脏矩形缩小到真正变化的区域，没有变化的部分不再重绘。
+ * 有无法记录的命令(如vgcanvas)时照常绘制，之后一段时间内不再记录。
+ */
+static ret_t window_manager_diff_dirty_rects(widget_t* widget, canvas_t* c) {
+  uint32_t i = 0;
+  lcd_t* lcd = c->lcd;
+  dirty_rects_t damage;
+  display_list_t* list = NULL;
+  window_manager_default_t* wm = WINDOW_MANAGER_DEFAULT(widget);
+  dirty_rects_t* dirty_rects = &(wm->native_window->dirty_rects);
+
+  if (dirty_rects->nr == 0 || dirty_rects->debug) {
+    return RET_OK;
+  }
+
+  if (wm->display_list_skip > 0 || lcd->type != LCD_FRAMEBUFFER || widget->children == NULL ||
+      widget->children->size == 0) {
+    if (wm->display_list_skip > 0) {
+      wm->display_list_skip--;
+    }
+    return window_manager_reset_display_list(widget);
+  }
+
+  if (wm->display_list_lcd != lcd) {
+    window_manager_reset_display_list(widget);
+    wm->display_list_lcd = lcd;
+  }
+
+  if (wm->display_list == NULL) {
+    wm->display_list = display_list_create(lcd);
+    return_value_if_fail(wm->display_list != NULL, RET_OOM);
+  }
+
+  list = wm->display_list;
+  c->lcd = display_list_get_lcd(list);
+  canvas_begin_frame(c, dirty_rects, LCD_DRAW_NORMAL);
+  if (dirty_rects->disable_multiple) {
+    widget_paint_with_clip(WIDGET(wm), &(dirty_rects->max), c, widget_paint);
+  } else {
+    for (i = 0; i < dirty_rects->nr; i++) {
+      widget_paint_with_clip(WIDGET(wm), dirty_rects->rects + i, c, widget_paint);
+    }
+  }
+  window_manager_paint_cursor(widget, c);
+  canvas_end_frame(c);
+  c->lcd = lcd;
+
+  if (display_list_has_unknown(list)) {
+    wm->display_list_skip = TK_DISPLAY_LIST_RETRY_FRAMES;
+    return window_manager_reset_display_list(widget);
+  }
+
+  display_list_diff(list, wm->prev_display_list, &damage);
+#ifndef WITHOUT_WIDGET_OCCLUSION
+  /*统计信息是真正绘制时的，没有记录在显示列表中*/
+  if (WINDOW_MANAGER(wm)->show_fps && damage.nr > 0) {
+    rect_t r = WINDOW_MANAGER_OCCLUSION_RECT;
+    dirty_rects_add(&damage, &r);
+  }
+  widget_occlusion_reset_stats();
+#endif /*WITHOUT_WIDGET_OCCLUSION*/
+
+  damage.profile = dirty_rects->profile;
+  damage.disable_multiple = dirty_rects->disable_multiple;
+  *dirty_rects = damage;
+
+  wm->display_list = wm->prev_display_list;
+  wm->prev_display_list = list;
+
+  return RET_OK;
+}
+#endif /*WITH_DISPLAY_LIST*/
+
 static ret_t window_manager_paint_normal(widget_t* widget, canvas_t* c) {
 #ifdef FRAGMENT_FRAME_BUFFER_SIZE
   uint32_t i = 0;
@@ -658,7 +786,14 @@ static ret_t window_manager_paint_normal(widget_t* widget, canvas_t* c) {
   if (WINDOW_MANAGER(wm)->show_fps) {
     rect_t fps_rect = rect_init(0, 0, 60, 30);
     window_manager_default_invalidate(widget, &fps_rect);
+#ifndef WITHOUT_WIDGET_OCCLUSION
+    fps_rect = WINDOW_MANAGER_OCCLUSION_RECT;
+    window_manager_default_invalidate(widget, &fps_rect);
+#endif /*WITHOUT_WIDGET_OCCLUSION*/
   }
+#ifndef WITHOUT_WIDGET_OCCLUSION
+  widget_occlusion_reset_stats();
+#endif /*WITHOUT_WIDGET_OCCLUSION*/
 #ifdef FRAGMENT_FRAME_BUFFER_SIZE
   if (wm->native_window->dirty_rects.max.w > 0 && wm->native_window->dirty_rects.max.h > 0) {
     rect_t r = native_window_calc_dirty_rect(wm->native_window);
@@ -694,6 +829,9 @@ static ret_t window_manager_paint_normal(widget_t* widget, canvas_t* c) {
     native_window_clear_dirty_rect(wm->native_window);
   }
 #else
+#ifdef WITH_DISPLAY_LIST
+  window_manager_diff_dirty_rects(widget, c);
+#endif /*WITH_DISPLAY_LIST*/
   if (native_window_begin_frame(wm->native_window, LCD_DRAW_NORMAL) == RET_OK) {
     if (widget->children == NULL || widget->children->size == 0) {
       color_t bg = color_init(0xff, 0xff, 0xff, 0xff);
@@ -708,7 +846,14 @@ static ret_t window_manager_paint_normal(widget_t* widget, canvas_t* c) {
       if (dirty_rects == NULL && !lcd_is_support_dirty_rect(c->lcd)) {
         dirty_rects = &(wm->native_window->dirty_rects);
       }
+      if (dirty_rects != NULL) {
+        wm->last_paint_pixels = dirty_rects_get_area(dirty_rects);
+        wm->last_paint_max_pixels = dirty_rects_rect_area(&(dirty_rects->max));
+      }
       dirty_rects_paint(dirty_rects, WIDGET(wm), c, widget_paint);
+#ifndef WITHOUT_WIDGET_OCCLUSION
+      window_manager_paint_occlusion_stats(widget, c);
+#endif /*WITHOUT_WIDGET_OCCLUSION*/
     }
     window_manager_paint_cursor(widget, c);
     native_window_end_frame(wm->native_window);
@@ -906,14 +1051,20 @@ static ret_t window_manager_default_paint(widget_t* widget) {
   ret_t ret = RET_OK;
   window_manager_default_t* wm = WINDOW_MANAGER_DEFAULT(widget);
   canvas_t* c = native_window_get_canvas(wm->native_window);
+  PAINT_PROFILER_VAR(start)
   return_value_if_fail(wm != NULL && c != NULL, RET_BAD_PARAMS);
 
+  PAINT_PROFILER_BEGIN(start)
   canvas_set_global_alpha(c, 0xff);
   window_manager_default_update_fps(widget);
   window_manager_set_curr_expected_sleep_time(widget, 0xFFFFFFFF);
 
 #ifndef WITHOUT_WINDOW_ANIMATORS
   if (wm->animator != NULL) {
+#ifdef WITH_DISPLAY_LIST
+    /*动画直接绘制到屏幕上，显示列表与屏幕的内容不再一致*/
+    window_manager_reset_display_list(widget);
+#endif /*WITH_DISPLAY_LIST*/
     ret = window_manager_paint_animation(widget, c);
   } else if (!wm->ready_animator) {
     ret = window_manager_paint_normal(widget, c);
@@ -921,6 +1072,8 @@ static ret_t window_manager_default_paint(widget_t* widget) {
 #else
   ret = window_manager_paint_normal(widget, c);
 #endif /*WITHOUT_WINDOW_ANIMATORS*/
+  PAINT_PROFILER_END_FRAME(start);
+
   return ret;
 }
 
@@ -952,8 +1105,47 @@ static ret_t window_manager_default_paint_always_on_top(widget_t* widget, canvas
   return RET_OK;
 }
 
+#ifndef WITHOUT_WIDGET_OCCLUSION
+/*
+ * 查找完全覆盖裁剪区的不透明窗口(在start之上，对话框等非普通窗口)，
+ * 它下面的窗口(包括普通窗口和系统栏)都不用绘制。
+ */
+static int32_t window_manager_default_find_covering_window(widget_t* widget, canvas_t* c,
+                                                           int32_t start) {
+  int32_t covering = -1;
+
+  WIDGET_FOR_EACH_CHILD_BEGIN_R(widget, iter, i)
+  if (i <= start) {
+    break;
+  }
+
+  if (iter->visible && !widget_is_system_bar(iter) && !widget_is_normal_window(iter) &&
+      widget_occlusion_covers_clip(iter, c)) {
+    covering = i;
+    break;
+  }
+  WIDGET_FOR_EACH_CHILD_END()
+
+  if (covering > 0) {
+    WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
+    if (i >= covering) {
+      break;
+    }
+
+    if (iter->visible && (i >= start || widget_is_system_bar(iter))) {
+      rect_t r = rect_init(c->ox + iter->x, c->oy + iter->y, iter->w, iter->h);
+      widget_occlusion_add_culled(c, &r);
+    }
+    WIDGET_FOR_EACH_CHILD_END()
+  }
+
+  return covering;
+}
+#endif /*WITHOUT_WIDGET_OCCLUSION*/
+
 static ret_t window_manager_default_on_paint_children(widget_t* widget, canvas_t* c) {
   int32_t start = 0;
+  int32_t covering = -1;
   bool_t has_fullscreen_win = FALSE;
   window_manager_default_t* wm = WINDOW_MANAGER_DEFAULT(widget);
   return_value_if_fail(widget != NULL && c != NULL, RET_BAD_PARAMS);
@@ -970,7 +1162,13 @@ static ret_t window_manager_default_on_paint_children(widget_t* widget, canvas_t
   }
   WIDGET_FOR_EACH_CHILD_END()
 
-  if (wm->dialog_highlighter != NULL) {
+#ifndef WITHOUT_WIDGET_OCCLUSION
+  covering = window_manager_default_find_covering_window(widget, c, start);
+#endif /*WITHOUT_WIDGET_OCCLUSION*/
+
+  if (covering > 0) {
+    start = covering;
+  } else if (wm->dialog_highlighter != NULL) {
     dialog_highlighter_draw(wm->dialog_highlighter, 1);
   } else {
     /*paint normal windows*/
@@ -1061,8 +1259,12 @@ static ret_t window_manager_default_on_destroy(widget_t* widget) {
     window_animator_destroy(wm->animator);
     wm->animator = NULL;
   }
+  window_snapshot_pool_clear();
 #endif /*WITHOUT_WINDOW_ANIMATORS*/
 
+#ifdef WITH_DISPLAY_LIST
+  window_manager_reset_display_list(widget);
+#endif /*WITH_DISPLAY_LIST*/
   object_unref(OBJECT(wm->native_window));
 
   return RET_OK;
@@ -25,6 +25,9 @@
 #include "tkc/fps.h"
 #include "base/native_window.h"
 #include "base/window_manager.h"
+#ifdef WITH_DISPLAY_LIST
+#include "base/display_list.h"
+#endif /*WITH_DISPLAY_LIST*/
 
 BEGIN_C_DECLS
 
@@ -45,6 +48,9 @@ typedef struct _window_manager_default_t {
   fps_t fps;
   uint32_t last_paint_cost;
   uint64_t last_paint_time;
+  /*最近一帧绘制的像素个数(脏矩形的总面积)和脏矩形外接矩形的像素个数*/
+  uint32_t last_paint_pixels;
+  uint32_t last_paint_max_pixels;
 
   widget_t* pending_close_window;
   widget_t* pending_open_window;
@@ -67,6 +73,14 @@ typedef struct _window_manager_default_t {
   int32_t lcd_w;
   int32_t lcd_h;
 
+#ifdef WITH_DISPLAY_LIST
+  /*本帧和上一帧的显示列表，用于计算真正变化的区域*/
+  lcd_t* display_list_lcd;
+  display_list_t* display_list;
+  display_list_t* prev_display_list;
+  uint32_t display_list_skip;
+#endif /*WITH_DISPLAY_LIST*/
+
 } window_manager_default_t;
 
 /**
@@ -0,0 +1,121 @@
+﻿#include "tkc/atom.h"
+#include "base/idle.h"
+#include "base/widget.h"
+#include "base/window.h"
+#include "widgets/button.h"
+#include "gtest/gtest.h"
+
+#include <string>
+
+using std::string;
+
+TEST(Atom, basic) {
+  char buff[32];
+  tk_atom_stat_t s0;
+  tk_atom_stat_t s1;
+  const char* a = NULL;
+  const char* b = NULL;
+
+  ASSERT_EQ(tk_atom_get_stat(&s0), RET_OK);
+  ASSERT_TRUE(tk_atom(NULL) == NULL);
+  ASSERT_TRUE(tk_atom_find("atom_test_basic") == NULL);
+
+  strcpy(buff, "atom_test_basic");
+  a = tk_atom("atom_test_basic");
+  b = tk_atom(buff);
+  ASSERT_TRUE(a != NULL);
+  ASSERT_TRUE(a == b);
+  ASSERT_TRUE(a != buff);
+  ASSERT_EQ(string(a), string("atom_test_basic"));
+  ASSERT_TRUE(tk_atom_find(buff) == a);
+  ASSERT_TRUE(tk_atom_ref(a) == a);
+
+  ASSERT_EQ(tk_atom_get_stat(&s1), RET_OK);
+  ASSERT_EQ(s1.count, s0.count + 1);
+  ASSERT_EQ(s1.refs, s0.refs + 3);
+  ASSERT_EQ(s1.saved_size, s0.saved_size + 2 * sizeof("atom_test_basic"));
+  ASSERT_GT(s1.mem_size, s0.mem_size);
+
+  ASSERT_EQ(tk_atom_unref(a), RET_OK);
+  ASSERT_EQ(tk_atom_unref(a), RET_OK);
+  ASSERT_TRUE(tk_atom_find(buff) == a);
+  ASSERT_EQ(tk_atom_unref(b), RET_OK);
+  ASSERT_TRUE(tk_atom_find(buff) == NULL);
+  ASSERT_EQ(tk_atom_unref(NULL), RET_OK);
+
+  ASSERT_EQ(tk_atom_get_stat(&s1), RET_OK);
+  ASSERT_EQ(s1.count, s0.count);
+  ASSERT_EQ(s1.refs, s0.refs);
+}
+
+TEST(Atom, deinit) {
+  const char* a = tk_atom("atom_test_deinit");
+
+  /*仍被引用的原子字符串在deinit之后保持有效*/
+  ASSERT_EQ(tk_atom_deinit(), RET_OK);
+  ASSERT_EQ(string(a), string("atom_test_deinit"));
+  ASSERT_TRUE(tk_atom_find("atom_test_deinit") == a);
+
+  ASSERT_EQ(tk_atom_init(), RET_OK);
+  ASSERT_EQ(tk_atom_unref(a), RET_OK);
+  ASSERT_TRUE(tk_atom_find("atom_test_deinit") == NULL);
+}
+
+TEST(Atom, many) {
+  uint32_t i = 0;
+  char buff[32];
+  const char* atoms[1000];
+
+  for (i = 0; i < ARRAY_SIZE(atoms); i++) {
+    tk_snprintf(buff, sizeof(buff), "atom_test_%u", i);
+    atoms[i] = tk_atom(buff);
+    ASSERT_TRUE(atoms[i] != NULL);
+  }
+
+  for (i = 0; i < ARRAY_SIZE(atoms); i++) {
+    tk_snprintf(buff, sizeof(buff), "atom_test_%u", i);
+    ASSERT_TRUE(tk_atom_find(buff) == atoms[i]);
+    ASSERT_EQ(string(atoms[i]), string(buff));
+  }
+
+  for (i = 0; i < ARRAY_SIZE(atoms); i++) {
+    tk_atom_unref(atoms[i]);
+  }
+  ASSERT_TRUE(tk_atom_find("atom_test_0") == NULL);
+}
+
+TEST(Atom, widget) {
+  char name[32];
+  widget_t* w = window_create(NULL, 0, 0, 400, 300);
+  widget_t* b1 = button_create(w, 0, 0, 10, 10);
+  widget_t* b2 = button_create(w, 0, 0, 10, 10);
+
+  strcpy(name, "atom_test_ok");
+  widget_set_name(b1, name);
+  widget_set_name(b2, "atom_test_ok");
+  widget_use_style(b1, "atom_test_style");
+  widget_use_style(b2, "atom_test_style");
+
+  /*相同的字符串只保存一份*/
+  ASSERT_TRUE(b1->name == b2->name);
+  ASSERT_TRUE(b1->style == b2->style);
+  ASSERT_TRUE(b1->state == b2->state);
+  ASSERT_TRUE(tk_atom_find(name) == b1->name);
+
+  ASSERT_TRUE(widget_lookup(w, name, FALSE) == b1);
+  ASSERT_TRUE(widget_lookup(w, name, TRUE) == b1);
+  ASSERT_TRUE(widget_lookup(w, "atom_test_none", TRUE) == NULL);
+
+  widget_set_state(b2, WIDGET_STATE_PRESSED);
+  ASSERT_EQ(string(b2->state), string(WIDGET_STATE_PRESSED));
+  ASSERT_TRUE(b1->state != b2->state);
+
+  widget_set_name(b1, "atom_test_cancel");
+  ASSERT_TRUE(widget_lookup(w, "atom_test_cancel", TRUE) == b1);
+  ASSERT_TRUE(widget_lookup(w, "atom_test_ok", TRUE) == b2);
+
+  widget_destroy(w);
+  idle_dispatch();
+  ASSERT_TRUE(tk_atom_find("atom_test_ok") == NULL);
+  ASSERT_TRUE(tk_atom_find("atom_test_style") == NULL);
+}
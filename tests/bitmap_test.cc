@@ -201,3 +201,63 @@ TEST(Bitmap, transform2) {
 
   bitmap_destroy(b);
 }
+
+TEST(Bitmap, alpha_runs) {
+  uint32_t x = 0;
+  uint32_t nr = 0;
+  bitmap_t copy;
+  const uint16_t* runs = NULL;
+  bitmap_t* b = bitmap_create_ex(16, 2, 0, BITMAP_FMT_RGBA8888);
+  uint8_t* bdata = bitmap_lock_buffer_for_write(b);
+
+  /*第一行：4个全透明，8个不透明，4个半透明；第二行：全部不透明*/
+  for (x = 0; x < 16; x++) {
+    bdata[x * 4 + 3] = x < 4 ? 0 : (x < 12 ? 0xff : 0x80);
+    bdata[b->line_length + x * 4 + 3] = 0xf9;
+  }
+  bitmap_unlock_buffer(b);
+
+  ASSERT_EQ(bitmap_build_alpha_runs(b), RET_OK);
+
+  runs = bitmap_get_alpha_runs(b, 0, &nr);
+  ASSERT_EQ(nr, 3u);
+  ASSERT_EQ(BITMAP_ALPHA_RUN_TYPE(runs[0]), BITMAP_ALPHA_RUN_TRANSPARENT);
+  ASSERT_EQ(BITMAP_ALPHA_RUN_LEN(runs[0]), 4);
+  ASSERT_EQ(BITMAP_ALPHA_RUN_TYPE(runs[1]), BITMAP_ALPHA_RUN_OPAQUE);
+  ASSERT_EQ(BITMAP_ALPHA_RUN_LEN(runs[1]), 8);
+  ASSERT_EQ(BITMAP_ALPHA_RUN_TYPE(runs[2]), BITMAP_ALPHA_RUN_TRANSLUCENT);
+  ASSERT_EQ(BITMAP_ALPHA_RUN_LEN(runs[2]), 4);
+
+  runs = bitmap_get_alpha_runs(b, 1, &nr);
+  ASSERT_EQ(nr, 1u);
+  ASSERT_EQ(BITMAP_ALPHA_RUN_TYPE(runs[0]), BITMAP_ALPHA_RUN_OPAQUE);
+  ASSERT_EQ(BITMAP_ALPHA_RUN_LEN(runs[0]), 16);
+
+  ASSERT_EQ(bitmap_get_alpha_runs(b, 2, &nr) == NULL, TRUE);
+
+  /*写数据后分段表失效*/
+  bitmap_lock_buffer_for_write(b);
+  bitmap_unlock_buffer(b);
+  ASSERT_EQ(bitmap_get_alpha_runs(b, 0, &nr) == NULL, TRUE);
+
+  /*拷贝共用数据和分段表，通过拷贝写数据时分段表也失效，只有owner释放分段表*/
+  ASSERT_EQ(bitmap_build_alpha_runs(b), RET_OK);
+  ASSERT_EQ(bitmap_get_alpha_runs(b, 0, &nr) != NULL, TRUE);
+  copy = *b;
+  copy.should_free_data = FALSE;
+  copy.should_free_handle = FALSE;
+  ASSERT_EQ(bitmap_get_alpha_runs(&copy, 0, &nr) != NULL, TRUE);
+  bitmap_lock_buffer_for_write(&copy);
+  bitmap_unlock_buffer(&copy);
+  ASSERT_EQ(copy.alpha_runs == NULL, TRUE);
+  ASSERT_EQ(bitmap_get_alpha_runs(b, 0, &nr) == NULL, TRUE);
+  bitmap_destroy(&copy);
+
+  ASSERT_EQ(bitmap_build_alpha_runs(b), RET_OK);
+  ASSERT_EQ(bitmap_get_alpha_runs(b, 0, &nr) != NULL, TRUE);
+  bitmap_destroy(b);
+
+  b = bitmap_create_ex(16, 2, 0, BITMAP_FMT_BGR565);
+  ASSERT_EQ(bitmap_build_alpha_runs(b), RET_NOT_IMPL);
+  bitmap_destroy(b);
+}
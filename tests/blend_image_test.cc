@@ -2,6 +2,7 @@
 #include "tkc/color.h"
 #include "base/bitmap.h"
 #include "blend/image_g2d.h"
+#include "blend/blend_simd.h"
 #include "gtest/gtest.h"
 #include "common.h"
 
@@ -71,3 +72,137 @@ TEST(BlendImage, BITMAP_FMT_BGR565_stride) {
   test_blend_image(2, BITMAP_FMT_BGR565, BITMAP_FMT_RGBA8888);
   test_blend_image(3, BITMAP_FMT_BGR888, BITMAP_FMT_BGR565);
 }
+
+static void fill_random_pixels(bitmap_t* b, uint32_t seed) {
+  uint32_t i = 0;
+  uint32_t size = b->line_length * b->h;
+  uint8_t* data = bitmap_lock_buffer_for_write(b);
+
+  for (i = 0; i < size; i++) {
+    seed = seed * 1103515245 + 12345;
+    data[i] = (uint8_t)(seed >> 16);
+  }
+
+  if (bitmap_get_bpp(b) == 4) {
+    /*让alpha形成全透明、不透明和半透明的连续段*/
+    for (i = 3; i < size; i += 4) {
+      uint32_t k = (i / 4) % 37;
+      if (k < 11) {
+        data[i] = 0;
+      } else if (k < 23) {
+        data[i] = 0xf9 + k % 7;
+      } else if (k < 26) {
+        data[i] = k % 2 ? 8 : 9;
+      }
+    }
+  }
+  bitmap_unlock_buffer(b);
+}
+
+static void test_blend_simd_exact(bitmap_format_t dfmt, bitmap_format_t sfmt, uint8_t alpha,
+                                  bool_t premulti, const rectf_t* dr, const rectf_t* sr) {
+  uint32_t w = 67;
+  uint32_t h = 13;
+  uint32_t dbpp = bitmap_get_bpp_of_format(dfmt);
+  bitmap_t* src = bitmap_create_ex(w, h, bitmap_get_bpp_of_format(sfmt) * w, sfmt);
+  bitmap_t* ref = bitmap_create_ex(w, h, dbpp * w, dfmt);
+  bitmap_t* out = bitmap_create_ex(w, h, dbpp * w, dfmt);
+
+  fill_random_pixels(src, 1);
+  fill_random_pixels(ref, 2);
+  fill_random_pixels(out, 2);
+  if (premulti) {
+    src->flags |= BITMAP_FLAG_PREMULTI_ALPHA;
+  }
+
+  blend_simd_set_enable(FALSE);
+  ASSERT_EQ(image_blend(ref, src, dr, sr, alpha), RET_OK);
+  blend_simd_set_enable(TRUE);
+  ASSERT_EQ(image_blend(out, src, dr, sr, alpha), RET_OK);
+
+  ASSERT_EQ(memcmp(bitmap_lock_buffer_for_read(ref), bitmap_lock_buffer_for_read(out),
+                   ref->line_length * h),
+            0);
+
+  bitmap_unlock_buffer(ref);
+  bitmap_unlock_buffer(out);
+  bitmap_destroy(src);
+  bitmap_destroy(ref);
+  bitmap_destroy(out);
+}
+
+TEST(BlendImage, simd_exact) {
+  uint32_t d = 0;
+  uint32_t s = 0;
+  uint32_t a = 0;
+  uint8_t alphas[] = {0xff, 0xf0, 0x80, 0x10};
+  bitmap_format_t dfmts[] = {BITMAP_FMT_BGR565,   BITMAP_FMT_RGB565,   BITMAP_FMT_BGR888,
+                             BITMAP_FMT_RGB888,   BITMAP_FMT_BGRA8888, BITMAP_FMT_RGBA8888};
+  bitmap_format_t sfmts[] = {BITMAP_FMT_RGBA8888, BITMAP_FMT_BGRA8888, BITMAP_FMT_BGR565,
+                             BITMAP_FMT_RGB565};
+  rectf_t same = rectf_init(1, 1, 65, 11);
+  rectf_t small = rectf_init(2, 3, 20, 7);
+  rectf_t large = rectf_init(0, 0, 67, 13);
+
+  for (d = 0; d < ARRAY_SIZE(dfmts); d++) {
+    for (s = 0; s < ARRAY_SIZE(sfmts); s++) {
+      for (a = 0; a < ARRAY_SIZE(alphas); a++) {
+        test_blend_simd_exact(dfmts[d], sfmts[s], alphas[a], FALSE, &same, &same);
+        test_blend_simd_exact(dfmts[d], sfmts[s], alphas[a], TRUE, &same, &same);
+        test_blend_simd_exact(dfmts[d], sfmts[s], alphas[a], FALSE, &large, &small);
+        test_blend_simd_exact(dfmts[d], sfmts[s], alphas[a], TRUE, &small, &large);
+      }
+    }
+  }
+}
+
+static void test_blend_alpha_runs_exact(bitmap_format_t dfmt, bitmap_format_t sfmt, uint8_t alpha,
+                                        const rectf_t* r) {
+  uint32_t w = 67;
+  uint32_t h = 13;
+  uint32_t dbpp = bitmap_get_bpp_of_format(dfmt);
+  bitmap_t* src = bitmap_create_ex(w, h, bitmap_get_bpp_of_format(sfmt) * w, sfmt);
+  bitmap_t* ref = bitmap_create_ex(w, h, dbpp * w, dfmt);
+  bitmap_t* out = bitmap_create_ex(w, h, dbpp * w, dfmt);
+
+  fill_random_pixels(src, 3);
+  fill_random_pixels(ref, 4);
+  fill_random_pixels(out, 4);
+
+  ASSERT_EQ(image_blend(ref, src, r, r, alpha), RET_OK);
+  ASSERT_EQ(bitmap_build_alpha_runs(src), RET_OK);
+  ASSERT_EQ(src->alpha_runs != NULL, TRUE);
+  ASSERT_EQ(image_blend(out, src, r, r, alpha), RET_OK);
+
+  ASSERT_EQ(memcmp(bitmap_lock_buffer_for_read(ref), bitmap_lock_buffer_for_read(out),
+                   ref->line_length * h),
+            0);
+
+  bitmap_unlock_buffer(ref);
+  bitmap_unlock_buffer(out);
+  bitmap_destroy(src);
+  bitmap_destroy(ref);
+  bitmap_destroy(out);
+}
+
+TEST(BlendImage, alpha_runs_exact) {
+  uint32_t d = 0;
+  uint32_t a = 0;
+  uint32_t e = 0;
+  uint8_t alphas[] = {0xff, 0xf0, 0x80};
+  bitmap_format_t dfmts[] = {BITMAP_FMT_BGR565, BITMAP_FMT_RGB888, BITMAP_FMT_BGRA8888,
+                             BITMAP_FMT_RGBA8888};
+  rectf_t full = rectf_init(0, 0, 67, 13);
+  rectf_t part = rectf_init(5, 2, 40, 9);
+
+  for (e = 0; e < 2; e++) {
+    blend_simd_set_enable(e == 0);
+    for (d = 0; d < ARRAY_SIZE(dfmts); d++) {
+      for (a = 0; a < ARRAY_SIZE(alphas); a++) {
+        test_blend_alpha_runs_exact(dfmts[d], BITMAP_FMT_RGBA8888, alphas[a], &full);
+        test_blend_alpha_runs_exact(dfmts[d], BITMAP_FMT_BGRA8888, alphas[a], &part);
+      }
+    }
+  }
+  blend_simd_set_enable(TRUE);
+}
@@ -42,7 +42,10 @@ TEST(DirtyRects, basic) {
   r = rect_init(100, 20, 10, 10);
   ASSERT_EQ(dirty_rects_add(&dr, &r), RET_OK);
 
-  ASSERT_EQ(dr.nr, 2u);
+  /*只合并多绘制面积最小的两个*/
+  ASSERT_EQ(dr.nr, 3u);
+  ASSERT_EQ(memcmp(&r, dr.rects + 2, sizeof(rect_t)), 0);
+  r = rect_init(10, 10, 20, 20);
   ASSERT_EQ(memcmp(&r, dr.rects + 1, sizeof(rect_t)), 0);
 
   dirty_rects_reset(&dr);
@@ -174,3 +177,88 @@ TEST(DirtyRects, overlap4) {
   }
   dirty_rects_deinit(&dr);
 }
+
+TEST(DirtyRects, corners) {
+  rect_t r;
+  dirty_rects_t dr;
+  dirty_rects_init(&dr);
+
+  r = rect_init(0, 0, 10, 10);
+  ASSERT_EQ(dirty_rects_add(&dr, &r), RET_OK);
+  r = rect_init(790, 0, 10, 10);
+  ASSERT_EQ(dirty_rects_add(&dr, &r), RET_OK);
+  r = rect_init(0, 470, 10, 10);
+  ASSERT_EQ(dirty_rects_add(&dr, &r), RET_OK);
+  r = rect_init(790, 470, 10, 10);
+  ASSERT_EQ(dirty_rects_add(&dr, &r), RET_OK);
+
+  /*超出个数后不会合并成整个屏幕*/
+  ASSERT_EQ(dr.nr, 3u);
+  ASSERT_EQ(dirty_rects_get_area(&dr), 100u + 100u + 10u * 480u);
+
+  r = rect_init(0, 0, 800, 480);
+  ASSERT_EQ(memcmp(&r, &(dr.max), sizeof(rect_t)), 0);
+
+  dirty_rects_deinit(&dr);
+}
+
+TEST(DirtyRects, overlap_split) {
+  rect_t r;
+  dirty_rects_t dr;
+  dirty_rects_init(&dr);
+
+  r = rect_init(0, 0, 800, 20);
+  ASSERT_EQ(dirty_rects_add(&dr, &r), RET_OK);
+
+  /*合并成外接矩形的开销太大，只加入不重叠的部分*/
+  r = rect_init(0, 0, 20, 480);
+  ASSERT_EQ(dirty_rects_add(&dr, &r), RET_OK);
+  ASSERT_EQ(dr.nr, 2u);
+
+  r = rect_init(0, 20, 20, 460);
+  ASSERT_EQ(memcmp(&r, dr.rects + 1, sizeof(rect_t)), 0);
+  ASSERT_EQ(dirty_rects_get_area(&dr), 800u * 20u + 20u * 460u);
+
+  dirty_rects_deinit(&dr);
+}
+
+static bool_t dirty_rects_test_covered(dirty_rects_t* dr, xy_t x, xy_t y) {
+  uint32_t i = 0;
+  uint32_t n = 0;
+
+  for (i = 0; i < dr->nr; i++) {
+    if (rect_contains(dr->rects + i, x, y)) {
+      n++;
+    }
+  }
+
+  return n == 1;
+}
+
+TEST(DirtyRects, random) {
+  rect_t r;
+  uint32_t i = 0;
+  uint32_t k = 0;
+  dirty_rects_t dr;
+  rect_t added[20];
+
+  srand(1234);
+  for (k = 0; k < 100; k++) {
+    dirty_rects_init(&dr);
+    for (i = 0; i < ARRAY_SIZE(added); i++) {
+      r = rect_init(rand() % 200, rand() % 200, 1 + rand() % 60, 1 + rand() % 60);
+      added[i] = r;
+      ASSERT_EQ(dirty_rects_add(&dr, &r), RET_OK);
+      ASSERT_LE(dr.nr, (uint32_t)TK_MAX_DIRTY_RECT_NR);
+    }
+
+    /*覆盖全部加入的矩形，并且互不重叠*/
+    for (i = 0; i < ARRAY_SIZE(added); i++) {
+      const rect_t* a = added + i;
+      ASSERT_TRUE(dirty_rects_test_covered(&dr, a->x, a->y));
+      ASSERT_TRUE(dirty_rects_test_covered(&dr, a->x + a->w - 1, a->y + a->h - 1));
+      ASSERT_TRUE(dirty_rects_test_covered(&dr, a->x + a->w / 2, a->y + a->h / 2));
+    }
+    dirty_rects_deinit(&dr);
+  }
+}
@@ -0,0 +1,297 @@
+#include "tkc/mem.h"
+#include "base/window.h"
+#include "base/display_list.h"
+#include "base/widget_vtable.h"
+#include "base/font_manager.h"
+#include "widgets/view.h"
+#include "widgets/label.h"
+#include "lcd/lcd_mem_bgra8888.h"
+#include "gtest/gtest.h"
+
+#define DL_W 320
+#define DL_H 240
+
+/*窗口管理器没有原生窗口时，窗口的大小为0*/
+static widget_t* display_list_test_create_window(void) {
+  widget_t* win = window_create(NULL, 0, 0, DL_W, DL_H);
+  widget_resize(win, DL_W, DL_H);
+  widget_set_style_color(win, "normal:bg_color", 0xff336699);
+
+  return win;
+}
+
+static void display_list_test_paint(widget_t* win, lcd_t* lcd, const rect_t* r) {
+  canvas_t c;
+  dirty_rects_t dr;
+
+  dirty_rects_init(&dr);
+  dirty_rects_add(&dr, r);
+  canvas_init(&c, lcd, font_manager());
+  canvas_begin_frame(&c, &dr, LCD_DRAW_OFFLINE);
+  widget_paint_with_clip(win, (rect_t*)r, &c, widget_paint);
+  canvas_end_frame(&c);
+  canvas_reset(&c);
+}
+
+static void display_list_test_record(widget_t* win, display_list_t* list, const rect_t* r) {
+  display_list_test_paint(win, display_list_get_lcd(list), r);
+}
+
+static uint8_t* display_list_test_alloc(uint32_t size) {
+  uint8_t* p = (uint8_t*)TKMEM_ALLOC(size);
+  memset(p, 0x00, size);
+
+  return p;
+}
+
+static bool_t display_list_test_rect_eq(const rect_t* a, const rect_t* b) {
+  return a->x == b->x && a->y == b->y && a->w == b->w && a->h == b->h;
+}
+
+TEST(DisplayList, replay) {
+  canvas_t c;
+  dirty_rects_t dr;
+  uint32_t size = DL_W * DL_H * 4;
+  rect_t all = rect_init(0, 0, DL_W, DL_H);
+  uint8_t* expected = display_list_test_alloc(size);
+  uint8_t* fb = display_list_test_alloc(size);
+  uint8_t* blank = display_list_test_alloc(size);
+  lcd_t* direct = lcd_mem_bgra8888_create_single_fb(DL_W, DL_H, expected);
+  lcd_t* lcd = lcd_mem_bgra8888_create_single_fb(DL_W, DL_H, fb);
+  display_list_t* list = display_list_create(lcd);
+  widget_t* win = display_list_test_create_window();
+  widget_t* view = view_create(win, 10, 10, 100, 80);
+  widget_t* label = label_create(win, 20, 100, 200, 40);
+
+  widget_set_style_color(view, "normal:bg_color", 0x80996633);
+  widget_set_style_color(view, "normal:border_color", 0xff00ff00);
+  widget_set_text_utf8(label, "display list");
+  widget_set_style_color(label, "normal:text_color", 0xff112233);
+
+  display_list_test_paint(win, direct, &all);
+  display_list_test_record(win, list, &all);
+  ASSERT_GT(display_list_size(list), 3u);
+  ASSERT_FALSE(display_list_has_unknown(list));
+  /*记录时不绘制*/
+  ASSERT_EQ(memcmp(blank, fb, size), 0);
+
+  dirty_rects_init(&dr);
+  dirty_rects_add(&dr, &all);
+  canvas_init(&c, lcd, font_manager());
+  canvas_begin_frame(&c, &dr, LCD_DRAW_OFFLINE);
+  ASSERT_EQ(display_list_replay(list, lcd), RET_OK);
+  canvas_end_frame(&c);
+  canvas_reset(&c);
+  ASSERT_EQ(memcmp(expected, fb, size), 0);
+
+  widget_destroy(win);
+  display_list_destroy(list);
+  lcd_destroy(direct);
+  lcd_destroy(lcd);
+  TKMEM_FREE(expected);
+  TKMEM_FREE(blank);
+  TKMEM_FREE(fb);
+}
+
+TEST(DisplayList, glyph_data) {
+  canvas_t c;
+  glyph_t g;
+  dirty_rects_t dr;
+  uint8_t data[8 * 8];
+  uint32_t offset = (12 * DL_W + 12) * 4;
+  rect_t src = rect_init(0, 0, 8, 8);
+  rect_t all = rect_init(0, 0, DL_W, DL_H);
+  uint8_t* fb = display_list_test_alloc(DL_W * DL_H * 4);
+  lcd_t* lcd = lcd_mem_bgra8888_create_single_fb(DL_W, DL_H, fb);
+  display_list_t* list = display_list_create(lcd);
+  lcd_t* record = display_list_get_lcd(list);
+
+  memset(&g, 0x00, sizeof(g));
+  memset(data, 0xff, sizeof(data));
+  g.w = 8;
+  g.h = 8;
+  g.data = data;
+  g.format = GLYPH_FMT_ALPHA;
+  lcd_set_text_color(record, color_init(0xff, 0, 0, 0xff));
+  ASSERT_EQ(lcd_draw_glyph(record, &g, &src, 10, 10), RET_OK);
+
+  /*记录之后字模缓存淘汰了字模，数据被重用，重放时仍然使用记录时的数据*/
+  memset(data, 0x00, sizeof(data));
+
+  dirty_rects_init(&dr);
+  dirty_rects_add(&dr, &all);
+  canvas_init(&c, lcd, font_manager());
+  canvas_begin_frame(&c, &dr, LCD_DRAW_OFFLINE);
+  ASSERT_EQ(display_list_replay(list, lcd), RET_OK);
+  canvas_end_frame(&c);
+  canvas_reset(&c);
+  ASSERT_EQ(fb[offset + 2], 0xff);
+  ASSERT_EQ(fb[offset + 1], 0x00);
+
+  display_list_destroy(list);
+  lcd_destroy(lcd);
+  TKMEM_FREE(fb);
+}
+
+TEST(DisplayList, diff) {
+  dirty_rects_t damage;
+  uint8_t* fb = display_list_test_alloc(DL_W * DL_H * 4);
+  lcd_t* lcd = lcd_mem_bgra8888_create_single_fb(DL_W, DL_H, fb);
+  display_list_t* prev = display_list_create(lcd);
+  display_list_t* list = display_list_create(lcd);
+  rect_t all = rect_init(0, 0, DL_W, DL_H);
+  rect_t part = rect_init(0, 0, 200, 200);
+  widget_t* win = display_list_test_create_window();
+  widget_t* view = view_create(win, 10, 10, 100, 80);
+  widget_t* label = label_create(win, 20, 100, 200, 40);
+  rect_t view_r = rect_init(view->x, view->y, view->w, view->h);
+  rect_t added_r = rect_init(150, 20, 30, 30);
+  widget_t* added = NULL;
+
+  widget_set_style_color(view, "normal:bg_color", 0xff996633);
+  widget_set_text_utf8(label, "display list");
+
+  /*没有上一帧时，绘制的区域都需要重绘*/
+  display_list_test_record(win, prev, &all);
+  ASSERT_EQ(display_list_diff(prev, NULL, &damage), RET_OK);
+  ASSERT_TRUE(display_list_test_rect_eq(&(damage.max), &all));
+
+  /*整个窗口都无效了，但是内容没有变化*/
+  display_list_test_record(win, list, &all);
+  ASSERT_EQ(display_list_diff(list, prev, &damage), RET_OK);
+  ASSERT_EQ(damage.nr, 0u);
+
+  /*只有颜色改变的控件需要重绘*/
+  widget_set_style_color(view, "normal:bg_color", 0xff123456);
+  display_list_test_record(win, prev, &all);
+  ASSERT_EQ(display_list_diff(prev, list, &damage), RET_OK);
+  ASSERT_EQ(damage.nr, 1u);
+  ASSERT_TRUE(display_list_test_rect_eq(&(damage.max), &view_r));
+
+  /*文本改变时，只重绘变化的字模*/
+  widget_set_text_utf8(label, "display lisT");
+  display_list_test_record(win, list, &all);
+  ASSERT_EQ(display_list_diff(list, prev, &damage), RET_OK);
+  ASSERT_GT(damage.nr, 0u);
+  ASSERT_GE(damage.max.x, label->x + 40);
+  ASSERT_LE(damage.max.x + damage.max.w, label->x + label->w);
+  ASSERT_GE(damage.max.y, label->y);
+  ASSERT_LE(damage.max.y + damage.max.h, label->y + label->h);
+
+  /*插入的控件*/
+  added = view_create(win, added_r.x, added_r.y, added_r.w, added_r.h);
+  widget_set_style_color(added, "normal:bg_color", 0xff00ff00);
+  widget_restack(added, 1);
+  display_list_test_record(win, prev, &all);
+  ASSERT_EQ(display_list_diff(prev, list, &damage), RET_OK);
+  ASSERT_EQ(damage.nr, 1u);
+  ASSERT_TRUE(display_list_test_rect_eq(&(damage.max), &added_r));
+
+  /*绘制的区域不同*/
+  display_list_test_record(win, list, &part);
+  ASSERT_EQ(display_list_diff(list, prev, &damage), RET_OK);
+  ASSERT_TRUE(display_list_test_rect_eq(&(damage.max), &part));
+
+  widget_destroy(win);
+  display_list_destroy(prev);
+  display_list_destroy(list);
+  lcd_destroy(lcd);
+  TKMEM_FREE(fb);
+}
+
+static void display_list_test_draw_image(canvas_t* c, display_list_t* list, bitmap_t* img,
+                                         const rect_t* dst) {
+  dirty_rects_t dr;
+  rect_t all = rect_init(0, 0, DL_W, DL_H);
+  rect_t src = rect_init(0, 0, img->w, img->h);
+
+  dirty_rects_init(&dr);
+  dirty_rects_add(&dr, &all);
+  c->lcd = display_list_get_lcd(list);
+  canvas_begin_frame(c, &dr, LCD_DRAW_OFFLINE);
+  canvas_draw_image(c, img, &src, (rect_t*)dst);
+  canvas_end_frame(c);
+}
+
+TEST(DisplayList, image) {
+  bitmap_t* img = bitmap_create_ex(16, 16, 0, BITMAP_FMT_RGBA8888);
+  uint8_t* fb = display_list_test_alloc(DL_W * DL_H * 4);
+  lcd_t* lcd = lcd_mem_bgra8888_create_single_fb(DL_W, DL_H, fb);
+  display_list_t* prev = display_list_create(lcd);
+  display_list_t* list = display_list_create(lcd);
+  rect_t dst = rect_init(40, 50, 16, 16);
+  dirty_rects_t damage;
+  canvas_t c;
+
+  canvas_init(&c, display_list_get_lcd(prev), font_manager());
+
+  /*内容可能改变的位图，总是需要重绘*/
+  display_list_test_draw_image(&c, prev, img, &dst);
+  display_list_test_draw_image(&c, list, img, &dst);
+  ASSERT_EQ(display_list_size(list), 1u);
+  ASSERT_EQ(display_list_diff(list, prev, &damage), RET_OK);
+  ASSERT_TRUE(display_list_test_rect_eq(&(damage.max), &dst));
+
+  img->flags |= BITMAP_FLAG_IMMUTABLE;
+  display_list_test_draw_image(&c, prev, img, &dst);
+  display_list_test_draw_image(&c, list, img, &dst);
+  ASSERT_EQ(display_list_diff(list, prev, &damage), RET_OK);
+  ASSERT_EQ(damage.nr, 0u);
+
+  /*位置改变*/
+  dst.x += 3;
+  display_list_test_draw_image(&c, prev, img, &dst);
+  ASSERT_EQ(display_list_diff(prev, list, &damage), RET_OK);
+  ASSERT_EQ(damage.max.x, dst.x - 3);
+  ASSERT_EQ(damage.max.w, dst.w + 3);
+
+  canvas_reset(&c);
+  bitmap_destroy(img);
+  display_list_destroy(prev);
+  display_list_destroy(list);
+  lcd_destroy(lcd);
+  TKMEM_FREE(fb);
+}
+
+TEST(DisplayList, unknown) {
+  canvas_t c;
+  dirty_rects_t dr;
+  dirty_rects_t damage;
+  uint8_t* fb = display_list_test_alloc(DL_W * DL_H * 4);
+  lcd_t* lcd = lcd_mem_bgra8888_create_single_fb(DL_W, DL_H, fb);
+  display_list_t* prev = display_list_create(lcd);
+  display_list_t* list = display_list_create(lcd);
+  rect_t all = rect_init(0, 0, DL_W, DL_H);
+  rect_t clip = rect_init(30, 40, 50, 60);
+  uint32_t i = 0;
+
+  dirty_rects_init(&dr);
+  dirty_rects_add(&dr, &all);
+  canvas_init(&c, display_list_get_lcd(prev), font_manager());
+
+  /*读取像素(以及vgcanvas的绘制)无法记录，当时的裁剪区总是需要重绘*/
+  for (i = 0; i < 2; i++) {
+    c.lcd = display_list_get_lcd(i == 0 ? prev : list);
+    canvas_begin_frame(&c, &dr, LCD_DRAW_OFFLINE);
+    canvas_set_fill_color(&c, color_init(0xff, 0, 0, 0xff));
+    canvas_fill_rect(&c, 0, 0, 10, 10);
+    canvas_set_clip_rect(&c, &clip);
+    lcd_get_point_color(c.lcd, 40, 45);
+    canvas_end_frame(&c);
+  }
+
+  /*记录时不绘制*/
+  ASSERT_EQ(fb[(5 * DL_W + 5) * 4 + 3], 0u);
+  ASSERT_TRUE(display_list_has_unknown(list));
+  ASSERT_EQ(display_list_size(list), 2u);
+  ASSERT_EQ(display_list_replay(list, lcd), RET_NOT_IMPL);
+  ASSERT_EQ(display_list_diff(list, prev, &damage), RET_OK);
+  ASSERT_EQ(damage.nr, 1u);
+  ASSERT_TRUE(display_list_test_rect_eq(&(damage.max), &clip));
+
+  canvas_reset(&c);
+  display_list_destroy(prev);
+  display_list_destroy(list);
+  lcd_destroy(lcd);
+  TKMEM_FREE(fb);
+}
@@ -51,3 +51,99 @@ TEST(FontGen, basic) {
   TKMEM_FREE(ttf_buff);
 }
 #endif /**/
+
+#if defined(WITH_FT_FONT) || defined(WITH_STB_FONT)
+#include "lcd/lcd_mem_bgra8888.h"
+
+#define FG_W 64
+#define FG_H 64
+
+static void draw_glyph_to_fb(uint8_t* fb, glyph_t* g, const rect_t* src, uint8_t global_alpha,
+                             color_t color) {
+  lcd_t* lcd = lcd_mem_bgra8888_create_single_fb(FG_W, FG_H, fb);
+
+  memset(fb, 0x80, FG_W * FG_H * 4);
+  lcd_set_text_color(lcd, color);
+  lcd_set_global_alpha(lcd, global_alpha);
+  lcd_draw_glyph(lcd, g, src, 3 + src->x, 2 + src->y);
+  lcd_destroy(lcd);
+}
+
+static uint32_t fb_max_diff(const uint8_t* a, const uint8_t* b) {
+  uint32_t i = 0;
+  uint32_t diff = 0;
+
+  for (i = 0; i < FG_W * FG_H * 4; i++) {
+    diff = tk_max(diff, (uint32_t)tk_abs(a[i] - b[i]));
+  }
+
+  return diff;
+}
+
+TEST(FontGen, compressed) {
+  uint32_t i = 0;
+  uint32_t k = 0;
+  uint32_t size = 0;
+  uint32_t sizes[4];
+  font_t* fonts[4];
+  uint16_t font_size = 40;
+  glyph_format_t formats[] = {GLYPH_FMT_ALPHA, GLYPH_FMT_A4, GLYPH_FMT_A2, GLYPH_FMT_RLE};
+  uint32_t max_diffs[] = {0, 9, 43, 0};
+  uint8_t* ttf_buff = (uint8_t*)read_file(TTF_FILE, &size);
+  font_t* ttf_font = font_truetype_create("default", ttf_buff, size);
+  uint8_t* expected = (uint8_t*)TKMEM_ALLOC(FG_W * FG_H * 4);
+  uint8_t* fb = (uint8_t*)TKMEM_ALLOC(FG_W * FG_H * 4);
+  const char* str = "AWTKgjq@%8";
+  uint8_t alphas[] = {0xff, 0x80};
+  color_t colors[] = {color_init(0x10, 0x20, 0x30, 0xff), color_init(0xf0, 0x80, 0x40, 0x90)};
+  wbuffer_t wbuffers[4];
+  uint8_t* fb_bg = (uint8_t*)TKMEM_ALLOC(FG_W * FG_H * 4);
+
+  memset(fb_bg, 0x80, FG_W * FG_H * 4);
+
+  for (k = 0; k < ARRAY_SIZE(formats); k++) {
+    wbuffer_init_extendable(wbuffers + k);
+    sizes[k] = font_gen_buff_ex(ttf_font, font_size, formats[k], str, wbuffers + k);
+    fonts[k] = font_bitmap_create("default", wbuffers[k].data, sizes[k]);
+  }
+  ASSERT_LT(sizes[1], sizes[0] * 6 / 10);
+  ASSERT_LT(sizes[2], sizes[1]);
+  ASSERT_LT(sizes[3], sizes[0]);
+
+  for (i = 0; str[i]; i++) {
+    glyph_t g0;
+    ASSERT_EQ(font_get_glyph(fonts[0], str[i], font_size, &g0), RET_OK);
+    ASSERT_EQ(g0.format, GLYPH_FMT_ALPHA);
+    rect_t rects[] = {rect_init(0, 0, g0.w, g0.h), rect_init(3, 5, g0.w - 7, g0.h - 9)};
+
+    for (uint32_t r = 0; r < ARRAY_SIZE(rects); r++) {
+      for (uint32_t a = 0; a < ARRAY_SIZE(alphas); a++) {
+        draw_glyph_to_fb(expected, &g0, rects + r, alphas[a], colors[a]);
+        ASSERT_GT(fb_max_diff(expected, fb_bg), 0x20u);
+
+        for (k = 1; k < ARRAY_SIZE(formats); k++) {
+          glyph_t g;
+          ASSERT_EQ(font_get_glyph(fonts[k], str[i], font_size, &g), RET_OK);
+          ASSERT_EQ(g.format, formats[k]);
+          ASSERT_EQ(g.w, g0.w);
+          ASSERT_EQ(g.h, g0.h);
+          ASSERT_EQ(g.advance, g0.advance);
+
+          draw_glyph_to_fb(fb, &g, rects + r, alphas[a], colors[a]);
+          ASSERT_LE(fb_max_diff(expected, fb), max_diffs[k]);
+        }
+      }
+    }
+  }
+
+  for (k = 0; k < ARRAY_SIZE(formats); k++) {
+    font_destroy(fonts[k]);
+    wbuffer_deinit(wbuffers + k);
+  }
+  font_destroy(ttf_font);
+  TKMEM_FREE(ttf_buff);
+  TKMEM_FREE(expected);
+  TKMEM_FREE(fb);
+  TKMEM_FREE(fb_bg);
+}
+#endif /*WITH_FT_FONT or WITH_STB_FONT*/
@@ -69,3 +69,124 @@ TEST(FontManager, unload) {
   font_manager_deinit(&font_manager);
 }
 #endif
+
+typedef struct _font_count_t {
+  font_t base;
+  uint32_t get_glyph_times;
+  uint16_t advance;
+} font_count_t;
+
+static ret_t font_count_get_glyph(font_t* f, wchar_t chr, font_size_t font_size, glyph_t* g) {
+  font_count_t* font = (font_count_t*)f;
+
+  font->get_glyph_times++;
+  memset(g, 0x00, sizeof(glyph_t));
+  g->advance = font->advance + chr % 3 + font_size / 10;
+
+  return RET_OK;
+}
+
+static ret_t font_count_destroy(font_t* f) {
+  return RET_OK;
+}
+
+static bool_t font_count_match(font_t* f, const char* name, font_size_t font_size) {
+  return tk_str_eq(f->name, name);
+}
+
+static font_t* font_count_init(font_count_t* font, const char* name, uint16_t advance) {
+  memset(font, 0x00, sizeof(font_count_t));
+  font->advance = advance;
+  font->base.match = font_count_match;
+  font->base.get_glyph = font_count_get_glyph;
+  font->base.destroy = font_count_destroy;
+  tk_strncpy(font->base.name, name, TK_NAME_LEN);
+
+  return &(font->base);
+}
+
+static float_t measure_text_slow(font_t* font, font_size_t font_size, const wchar_t* str) {
+  glyph_t g;
+  float_t w = 0;
+  uint32_t i = 0;
+
+  for (i = 0; str[i]; i++) {
+    if (font_get_glyph(font, str[i], font_size, &g) == RET_OK) {
+      w += g.advance + 1;
+    } else {
+      w += 4;
+    }
+  }
+
+  return w;
+}
+
+TEST(FontManager, measure_text) {
+  font_count_t font;
+  font_manager_t font_manager;
+  const wchar_t* ascii = L"hello world";
+  const wchar_t* cjk = L"\x4e2d\x6587\x5b57\x7b26";
+  font_t* f = font_count_init(&font, "count", 5);
+  float_t ascii_w = measure_text_slow(f, 20, ascii);
+  float_t cjk_w = measure_text_slow(f, 20, cjk);
+  float_t low_w = measure_text_slow(f, 20, L"low");
+
+  font_manager_init(&font_manager, NULL);
+  font_manager_add_font(&font_manager, f);
+
+  /*ASCII字符的占位宽度只获取一次*/
+  font.get_glyph_times = 0;
+  ASSERT_EQ(font_manager_measure_text(&font_manager, f, 20, ascii, wcslen(ascii)), ascii_w);
+  ASSERT_EQ(font.get_glyph_times, 8u);
+  ASSERT_EQ(font_manager_measure_text(&font_manager, f, 20, L"low", 3), low_w);
+  ASSERT_EQ(font.get_glyph_times, 8u);
+
+  /*不同字号是不同的表*/
+  ASSERT_EQ(font_manager_measure_text(&font_manager, f, 30, ascii, wcslen(ascii)),
+            measure_text_slow(f, 30, ascii));
+
+  /*非ASCII字符串的宽度被缓存*/
+  font.get_glyph_times = 0;
+  ASSERT_EQ(font_manager_measure_text(&font_manager, f, 20, cjk, wcslen(cjk)), cjk_w);
+  ASSERT_EQ(font.get_glyph_times, 4u);
+  ASSERT_EQ(font_manager_measure_text(&font_manager, f, 20, cjk, wcslen(cjk)), cjk_w);
+  ASSERT_EQ(font_manager_measure_text(&font_manager, f, 20, cjk, 3),
+            measure_text_slow(f, 20, L"\x4e2d\x6587\x5b57"));
+  font.get_glyph_times = 0;
+  ASSERT_EQ(font_manager_measure_text(&font_manager, f, 20, cjk, wcslen(cjk)), cjk_w);
+  ASSERT_EQ(font.get_glyph_times, 0u);
+
+  /*卸载字体时清除缓存*/
+  ASSERT_EQ(font_manager_unload_all(&font_manager), RET_OK);
+  font.advance = 7;
+  font_manager_add_font(&font_manager, f);
+  ASSERT_EQ(font_manager_measure_text(&font_manager, f, 20, cjk, wcslen(cjk)), cjk_w + 4 * 2);
+  ASSERT_EQ(font_manager_measure_text(&font_manager, f, 20, ascii, wcslen(ascii)),
+            ascii_w + 11 * 2);
+
+  font_manager_deinit(&font_manager);
+}
+
+TEST(FontManager, measure_text_many) {
+  uint32_t i = 0;
+  font_count_t font;
+  wchar_t str[16];
+  font_manager_t font_manager;
+  font_t* f = font_count_init(&font, "count", 5);
+
+  font_manager_init(&font_manager, NULL);
+  font_manager_add_font(&font_manager, f);
+
+  /*缓存满了之后淘汰，结果仍然正确*/
+  for (i = 0; i < 10 * TK_TEXT_MEASURE_CACHE_NR; i++) {
+    str[0] = 0x4e00 + i;
+    str[1] = 0x4e00 + i * 7;
+    str[2] = 0;
+    ASSERT_EQ(font_manager_measure_text(&font_manager, f, 16, str, 2),
+              measure_text_slow(f, 16, str));
+    ASSERT_EQ(font_manager_measure_text(&font_manager, f, 16, str, 2),
+              measure_text_slow(f, 16, str));
+  }
+
+  font_manager_deinit(&font_manager);
+}
@@ -0,0 +1,245 @@
+﻿#include "tkc/mem.h"
+#include "base/canvas.h"
+#include "base/glyph_atlas.h"
+#include "base/font_manager.h"
+#include "lcd/lcd_mem_bgra8888.h"
+#include "gtest/gtest.h"
+
+#define TEST_FONT_MAX_SIZE 64
+
+typedef struct _font_test_t {
+  font_t base;
+  uint32_t get_glyph_times;
+  uint8_t data[TEST_FONT_MAX_SIZE * TEST_FONT_MAX_SIZE];
+} font_test_t;
+
+static ret_t font_test_get_glyph(font_t* f, wchar_t chr, font_size_t font_size, glyph_t* g) {
+  font_test_t* font = (font_test_t*)f;
+
+  font->get_glyph_times++;
+  memset(g, 0x00, sizeof(glyph_t));
+  g->x = 1;
+  g->y = -(int16_t)font_size;
+  g->format = chr == 'M' ? GLYPH_FMT_MONO : GLYPH_FMT_ALPHA;
+  g->advance = 4 + chr % 7;
+
+  if (chr != ' ') {
+    g->w = tk_min(4 + chr % 7, TEST_FONT_MAX_SIZE);
+    g->h = tk_min(font_size, TEST_FONT_MAX_SIZE);
+    g->data = font->data + chr % 17;
+  }
+
+  return RET_OK;
+}
+
+static font_t* font_test_init(font_test_t* font) {
+  uint32_t i = 0;
+
+  memset(font, 0x00, sizeof(font_test_t));
+  for (i = 0; i < sizeof(font->data); i++) {
+    font->data[i] = (uint8_t)(i * 7 + (i >> 5));
+  }
+  font->base.get_glyph = font_test_get_glyph;
+
+  return &(font->base);
+}
+
+static void check_glyph_data(const glyph_atlas_glyph_t* g, font_test_t* font, wchar_t chr) {
+  uint32_t j = 0;
+  const uint8_t* expected = font->data + chr % 17;
+  const glyph_atlas_page_t* page = g->page;
+
+  ASSERT_TRUE(page != NULL);
+  for (j = 0; j < g->h; j++) {
+    ASSERT_EQ(memcmp(page->data + (g->page_y + j) * page->w + g->page_x, expected + j * g->w, g->w),
+              0);
+  }
+}
+
+TEST(GlyphAtlas, basic) {
+  font_test_t font;
+  glyph_atlas_glyph_t g;
+  glyph_atlas_glyph_t g1;
+  font_t* f = font_test_init(&font);
+  glyph_atlas_t* atlas = glyph_atlas_create(64, 2);
+
+  ASSERT_EQ(glyph_atlas_get(atlas, f, 'A', 16, &g), RET_OK);
+  ASSERT_EQ(font.get_glyph_times, 1u);
+  ASSERT_EQ(g.w, 4 + 'A' % 7);
+  ASSERT_EQ(g.h, 16);
+  ASSERT_EQ(g.x, 1);
+  ASSERT_EQ(g.y, -16);
+  check_glyph_data(&g, &font, 'A');
+
+  ASSERT_EQ(glyph_atlas_get(atlas, f, 'A', 16, &g1), RET_OK);
+  ASSERT_EQ(font.get_glyph_times, 1u);
+  ASSERT_EQ(memcmp(&g, &g1, sizeof(g)), 0);
+
+  ASSERT_EQ(glyph_atlas_get(atlas, f, 'B', 16, &g1), RET_OK);
+  ASSERT_EQ(g1.page, g.page);
+  ASSERT_EQ(glyph_atlas_get_pages_nr(atlas), 1u);
+  check_glyph_data(&g1, &font, 'B');
+  check_glyph_data(&g, &font, 'A');
+
+  /*空格没有字模数据*/
+  ASSERT_EQ(glyph_atlas_get(atlas, f, ' ', 16, &g), RET_OK);
+  ASSERT_TRUE(g.page == NULL);
+  ASSERT_EQ(g.advance, 4 + ' ' % 7);
+
+  /*非A8格式和太大的字模不能放入图集，记下来之后不再从字体中获取*/
+  ASSERT_EQ(glyph_atlas_get(atlas, f, 'M', 16, &g), RET_NOT_IMPL);
+  ASSERT_EQ(glyph_atlas_get(atlas, f, 'A', 48, &g), RET_NOT_IMPL);
+  ASSERT_EQ(font.get_glyph_times, 5u);
+  ASSERT_EQ(glyph_atlas_get(atlas, f, 'M', 16, &g), RET_NOT_IMPL);
+  ASSERT_EQ(glyph_atlas_get(atlas, f, 'A', 48, &g), RET_NOT_IMPL);
+  ASSERT_EQ(font.get_glyph_times, 5u);
+  ASSERT_EQ(glyph_atlas_get_pages_nr(atlas), 1u);
+
+  glyph_atlas_destroy(atlas);
+}
+
+TEST(GlyphAtlas, many) {
+  uint32_t i = 0;
+  font_test_t font;
+  glyph_atlas_glyph_t g;
+  font_t* f = font_test_init(&font);
+  glyph_atlas_t* atlas = glyph_atlas_create(256, 4);
+
+  for (i = 0; i < 500; i++) {
+    ASSERT_EQ(glyph_atlas_get(atlas, f, 0x4e00 + i, 12, &g), RET_OK);
+  }
+
+  for (i = 0; i < 500; i++) {
+    ASSERT_EQ(glyph_atlas_get(atlas, f, 0x4e00 + i, 12, &g), RET_OK);
+    check_glyph_data(&g, &font, 0x4e00 + i);
+  }
+  ASSERT_EQ(font.get_glyph_times, 500u);
+
+  glyph_atlas_destroy(atlas);
+}
+
+TEST(GlyphAtlas, evict) {
+  font_test_t font;
+  glyph_atlas_glyph_t g;
+  glyph_atlas_glyph_t g1;
+  glyph_atlas_glyph_t g2;
+  font_t* f = font_test_init(&font);
+  glyph_atlas_t* atlas = glyph_atlas_create(32, 2);
+
+  /*同一个字模串中用到的页面不能淘汰，允许超过上限*/
+  glyph_atlas_begin(atlas);
+  ASSERT_EQ(glyph_atlas_get(atlas, f, 'A', 10, &g), RET_OK);
+  ASSERT_EQ(glyph_atlas_get(atlas, f, 'A', 11, &g1), RET_OK);
+  ASSERT_EQ(glyph_atlas_get(atlas, f, 'A', 12, &g2), RET_OK);
+  ASSERT_EQ(glyph_atlas_get_pages_nr(atlas), 3u);
+  ASSERT_TRUE(g.page != g1.page && g1.page != g2.page);
+  check_glyph_data(&g, &font, 'A');
+  check_glyph_data(&g1, &font, 'A');
+  check_glyph_data(&g2, &font, 'A');
+
+  /*新的字模串，淘汰最久没有用到的页面，并释放多出来的页面*/
+  glyph_atlas_begin(atlas);
+  ASSERT_EQ(glyph_atlas_get(atlas, f, 'A', 12, &g2), RET_OK);
+  ASSERT_EQ(glyph_atlas_get(atlas, f, 'A', 13, &g), RET_OK);
+  ASSERT_EQ(glyph_atlas_get_pages_nr(atlas), 2u);
+  ASSERT_EQ(font.get_glyph_times, 4u);
+  check_glyph_data(&g, &font, 'A');
+  check_glyph_data(&g2, &font, 'A');
+
+  /*被淘汰的字模需要重新获取*/
+  glyph_atlas_begin(atlas);
+  ASSERT_EQ(glyph_atlas_get(atlas, f, 'A', 10, &g), RET_OK);
+  ASSERT_EQ(font.get_glyph_times, 5u);
+  check_glyph_data(&g, &font, 'A');
+  ASSERT_EQ(glyph_atlas_get_pages_nr(atlas), 2u);
+
+  glyph_atlas_destroy(atlas);
+}
+
+TEST(GlyphAtlas, remove_font) {
+  font_test_t font;
+  font_test_t font1;
+  glyph_atlas_glyph_t g;
+  font_t* f = font_test_init(&font);
+  font_t* f1 = font_test_init(&font1);
+  glyph_atlas_t* atlas = glyph_atlas_create(64, 4);
+
+  ASSERT_EQ(glyph_atlas_get(atlas, f, 'A', 16, &g), RET_OK);
+  ASSERT_EQ(glyph_atlas_get(atlas, f1, 'A', 16, &g), RET_OK);
+  ASSERT_EQ(glyph_atlas_get_pages_nr(atlas), 2u);
+
+  ASSERT_EQ(glyph_atlas_remove_font(atlas, f), RET_OK);
+  ASSERT_EQ(glyph_atlas_get_pages_nr(atlas), 1u);
+  ASSERT_EQ(glyph_atlas_get_page(atlas, 0), g.page);
+
+  ASSERT_EQ(glyph_atlas_get(atlas, f1, 'A', 16, &g), RET_OK);
+  ASSERT_EQ(font1.get_glyph_times, 1u);
+  ASSERT_EQ(glyph_atlas_get(atlas, f, 'A', 16, &g), RET_OK);
+  ASSERT_EQ(font.get_glyph_times, 2u);
+
+  ASSERT_EQ(glyph_atlas_clear(atlas), RET_OK);
+  ASSERT_EQ(glyph_atlas_get_pages_nr(atlas), 0u);
+
+  glyph_atlas_destroy(atlas);
+}
+
+#define GA_W 200
+#define GA_H 120
+
+static void draw_text_to_fb(uint8_t* fb, glyph_atlas_t* atlas, uint8_t global_alpha,
+                            color_t color) {
+  canvas_t c;
+  rect_t r = rect_init(13, 9, 150, 53);
+  lcd_t* lcd = lcd_mem_bgra8888_create_single_fb(GA_W, GA_H, fb);
+  glyph_atlas_t* old = glyph_atlas();
+  const wchar_t* str = L"Glyph atlas: 0123456789 abcdefghijklmnopqrstuvwxyz\r\nsecond line";
+
+  glyph_atlas_set(atlas);
+  memset(fb, 0x80, GA_W * GA_H * 4);
+  canvas_init(&c, lcd, font_manager());
+  canvas_set_font(&c, NULL, 18);
+  canvas_set_text_color(&c, color);
+  canvas_set_global_alpha(&c, global_alpha);
+
+  canvas_begin_frame(&c, NULL, LCD_DRAW_OFFLINE);
+  canvas_draw_text(&c, str, wcslen(str), 2, 2);
+  canvas_draw_text(&c, str, wcslen(str), -7, 50);
+  canvas_set_clip_rect(&c, &r);
+  canvas_draw_text(&c, str, wcslen(str), 5, 5);
+  canvas_draw_text(&c, str, wcslen(str), 9, 48);
+  canvas_end_frame(&c);
+
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+  glyph_atlas_set(old);
+}
+
+TEST(GlyphAtlas, canvas_same_as_direct) {
+  uint32_t i = 0;
+  uint32_t size = GA_W * GA_H * 4;
+  uint8_t* fb = (uint8_t*)TKMEM_ALLOC(size);
+  uint8_t* expected = (uint8_t*)TKMEM_ALLOC(size);
+  glyph_atlas_t* atlas = glyph_atlas_create(128, 2);
+  uint8_t alphas[] = {0xff, 0x80};
+  color_t colors[] = {color_init(0x10, 0x20, 0x30, 0xff), color_init(0xf0, 0x80, 0x40, 0x90)};
+
+  for (i = 0; i < ARRAY_SIZE(alphas); i++) {
+    uint32_t k = 0;
+    uint32_t changed = 0;
+
+    draw_text_to_fb(expected, NULL, alphas[i], colors[i]);
+    draw_text_to_fb(fb, atlas, alphas[i], colors[i]);
+    ASSERT_EQ(memcmp(expected, fb, size), 0);
+
+    /*确认绘制了文字(左下角没有文字，是背景色)*/
+    for (k = 0; k < size / 4; k++) {
+      changed += ((uint32_t*)fb)[k] != ((uint32_t*)fb)[size / 4 - 1];
+    }
+    ASSERT_GT(changed, 1000u);
+  }
+  ASSERT_GT(glyph_atlas_get_pages_nr(atlas), 0u);
+
+  glyph_atlas_destroy(atlas);
+  TKMEM_FREE(fb);
+  TKMEM_FREE(expected);
+}
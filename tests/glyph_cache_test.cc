@@ -55,3 +55,97 @@ TEST(GlyphCache, shrink) {
 
   glyph_cache_deinit(c);
 }
+
+TEST(GlyphCache, lru) {
+  uint16_t i = 0;
+  uint16_t size = 10;
+  uint16_t nr = 8;
+  glyph_cache_t cache;
+  glyph_t g;
+  glyph_cache_t* c = glyph_cache_init(&cache, nr, (tk_destroy_t)glyph_destroy);
+
+  memset(&g, 0x00, sizeof(g));
+  for (i = 0; i < nr; i++) {
+    ASSERT_EQ(glyph_cache_add(c, i, size, glyph_clone(&g)), RET_OK);
+  }
+
+  /*最近使用过的字模不会被淘汰*/
+  ASSERT_EQ(glyph_cache_lookup(c, 0, size, &g), RET_OK);
+  ASSERT_EQ(glyph_cache_lookup(c, 1, size, &g), RET_OK);
+  ASSERT_EQ(glyph_cache_add(c, 100, size, glyph_clone(&g)), RET_OK);
+  ASSERT_EQ(glyph_cache_add(c, 101, size, glyph_clone(&g)), RET_OK);
+  ASSERT_EQ(c->size, (uint32_t)nr);
+  ASSERT_EQ(c->evictions, 2u);
+
+  ASSERT_EQ(glyph_cache_lookup(c, 0, size, &g), RET_OK);
+  ASSERT_EQ(glyph_cache_lookup(c, 1, size, &g), RET_OK);
+  ASSERT_EQ(glyph_cache_lookup(c, 2, size, &g), RET_NOT_FOUND);
+  ASSERT_EQ(glyph_cache_lookup(c, 3, size, &g), RET_NOT_FOUND);
+  ASSERT_EQ(glyph_cache_lookup(c, 4, size, &g), RET_OK);
+  ASSERT_EQ(glyph_cache_lookup(c, 100, size, &g), RET_OK);
+  ASSERT_EQ(glyph_cache_lookup(c, 101, size, &g), RET_OK);
+
+  /*同一个字符不同字号是不同的字模*/
+  ASSERT_EQ(glyph_cache_lookup(c, 0, size + 1, &g), RET_NOT_FOUND);
+
+  ASSERT_EQ(c->hits, 7u);
+  ASSERT_EQ(c->misses, 3u);
+  ASSERT_EQ(glyph_cache_reset_stats(c), RET_OK);
+  ASSERT_EQ(c->hits, 0u);
+  ASSERT_EQ(c->misses, 0u);
+  ASSERT_EQ(c->evictions, 0u);
+
+  /*shrink之后最近使用的字模在最前面*/
+  ASSERT_EQ(glyph_cache_shrink(c, 3), RET_OK);
+  ASSERT_EQ(c->size, 3u);
+  ASSERT_EQ(c->items[0].code, 101);
+  ASSERT_EQ(c->items[1].code, 100);
+  ASSERT_EQ(c->items[2].code, 4);
+  ASSERT_EQ(glyph_cache_lookup(c, 100, size, &g), RET_OK);
+  ASSERT_EQ(glyph_cache_lookup(c, 1, size, &g), RET_NOT_FOUND);
+
+  glyph_cache_deinit(c);
+}
+
+TEST(GlyphCache, max_bytes) {
+  uint16_t i = 0;
+  uint16_t size = 10;
+  glyph_cache_t cache;
+  glyph_t g;
+  uint8_t data[32 * 32];
+  glyph_cache_t* c = glyph_cache_init(&cache, 4, (tk_destroy_t)glyph_destroy);
+
+  memset(&g, 0x00, sizeof(g));
+  g.w = 32;
+  g.h = 32;
+  g.data = data;
+  g.format = GLYPH_FMT_ALPHA;
+
+  /*按内存淘汰时，字模个数可以超过初始容量*/
+  ASSERT_EQ(glyph_cache_set_max_bytes(c, 10 * 1100), RET_OK);
+  for (i = 0; i < 100; i++) {
+    ASSERT_EQ(glyph_cache_add(c, i, size, glyph_clone(&g)), RET_OK);
+    ASSERT_LE(c->bytes, c->max_bytes);
+  }
+  ASSERT_GT(c->size, 4u);
+  ASSERT_LT(c->size, 11u);
+  ASSERT_EQ(c->evictions, 100u - c->size);
+  ASSERT_EQ(glyph_cache_lookup(c, 99, size, &g), RET_OK);
+  ASSERT_EQ(glyph_cache_lookup(c, 0, size, &g), RET_NOT_FOUND);
+
+  /*小字模占用的内存少，可以缓存更多*/
+  g.w = 8;
+  g.h = 8;
+  for (i = 0; i < 100; i++) {
+    ASSERT_EQ(glyph_cache_add(c, 1000 + i, size, glyph_clone(&g)), RET_OK);
+    ASSERT_LE(c->bytes, c->max_bytes);
+  }
+  ASSERT_GT(c->size, 20u);
+
+  /*降低上限时立即淘汰*/
+  ASSERT_EQ(glyph_cache_set_max_bytes(c, 1024), RET_OK);
+  ASSERT_LE(c->bytes, 1024u);
+  ASSERT_EQ(glyph_cache_lookup(c, 1099, size, &g), RET_OK);
+
+  glyph_cache_deinit(c);
+}
@@ -122,7 +122,7 @@ lcd_t* lcd_log_init(wh_t w, wh_t h) {
   lcd_log_t* lcd = new lcd_log_t();
   lcd_t* base = &(lcd->base);
 
-  memset(lcd, 0x00, sizeof(lcd_log_t));
+  memset(base, 0x00, sizeof(lcd_t));
 
   base->begin_frame = lcd_log_begin_frame;
   base->draw_vline = lcd_log_draw_vline;
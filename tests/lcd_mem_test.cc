@@ -116,3 +116,147 @@ TEST(LCDMem, resize) {
 
   lcd_destroy(lcd);
 }
+
+static uint8_t test_glyph_ref(uint8_t bg, uint8_t fg, uint8_t cover, uint8_t global_alpha,
+                              uint8_t color_alpha) {
+  uint8_t a = global_alpha > TK_OPACITY_ALPHA ? cover : ((cover * global_alpha) >> 8);
+  a = (a * color_alpha) >> 8;
+
+  if (a >= TK_OPACITY_ALPHA) {
+    return fg;
+  } else if (a >= TK_TRANSPARENT_ALPHA) {
+    return (bg * (0xff - a) + fg * a) >> 8;
+  } else {
+    return bg;
+  }
+}
+
+static void test_draw_glyph(lcd_t* lcd, uint8_t global_alpha, uint8_t color_alpha) {
+  uint32_t i = 0;
+  uint8_t data[160];
+  glyph_t glyph;
+  rect_t r = rect_init(0, 0, ARRAY_SIZE(data), 1);
+  color_t bg = color_init(0xf0, 0x80, 0x10, 0xff);
+  color_t fg = color_init(0x10, 0x20, 0xe0, color_alpha);
+
+  for (i = 0; i < ARRAY_SIZE(data); i++) {
+    uint32_t k = i % 41;
+    data[i] = k < 10 ? 0 : (k < 25 ? 0xff : (k * 37) & 0xff);
+  }
+
+  memset(&glyph, 0x00, sizeof(glyph));
+  glyph.w = ARRAY_SIZE(data);
+  glyph.h = 1;
+  glyph.data = data;
+
+  lcd_set_fill_color(lcd, bg);
+  lcd_fill_rect(lcd, 0, 0, lcd->w, lcd->h);
+  lcd_set_text_color(lcd, fg);
+  lcd_set_global_alpha(lcd, global_alpha);
+  ASSERT_EQ(lcd_draw_glyph(lcd, &glyph, &r, 0, 1), RET_OK);
+  lcd_set_global_alpha(lcd, 0xff);
+
+  for (i = 0; i < ARRAY_SIZE(data); i++) {
+    color_t c = lcd_get_point_color(lcd, i, 1);
+    ASSERT_EQ(c.rgba.r, test_glyph_ref(bg.rgba.r, fg.rgba.r, data[i], global_alpha, color_alpha));
+    ASSERT_EQ(c.rgba.g, test_glyph_ref(bg.rgba.g, fg.rgba.g, data[i], global_alpha, color_alpha));
+    ASSERT_EQ(c.rgba.b, test_glyph_ref(bg.rgba.b, fg.rgba.b, data[i], global_alpha, color_alpha));
+  }
+}
+
+TEST(LCDMem, draw_glyph) {
+  lcd_t* lcd = lcd_mem_rgba8888_create(200, 4, TRUE);
+
+  test_draw_glyph(lcd, 0xff, 0xff);
+  test_draw_glyph(lcd, 0x80, 0xff);
+  test_draw_glyph(lcd, 0xff, 0x80);
+  test_draw_glyph(lcd, 0x30, 0x60);
+  test_draw_glyph(lcd, 0x04, 0xff);
+  lcd_destroy(lcd);
+
+  lcd = lcd_mem_bgr888_create(200, 4, TRUE);
+  test_draw_glyph(lcd, 0xff, 0xff);
+  test_draw_glyph(lcd, 0x80, 0x80);
+  lcd_destroy(lcd);
+}
+
+#define ASYNC_W 64
+#define ASYNC_H 64
+#define ASYNC_BOXES 6
+
+static void test_async_flush_paint(canvas_t* c, uint32_t* colors) {
+  uint32_t i = 0;
+  color_t bg = color_init(0xff, 0xff, 0xff, 0xff);
+
+  canvas_set_fill_color(c, bg);
+  canvas_fill_rect(c, 0, 0, ASYNC_W, ASYNC_H);
+  for (i = 0; i < ASYNC_BOXES; i++) {
+    color_t fg;
+    fg.color = colors[i];
+    canvas_set_fill_color(c, fg);
+    canvas_fill_rect(c, i * 10, i * 10, 10, 10);
+  }
+}
+
+TEST(LCDMem, async_flush) {
+  uint32_t i = 0;
+  canvas_t canvas;
+  canvas_t expected_canvas;
+  dirty_rects_t dr;
+  font_manager_t font_manager;
+  uint32_t colors[ASYNC_BOXES];
+  uint32_t size = ASYNC_W * ASYNC_H * 4;
+  uint8_t* online_fb = (uint8_t*)TKMEM_ALLOC(size);
+  uint8_t* offline_fb = (uint8_t*)TKMEM_ALLOC(size);
+  uint8_t* expected_fb = (uint8_t*)TKMEM_ALLOC(size);
+  lcd_t* lcd = lcd_mem_bgra8888_create_double_fb(ASYNC_W, ASYNC_H, online_fb, offline_fb);
+  lcd_t* expected = lcd_mem_bgra8888_create_single_fb(ASYNC_W, ASYNC_H, expected_fb);
+  lcd_mem_t* mem = (lcd_mem_t*)lcd;
+
+  font_manager_init(&font_manager, NULL);
+  canvas_init(&canvas, lcd, &font_manager);
+  canvas_init(&expected_canvas, expected, &font_manager);
+  memset(online_fb, 0x00, size);
+  memset(colors, 0x00, sizeof(colors));
+
+  /*单缓冲的lcd不支持*/
+  ASSERT_NE(lcd_mem_set_async_flush(expected, TRUE), RET_OK);
+  ASSERT_EQ(lcd_mem_set_async_flush(lcd, TRUE), RET_OK);
+  ASSERT_TRUE(mem->async_flush != NULL);
+
+  for (i = 0; i < 3 * ASYNC_BOXES; i++) {
+    uint32_t k = i % ASYNC_BOXES;
+    rect_t r = rect_init(k * 10, k * 10, 10, 10);
+
+    colors[k] = 0xff000000 | (i * 0x10203);
+    dirty_rects_init(&dr);
+    dirty_rects_add(&dr, &r);
+    ASSERT_EQ(canvas_begin_frame(&canvas, &dr, LCD_DRAW_NORMAL), RET_OK);
+    test_async_flush_paint(&canvas, colors);
+    ASSERT_EQ(canvas_end_frame(&canvas), RET_OK);
+    dirty_rects_deinit(&dr);
+
+    /*两个offline fb轮流使用*/
+    ASSERT_EQ(mem->offline_fb == offline_fb, (i % 2) == 1);
+  }
+  ASSERT_EQ(lcd_mem_async_flush_wait(mem), RET_OK);
+
+  ASSERT_EQ(canvas_begin_frame(&expected_canvas, NULL, LCD_DRAW_OFFLINE), RET_OK);
+  test_async_flush_paint(&expected_canvas, colors);
+  ASSERT_EQ(canvas_end_frame(&expected_canvas), RET_OK);
+  ASSERT_EQ(memcmp(online_fb, expected_fb, size), 0);
+
+  /*回到同步flush*/
+  ASSERT_EQ(lcd_mem_set_async_flush(lcd, FALSE), RET_OK);
+  ASSERT_TRUE(mem->async_flush == NULL);
+  ASSERT_TRUE(mem->offline_fb == offline_fb);
+
+  canvas_reset(&canvas);
+  canvas_reset(&expected_canvas);
+  font_manager_deinit(&font_manager);
+  lcd_destroy(lcd);
+  lcd_destroy(expected);
+  TKMEM_FREE(online_fb);
+  TKMEM_FREE(offline_fb);
+  TKMEM_FREE(expected_fb);
+}
@@ -189,6 +189,26 @@ TEST(LcdMono, draw_glyph) {
   lcd_destroy(lcd);
 }
 
+TEST(LcdMono, draw_glyph_compressed) {
+  glyph_t g;
+  uint8_t data[4];
+  rect_t r = rect_init(0, 0, 10, 10);
+  lcd_t* lcd = lcd_mono_create(128, 64, lcd_log_flush, NULL, NULL);
+
+  /*不支持压缩格式，不能越界读取数据*/
+  memset(&g, 0x00, sizeof(g));
+  memset(data, 0x00, sizeof(data));
+  g.w = 10;
+  g.h = 10;
+  g.data = data;
+  g.format = GLYPH_FMT_RLE;
+  ASSERT_EQ(lcd_draw_glyph(lcd, &g, &r, 0, 0), RET_NOT_IMPL);
+  g.format = GLYPH_FMT_A2;
+  ASSERT_EQ(lcd_draw_glyph(lcd, &g, &r, 0, 0), RET_NOT_IMPL);
+
+  lcd_destroy(lcd);
+}
+
 static void bitmap_gen(bitmap_t* b, uint32_t w, uint32_t h) {
   uint8_t* data = NULL;
   memset(b, 0x00, sizeof(bitmap_t));
@@ -1,7 +1,17 @@
 ﻿#include "scroll_view/list_view.h"
+#include "scroll_view/scroll_bar.h"
+#include "scroll_view/scroll_view.h"
+#include "tkc/utils.h"
+#include "tkc/object_array.h"
+#include "tkc/object_default.h"
+#include "base/idle.h"
+#include "base/window.h"
 #include "base/canvas.h"
+#include "base/dirty_rects.h"
 #include "base/widget.h"
 #include "base/layout.h"
+#include "widgets/view.h"
+#include "widgets/label.h"
 #include "widgets/button.h"
 #include "font_dummy.h"
 #include "lcd_log.h"
@@ -37,3 +47,172 @@ TEST(ListView, cast) {
 
   widget_destroy(w);
 }
+
+static widget_t* create_virtual_list_view(widget_t* win) {
+  widget_t* list_view = list_view_create(win, 0, 0, 200, 300);
+  widget_t* scroll_view = scroll_view_create(list_view, 0, 0, 200, 300);
+  widget_t* item = view_create(scroll_view, 0, 0, 0, 30);
+  widget_t* title = label_create(item, 0, 0, 100, 30);
+
+  widget_set_name(title, "title");
+  view_create(scroll_view, 0, 0, 0, 30);
+
+  return list_view;
+}
+
+static ret_t on_bind_item(void* ctx, widget_t* item, uint32_t index) {
+  char text[32];
+  uint32_t* bind_times = (uint32_t*)ctx;
+
+  (*bind_times)++;
+  tk_snprintf(text, sizeof(text), "row %u", index);
+
+  return widget_set_text_utf8(widget_lookup(item, "title", TRUE), text);
+}
+
+static const char* get_title(widget_t* item, char* text, uint32_t size) {
+  widget_get_text_utf8(widget_lookup(item, "title", TRUE), text, size);
+
+  return text;
+}
+
+static void check_virtual_items(widget_t* list_view, int32_t item_h) {
+  char text[32];
+  char title[32];
+  widget_t* scroll_view = LIST_VIEW(list_view)->scroll_view;
+  int32_t yoffset = SCROLL_VIEW(scroll_view)->yoffset;
+
+  WIDGET_FOR_EACH_CHILD_BEGIN(scroll_view, iter, i)
+  tk_snprintf(text, sizeof(text), "row %d", iter->y / item_h);
+  ASSERT_STREQ(get_title(iter, title, sizeof(title)), text);
+  WIDGET_FOR_EACH_CHILD_END();
+
+  /*可见的每一行都有对应的列表项(widget_find_target的参数是屏幕坐标)*/
+  int32_t h = tk_min(scroll_view->h, SCROLL_VIEW(scroll_view)->virtual_h - yoffset);
+  for (int32_t y = 0; y < h; y++) {
+    widget_t* target = widget_find_target(scroll_view, 10, y);
+    ASSERT_TRUE(target != NULL);
+    ASSERT_EQ(target->y / item_h, (y + yoffset) / item_h);
+  }
+}
+
+TEST(ListView, virtual) {
+  char text[32];
+  uint32_t bind_times = 0;
+  widget_t* win = window_create(NULL, 0, 0, 400, 300);
+  widget_t* list_view = create_virtual_list_view(win);
+  widget_t* scroll_view = LIST_VIEW(list_view)->scroll_view;
+
+  ASSERT_EQ(list_view_set_virtual(list_view, 50000, on_bind_item, &bind_times), RET_OK);
+  widget_layout(list_view);
+
+  /*只创建可见行和预留行所需的列表项，与行数无关*/
+  ASSERT_EQ(widget_count_children(scroll_view), 300 / 30 + 2 + 4);
+  ASSERT_EQ(bind_times, 16u);
+  ASSERT_EQ(SCROLL_VIEW(scroll_view)->virtual_h, 50000 * 30);
+  check_virtual_items(list_view, 30);
+
+  widget_set_prop_int(scroll_view, WIDGET_PROP_YOFFSET, 30 * 1000);
+  check_virtual_items(list_view, 30);
+
+  /*滚动一行只重新绑定一个列表项*/
+  bind_times = 0;
+  widget_set_prop_int(scroll_view, WIDGET_PROP_YOFFSET, 30 * 1001);
+  ASSERT_EQ(bind_times, 1u);
+  check_virtual_items(list_view, 30);
+
+  /*滚动到最后*/
+  widget_set_prop_int(scroll_view, WIDGET_PROP_YOFFSET, 30 * 50000 - 300);
+  check_virtual_items(list_view, 30);
+  ASSERT_STREQ(get_title(widget_find_target(scroll_view, 10, 299), text, sizeof(text)),
+               "row 49999");
+
+  /*行数变少*/
+  ASSERT_EQ(list_view_set_virtual_rows(list_view, 5), RET_OK);
+  widget_layout(list_view);
+  ASSERT_EQ(widget_count_children(scroll_view), 5);
+  ASSERT_EQ(SCROLL_VIEW(scroll_view)->yoffset, 0);
+  check_virtual_items(list_view, 30);
+
+  widget_destroy(win);
+  idle_dispatch();
+}
+
+TEST(ListView, virtual_scroll_bar) {
+  canvas_t c;
+  dirty_rects_t dr;
+  uint32_t bind_times = 0;
+  rect_t r = rect_init(0, 0, 400, 300);
+  font_manager_t font_manager;
+  lcd_t* lcd = lcd_log_init(400, 300);
+  widget_t* win = window_create(NULL, 0, 0, 400, 300);
+  widget_t* list_view = create_virtual_list_view(win);
+  widget_t* scroll_view = LIST_VIEW(list_view)->scroll_view;
+  widget_t* scroll_bar = scroll_bar_create_desktop(list_view, 200, 0, 10, 300);
+
+  font_manager_init(&font_manager, NULL);
+  canvas_init(&c, lcd, &font_manager);
+
+  ASSERT_EQ(list_view_set_virtual(list_view, 1000, on_bind_item, &bind_times), RET_OK);
+  widget_layout(list_view);
+
+  /*拖动滚动条时绑定，绘制时不再绑定*/
+  scroll_bar_set_value(scroll_bar, SCROLL_BAR(scroll_bar)->virtual_size / 2);
+  ASSERT_GT(SCROLL_VIEW(scroll_view)->yoffset, 0);
+  check_virtual_items(list_view, 30);
+
+  bind_times = 0;
+  dirty_rects_init(&dr);
+  dirty_rects_add(&dr, &r);
+  canvas_begin_frame(&c, &dr, LCD_DRAW_NORMAL);
+  widget_paint(list_view, &c);
+  canvas_end_frame(&c);
+  ASSERT_EQ(bind_times, 0u);
+
+  widget_destroy(win);
+  idle_dispatch();
+  canvas_reset(&c);
+  font_manager_deinit(&font_manager);
+  lcd_destroy(lcd);
+}
+
+TEST(ListView, virtual_data_source) {
+  value_t v;
+  char text[32];
+  uint32_t i = 0;
+  object_t* rows = object_array_create();
+  widget_t* win = window_create(NULL, 0, 0, 400, 300);
+  widget_t* list_view = create_virtual_list_view(win);
+  widget_t* scroll_view = LIST_VIEW(list_view)->scroll_view;
+
+  for (i = 0; i < 100; i++) {
+    object_t* row = object_default_create();
+
+    tk_snprintf(text, sizeof(text), "row %u", i);
+    object_set_prop_str(row, "title", text);
+    object_array_push(rows, value_set_object(&v, row));
+    OBJECT_UNREF(row);
+  }
+
+  ASSERT_EQ(list_view_set_virtual_data_source(list_view, rows), RET_OK);
+  widget_layout(list_view);
+  ASSERT_EQ(SCROLL_VIEW(scroll_view)->virtual_h, 100 * 30);
+  check_virtual_items(list_view, 30);
+
+  /*数据源改变后自动更新行数*/
+  object_t* row = object_default_create();
+  object_set_prop_str(row, "title", "row 100");
+  object_array_push(rows, value_set_object(&v, row));
+  OBJECT_UNREF(row);
+  widget_layout(list_view);
+  ASSERT_EQ(SCROLL_VIEW(scroll_view)->virtual_h, 101 * 30);
+
+  widget_set_prop_int(scroll_view, WIDGET_PROP_YOFFSET, 30 * 101 - 300);
+  check_virtual_items(list_view, 30);
+  ASSERT_STREQ(get_title(widget_find_target(scroll_view, 10, 299), text, sizeof(text)),
+               "row 100");
+
+  widget_destroy(win);
+  OBJECT_UNREF(rows);
+  idle_dispatch();
+}
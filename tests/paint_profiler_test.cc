@@ -0,0 +1,158 @@
+#include "base/canvas.h"
+#include "base/window.h"
+#include "base/font_manager.h"
+#include "base/paint_profiler.h"
+#include "conf_io/conf_json.h"
+#include "widgets/view.h"
+#include "widgets/label.h"
+#include "lcd_log.h"
+#include "gtest/gtest.h"
+
+#include <string>
+
+using std::string;
+
+static conf_doc_t* paint_profiler_test_export(void) {
+  str_t str;
+  conf_doc_t* doc = NULL;
+
+  str_init(&str, 1024);
+  paint_profiler_export(&str);
+  doc = conf_doc_load_json(str.str, str.size);
+  str_reset(&str);
+
+  return doc;
+}
+
+static string paint_profiler_test_get_str(conf_doc_t* doc, const char* path) {
+  value_t v;
+
+  if (conf_doc_get(doc, path, &v) != RET_OK) {
+    return "";
+  }
+
+  return value_str(&v);
+}
+
+TEST(PaintProfiler, not_started) {
+  str_t str;
+
+  ASSERT_FALSE(paint_profiler_is_started());
+  ASSERT_EQ(paint_profiler_now(), 0u);
+  ASSERT_EQ(paint_profiler_record(NULL, PAINT_PROFILER_PAINT, 0), RET_OK);
+  ASSERT_EQ(paint_profiler_get_events_nr(), 0u);
+
+  str_init(&str, 100);
+  ASSERT_EQ(paint_profiler_export(&str), RET_OK);
+  ASSERT_STREQ(str.str, "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ms\"}\n");
+  str_reset(&str);
+}
+
+TEST(PaintProfiler, ring_buffer) {
+  value_t v;
+  uint32_t i = 0;
+  conf_doc_t* doc = NULL;
+  widget_t* view = view_create(NULL, 0, 0, 100, 100);
+
+  widget_set_name(view, "v\"1");
+  ASSERT_EQ(paint_profiler_start(4), RET_OK);
+  ASSERT_TRUE(paint_profiler_is_started());
+
+  for (i = 0; i < 7; i++) {
+    paint_profiler_record(view, (paint_profiler_phase_t)(PAINT_PROFILER_PAINT + i),
+                          paint_profiler_now());
+  }
+  ASSERT_EQ(paint_profiler_get_events_nr(), 4u);
+
+  /*最早的三条(paint、background和self)被覆盖*/
+  doc = paint_profiler_test_export();
+  ASSERT_TRUE(doc != NULL);
+  ASSERT_EQ(conf_doc_get(doc, "traceEvents.#size", &v), RET_OK);
+  ASSERT_EQ(value_int(&v), 4);
+  ASSERT_EQ(paint_profiler_test_get_str(doc, "traceEvents.[0].name"), "children");
+  ASSERT_EQ(paint_profiler_test_get_str(doc, "traceEvents.[0].ph"), "X");
+  ASSERT_EQ(paint_profiler_test_get_str(doc, "traceEvents.[0].args.type"), "view");
+  ASSERT_EQ(paint_profiler_test_get_str(doc, "traceEvents.[2].cat"), "layout");
+  ASSERT_EQ(paint_profiler_test_get_str(doc, "traceEvents.[3].name"), "update_style");
+  ASSERT_EQ(paint_profiler_test_get_str(doc, "traceEvents.[3].cat"), "style");
+  conf_doc_destroy(doc);
+
+  /*每一帧输出查询style的次数*/
+  paint_profiler_count_style_lookup();
+  paint_profiler_count_style_lookup();
+  paint_profiler_end_frame(paint_profiler_now());
+  doc = paint_profiler_test_export();
+  ASSERT_EQ(conf_doc_get(doc, "traceEvents.#size", &v), RET_OK);
+  ASSERT_EQ(value_int(&v), 5);
+  ASSERT_EQ(paint_profiler_test_get_str(doc, "traceEvents.[3].name"), "frame");
+  ASSERT_EQ(paint_profiler_test_get_str(doc, "traceEvents.[4].ph"), "C");
+  ASSERT_EQ(conf_doc_get(doc, "traceEvents.[4].args.count", &v), RET_OK);
+  ASSERT_EQ(value_int(&v), 2);
+  conf_doc_destroy(doc);
+
+  ASSERT_EQ(paint_profiler_stop(), RET_OK);
+  ASSERT_FALSE(paint_profiler_is_started());
+  ASSERT_EQ(paint_profiler_get_events_nr(), 0u);
+
+  widget_destroy(view);
+}
+
+#ifdef WITH_PAINT_PROFILER
+TEST(PaintProfiler, widget_paint) {
+  canvas_t c;
+  value_t v;
+  rect_t r;
+  dirty_rects_t dr;
+  conf_doc_t* doc = NULL;
+  string names;
+  int32_t i = 0;
+  int32_t nr = 0;
+  char path[64];
+  font_manager_t font_manager;
+  lcd_t* lcd = lcd_log_init(320, 240);
+  widget_t* win = window_create(NULL, 0, 0, 320, 240);
+  widget_t* view = view_create(win, 10, 10, 100, 80);
+  widget_t* label = label_create(view, 0, 0, 100, 30);
+
+  widget_resize(win, 320, 240);
+  widget_set_text_utf8(label, "hello");
+  font_manager_init(&font_manager, NULL);
+  canvas_init(&c, lcd, &font_manager);
+
+  ASSERT_EQ(paint_profiler_start(0), RET_OK);
+  widget_layout(win);
+  r = rect_init(0, 0, 320, 240);
+  dirty_rects_init(&dr);
+  dirty_rects_add(&dr, &r);
+  canvas_begin_frame(&c, &dr, LCD_DRAW_NORMAL);
+  widget_paint(win, &c);
+  canvas_end_frame(&c);
+  paint_profiler_end_frame(paint_profiler_now() - 1);
+
+  doc = paint_profiler_test_export();
+  ASSERT_TRUE(doc != NULL);
+  ASSERT_EQ(conf_doc_get(doc, "traceEvents.#size", &v), RET_OK);
+  nr = value_int(&v);
+  for (i = 0; i < nr; i++) {
+    tk_snprintf(path, sizeof(path), "traceEvents.[%d].name", i);
+    names += paint_profiler_test_get_str(doc, path) + ",";
+  }
+  tk_snprintf(path, sizeof(path), "traceEvents.[%d].args.count", nr - 1);
+  ASSERT_EQ(conf_doc_get(doc, path, &v), RET_OK);
+  ASSERT_GT(value_int(&v), 0);
+  conf_doc_destroy(doc);
+  paint_profiler_stop();
+
+  /*子控件先于父控件结束*/
+  ASSERT_NE(names.find("layout,"), string::npos);
+  ASSERT_NE(names.find("background,self,children,border,label,"), string::npos);
+  ASSERT_LT(names.find("label,"), names.find("view,"));
+  ASSERT_LT(names.find("view,"), names.find("window,"));
+  ASSERT_NE(names.find("window,frame,style_lookups,"), string::npos);
+
+  widget_destroy(win);
+  canvas_reset(&c);
+  font_manager_deinit(&font_manager);
+  lcd_destroy(lcd);
+}
+#endif /*WITH_PAINT_PROFILER*/
@@ -0,0 +1,289 @@
+﻿#include "widgets/label.h"
+#include "widgets/button.h"
+#include "widgets/edit.h"
+#include "base/window.h"
+#include "base/window_base.h"
+#include "widgets/slider.h"
+#include "widgets/progress_bar.h"
+#include "rich_text/rich_text.h"
+#include "base/font_manager.h"
+#include "base/glyph_cache.h"
+#include "base/window_manager.h"
+#include "base/widget_layer_cache.h"
+#include "native_window/native_window_raw.h"
+#include "window_manager/window_manager_default.h"
+#include "widgets/view.h"
+#include "base/parallel_paint.h"
+#include "lcd/lcd_mem_bgra8888.h"
+#include "lcd_log.h"
+#include "gtest/gtest.h"
+
+#define PP_W 320
+#define PP_H 240
+#define PP_SIZE (PP_W * PP_H * 4)
+
+/*和parallel_paint.c中的条件一致*/
+#if (defined(WITH_PARALLEL_PAINT) || defined(HAS_PTHREAD) || defined(WITH_SDL)) && \
+    !defined(WITHOUT_PARALLEL_PAINT) && !defined(WITH_GPU) && \
+    !defined(FRAGMENT_FRAME_BUFFER_SIZE) && !defined(ENABLE_PERFORMANCE_PROFILE)
+#define PP_ENABLED 1
+#endif /*PP_ENABLED*/
+
+static void parallel_paint_test_draw(widget_t* win, canvas_t* c, dirty_rects_t* dr,
+                                     bool_t parallel) {
+  uint32_t i = 0;
+
+  canvas_begin_frame(c, dr, LCD_DRAW_OFFLINE);
+  if (parallel) {
+    ASSERT_EQ(parallel_paint(dr, win, c, widget_paint), RET_OK);
+  } else {
+    for (i = 0; i < dr->nr; i++) {
+      widget_paint_with_clip(win, dr->rects + i, c, widget_paint);
+    }
+  }
+  canvas_end_frame(c);
+}
+
+class ParallelPaintTest : public testing::Test {
+ protected:
+  virtual void SetUp() {
+    rect_t r1 = rect_init(0, 0, PP_W, PP_H);
+    rect_t r2 = rect_init(10, 10, 300, 30);
+
+    this->fb = (uint8_t*)TKMEM_ALLOC(PP_SIZE);
+    this->expected = (uint8_t*)TKMEM_ALLOC(PP_SIZE);
+    this->lcd = lcd_mem_bgra8888_create_single_fb(PP_W, PP_H, this->fb);
+    this->win = window_create(NULL, 0, 0, PP_W, PP_H);
+    /*测试环境中窗口管理器的大小为0，打开窗口时会按它调整窗口的大小*/
+    widget_move_resize(this->win, 0, 0, PP_W, PP_H);
+    widget_set_style_color(this->win, "normal:bg_color", 0xff336699);
+    canvas_init(&(this->c), this->lcd, font_manager());
+
+    dirty_rects_init(&(this->dr));
+    dirty_rects_add(&(this->dr), &r1);
+    dirty_rects_add(&(this->dr), &r2);
+  }
+
+  virtual void TearDown() {
+    ASSERT_EQ(parallel_paint_set_threads(0), RET_OK);
+    ASSERT_EQ(parallel_paint_get_threads(), 0u);
+
+    widget_destroy(this->win);
+    canvas_reset(&(this->c));
+    lcd_destroy(this->lcd);
+    TKMEM_FREE(this->fb);
+    TKMEM_FREE(this->expected);
+  }
+
+  /*单线程绘制的结果保存到expected中*/
+  void DrawExpected(void) {
+    memset(this->fb, 0x00, PP_SIZE);
+    parallel_paint_test_draw(this->win, &(this->c), &(this->dr), FALSE);
+    memcpy(this->expected, this->fb, PP_SIZE);
+  }
+
+  /*多线程绘制，和单线程绘制的结果逐像素比较*/
+  bool_t DrawParallelAndCompare(void) {
+    memset(this->fb, 0x00, PP_SIZE);
+    parallel_paint_test_draw(this->win, &(this->c), &(this->dr), TRUE);
+
+    return memcmp(this->expected, this->fb, PP_SIZE) == 0;
+  }
+
+  canvas_t c;
+  lcd_t* lcd;
+  uint8_t* fb;
+  uint8_t* expected;
+  widget_t* win;
+  dirty_rects_t dr;
+};
+
+TEST_F(ParallelPaintTest, same_as_single_thread) {
+  rect_t r2 = rect_init(10, 10, 300, 30);
+  widget_t* label = label_create(win, 10, 10, 300, 30);
+  widget_t* button = button_create(win, 10, 50, 300, 60);
+  widget_t* slider = slider_create(win, 10, 120, 300, 20);
+  widget_t* bar = progress_bar_create(win, 10, 150, 300, 80);
+
+  widget_set_text_utf8(label, "parallel paint 0123456789");
+  widget_set_text_utf8(button, "button");
+  widget_set_value(slider, 40);
+  widget_set_value(bar, 70);
+
+#ifdef PP_ENABLED
+  ASSERT_EQ(parallel_paint_set_threads(4), RET_OK);
+  ASSERT_EQ(parallel_paint_get_threads(), 4u);
+
+  DrawExpected();
+  ASSERT_TRUE(DrawParallelAndCompare());
+
+  /*脏矩形太小，不值得多线程绘制*/
+  dirty_rects_reset(&dr);
+  dirty_rects_add(&dr, &r2);
+  ASSERT_EQ(parallel_paint(&dr, win, &c, widget_paint), RET_NOT_IMPL);
+#else
+  ASSERT_NE(parallel_paint_set_threads(4), RET_OK);
+  ASSERT_EQ(parallel_paint(&dr, win, &c, widget_paint), RET_NOT_IMPL);
+  (void)r2;
+#endif /*PP_ENABLED*/
+}
+
+#ifdef PP_ENABLED
+TEST_F(ParallelPaintTest, text_edit_and_rich_text) {
+  widget_t* label = label_create(win, 10, 10, 300, 30);
+  widget_t* edit = edit_create(win, 10, 50, 300, 40);
+  widget_t* rich_text = rich_text_create(win, 10, 100, 300, 130);
+
+  widget_set_text_utf8(label, "parallel paint 0123456789");
+  widget_set_text_utf8(edit, "edit 0123456789");
+  widget_set_text_utf8(rich_text, "<font color=\"red\" size=\"20\">rich</font> text 0123456789");
+  ASSERT_EQ(parallel_paint_set_threads(4), RET_OK);
+
+  /*edit和rich_text绘制时会布局，不能多线程绘制，调用者单线程绘制*/
+  DrawExpected();
+  ASSERT_EQ(parallel_paint(&dr, win, &c, widget_paint), RET_NOT_IMPL);
+  memset(fb, 0x00, PP_SIZE);
+  parallel_paint_test_draw(win, &c, &dr, FALSE);
+  ASSERT_EQ(memcmp(expected, fb, PP_SIZE), 0);
+
+  widget_set_visible(edit, FALSE);
+  ASSERT_EQ(parallel_paint(&dr, win, &c, widget_paint), RET_NOT_IMPL);
+
+  /*不可见时不绘制，可以多线程绘制*/
+  widget_set_visible(rich_text, FALSE);
+  DrawExpected();
+  ASSERT_TRUE(DrawParallelAndCompare());
+}
+
+TEST_F(ParallelPaintTest, layout_before_paint) {
+  widget_t* label = label_create(win, 0, 0, 10, 10);
+  widget_t* button = button_create(win, 0, 0, 10, 10);
+
+  widget_set_text_utf8(label, "parallel paint 0123456789");
+  widget_set_text_utf8(button, "button");
+  widget_set_self_layout_params(label, "10", "10", "300", "30");
+  widget_set_self_layout_params(button, "10", "50", "300", "100");
+  ASSERT_EQ(parallel_paint_set_threads(4), RET_OK);
+
+  /*在UI线程中先布局，再分条带绘制*/
+  window_base_set_need_relayout(win, TRUE);
+  memset(fb, 0x00, PP_SIZE);
+  parallel_paint_test_draw(win, &c, &dr, TRUE);
+  ASSERT_FALSE(WINDOW_BASE(win)->need_relayout);
+  ASSERT_EQ(button->y, 50);
+  ASSERT_EQ(button->h, 100);
+  memcpy(expected, fb, PP_SIZE);
+
+  memset(fb, 0x00, PP_SIZE);
+  parallel_paint_test_draw(win, &c, &dr, FALSE);
+  ASSERT_EQ(memcmp(expected, fb, PP_SIZE), 0);
+}
+
+static glyph_cache_t s_glyph_cache;
+static wchar_t s_glyph_code = 0;
+
+/*每个条带都往缓存中增加字模，这些字模都是本帧用到的，不能淘汰*/
+static ret_t parallel_paint_test_add_glyphs(widget_t* widget, canvas_t* c) {
+  uint32_t i = 0;
+  glyph_t g;
+
+  memset(&g, 0x00, sizeof(g));
+  parallel_paint_lock();
+  for (i = 0; i < 16; i++) {
+    glyph_cache_add(&s_glyph_cache, s_glyph_code++, 10, glyph_clone(&g));
+  }
+  parallel_paint_unlock();
+
+  return widget_paint(widget, c);
+}
+
+TEST_F(ParallelPaintTest, glyph_cache_grow) {
+  uint32_t i = 0;
+  glyph_t g;
+
+  memset(&g, 0x00, sizeof(g));
+  ASSERT_EQ(glyph_cache_init(&s_glyph_cache, 4, (tk_destroy_t)glyph_destroy), &s_glyph_cache);
+  ASSERT_EQ(parallel_paint_set_threads(4), RET_OK);
+
+  for (i = 0; i < 3; i++) {
+    canvas_begin_frame(&c, &dr, LCD_DRAW_OFFLINE);
+    ASSERT_EQ(parallel_paint(&dr, win, &c, parallel_paint_test_add_glyphs), RET_OK);
+    canvas_end_frame(&c);
+    ASSERT_GT(s_glyph_cache.size, 4u);
+    ASSERT_GT(s_glyph_cache.capacity, 4u);
+
+    /*绘制结束之后淘汰到上限以内，容量也收缩回来，不会一直增长*/
+    ASSERT_EQ(glyph_cache_add(&s_glyph_cache, s_glyph_code++, 10, glyph_clone(&g)), RET_OK);
+    ASSERT_EQ(s_glyph_cache.size, 4u);
+    ASSERT_EQ(s_glyph_cache.capacity, 4u);
+    ASSERT_EQ(s_glyph_cache.max_size, 4u);
+    ASSERT_EQ(glyph_cache_lookup(&s_glyph_cache, s_glyph_code - 1, 10, &g), RET_OK);
+  }
+
+  glyph_cache_deinit(&s_glyph_cache);
+}
+
+static ret_t on_before_paint(void* ctx, event_t* e) {
+  parallel_paint_lock();
+  (*(uint32_t*)ctx)++;
+  parallel_paint_unlock();
+
+  return RET_OK;
+}
+
+TEST_F(ParallelPaintTest, layer_cache) {
+  static lcd_t* s_lcd = NULL;
+  uint32_t painted = 0;
+  uint32_t size = 0;
+  window_manager_default_t* wm = WINDOW_MANAGER_DEFAULT(window_manager());
+  widget_t* group = view_create(win, 10, 10, 300, 200);
+  widget_t* child = view_create(group, 10, 10, 50, 50);
+
+  /*离线画布需要原生窗口，测试环境中没有，临时创建一个*/
+  if (s_lcd == NULL) {
+    s_lcd = lcd_log_init(800, 600);
+    native_window_raw_init(s_lcd);
+  }
+  wm->native_window = native_window_create(window_manager());
+
+  widget_on(child, EVT_BEFORE_PAINT, on_before_paint, &painted);
+  widget_set_cache_as_bitmap(group, TRUE);
+  ASSERT_EQ(parallel_paint_set_threads(4), RET_OK);
+
+  /*多线程绘制时不创建缓存，照常绘制控件*/
+  parallel_paint_test_draw(win, &c, &dr, TRUE);
+  ASSERT_GT(painted, 0u);
+  ASSERT_EQ(widget_layer_cache_get_size(), 0u);
+
+  /*单线程绘制时创建缓存*/
+  painted = 0;
+  parallel_paint_test_draw(win, &c, &dr, FALSE);
+  ASSERT_EQ(painted, 1u);
+  size = widget_layer_cache_get_size();
+  ASSERT_GT(size, 0u);
+
+  /*多线程绘制时使用有效的缓存*/
+  painted = 0;
+  parallel_paint_test_draw(win, &c, &dr, TRUE);
+  ASSERT_EQ(painted, 0u);
+  ASSERT_EQ(widget_layer_cache_get_size(), size);
+
+  /*缓存无效时不更新缓存，照常绘制控件，之后单线程绘制时再更新*/
+  widget_invalidate(child, NULL);
+  parallel_paint_test_draw(win, &c, &dr, TRUE);
+  ASSERT_GT(painted, 0u);
+  painted = 0;
+  parallel_paint_test_draw(win, &c, &dr, TRUE);
+  ASSERT_GT(painted, 0u);
+  painted = 0;
+  parallel_paint_test_draw(win, &c, &dr, FALSE);
+  ASSERT_EQ(painted, 1u);
+  painted = 0;
+  parallel_paint_test_draw(win, &c, &dr, TRUE);
+  ASSERT_EQ(painted, 0u);
+
+  widget_set_cache_as_bitmap(group, FALSE);
+  ASSERT_EQ(widget_layer_cache_get_size(), 0u);
+  wm->native_window = NULL;
+}
+#endif /*PP_ENABLED*/
@@ -0,0 +1,166 @@
+﻿#include "tkc/region.h"
+#include "gtest/gtest.h"
+
+static void region_test_check_rect(region_t* region, uint32_t i, xy_t x, xy_t y, wh_t w, wh_t h) {
+  rect_t r = rect_init(x, y, w, h);
+  ASSERT_LT(i, region->nr);
+  ASSERT_EQ(memcmp(&r, region->rects + i, sizeof(rect_t)), 0);
+}
+
+TEST(Region, basic) {
+  region_t region;
+  rect_t r = rect_init(10, 20, 30, 40);
+
+  region_init(&region);
+  ASSERT_EQ(region_is_empty(&region), TRUE);
+
+  ASSERT_EQ(region_set_rect(&region, &r), RET_OK);
+  ASSERT_EQ(region.nr, 1u);
+  ASSERT_EQ(region_get_area(&region), 1200u);
+  ASSERT_EQ(region_contains(&region, 10, 20), TRUE);
+  ASSERT_EQ(region_contains(&region, 40, 20), FALSE);
+  ASSERT_EQ(memcmp(&r, &(region.extents), sizeof(rect_t)), 0);
+
+  ASSERT_EQ(region_reset(&region), RET_OK);
+  ASSERT_EQ(region_is_empty(&region), TRUE);
+
+  region_deinit(&region);
+}
+
+TEST(Region, union_coalesce) {
+  region_t region;
+  rect_t r = rect_init(0, 0, 10, 10);
+
+  region_init(&region);
+  ASSERT_EQ(region_union_rect(&region, &r), RET_OK);
+
+  /*水平相邻，合并成一个矩形*/
+  r = rect_init(10, 0, 10, 10);
+  ASSERT_EQ(region_union_rect(&region, &r), RET_OK);
+  ASSERT_EQ(region.nr, 1u);
+  region_test_check_rect(&region, 0, 0, 0, 20, 10);
+
+  /*垂直相邻，带合并*/
+  r = rect_init(0, 10, 20, 10);
+  ASSERT_EQ(region_union_rect(&region, &r), RET_OK);
+  ASSERT_EQ(region.nr, 1u);
+  region_test_check_rect(&region, 0, 0, 0, 20, 20);
+
+  /*重叠*/
+  r = rect_init(10, 10, 20, 20);
+  ASSERT_EQ(region_union_rect(&region, &r), RET_OK);
+  ASSERT_EQ(region.nr, 3u);
+  region_test_check_rect(&region, 0, 0, 0, 20, 10);
+  region_test_check_rect(&region, 1, 0, 10, 30, 10);
+  region_test_check_rect(&region, 2, 10, 20, 20, 10);
+  ASSERT_EQ(region_get_area(&region), 400u + 400u - 100u);
+
+  region_deinit(&region);
+}
+
+TEST(Region, union_disjoint) {
+  region_t region;
+  rect_t r = rect_init(50, 0, 10, 10);
+
+  region_init(&region);
+  ASSERT_EQ(region_union_rect(&region, &r), RET_OK);
+  r = rect_init(0, 0, 10, 10);
+  ASSERT_EQ(region_union_rect(&region, &r), RET_OK);
+
+  ASSERT_EQ(region.nr, 2u);
+  region_test_check_rect(&region, 0, 0, 0, 10, 10);
+  region_test_check_rect(&region, 1, 50, 0, 10, 10);
+
+  r = rect_init(0, 0, 60, 10);
+  ASSERT_EQ(memcmp(&r, &(region.extents), sizeof(rect_t)), 0);
+
+  region_deinit(&region);
+}
+
+TEST(Region, subtract) {
+  region_t region;
+  rect_t r = rect_init(0, 0, 30, 30);
+
+  region_init(&region);
+  region_set_rect(&region, &r);
+
+  r = rect_init(10, 10, 10, 10);
+  ASSERT_EQ(region_subtract_rect(&region, &r), RET_OK);
+  ASSERT_EQ(region.nr, 4u);
+  region_test_check_rect(&region, 0, 0, 0, 30, 10);
+  region_test_check_rect(&region, 1, 0, 10, 10, 10);
+  region_test_check_rect(&region, 2, 20, 10, 10, 10);
+  region_test_check_rect(&region, 3, 0, 20, 30, 10);
+  ASSERT_EQ(region_get_area(&region), 800u);
+  ASSERT_EQ(region_contains(&region, 15, 15), FALSE);
+  ASSERT_EQ(region_contains(&region, 5, 15), TRUE);
+
+  /*不相交*/
+  r = rect_init(100, 100, 10, 10);
+  ASSERT_EQ(region_subtract_rect(&region, &r), RET_OK);
+  ASSERT_EQ(region.nr, 4u);
+
+  r = rect_init(0, 0, 30, 30);
+  ASSERT_EQ(region_subtract_rect(&region, &r), RET_OK);
+  ASSERT_EQ(region_is_empty(&region), TRUE);
+
+  region_deinit(&region);
+}
+
+TEST(Region, intersect) {
+  region_t a;
+  region_t b;
+  rect_t r = rect_init(0, 0, 10, 10);
+
+  region_init(&a);
+  region_init(&b);
+  region_union_rect(&a, &r);
+  r = rect_init(20, 0, 10, 10);
+  region_union_rect(&a, &r);
+
+  r = rect_init(5, 5, 20, 20);
+  region_set_rect(&b, &r);
+
+  ASSERT_EQ(region_intersect(&a, &b), RET_OK);
+  ASSERT_EQ(a.nr, 2u);
+  region_test_check_rect(&a, 0, 5, 5, 5, 5);
+  region_test_check_rect(&a, 1, 20, 5, 5, 5);
+
+  r = rect_init(5, 5, 20, 5);
+  ASSERT_EQ(memcmp(&r, &(a.extents), sizeof(rect_t)), 0);
+
+  r = rect_init(100, 100, 1, 1);
+  ASSERT_EQ(region_intersect_rect(&a, &r), RET_OK);
+  ASSERT_EQ(region_is_empty(&a), TRUE);
+
+  region_deinit(&a);
+  region_deinit(&b);
+}
+
+TEST(Region, many) {
+  uint32_t i = 0;
+  region_t region;
+  region_t other;
+
+  region_init(&region);
+  region_init(&other);
+  for (i = 0; i < 100; i++) {
+    rect_t r = rect_init(i * 20, i * 3, 10, 10);
+    ASSERT_EQ(region_union_rect(&region, &r), RET_OK);
+  }
+  ASSERT_EQ(region_get_area(&region), 100u * 100u);
+  ASSERT_GT(region.nr, (uint32_t)TK_REGION_STATIC_NR);
+
+  ASSERT_EQ(region_copy(&other, &region), RET_OK);
+  ASSERT_EQ(other.nr, region.nr);
+  ASSERT_EQ(region_subtract(&other, &region), RET_OK);
+  ASSERT_EQ(region_is_empty(&other), TRUE);
+
+  for (i = 0; i < 100; i++) {
+    ASSERT_EQ(region_contains(&region, i * 20 + 5, i * 3 + 5), TRUE);
+    ASSERT_EQ(region_contains(&region, i * 20 + 15, i * 3 + 5), FALSE);
+  }
+
+  region_deinit(&region);
+  region_deinit(&other);
+}
@@ -2,6 +2,8 @@
 #include "tkc/color.h"
 #include "base/bitmap.h"
 #include "blend/image_g2d.h"
+#include "blend/blend_simd.h"
+#include "tkc/time_now.h"
 #include "gtest/gtest.h"
 #include "common.h"
 
@@ -59,3 +61,207 @@ TEST(RotateImage, BITMAP_FMT_BGR565_stride) {
 TEST(RotateImage, BITMAP_FMT_RGB565_stride) {
   test_rotate_image(1, BITMAP_FMT_RGB565);
 }
+
+static void fill_random_pixels(bitmap_t* b, uint32_t seed) {
+  uint32_t i = 0;
+  uint32_t size = b->line_length * b->h;
+  uint8_t* data = bitmap_lock_buffer_for_write(b);
+
+  for (i = 0; i < size; i++) {
+    seed = seed * 1103515245 + 12345;
+    data[i] = (uint8_t)(seed >> 16);
+  }
+  bitmap_unlock_buffer(b);
+}
+
+template <uint32_t N>
+struct pixel_bytes_t {
+  uint8_t data[N];
+};
+
+/*旋转前的逐像素实现，用于校验和性能对比*/
+template <typename pixel_t>
+static void rotate_image_naive(bitmap_t* dst, bitmap_t* src, const rect_t* src_r,
+                               lcd_orientation_t o) {
+  xy_t dx = 0;
+  xy_t dy = 0;
+  uint32_t i = 0;
+  uint32_t k = 0;
+  uint32_t w = src_r->w;
+  uint32_t h = src_r->h;
+  uint32_t bpp = sizeof(pixel_t);
+  uint32_t dst_line_length = bitmap_get_line_length(dst);
+  uint32_t src_line_length = bitmap_get_line_length(src);
+  uint8_t* dst_data = bitmap_lock_buffer_for_write(dst);
+  uint8_t* src_data = bitmap_lock_buffer_for_read(src);
+
+  if (o == LCD_ORIENTATION_90) {
+    dx = src_r->y;
+    dy = src->w - src_r->x - src_r->w;
+  } else if (o == LCD_ORIENTATION_180) {
+    dy = src->h - src_r->y - 1;
+    dx = src->w - src_r->x - 1;
+  } else {
+    dx = src->h - src_r->y - 1;
+    dy = src_r->x;
+  }
+
+  pixel_t* dst_p = (pixel_t*)(dst_data + dy * dst_line_length + dx * bpp);
+  pixel_t* src_p = (pixel_t*)(src_data + src_r->y * src_line_length + src_r->x * bpp);
+
+  for (i = 0; i < h; i++) {
+    pixel_t* s = src_p;
+    pixel_t* d = dst_p;
+
+    for (k = 0; k < w; k++) {
+      if (o == LCD_ORIENTATION_90) {
+        *d = s[w - 1 - k];
+        d = (pixel_t*)(((char*)d) + dst_line_length);
+      } else if (o == LCD_ORIENTATION_180) {
+        *d-- = s[k];
+      } else {
+        *d = s[k];
+        d = (pixel_t*)(((char*)d) + dst_line_length);
+      }
+    }
+
+    if (o == LCD_ORIENTATION_180) {
+      dst_p = (pixel_t*)(((char*)dst_p) - dst_line_length);
+    } else {
+      dst_p += o == LCD_ORIENTATION_90 ? 1 : -1;
+    }
+    src_p = (pixel_t*)(((char*)src_p) + src_line_length);
+  }
+
+  bitmap_unlock_buffer(dst);
+  bitmap_unlock_buffer(src);
+}
+
+static void rotate_image_naive(bitmap_t* dst, bitmap_t* src, const rect_t* src_r,
+                               lcd_orientation_t o) {
+  switch (bitmap_get_bpp(src)) {
+    case 2: {
+      rotate_image_naive<pixel_bytes_t<2> >(dst, src, src_r, o);
+      break;
+    }
+    case 3: {
+      rotate_image_naive<pixel_bytes_t<3> >(dst, src, src_r, o);
+      break;
+    }
+    default: {
+      rotate_image_naive<pixel_bytes_t<4> >(dst, src, src_r, o);
+      break;
+    }
+  }
+}
+
+static void test_rotate_image_exact(bitmap_format_t fmt, uint32_t w, uint32_t h, uint32_t stride,
+                                    const rect_t* r, lcd_orientation_t o) {
+  uint32_t bpp = bitmap_get_bpp_of_format(fmt);
+  bool_t swap = o != LCD_ORIENTATION_180;
+  uint32_t dw = swap ? h : w;
+  uint32_t dh = swap ? w : h;
+  bitmap_t* src = bitmap_create_ex(w, h, bpp * (w + stride), fmt);
+  bitmap_t* ref = bitmap_create_ex(dw, dh, bpp * (dw + stride), fmt);
+  bitmap_t* out = bitmap_create_ex(dw, dh, bpp * (dw + stride), fmt);
+
+  fill_random_pixels(src, w * h + o);
+  fill_random_pixels(ref, 7);
+  fill_random_pixels(out, 7);
+
+  rotate_image_naive(ref, src, r, o);
+  ASSERT_EQ(image_rotate(out, src, r, o), RET_OK);
+  ASSERT_EQ(memcmp(bitmap_lock_buffer_for_read(ref), bitmap_lock_buffer_for_read(out),
+                   ref->line_length * ref->h),
+            0)
+      << "fmt=" << fmt << " o=" << o << " r=(" << r->x << "," << r->y << "," << r->w << ","
+      << r->h << ") stride=" << stride;
+  bitmap_unlock_buffer(ref);
+  bitmap_unlock_buffer(out);
+
+  bitmap_destroy(src);
+  bitmap_destroy(ref);
+  bitmap_destroy(out);
+}
+
+TEST(RotateImage, tiled_exact) {
+  uint32_t f = 0;
+  uint32_t e = 0;
+  uint32_t k = 0;
+  uint32_t n = 0;
+  bitmap_format_t fmts[] = {BITMAP_FMT_BGR565,   BITMAP_FMT_RGB565,   BITMAP_FMT_BGR888,
+                            BITMAP_FMT_RGB888,   BITMAP_FMT_BGRA8888, BITMAP_FMT_RGBA8888};
+  lcd_orientation_t os[] = {LCD_ORIENTATION_90, LCD_ORIENTATION_180, LCD_ORIENTATION_270};
+  rect_t rects[] = {rect_init(0, 0, 67, 45),  rect_init(3, 5, 32, 32), rect_init(1, 2, 41, 19),
+                    rect_init(9, 7, 7, 3),    rect_init(66, 44, 1, 1), rect_init(0, 13, 67, 0),
+                    rect_init(17, 0, 33, 45)};
+
+  for (e = 0; e < 2; e++) {
+    blend_simd_set_enable(e == 0);
+    for (f = 0; f < ARRAY_SIZE(fmts); f++) {
+      for (k = 0; k < ARRAY_SIZE(os); k++) {
+        for (n = 0; n < ARRAY_SIZE(rects); n++) {
+          test_rotate_image_exact(fmts[f], 67, 45, n % 3, rects + n, os[k]);
+        }
+      }
+    }
+  }
+  blend_simd_set_enable(TRUE);
+}
+
+static double bench_rotate_image(bitmap_t* dst, bitmap_t* src, lcd_orientation_t o, bool_t naive,
+                                 uint32_t times) {
+  uint32_t i = 0;
+  rect_t r = rect_init(0, 0, src->w, src->h);
+  uint64_t start = time_now_us();
+
+  for (i = 0; i < times; i++) {
+    if (naive) {
+      rotate_image_naive(dst, src, &r, o);
+    } else {
+      image_rotate(dst, src, &r, o);
+    }
+  }
+
+  return (double)(time_now_us() - start) / times / 1000.0;
+}
+
+/*
+ * 性能对比(缺省不运行)：
+ * ./bin/runTest --gtest_filter=RotateImage.DISABLED_benchmark --gtest_also_run_disabled_tests
+ */
+TEST(RotateImage, DISABLED_benchmark) {
+  uint32_t f = 0;
+  uint32_t s = 0;
+  uint32_t k = 0;
+  uint32_t sizes[][2] = {{1024, 600}, {1920, 1080}};
+  bitmap_format_t fmts[] = {BITMAP_FMT_BGR565, BITMAP_FMT_BGR888, BITMAP_FMT_BGRA8888};
+  lcd_orientation_t os[] = {LCD_ORIENTATION_90, LCD_ORIENTATION_270};
+
+  for (s = 0; s < ARRAY_SIZE(sizes); s++) {
+    for (f = 0; f < ARRAY_SIZE(fmts); f++) {
+      for (k = 0; k < ARRAY_SIZE(os); k++) {
+        uint32_t w = sizes[s][0];
+        uint32_t h = sizes[s][1];
+        bitmap_t* src = bitmap_create_ex(w, h, 0, fmts[f]);
+        bitmap_t* dst = bitmap_create_ex(h, w, 0, fmts[f]);
+        double naive = 0;
+        double tiled = 0;
+        double simd = 0;
+
+        fill_random_pixels(src, 1);
+        naive = bench_rotate_image(dst, src, os[k], TRUE, 20);
+        blend_simd_set_enable(FALSE);
+        tiled = bench_rotate_image(dst, src, os[k], FALSE, 20);
+        blend_simd_set_enable(TRUE);
+        simd = bench_rotate_image(dst, src, os[k], FALSE, 20);
+
+        printf("%ux%u fmt=%d o=%d: naive %.3fms tiled %.3fms tiled+simd %.3fms\n", w, h,
+               fmts[f], os[k], naive, tiled, simd);
+
+        bitmap_destroy(src);
+        bitmap_destroy(dst);
+      }
+    }
+  }
+}
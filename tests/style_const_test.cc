@@ -49,3 +49,61 @@ TEST(StyleConst, combo_box_item) {
   style_destroy(s);
   widget_destroy(w);
 }
+
+TEST(StyleConst, shared) {
+  uint32_t i = 0;
+  style_t* styles[20];
+  widget_t* w = window_create(NULL, 10, 20, 30, 40);
+  widget_t* b = button_create(w, 0, 0, 10, 10);
+
+  style_const_cache_clear();
+  for (i = 0; i < ARRAY_SIZE(styles); i++) {
+    widget_t* iter = button_create(w, 0, 0, 10, 10);
+    styles[i] = style_const_create();
+    ASSERT_EQ(style_notify_widget_state_changed(styles[i], iter), RET_OK);
+  }
+
+  /*同样的类型、style和状态共享同一个解析结果*/
+  ASSERT_EQ(style_const_cache_get_size(), 1u);
+  for (i = 1; i < ARRAY_SIZE(styles); i++) {
+    ASSERT_TRUE(((style_const_t*)styles[i])->entry == ((style_const_t*)styles[0])->entry);
+    ASSERT_TRUE(((style_const_t*)styles[i])->data == ((style_const_t*)styles[0])->data);
+  }
+
+  /*解析后的值与直接从数据中读取的相同*/
+  const uint8_t* data = ((style_const_t*)styles[0])->data;
+  ASSERT_TRUE(data != NULL);
+  ASSERT_EQ(style_get_int(styles[0], STYLE_ID_FONT_SIZE, -1),
+            style_data_get_int(data, STYLE_ID_FONT_SIZE, -1));
+  ASSERT_EQ(style_get_uint(styles[0], STYLE_ID_BG_COLOR, 1),
+            style_data_get_uint(data, STYLE_ID_BG_COLOR, 1));
+  ASSERT_EQ(style_get_uint(styles[0], STYLE_ID_TEXT_COLOR, 1),
+            style_data_get_uint(data, STYLE_ID_TEXT_COLOR, 1));
+  ASSERT_EQ(style_get_str(styles[0], STYLE_ID_BG_IMAGE, "none"),
+            style_data_get_str(data, STYLE_ID_BG_IMAGE, "none"));
+  ASSERT_EQ(style_get_int(styles[0], STYLE_ID_MARGIN_LEFT, 123),
+            style_data_get_int(data, STYLE_ID_MARGIN_LEFT, 123));
+  ASSERT_EQ(style_get_int(styles[0], "no_such_prop", 7), 7);
+
+  /*不同的状态*/
+  widget_set_state(b, WIDGET_STATE_PRESSED);
+  style_t* pressed = style_const_create();
+  ASSERT_EQ(style_notify_widget_state_changed(pressed, b), RET_OK);
+  ASSERT_EQ(style_const_cache_get_size(), 2u);
+  ASSERT_TRUE(((style_const_t*)pressed)->entry != ((style_const_t*)styles[0])->entry);
+
+  /*主题数据变化后缓存失效，仍被引用的在释放style时释放*/
+  theme_set_theme_data(theme(), theme()->data);
+  ASSERT_EQ(style_notify_widget_state_changed(pressed, b), RET_OK);
+  ASSERT_EQ(style_const_cache_get_size(), 1u);
+  ASSERT_EQ(style_get_int(styles[0], STYLE_ID_FONT_SIZE, -1),
+            style_data_get_int(data, STYLE_ID_FONT_SIZE, -1));
+
+  for (i = 0; i < ARRAY_SIZE(styles); i++) {
+    style_destroy(styles[i]);
+  }
+  style_destroy(pressed);
+  style_const_cache_clear();
+  ASSERT_EQ(style_const_cache_get_size(), 0u);
+  widget_destroy(w);
+}
@@ -1,6 +1,7 @@
 ﻿
 #include "base/theme.h"
 #include "base/widget.h"
+#include "tools/theme_gen/theme_gen.h"
 #include "tools/theme_gen/xml_theme_gen.h"
 #include "gtest/gtest.h"
 #include "base/style_factory.h"
@@ -447,3 +448,83 @@ TEST(ThemeGen, gradient) {
 
   style_destroy(s);
 }
+
+TEST(ThemeGen, prop_id) {
+  char name[32];
+
+  ASSERT_EQ(style_prop_id_from_name(STYLE_ID_BG_COLOR), 0u);
+  ASSERT_EQ(style_prop_id_from_name(STYLE_ID_FEEDBACK), 42u);
+  ASSERT_EQ(style_prop_id_from_name("no_such_prop"), (uint32_t)STYLE_PROP_ID_INVALID);
+  ASSERT_EQ(style_prop_id_from_name(NULL), (uint32_t)STYLE_PROP_ID_INVALID);
+
+  /*不是常量字符串时按内容查找*/
+  tk_strncpy(name, STYLE_ID_TEXT_COLOR, sizeof(name) - 1);
+  ASSERT_EQ(style_prop_id_from_name(name), style_prop_id_from_name(STYLE_ID_TEXT_COLOR));
+}
+
+TEST(ThemeGen, indexed) {
+  char name[32];
+  uint32_t nr = 0;
+  uint8_t buff[1024];
+  wbuffer_t wbuffer;
+  Style style(WIDGET_TYPE_BUTTON, TK_DEFAULT_STYLE, WIDGET_STATE_NORMAL);
+
+  style.AddValue(STYLE_ID_FEEDBACK, (uint32_t)1);
+  style.AddValue(STYLE_ID_BG_COLOR, (uint32_t)0xff112233);
+  style.AddValue("my_prop", (int32_t)-5);
+  style.AddValue(STYLE_ID_FONT_SIZE, (int32_t)18);
+  style.AddValue(STYLE_ID_FONT_NAME, "sans");
+  style.AddValue("my_str", "hello");
+
+  wbuffer_init(&wbuffer, buff, sizeof(buff));
+  ASSERT_EQ(style.Output(&wbuffer), RET_OK);
+  memcpy(&nr, buff, sizeof(nr));
+  ASSERT_EQ(nr, 6u | STYLE_DATA_INDEXED);
+
+  ASSERT_EQ(style_data_get_uint(buff, STYLE_ID_FEEDBACK, 0), 1u);
+  ASSERT_EQ(style_data_get_uint(buff, STYLE_ID_BG_COLOR, 0), 0xff112233u);
+  ASSERT_EQ(style_data_get_int(buff, STYLE_ID_FONT_SIZE, 0), 18);
+  ASSERT_EQ(string(style_data_get_str(buff, STYLE_ID_FONT_NAME, "")), string("sans"));
+
+  /*自定义的属性按名称查找*/
+  ASSERT_EQ(style_data_get_int(buff, "my_prop", 0), -5);
+  ASSERT_EQ(string(style_data_get_str(buff, "my_str", "")), string("hello"));
+  ASSERT_EQ(style_data_get_int(buff, "not_exist", 7), 7);
+
+  /*没有设置的预定义属性返回缺省值*/
+  ASSERT_EQ(style_data_get_uint(buff, STYLE_ID_FG_COLOR, 3), 3u);
+  ASSERT_EQ(style_data_get_int(buff, STYLE_ID_MARGIN, -1), -1);
+
+  tk_strncpy(name, STYLE_ID_FONT_SIZE, sizeof(name) - 1);
+  ASSERT_EQ(style_data_get_int(buff, name, 0), 18);
+}
+
+TEST(ThemeGen, not_indexed) {
+  uint8_t buff[1024];
+  wbuffer_t wbuffer;
+  NameValues<int32_t> int_values;
+  NameValues<string> str_values;
+
+  /*旧的主题数据没有索引*/
+  int_values.AddValue(STYLE_ID_FONT_SIZE, 20, VALUE_TYPE_INT32);
+  int_values.AddValue("my_prop", 9, VALUE_TYPE_INT32);
+  str_values.AddValue(STYLE_ID_FONT_NAME, string("serif"), VALUE_TYPE_STRING);
+
+  wbuffer_init(&wbuffer, buff, sizeof(buff));
+  wbuffer_write_uint32(&wbuffer, 3);
+  int_values.WriteToWbuffer(&wbuffer);
+  str_values.WriteToWbuffer(&wbuffer);
+
+  ASSERT_EQ(style_data_get_int(buff, STYLE_ID_FONT_SIZE, 0), 20);
+  ASSERT_EQ(style_data_get_int(buff, "my_prop", 0), 9);
+  ASSERT_EQ(string(style_data_get_str(buff, STYLE_ID_FONT_NAME, "")), string("serif"));
+  ASSERT_EQ(style_data_get_int(buff, STYLE_ID_MARGIN, 4), 4);
+
+  /*只有自定义属性时也不需要索引*/
+  Style style(WIDGET_TYPE_BUTTON, TK_DEFAULT_STYLE, WIDGET_STATE_NORMAL);
+  style.AddValue("my_prop", (int32_t)11);
+  wbuffer_init(&wbuffer, buff, sizeof(buff));
+  ASSERT_EQ(style.Output(&wbuffer), RET_OK);
+  ASSERT_EQ(buff[3] & 0x80, 0);
+  ASSERT_EQ(style_data_get_int(buff, "my_prop", 0), 11);
+}
@@ -2,7 +2,9 @@
 #include "base/enums.h"
 #include "base/theme.h"
 #include "base/widget.h"
+#include "tkc/mem.h"
 #include "tkc/buffer.h"
+#include "tkc/time_now.h"
 #include "tools/theme_gen/theme_gen.h"
 #include "base/style_factory.h"
 #include "gtest/gtest.h"
@@ -139,3 +141,113 @@ TEST(Theme, basic) {
     }
   }
 }
+
+static uint8_t* gen_many_styles(uint32_t types_nr, uint32_t* size) {
+  ThemeGen g;
+  wbuffer_t wbuffer;
+  uint8_t* data = NULL;
+
+  for (uint32_t i = 0; i < types_nr; i++) {
+    char type[32];
+    snprintf(type, sizeof(type), "widget_%u", i);
+    for (uint32_t state = 0; state_names[state] != NULL; state++) {
+      Style s(type, TK_DEFAULT_STYLE, state_names[state]);
+      s.AddValue(STYLE_ID_FONT_SIZE, (int32_t)(i * 10 + state));
+      g.AddStyle(s);
+    }
+  }
+
+  /*重复的项，返回第一个*/
+  Style dup("widget_0", TK_DEFAULT_STYLE, WIDGET_STATE_NORMAL);
+  dup.AddValue(STYLE_ID_FONT_SIZE, (int32_t)-1);
+  g.AddStyle(dup);
+
+  wbuffer_init_extendable(&wbuffer);
+  g.Output(&wbuffer);
+  data = (uint8_t*)TKMEM_ALLOC(wbuffer.cursor);
+  memcpy(data, wbuffer.data, wbuffer.cursor);
+  *size = wbuffer.cursor;
+  wbuffer_deinit(&wbuffer);
+
+  return data;
+}
+
+TEST(Theme, index) {
+  uint32_t size = 0;
+  uint32_t types_nr = 500;
+  uint8_t* data = gen_many_styles(types_nr, &size);
+  theme_t* t = theme_default_create(data);
+  theme_t linear;
+
+  memset(&linear, 0x00, sizeof(linear));
+  linear.data = data;
+
+  for (uint32_t i = 0; i < types_nr; i++) {
+    char type[32];
+    snprintf(type, sizeof(type), "widget_%u", i);
+    for (uint32_t state = 0; state_names[state] != NULL; state++) {
+      const uint8_t* s = theme_find_style(t, type, NULL, state_names[state]);
+      ASSERT_TRUE(s != NULL);
+      ASSERT_EQ(s, theme_find_style(&linear, type, TK_DEFAULT_STYLE, state_names[state]));
+      ASSERT_EQ(style_data_get_int(s, STYLE_ID_FONT_SIZE, 0), (int32_t)(i * 10 + state));
+    }
+  }
+
+  ASSERT_TRUE(theme_find_style(t, "widget_0", "other", WIDGET_STATE_NORMAL) == NULL);
+  ASSERT_TRUE(theme_find_style(t, "widget_x", NULL, WIDGET_STATE_NORMAL) == NULL);
+  ASSERT_TRUE(theme_find_style(t, "widget_0", NULL, WIDGET_STATE_CHECKED) == NULL);
+  ASSERT_TRUE(theme_find_style(t, NULL, NULL, WIDGET_STATE_NORMAL) == NULL);
+  ASSERT_TRUE(theme_find_style(t, "widget_0", NULL, NULL) == NULL);
+
+  /*重新设置数据后重建索引*/
+  ASSERT_EQ(theme_set_theme_data(t, data), RET_OK);
+  ASSERT_TRUE(theme_find_style(t, "widget_7", NULL, WIDGET_STATE_OVER) != NULL);
+
+  theme_destroy(t);
+  TKMEM_FREE(data);
+}
+
+/*
+ * 性能对比(缺省不运行)：
+ * ./bin/runTest --gtest_filter=Theme.DISABLED_benchmark --gtest_also_run_disabled_tests
+ */
+TEST(Theme, DISABLED_benchmark) {
+  uint32_t n = 0;
+  uint32_t size = 0;
+  uint32_t types_nr = 500;
+  uint32_t times = 200000;
+  const uint8_t* found = NULL;
+  uint8_t* data = gen_many_styles(types_nr, &size);
+  theme_t* t = theme_default_create(data);
+  theme_t linear;
+  uint64_t start = 0;
+  double indexed_ns = 0;
+  double linear_ns = 0;
+
+  memset(&linear, 0x00, sizeof(linear));
+  linear.data = data;
+
+  start = time_now_us();
+  for (n = 0; n < times; n++) {
+    char type[32];
+    snprintf(type, sizeof(type), "widget_%u", (n * 7919) % types_nr);
+    found = theme_find_style(t, type, NULL, state_names[n % 5]);
+  }
+  indexed_ns = (double)(time_now_us() - start) * 1000.0 / times;
+  ASSERT_TRUE(found != NULL);
+
+  start = time_now_us();
+  for (n = 0; n < times / 100; n++) {
+    char type[32];
+    snprintf(type, sizeof(type), "widget_%u", (n * 7919) % types_nr);
+    found = theme_find_style(&linear, type, NULL, state_names[n % 5]);
+  }
+  linear_ns = (double)(time_now_us() - start) * 1000.0 / (times / 100);
+  ASSERT_TRUE(found != NULL);
+
+  printf("theme items=%u: indexed %.1fns linear %.1fns per lookup\n",
+         ((const theme_header_t*)data)->nr, indexed_ns, linear_ns);
+
+  theme_destroy(t);
+  TKMEM_FREE(data);
+}
@@ -0,0 +1,184 @@
+#include "base/idle.h"
+#include "base/canvas.h"
+#include "base/widget.h"
+#include "base/dirty_rects.h"
+#include "base/font_manager.h"
+#include "base/window_manager.h"
+#include "base/widget_layer_cache.h"
+#include "native_window/native_window_raw.h"
+#include "window_manager/window_manager_default.h"
+#include "gauge/gauge_pointer.h"
+#include "widgets/view.h"
+#include "lcd_log.h"
+#include "gtest/gtest.h"
+
+#include <string>
+
+using std::string;
+
+/*离线画布需要原生窗口，测试环境中没有，临时创建一个*/
+class WidgetLayerCacheTest : public testing::Test {
+ protected:
+  virtual void SetUp() {
+    static lcd_t* s_lcd = NULL;
+    window_manager_default_t* wm = WINDOW_MANAGER_DEFAULT(window_manager());
+
+    if (s_lcd == NULL) {
+      s_lcd = lcd_log_init(800, 600);
+      native_window_raw_init(s_lcd);
+    }
+
+    this->lcd = lcd_log_init(800, 600);
+    font_manager_init(&(this->font_manager), NULL);
+    canvas_init(&(this->c), this->lcd, &(this->font_manager));
+    wm->native_window = native_window_create(window_manager());
+  }
+
+  virtual void TearDown() {
+    window_manager_default_t* wm = WINDOW_MANAGER_DEFAULT(window_manager());
+
+    wm->native_window = NULL;
+    canvas_reset(&(this->c));
+    font_manager_deinit(&(this->font_manager));
+    lcd_destroy(this->lcd);
+  }
+
+  void Paint(widget_t* widget) {
+    dirty_rects_t dr;
+    rect_t r = rect_init(0, 0, 800, 600);
+
+    lcd_log_reset(this->lcd);
+    dirty_rects_init(&dr);
+    dirty_rects_add(&dr, &r);
+    canvas_begin_frame(&(this->c), &dr, LCD_DRAW_NORMAL);
+    widget_paint(widget, &(this->c));
+    canvas_end_frame(&(this->c));
+  }
+
+  const string& Commands(void) {
+    return lcd_log_get_commands(this->lcd);
+  }
+
+  canvas_t c;
+  lcd_t* lcd;
+  font_manager_t font_manager;
+};
+
+static ret_t on_before_paint(void* ctx, event_t* e) {
+  (*(uint32_t*)ctx)++;
+
+  return RET_OK;
+}
+
+TEST_F(WidgetLayerCacheTest, paint) {
+  uint32_t painted = 0;
+  widget_t* container = view_create(NULL, 0, 0, 800, 600);
+  widget_t* group = view_create(container, 10, 10, 200, 100);
+  widget_t* child = view_create(group, 10, 10, 50, 50);
+  uint32_t size = (200 + 8) * (100 + 8) * 4;
+  string blit = "dg(0,0,208,108,6,6,208,108);";
+
+  widget_on(child, EVT_BEFORE_PAINT, on_before_paint, &painted);
+  ASSERT_EQ(widget_set_prop_bool(group, WIDGET_PROP_CACHE_AS_BITMAP, TRUE), RET_OK);
+  ASSERT_TRUE(widget_get_prop_bool(group, WIDGET_PROP_CACHE_AS_BITMAP, FALSE));
+
+  /*第一次绘制到缓存中*/
+  Paint(container);
+  ASSERT_EQ(painted, 1u);
+  ASSERT_TRUE(group->with_layer_cache);
+  ASSERT_EQ(widget_layer_cache_get_size(), size);
+  ASSERT_NE(Commands().find(blit), string::npos);
+
+  /*没有变化时直接绘制缓存的位图*/
+  Paint(container);
+  Paint(container);
+  ASSERT_EQ(painted, 1u);
+  ASSERT_EQ(Commands(), string("bf();") + blit + "ef();");
+
+  /*子控件变化后重新绘制*/
+  widget_invalidate(child, NULL);
+  Paint(container);
+  ASSERT_EQ(painted, 2u);
+  Paint(container);
+  ASSERT_EQ(painted, 2u);
+
+  /*不透明度在绘制缓存时才使用，改变时不用重新绘制缓存*/
+  widget_set_opacity(group, 0x80);
+  ASSERT_TRUE(group->dirty);
+  Paint(container);
+  Paint(container);
+  ASSERT_EQ(painted, 2u);
+  ASSERT_EQ(group->opacity, 0x80);
+
+  /*大小改变后重新创建缓存*/
+  widget_resize(group, 100, 100);
+  Paint(container);
+  ASSERT_EQ(painted, 3u);
+  ASSERT_EQ(widget_layer_cache_get_size(), (100u + 8) * (100 + 8) * 4);
+
+  ASSERT_EQ(widget_set_cache_as_bitmap(group, FALSE), RET_OK);
+  ASSERT_FALSE(group->with_layer_cache);
+  ASSERT_EQ(widget_layer_cache_get_size(), 0u);
+  Paint(container);
+  Paint(container);
+  ASSERT_EQ(painted, 5u);
+
+  widget_destroy(container);
+  idle_dispatch();
+}
+
+TEST_F(WidgetLayerCacheTest, lru) {
+  widget_t* container = view_create(NULL, 0, 0, 800, 600);
+  widget_t* group1 = view_create(container, 10, 10, 200, 100);
+  widget_t* group2 = view_create(container, 10, 200, 200, 100);
+  uint32_t size = (200 + 8) * (100 + 8) * 4;
+
+  widget_set_cache_as_bitmap(group1, TRUE);
+  widget_set_cache_as_bitmap(group2, TRUE);
+
+  Paint(container);
+  ASSERT_TRUE(group1->with_layer_cache);
+  ASSERT_TRUE(group2->with_layer_cache);
+  ASSERT_EQ(widget_layer_cache_get_size(), 2 * size);
+
+  /*超出上限时淘汰最久没有使用的*/
+  ASSERT_EQ(widget_layer_cache_set_max_size(size + 100), RET_OK);
+  ASSERT_FALSE(group1->with_layer_cache);
+  ASSERT_TRUE(group2->with_layer_cache);
+
+  Paint(container);
+  ASSERT_EQ(widget_layer_cache_get_size(), size);
+  ASSERT_TRUE(group2->with_layer_cache);
+  ASSERT_FALSE(group1->with_layer_cache);
+
+  /*比上限还大的控件不缓存*/
+  ASSERT_EQ(widget_layer_cache_set_max_size(size - 100), RET_OK);
+  ASSERT_EQ(widget_layer_cache_get_size(), 0u);
+  Paint(container);
+  ASSERT_EQ(widget_layer_cache_get_size(), 0u);
+
+  ASSERT_EQ(widget_layer_cache_set_max_size(TK_WIDGET_LAYER_CACHE_MAX_SIZE), RET_OK);
+  Paint(container);
+  ASSERT_EQ(widget_layer_cache_get_size(), 2 * size);
+
+  /*销毁控件时删除缓存*/
+  widget_destroy(container);
+  idle_dispatch();
+  ASSERT_EQ(widget_layer_cache_get_size(), 0u);
+}
+
+TEST_F(WidgetLayerCacheTest, draw_outside) {
+  widget_t* container = view_create(NULL, 0, 0, 800, 600);
+  widget_t* group = view_create(container, 10, 10, 200, 100);
+
+  widget_set_cache_as_bitmap(group, TRUE);
+  gauge_pointer_create(group, 0, 0, 20, 100);
+
+  /*子控件可能绘制到控件外面，不缓存*/
+  Paint(container);
+  ASSERT_FALSE(group->with_layer_cache);
+  ASSERT_EQ(widget_layer_cache_get_size(), 0u);
+
+  widget_destroy(container);
+  idle_dispatch();
+}
@@ -0,0 +1,233 @@
+﻿#include "tkc/atom.h"
+#include "tkc/utils.h"
+#include "tkc/time_now.h"
+#include "base/idle.h"
+#include "base/widget.h"
+#include "base/window.h"
+#include "base/window_base.h"
+#include "base/widget_name_index.h"
+#include "widgets/view.h"
+#include "widgets/button.h"
+#include "gtest/gtest.h"
+
+/*与widget_lookup(recursive=TRUE)原来的实现相同，用于对比*/
+static widget_t* lookup_by_traversal(widget_t* widget, const char* name) {
+  WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
+  if (tk_str_eq(iter->name, name)) {
+    return iter;
+  } else {
+    iter = lookup_by_traversal(iter, name);
+    if (iter != NULL) {
+      return iter;
+    }
+  }
+  WIDGET_FOR_EACH_CHILD_END();
+
+  return NULL;
+}
+
+TEST(WidgetNameIndex, basic) {
+  widget_t* root = view_create(NULL, 0, 0, 100, 100);
+  widget_t* a = view_create(root, 0, 0, 10, 10);
+  widget_t* b = button_create(root, 0, 0, 10, 10);
+  widget_t* a1 = button_create(a, 0, 0, 10, 10);
+  widget_name_index_t* index = widget_name_index_create();
+
+  widget_set_name(a, "a");
+  widget_set_name(b, "dup");
+  widget_set_name(a1, "dup");
+
+  ASSERT_EQ(widget_name_index_add(index, root), RET_OK);
+  ASSERT_EQ(widget_name_index_add(index, b), RET_OK);
+  ASSERT_EQ(widget_name_index_add(index, a1), RET_OK);
+  ASSERT_EQ(widget_name_index_add(index, a), RET_OK);
+  ASSERT_EQ(widget_name_index_add(index, a), RET_OK);
+  ASSERT_EQ(widget_name_index_size(index), 3u);
+  ASSERT_EQ(widget_name_index_count(index, b->name), 2u);
+  ASSERT_EQ(widget_name_index_count(index, a->name), 1u);
+
+  /*名称重复时，返回先序深度优先遍历先遇到的控件*/
+  ASSERT_EQ(widget_name_index_find(index, root, b->name, TRUE), a1);
+  ASSERT_EQ(widget_name_index_find(index, root, b->name, FALSE), b);
+  ASSERT_EQ(widget_name_index_find(index, a, b->name, TRUE), a1);
+  ASSERT_EQ(widget_name_index_find(index, a1, b->name, TRUE), (widget_t*)NULL);
+  ASSERT_EQ(widget_name_index_find(index, root, a->name, TRUE), a);
+  ASSERT_EQ(widget_name_index_find(index, a, a->name, TRUE), (widget_t*)NULL);
+
+  ASSERT_EQ(widget_name_index_remove(index, a1, a1->name), RET_OK);
+  ASSERT_EQ(widget_name_index_remove(index, a1, a1->name), RET_NOT_FOUND);
+  ASSERT_EQ(widget_name_index_find(index, root, b->name, TRUE), b);
+  ASSERT_EQ(widget_name_index_size(index), 2u);
+
+  widget_name_index_destroy(index);
+  widget_destroy(root);
+  idle_dispatch();
+}
+
+TEST(WidgetNameIndex, window) {
+  char name[32];
+  uint32_t i = 0;
+  widget_t* win = window_create(NULL, 0, 0, 400, 300);
+  widget_t* group = view_create(win, 0, 0, 100, 100);
+  widget_t* btn = NULL;
+
+  for (i = 0; i < 100; i++) {
+    tk_snprintf(name, sizeof(name), "b%u", i);
+    btn = button_create(i % 2 ? group : win, 0, 0, 10, 10);
+    widget_set_name(btn, name);
+  }
+  widget_set_name(group, "group");
+
+  ASSERT_TRUE(WINDOW_BASE(win)->name_index == NULL);
+  ASSERT_EQ(widget_lookup(win, "b1", TRUE), lookup_by_traversal(win, "b1"));
+  ASSERT_TRUE(WINDOW_BASE(win)->name_index != NULL);
+  ASSERT_EQ(widget_name_index_size(WINDOW_BASE(win)->name_index), 101u);
+
+  for (i = 0; i < 100; i++) {
+    tk_snprintf(name, sizeof(name), "b%u", i);
+    ASSERT_EQ(widget_lookup(win, name, TRUE), lookup_by_traversal(win, name));
+    ASSERT_EQ(widget_lookup(group, name, TRUE), i % 2 ? lookup_by_traversal(group, name) : NULL);
+    ASSERT_EQ(widget_lookup(win, name, FALSE), i % 2 ? NULL : lookup_by_traversal(win, name));
+  }
+
+  /*修改名称*/
+  btn = widget_lookup(win, "b3", TRUE);
+  widget_set_name(btn, "renamed");
+  ASSERT_EQ(widget_lookup(win, "b3", TRUE), (widget_t*)NULL);
+  ASSERT_EQ(widget_lookup(win, "renamed", TRUE), btn);
+
+  /*名称重复：group在前面，所以group中的控件先找到*/
+  btn = widget_lookup(win, "b0", TRUE);
+  widget_set_name(btn, "dup");
+  widget_set_name(widget_lookup(win, "b5", TRUE), "dup");
+  ASSERT_EQ(widget_lookup(win, "dup", TRUE), widget_lookup(group, "dup", TRUE));
+  ASSERT_EQ(widget_lookup(win, "dup", TRUE), lookup_by_traversal(win, "dup"));
+  ASSERT_EQ(widget_lookup(win, "dup", FALSE), btn);
+  widget_restack(group, 1000);
+  ASSERT_EQ(widget_lookup(win, "dup", TRUE), lookup_by_traversal(win, "dup"));
+  ASSERT_EQ(widget_lookup(win, "dup", TRUE)->parent, win);
+
+  /*删除和增加控件*/
+  btn = widget_lookup(win, "dup", TRUE);
+  widget_remove_child(win, btn);
+  ASSERT_EQ(widget_lookup(win, "dup", TRUE), widget_lookup(group, "dup", TRUE));
+  widget_add_child(group, btn);
+  ASSERT_EQ(widget_lookup(win, "dup", TRUE), lookup_by_traversal(win, "dup"));
+  widget_destroy(group);
+  ASSERT_EQ(widget_lookup(win, "dup", TRUE), (widget_t*)NULL);
+  ASSERT_EQ(widget_lookup(win, "b1", TRUE), (widget_t*)NULL);
+  ASSERT_EQ(widget_lookup(win, "b2", TRUE), lookup_by_traversal(win, "b2"));
+  /*b0(dup)移到了group中，剩下49个*/
+  ASSERT_EQ(widget_name_index_size(WINDOW_BASE(win)->name_index), 49u);
+
+  widget_destroy(win);
+  idle_dispatch();
+}
+
+TEST(WidgetNameIndex, path) {
+  char name[32];
+  uint32_t i = 0;
+  widget_t* win = window_create(NULL, 0, 0, 400, 300);
+  widget_t* btn = NULL;
+
+  for (i = 0; i < 40; i++) {
+    widget_t* group = view_create(win, 0, 0, 100, 100);
+
+    tk_snprintf(name, sizeof(name), "g%u", i);
+    widget_set_name(group, name);
+    btn = button_create(group, 0, 0, 10, 10);
+    widget_set_name(btn, "ok");
+  }
+
+  /*逐级查找(比如fscript中的a.b.c)，子控件多时也通过索引*/
+  btn = widget_get_child(widget_get_child(win, 7), 0);
+  ASSERT_EQ(widget_child(widget_child(win, "g7"), "ok"), btn);
+  ASSERT_EQ(widget_child(win, "ok"), (widget_t*)NULL);
+  ASSERT_TRUE(WINDOW_BASE(win)->name_index != NULL);
+
+  widget_set_name(widget_get_child(win, 9), "g7");
+  ASSERT_EQ(widget_child(win, "g7"), widget_get_child(win, 7));
+  widget_restack(widget_get_child(win, 9), 0);
+  ASSERT_EQ(widget_child(win, "g7"), widget_get_child(win, 0));
+  ASSERT_EQ(widget_lookup(win, "ok", TRUE), widget_get_child(widget_get_child(win, 0), 0));
+
+  widget_destroy(win);
+  idle_dispatch();
+}
+
+TEST(WidgetNameIndex, same_name) {
+  uint32_t i = 0;
+  widget_t* win = window_create(NULL, 0, 0, 400, 300);
+
+  /*列表项中的控件使用相同的名称，绑定每一项时在列表项中查找*/
+  for (i = 0; i < 200; i++) {
+    widget_t* item = view_create(win, 0, 0, 100, 100);
+    widget_t* title = button_create(item, 0, 0, 10, 10);
+
+    widget_set_name(title, "title");
+  }
+
+  ASSERT_EQ(widget_lookup(win, "title", TRUE), lookup_by_traversal(win, "title"));
+  ASSERT_TRUE(WINDOW_BASE(win)->name_index != NULL);
+  ASSERT_EQ(widget_name_index_count(WINDOW_BASE(win)->name_index, tk_atom_find("title")), 200u);
+
+  for (i = 0; i < 200; i++) {
+    widget_t* item = widget_get_child(win, i);
+    ASSERT_EQ(widget_lookup(item, "title", TRUE), widget_get_child(item, 0));
+  }
+
+  widget_destroy(win);
+  idle_dispatch();
+}
+
+static widget_t* create_bench_window(uint32_t groups, uint32_t children) {
+  char name[32];
+  uint32_t i = 0;
+  uint32_t k = 0;
+  widget_t* win = window_create(NULL, 0, 0, 400, 300);
+
+  for (i = 0; i < groups; i++) {
+    widget_t* group = view_create(win, 0, 0, 100, 100);
+
+    for (k = 0; k < children; k++) {
+      widget_t* btn = button_create(group, 0, 0, 10, 10);
+      tk_snprintf(name, sizeof(name), "b%u_%u", i, k);
+      widget_set_name(btn, name);
+    }
+  }
+
+  return win;
+}
+
+/*性能对比(缺省不运行)： ./bin/runTest --gtest_filter=WidgetNameIndex.DISABLED_benchmark --gtest_also_run_disabled_tests*/
+TEST(WidgetNameIndex, DISABLED_benchmark) {
+  char name[32];
+  uint32_t i = 0;
+  uint32_t n = 10000;
+  uint64_t start = 0;
+  uint64_t traversal = 0;
+  uint64_t indexed = 0;
+  widget_t* found = NULL;
+  widget_t* win = create_bench_window(50, 20);
+
+  tk_snprintf(name, sizeof(name), "b%u_%u", 49, 19);
+  start = time_now_us();
+  for (i = 0; i < n; i++) {
+    found = lookup_by_traversal(win, name);
+  }
+  traversal = time_now_us() - start;
+  ASSERT_TRUE(found != NULL);
+
+  start = time_now_us();
+  for (i = 0; i < n; i++) {
+    found = widget_lookup(win, name, TRUE);
+  }
+  indexed = time_now_us() - start;
+  ASSERT_EQ(found, lookup_by_traversal(win, name));
+
+  log_debug("lookup in 1000 widgets: traversal=%uus index=%uus (%u times)\n", (uint32_t)traversal,
+            (uint32_t)indexed, n);
+
+  widget_destroy(win);
+  idle_dispatch();
+}
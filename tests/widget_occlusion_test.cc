@@ -0,0 +1,181 @@
+#include "tkc/mem.h"
+#include "base/window.h"
+#include "base/widget_vtable.h"
+#include "base/font_manager.h"
+#include "base/widget_occlusion.h"
+#include "widgets/view.h"
+#include "widgets/label.h"
+#include "lcd/lcd_mem_bgra8888.h"
+#include "gtest/gtest.h"
+
+#define OC_W 320
+#define OC_H 240
+
+/*窗口管理器没有原生窗口时，窗口的大小为0*/
+static widget_t* occlusion_test_create_window(void) {
+  widget_t* win = window_create(NULL, 0, 0, OC_W, OC_H);
+  widget_resize(win, OC_W, OC_H);
+
+  return win;
+}
+
+static ret_t on_before_paint(void* ctx, event_t* e) {
+  (*(uint32_t*)ctx)++;
+
+  return RET_OK;
+}
+
+static void occlusion_test_draw(widget_t* win, canvas_t* c, const rect_t* r) {
+  dirty_rects_t dr;
+
+  dirty_rects_init(&dr);
+  dirty_rects_add(&dr, r);
+  canvas_begin_frame(c, &dr, LCD_DRAW_OFFLINE);
+  widget_paint_with_clip(win, (rect_t*)r, c, widget_paint);
+  canvas_end_frame(c);
+}
+
+/*分别启用和禁用遮挡剔除绘制，结果应该完全相同*/
+static void occlusion_test_check(widget_t* win, canvas_t* c, uint8_t* fb, const rect_t* r) {
+  uint32_t size = OC_W * OC_H * 4;
+  uint8_t* expected = (uint8_t*)TKMEM_ALLOC(size);
+
+  widget_occlusion_set_enable(FALSE);
+  memset(fb, 0x00, size);
+  occlusion_test_draw(win, c, r);
+  memcpy(expected, fb, size);
+
+  widget_occlusion_set_enable(TRUE);
+  memset(fb, 0x00, size);
+  occlusion_test_draw(win, c, r);
+  ASSERT_EQ(memcmp(expected, fb, size), 0);
+
+  TKMEM_FREE(expected);
+}
+
+TEST(WidgetOcclusion, is_opaque) {
+  widget_t* win = occlusion_test_create_window();
+  widget_t* view = view_create(win, 0, 0, 100, 100);
+
+  widget_update_style(view);
+  ASSERT_FALSE(widget_is_opaque(view));
+
+  widget_set_style_color(view, "normal:bg_color", 0xff336699);
+  ASSERT_TRUE(widget_is_opaque(view));
+
+  /*style需要更新时不确定*/
+  widget_set_need_update_style(view);
+  ASSERT_FALSE(widget_is_opaque(view));
+  widget_update_style(view);
+
+  widget_set_opacity(view, 0x80);
+  ASSERT_FALSE(widget_is_opaque(view));
+  widget_set_opacity(view, 0xff);
+
+  widget_set_style_int(view, "normal:round_radius", 10);
+  ASSERT_FALSE(widget_is_opaque(view));
+  widget_set_style_int(view, "normal:round_radius", 2);
+  ASSERT_TRUE(widget_is_opaque(view));
+
+  widget_set_style_int(view, "normal:x_offset", 1);
+  ASSERT_FALSE(widget_is_opaque(view));
+  widget_set_style_int(view, "normal:x_offset", 0);
+
+  widget_set_style_color(view, "normal:bg_color", 0x80336699);
+  ASSERT_FALSE(widget_is_opaque(view));
+
+  widget_set_style_color(view, "normal:bg_color", 0xff336699);
+  widget_set_visible(view, FALSE);
+  ASSERT_FALSE(widget_is_opaque(view));
+
+  widget_destroy(win);
+}
+
+TEST(WidgetOcclusion, cull) {
+  canvas_t c;
+  uint32_t hidden_painted = 0;
+  uint32_t partial_painted = 0;
+  uint32_t size = OC_W * OC_H * 4;
+  rect_t all = rect_init(0, 0, OC_W, OC_H);
+  rect_t small = rect_init(30, 30, 20, 20);
+  uint8_t* fb = (uint8_t*)TKMEM_ALLOC(size);
+  lcd_t* lcd = lcd_mem_bgra8888_create_single_fb(OC_W, OC_H, fb);
+  widget_t* win = occlusion_test_create_window();
+  widget_t* hidden = label_create(win, 20, 20, 50, 50);
+  widget_t* partial = label_create(win, 150, 150, 100, 80);
+  widget_t* cover = view_create(win, 0, 0, 200, 200);
+  widget_t* top = label_create(win, 10, 10, 100, 30);
+
+  widget_set_text_utf8(hidden, "hidden");
+  widget_set_text_utf8(partial, "partial");
+  widget_set_text_utf8(top, "top");
+  widget_set_style_color(win, "normal:bg_color", 0xff336699);
+  widget_set_style_color(cover, "normal:bg_color", 0xff996633);
+  widget_on(hidden, EVT_BEFORE_PAINT, on_before_paint, &hidden_painted);
+  widget_on(partial, EVT_BEFORE_PAINT, on_before_paint, &partial_painted);
+  canvas_init(&c, lcd, font_manager());
+
+  occlusion_test_check(win, &c, fb, &all);
+  ASSERT_EQ(hidden_painted, 1u);
+  ASSERT_EQ(partial_painted, 2u);
+
+  widget_occlusion_reset_stats();
+  occlusion_test_draw(win, &c, &all);
+  ASSERT_EQ(hidden_painted, 1u);
+  ASSERT_EQ(partial_painted, 3u);
+  ASSERT_EQ(widget_occlusion_get_culled(), 1u);
+  ASSERT_EQ(widget_occlusion_get_saved_pixels(), 58u * 58u);
+
+  /*cover完全覆盖裁剪区*/
+  canvas_set_clip_rect(&c, &small);
+  ASSERT_TRUE(widget_occlusion_covers_clip(cover, &c));
+  canvas_set_clip_rect(&c, &all);
+  ASSERT_FALSE(widget_occlusion_covers_clip(cover, &c));
+
+  /*cover变成半透明后，下面的控件需要绘制*/
+  widget_set_style_color(cover, "normal:bg_color", 0x80996633);
+  occlusion_test_check(win, &c, fb, &small);
+  ASSERT_EQ(hidden_painted, 3u);
+
+  widget_set_style_color(cover, "normal:bg_color", 0xff996633);
+  widget_set_visible(top, FALSE);
+  occlusion_test_check(win, &c, fb, &small);
+  ASSERT_EQ(hidden_painted, 4u);
+
+  widget_occlusion_set_enable(TRUE);
+  widget_destroy(win);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+  TKMEM_FREE(fb);
+}
+
+TEST(WidgetOcclusion, many_children) {
+  canvas_t c;
+  uint32_t i = 0;
+  uint32_t painted = 0;
+  uint32_t size = OC_W * OC_H * 4;
+  rect_t all = rect_init(0, 0, OC_W, OC_H);
+  uint8_t* fb = (uint8_t*)TKMEM_ALLOC(size);
+  lcd_t* lcd = lcd_mem_bgra8888_create_single_fb(OC_W, OC_H, fb);
+  widget_t* win = occlusion_test_create_window();
+  widget_t* cover = NULL;
+
+  /*子控件很多时通过空间索引绘制*/
+  for (i = 0; i < 200; i++) {
+    widget_t* iter = view_create(win, (i % 20) * 16, (i / 20) * 24, 16, 24);
+    widget_set_style_color(iter, "normal:bg_color", 0xff000000 | (i * 0x010203));
+    widget_on(iter, EVT_BEFORE_PAINT, on_before_paint, &painted);
+  }
+  cover = view_create(win, 0, 0, OC_W, 120);
+  widget_set_style_color(cover, "normal:bg_color", 0xff996633);
+  canvas_init(&c, lcd, font_manager());
+
+  occlusion_test_check(win, &c, fb, &all);
+  ASSERT_TRUE(win->with_spatial_index);
+  ASSERT_EQ(painted, 200u + 100u);
+
+  widget_destroy(win);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+  TKMEM_FREE(fb);
+}
@@ -0,0 +1,126 @@
+#include "tkc/time_now.h"
+#include "base/widget.h"
+#include "base/window.h"
+#include "widgets/slider.h"
+#include "widgets/progress_bar.h"
+#include "base/widget_prop_ids.h"
+#include "gtest/gtest.h"
+#include <string>
+
+using std::string;
+
+TEST(WidgetPropIds, all) {
+  uint32_t i = 0;
+
+  ASSERT_TRUE(widget_prop_name_from_id(WIDGET_PROP_ID_NONE) == NULL);
+  ASSERT_TRUE(widget_prop_name_from_id(WIDGET_PROP_ID_NR) == NULL);
+
+  for (i = WIDGET_PROP_ID_NONE + 1; i < WIDGET_PROP_ID_NR; i++) {
+    const char* name = widget_prop_name_from_id((widget_prop_id_t)i);
+    string copy(name);
+
+    ASSERT_TRUE(name != NULL);
+    ASSERT_EQ(widget_prop_id_from_name(name), (widget_prop_id_t)i);
+    /*不是同一个字符串常量时按内容比较*/
+    ASSERT_EQ(widget_prop_id_from_name(copy.c_str()), (widget_prop_id_t)i);
+  }
+
+  ASSERT_EQ(widget_prop_id_from_name(WIDGET_PROP_X), WIDGET_PROP_ID_X);
+  ASSERT_EQ(widget_prop_id_from_name(WIDGET_PROP_VALUE), WIDGET_PROP_ID_VALUE);
+  ASSERT_EQ(widget_prop_id_from_name(NULL), WIDGET_PROP_ID_NONE);
+  ASSERT_EQ(widget_prop_id_from_name(""), WIDGET_PROP_ID_NONE);
+  ASSERT_EQ(widget_prop_id_from_name("xx"), WIDGET_PROP_ID_NONE);
+  ASSERT_EQ(widget_prop_id_from_name("value1"), WIDGET_PROP_ID_NONE);
+  ASSERT_EQ(widget_prop_id_from_name("animate.value"), WIDGET_PROP_ID_NONE);
+}
+
+TEST(WidgetPropIds, desc) {
+  value_t v;
+  widget_t* w = window_create(NULL, 0, 0, 400, 300);
+  widget_t* p = progress_bar_create(w, 0, 0, 100, 20);
+  widget_t* s = slider_create(w, 0, 20, 100, 20);
+
+  /*progress_bar只使用属性描述*/
+  ASSERT_EQ(widget_set_prop_int(p, WIDGET_PROP_VALUE, 30), RET_OK);
+  ASSERT_EQ(widget_get_prop_int(p, WIDGET_PROP_VALUE, 0), 30);
+  ASSERT_EQ(widget_set_prop_str(p, "format", "%d%%"), RET_OK);
+  ASSERT_EQ(string(widget_get_prop_str(p, WIDGET_PROP_FORMAT, "")), string("%d%%"));
+  ASSERT_EQ(widget_set_prop_bool(p, WIDGET_PROP_SHOW_TEXT, TRUE), RET_OK);
+  ASSERT_EQ(widget_get_prop_bool(p, WIDGET_PROP_SHOW_TEXT, FALSE), TRUE);
+  ASSERT_EQ(widget_get_prop_int(p, WIDGET_PROP_X, -1), 0);
+  ASSERT_EQ(widget_set_prop_int(p, "my_prop", 3), RET_OK);
+  ASSERT_EQ(widget_get_prop_int(p, "my_prop", 0), 3);
+
+  /*slider同时使用属性描述和set_prop/get_prop*/
+  ASSERT_EQ(widget_set_prop_int(s, WIDGET_PROP_MAX, 200), RET_OK);
+  ASSERT_EQ(widget_set_prop_int(s, WIDGET_PROP_VALUE, 150), RET_OK);
+  ASSERT_EQ(widget_get_prop_int(s, WIDGET_PROP_VALUE, 0), 150);
+  ASSERT_EQ(widget_set_prop_int(s, SLIDER_PROP_DRAGGER_SIZE, 20), RET_OK);
+  ASSERT_EQ(widget_get_prop_int(s, SLIDER_PROP_DRAGGER_SIZE, 0), 20);
+  ASSERT_EQ(widget_get_prop(s, WIDGET_PROP_INPUTING, &v), RET_OK);
+  ASSERT_EQ(value_bool(&v), FALSE);
+  ASSERT_EQ(string(widget_get_prop_str(s, WIDGET_PROP_TYPE, "")), string(WIDGET_TYPE_SLIDER));
+
+  widget_destroy(w);
+}
+
+static double bench_get_prop(widget_t* widget, const char* name, uint32_t times) {
+  value_t v;
+  uint32_t i = 0;
+  uint64_t start = time_now_us();
+
+  for (i = 0; i < times; i++) {
+    widget_get_prop(widget, name, &v);
+  }
+
+  return (double)(time_now_us() - start) * 1000.0 / times;
+}
+
+static double bench_set_prop(widget_t* widget, const char* name, uint32_t times) {
+  value_t v;
+  uint32_t i = 0;
+  uint64_t start = time_now_us();
+
+  for (i = 0; i < times; i++) {
+    value_set_int(&v, i & 0x3f);
+    widget_set_prop(widget, name, &v);
+  }
+
+  return (double)(time_now_us() - start) * 1000.0 / times;
+}
+
+/*
+ * 性能对比(缺省不运行)：
+ * ./bin/runTest --gtest_filter=WidgetPropIds.DISABLED_benchmark --gtest_also_run_disabled_tests
+ * 每一项输出两个结果：使用WIDGET_PROP_*常量/使用复制的名称。
+ */
+TEST(WidgetPropIds, DISABLED_benchmark) {
+  uint32_t i = 0;
+  uint32_t times = 1000000;
+  widget_t* w = window_create(NULL, 0, 0, 400, 300);
+  widget_t* p = progress_bar_create(w, 0, 0, 100, 20);
+  widget_t* s = slider_create(w, 0, 20, 100, 20);
+  const char* consts[] = {WIDGET_PROP_X, WIDGET_PROP_POINTER_CURSOR, WIDGET_PROP_VALUE,
+                          WIDGET_PROP_REVERSE, WIDGET_PROP_STATE_FOR_STYLE};
+  /*复制的名称(比如从XML中解析出来的)，不能按地址比较*/
+  string copies[] = {WIDGET_PROP_X, WIDGET_PROP_POINTER_CURSOR, WIDGET_PROP_VALUE,
+                     WIDGET_PROP_REVERSE, WIDGET_PROP_STATE_FOR_STYLE};
+
+  for (i = 0; i < ARRAY_SIZE(consts); i++) {
+    const char* name = consts[i];
+    const char* copy = copies[i].c_str();
+    printf("%-16s get: progress_bar %.1fns/%.1fns slider %.1fns/%.1fns\n", name,
+           bench_get_prop(p, name, times), bench_get_prop(p, copy, times),
+           bench_get_prop(s, name, times), bench_get_prop(s, copy, times));
+  }
+
+  for (i = 0; i < 3; i++) {
+    const char* name = consts[i];
+    const char* copy = copies[i].c_str();
+    printf("%-16s set: progress_bar %.1fns/%.1fns slider %.1fns/%.1fns\n", name,
+           bench_set_prop(p, name, times / 10), bench_set_prop(p, copy, times / 10),
+           bench_set_prop(s, name, times / 10), bench_set_prop(s, copy, times / 10));
+  }
+
+  widget_destroy(w);
+}
@@ -0,0 +1,236 @@
+﻿#include "base/idle.h"
+#include "base/canvas.h"
+#include "base/widget.h"
+#include "base/layout.h"
+#include "base/dirty_rects.h"
+#include "base/font_manager.h"
+#include "base/self_layouter.h"
+#include "base/widget_spatial_index.h"
+#include "tkc/time_now.h"
+#include "widgets/view.h"
+#include "lcd_log.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using std::vector;
+
+#define CHILDREN_NR 400
+
+static widget_t* create_container(void) {
+  uint32_t i = 0;
+  widget_t* container = view_create(NULL, 0, 0, 800, 800);
+
+  /*20x20个子控件，每隔7个放一个跨越多个网格的大控件*/
+  for (i = 0; i < CHILDREN_NR; i++) {
+    xy_t x = (i % 20) * 40;
+    xy_t y = (i / 20) * 40;
+
+    if (i % 7 == 0) {
+      view_create(container, x - 30, y - 30, 100, 90);
+    } else {
+      view_create(container, x, y, 30, 30);
+    }
+  }
+
+  return container;
+}
+
+/*与没有空间索引时相同的查找方法，用于对比*/
+static widget_t* find_target_by_traversal(widget_t* widget, xy_t x, xy_t y) {
+  WIDGET_FOR_EACH_CHILD_BEGIN_R(widget, iter, i)
+  if (iter->sensitive && iter->enable && widget_is_point_in(iter, x - iter->x, y - iter->y, TRUE)) {
+    return iter;
+  }
+  WIDGET_FOR_EACH_CHILD_END();
+
+  return NULL;
+}
+
+static void check_find_target(widget_t* container) {
+  xy_t x = 0;
+  xy_t y = 0;
+
+  for (y = -50; y < 850; y += 7) {
+    for (x = -50; x < 850; x += 11) {
+      ASSERT_EQ(widget_find_target(container, x, y), find_target_by_traversal(container, x, y));
+    }
+  }
+}
+
+TEST(WidgetSpatialIndex, find_target) {
+  uint32_t i = 0;
+  widget_t* container = create_container();
+
+  check_find_target(container);
+  ASSERT_TRUE(container->with_spatial_index);
+
+  /*移动/改变大小后增量更新*/
+  for (i = 0; i < CHILDREN_NR; i += 3) {
+    widget_t* iter = widget_get_child(container, i);
+    widget_move_resize(iter, 790 - iter->x, iter->y + 13, iter->w + (i % 5) * 20, iter->h);
+  }
+  check_find_target(container);
+
+  /*调整顺序、删除和增加子控件后重建*/
+  widget_restack(widget_get_child(container, 0), CHILDREN_NR);
+  widget_destroy(widget_get_child(container, 5));
+  view_create(container, 100, 100, 200, 200);
+  check_find_target(container);
+  ASSERT_TRUE(container->with_spatial_index);
+
+  widget_set_enable(widget_get_child(container, 10), FALSE);
+  check_find_target(container);
+
+  widget_destroy(container);
+  idle_dispatch();
+}
+
+/*与label/button一样，在auto_adjust_size中直接修改大小*/
+static ret_t grow_auto_adjust_size(widget_t* widget) {
+  widget->w = 200;
+  widget->h = 150;
+
+  return RET_OK;
+}
+
+TEST(WidgetSpatialIndex, auto_adjust_size) {
+  widget_vtable_t vt;
+  widget_t* container = create_container();
+  widget_t* child = widget_get_child(container, 200);
+  const widget_vtable_t* old_vt = child->vt;
+  rect_t area = rect_init(0, 0, container->w, container->h);
+
+  check_find_target(container);
+  ASSERT_TRUE(container->with_spatial_index);
+
+  vt = *old_vt;
+  vt.auto_adjust_size = grow_auto_adjust_size;
+  child->vt = &vt;
+
+  /*没有self_layouter*/
+  ASSERT_EQ(self_layouter_layout(NULL, child, &area), RET_FAIL);
+  ASSERT_EQ(child->w, 200);
+  check_find_target(container);
+
+  /*缺省的self_layouter先设置layout计算的大小，再调用auto_adjust_size*/
+  widget_set_self_layout_params(child, "10", "20", "30", "30");
+  ASSERT_EQ(widget_layout_self(child), RET_OK);
+  ASSERT_EQ(child->x, 10);
+  ASSERT_EQ(child->h, 150);
+  check_find_target(container);
+
+  child->vt = old_vt;
+  widget_destroy(container);
+  idle_dispatch();
+}
+
+static ret_t on_before_paint(void* ctx, event_t* e) {
+  vector<widget_t*>* painted = (vector<widget_t*>*)ctx;
+  painted->push_back(WIDGET(e->target));
+
+  return RET_OK;
+}
+
+static void check_paint(widget_t* container, canvas_t* c, const rect_t* r) {
+  dirty_rects_t dr;
+  vector<widget_t*> painted;
+  vector<widget_t*> expected;
+
+  dirty_rects_init(&dr);
+  dirty_rects_add(&dr, r);
+  canvas_begin_frame(c, &dr, LCD_DRAW_NORMAL);
+
+  WIDGET_FOR_EACH_CHILD_BEGIN(container, iter, i)
+  int32_t t = container->dirty_rect_tolerance;
+  if (iter->visible && canvas_is_rect_in_clip_rect(c, iter->x - t, iter->y - t,
+                                                   iter->x + iter->w + t, iter->y + iter->h + t)) {
+    expected.push_back(iter);
+  }
+  widget_on(iter, EVT_BEFORE_PAINT, on_before_paint, &painted);
+  WIDGET_FOR_EACH_CHILD_END();
+
+  widget_paint(container, c);
+  canvas_end_frame(c);
+
+  WIDGET_FOR_EACH_CHILD_BEGIN(container, iter, i)
+  widget_off_by_func(iter, EVT_BEFORE_PAINT, on_before_paint, &painted);
+  WIDGET_FOR_EACH_CHILD_END();
+
+  ASSERT_EQ(painted.size(), expected.size());
+  ASSERT_TRUE(painted == expected);
+}
+
+TEST(WidgetSpatialIndex, paint) {
+  canvas_t c;
+  uint32_t i = 0;
+  font_manager_t font_manager;
+  lcd_t* lcd = lcd_log_init(800, 800);
+  widget_t* container = create_container();
+  rect_t rects[] = {rect_init(0, 0, 10, 10), rect_init(100, 100, 50, 50),
+                    rect_init(395, 0, 10, 800), rect_init(700, 700, 100, 100),
+                    rect_init(0, 0, 800, 800)};
+
+  font_manager_init(&font_manager, NULL);
+  canvas_init(&c, lcd, &font_manager);
+
+  for (i = 0; i < ARRAY_SIZE(rects); i++) {
+    check_paint(container, &c, rects + i);
+  }
+  ASSERT_TRUE(container->with_spatial_index);
+
+  widget_set_visible(widget_get_child(container, 44), FALSE);
+  widget_move(widget_get_child(container, 45), 600, 20);
+  widget_restack(widget_get_child(container, 46), 0);
+  for (i = 0; i < ARRAY_SIZE(rects); i++) {
+    check_paint(container, &c, rects + i);
+  }
+
+  widget_destroy(container);
+  idle_dispatch();
+  canvas_reset(&c);
+  font_manager_deinit(&font_manager);
+  lcd_destroy(lcd);
+}
+
+TEST(WidgetSpatialIndex, few_children) {
+  widget_t* container = view_create(NULL, 0, 0, 800, 800);
+
+  view_create(container, 0, 0, 10, 10);
+  ASSERT_TRUE(widget_spatial_index_get(container) == NULL);
+  ASSERT_EQ(widget_find_target(container, 5, 5), widget_get_child(container, 0));
+  ASSERT_FALSE(container->with_spatial_index);
+
+  widget_destroy(container);
+  idle_dispatch();
+}
+
+/*性能对比(缺省不运行)： ./bin/runTest --gtest_filter=WidgetSpatialIndex.DISABLED_benchmark --gtest_also_run_disabled_tests*/
+TEST(WidgetSpatialIndex, DISABLED_benchmark) {
+  uint32_t i = 0;
+  uint32_t n = 100000;
+  uint64_t start = 0;
+  uint64_t traversal = 0;
+  uint64_t indexed = 0;
+  widget_t* found = NULL;
+  widget_t* container = create_container();
+
+  start = time_now_us();
+  for (i = 0; i < n; i++) {
+    found = find_target_by_traversal(container, i % 800, (i * 7) % 800);
+  }
+  traversal = time_now_us() - start;
+
+  start = time_now_us();
+  for (i = 0; i < n; i++) {
+    found = widget_find_target(container, i % 800, (i * 7) % 800);
+  }
+  indexed = time_now_us() - start;
+  ASSERT_TRUE(found == find_target_by_traversal(container, (n - 1) % 800, ((n - 1) * 7) % 800));
+
+  log_debug("find_target in %u children: traversal=%uus index=%uus (%u times)\n", CHILDREN_NR,
+            (uint32_t)traversal, (uint32_t)indexed, n);
+
+  widget_destroy(container);
+  idle_dispatch();
+}
@@ -0,0 +1,163 @@
+#include "base/canvas.h"
+#include "base/system_info.h"
+#include "base/window_manager.h"
+#include "base/window_snapshot_pool.h"
+#include "lcd/lcd_mem_bgra8888.h"
+#include "native_window/native_window_raw.h"
+#include "window_manager/window_manager_default.h"
+#include "lcd_log.h"
+#include "gtest/gtest.h"
+
+/*离线画布需要原生窗口，测试环境中没有，临时创建一个*/
+class WindowSnapshotPoolTest : public testing::Test {
+ protected:
+  virtual void SetUp() {
+    static lcd_t* s_lcd = NULL;
+    window_manager_default_t* wm = WINDOW_MANAGER_DEFAULT(window_manager());
+
+    if (s_lcd == NULL) {
+      s_lcd = lcd_log_init(800, 600);
+      native_window_raw_init(s_lcd);
+    }
+
+    wm->native_window = native_window_create(window_manager());
+  }
+
+  virtual void TearDown() {
+    window_manager_default_t* wm = WINDOW_MANAGER_DEFAULT(window_manager());
+
+    window_snapshot_pool_clear();
+    wm->native_window = NULL;
+  }
+};
+
+static canvas_t* window_snapshot_pool_test_fill(const rect_t* r, color_t color) {
+  canvas_t* canvas = window_snapshot_pool_begin(800, 600, BITMAP_FMT_BGRA8888, r);
+
+  if (canvas != NULL) {
+    canvas_set_fill_color(canvas, color);
+    canvas_fill_rect(canvas, 0, 0, 800, 600);
+  }
+
+  return canvas;
+}
+
+static uint32_t window_snapshot_pool_test_get_pixel(bitmap_t* img, uint32_t x, uint32_t y) {
+  rgba_t rgba;
+
+  memset(&rgba, 0x00, sizeof(rgba));
+  bitmap_get_pixel(img, x, y, &rgba);
+
+  return (rgba.r << 24) | (rgba.g << 16) | (rgba.b << 8) | rgba.a;
+}
+
+TEST_F(WindowSnapshotPoolTest, reuse) {
+  bitmap_t img;
+  void* buffer = NULL;
+  rect_t r = rect_init(0, 0, 800, 600);
+  canvas_t* canvas = window_snapshot_pool_test_fill(&r, color_init(0xff, 0, 0, 0xff));
+
+  ASSERT_TRUE(canvas != NULL);
+  memset(&img, 0x00, sizeof(img));
+  ASSERT_EQ(window_snapshot_pool_end(canvas, &img), RET_OK);
+  ASSERT_EQ(img.w, 800u);
+  ASSERT_EQ(img.h, 600u);
+  ASSERT_EQ(img.format, BITMAP_FMT_BGRA8888);
+  ASSERT_TRUE((img.flags & BITMAP_FLAG_OPAQUE) != 0);
+  ASSERT_EQ(window_snapshot_pool_test_get_pixel(&img, 400, 300), 0xff0000ffu);
+  ASSERT_EQ(window_snapshot_pool_get_size(), 800u * 600 * 4);
+
+  /*释放后放回池中，下次截图使用同一个缓冲区*/
+  buffer = img.buffer;
+  ASSERT_EQ(bitmap_destroy(&img), RET_OK);
+  ASSERT_EQ(window_snapshot_pool_get_size(), 800u * 600 * 4);
+
+  canvas = window_snapshot_pool_test_fill(&r, color_init(0, 0xff, 0, 0xff));
+  ASSERT_EQ(window_snapshot_pool_end(canvas, &img), RET_OK);
+  ASSERT_EQ(img.buffer, buffer);
+  ASSERT_EQ(window_snapshot_pool_test_get_pixel(&img, 400, 300), 0x00ff00ffu);
+  ASSERT_EQ(bitmap_destroy(&img), RET_OK);
+  ASSERT_EQ(window_snapshot_pool_get_size(), 800u * 600 * 4);
+
+  /*大小不同时替换空闲的缓冲区*/
+  canvas = window_snapshot_pool_begin(600, 800, BITMAP_FMT_BGRA8888, &r);
+  ASSERT_TRUE(canvas != NULL);
+  ASSERT_EQ(window_snapshot_pool_end(canvas, &img), RET_OK);
+  ASSERT_EQ(img.w, 600u);
+  ASSERT_EQ(bitmap_destroy(&img), RET_OK);
+
+  ASSERT_EQ(window_snapshot_pool_clear(), RET_OK);
+  ASSERT_EQ(window_snapshot_pool_get_size(), 0u);
+}
+
+TEST_F(WindowSnapshotPoolTest, clear_only_rect) {
+  bitmap_t img;
+  rect_t all = rect_init(0, 0, 800, 600);
+  rect_t r = rect_init(0, 400, 800, 200);
+  canvas_t* canvas = window_snapshot_pool_test_fill(&all, color_init(0xff, 0, 0, 0xff));
+
+  memset(&img, 0x00, sizeof(img));
+  ASSERT_EQ(window_snapshot_pool_end(canvas, &img), RET_OK);
+  ASSERT_EQ(bitmap_destroy(&img), RET_OK);
+
+  /*只清除和绘制r所在的区域(如从底部弹出的popup)*/
+  canvas = window_snapshot_pool_begin(800, 600, BITMAP_FMT_BGRA8888, &r);
+  ASSERT_TRUE(canvas != NULL);
+  canvas_set_fill_color(canvas, color_init(0, 0, 0xff, 0xff));
+  canvas_fill_rect(canvas, 0, 0, 800, 500);
+  ASSERT_EQ(window_snapshot_pool_end(canvas, &img), RET_OK);
+
+  ASSERT_EQ(window_snapshot_pool_test_get_pixel(&img, 10, 450), 0x0000ffffu);
+  ASSERT_EQ(window_snapshot_pool_test_get_pixel(&img, 10, 550), 0u);
+  ASSERT_EQ(window_snapshot_pool_test_get_pixel(&img, 10, 10), 0xff0000ffu);
+  ASSERT_EQ(bitmap_destroy(&img), RET_OK);
+}
+
+TEST_F(WindowSnapshotPoolTest, busy) {
+  uint32_t i = 0;
+  bitmap_t imgs[TK_WINDOW_SNAPSHOT_POOL_MAX_NR + 1];
+  rect_t r = rect_init(0, 0, 800, 600);
+
+  /*池中的缓冲区都在使用时，创建新的位图*/
+  memset(imgs, 0x00, sizeof(imgs));
+  for (i = 0; i < ARRAY_SIZE(imgs); i++) {
+    canvas_t* canvas = window_snapshot_pool_test_fill(&r, color_init(0xff, 0, 0, 0xff));
+    ASSERT_TRUE(canvas != NULL);
+    ASSERT_EQ(window_snapshot_pool_end(canvas, imgs + i), RET_OK);
+    ASSERT_EQ(window_snapshot_pool_test_get_pixel(imgs + i, 0, 0), 0xff0000ffu);
+    if (i > 0) {
+      ASSERT_NE(imgs[i].buffer, imgs[i - 1].buffer);
+    }
+  }
+  ASSERT_EQ(window_snapshot_pool_get_size(), 800u * 600 * 4 * TK_WINDOW_SNAPSHOT_POOL_MAX_NR);
+
+  /*正在使用的缓冲区在释放位图时销毁*/
+  ASSERT_EQ(window_snapshot_pool_clear(), RET_OK);
+  ASSERT_EQ(window_snapshot_pool_get_size(), 800u * 600 * 4 * TK_WINDOW_SNAPSHOT_POOL_MAX_NR);
+  for (i = 0; i < ARRAY_SIZE(imgs); i++) {
+    ASSERT_EQ(bitmap_destroy(imgs + i), RET_OK);
+  }
+  ASSERT_EQ(window_snapshot_pool_get_size(), 0u);
+}
+
+TEST_F(WindowSnapshotPoolTest, format) {
+  system_info_t* info = system_info();
+  uint32_t lcd_w = info->lcd_w;
+  uint32_t lcd_h = info->lcd_h;
+  lcd_type_t lcd_type = info->lcd_type;
+  float_t ratio = info->device_pixel_ratio;
+  lcd_t* lcd = lcd_mem_bgra8888_create(80, 60, TRUE);
+
+#ifdef WITH_WINDOW_SNAPSHOT_RGB565
+  ASSERT_EQ(window_snapshot_pool_get_format(lcd), BITMAP_FMT_BGR565);
+#else
+  ASSERT_EQ(window_snapshot_pool_get_format(lcd), BITMAP_FMT_BGRA8888);
+#endif /*WITH_WINDOW_SNAPSHOT_RGB565*/
+
+  lcd_destroy(lcd);
+  /*lcd_mem会修改system_info中LCD的大小*/
+  system_info_set_lcd_w(info, lcd_w);
+  system_info_set_lcd_h(info, lcd_h);
+  system_info_set_lcd_type(info, lcd_type);
+  system_info_set_device_pixel_ratio(info, ratio);
+}
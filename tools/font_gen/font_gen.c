@@ -42,10 +42,15 @@ static int char_cmp(const void* a, const void* b) {
 
 ret_t font_gen(font_t* font, uint16_t font_size, const char* str, const char* output_filename,
                const char* theme) {
+  return font_gen_ex(font, font_size, GLYPH_FMT_ALPHA, str, output_filename, theme);
+}
+
+ret_t font_gen_ex(font_t* font, uint16_t font_size, glyph_format_t format, const char* str,
+                  const char* output_filename, const char* theme) {
   wbuffer_t wbuffer;
   wbuffer_init_extendable(&wbuffer);
 
-  uint32_t size = font_gen_buff(font, font_size, str, &wbuffer);
+  uint32_t size = font_gen_buff_ex(font, font_size, format, str, &wbuffer);
 
   if (strstr(output_filename, ".bin") != NULL) {
     file_write(output_filename, wbuffer.data, size);
@@ -58,10 +63,124 @@ ret_t font_gen(font_t* font, uint16_t font_size, const char* str, const char* ou
   return RET_OK;
 }
 
+static uint8_t font_gen_quantize(uint8_t a, uint32_t bits) {
+  uint32_t max = (1 << bits) - 1;
+
+  return (uint8_t)((a * max + 127) / 255);
+}
+
+static ret_t font_gen_encode_packed(const glyph_t* g, uint32_t bits, wbuffer_t* out) {
+  uint32_t i = 0;
+  uint32_t j = 0;
+  uint32_t ppb = 8 / bits;
+  uint32_t pitch = (g->w + ppb - 1) / ppb;
+
+  for (j = 0; j < g->h; j++) {
+    const uint8_t* row = g->data + j * g->w;
+
+    for (i = 0; i < pitch; i++) {
+      uint32_t k = 0;
+      uint8_t b = 0;
+
+      for (k = 0; k < ppb; k++) {
+        uint32_t x = i * ppb + k;
+        uint8_t v = x < g->w ? font_gen_quantize(row[x], bits) : 0;
+        b |= v << (8 - bits - k * bits);
+      }
+      wbuffer_write_uint8(out, b);
+    }
+  }
+
+  return RET_OK;
+}
+
+static uint32_t font_gen_rle_run(const uint8_t* row, uint32_t x, uint32_t w, uint8_t value) {
+  uint32_t n = 0;
+
+  while (x + n < w && n < GLYPH_RLE_MAX_COUNT && row[x + n] == value) {
+    n++;
+  }
+
+  return n;
+}
+
+static ret_t font_gen_encode_rle(const glyph_t* g, wbuffer_t* out) {
+  uint32_t j = 0;
+
+  for (j = 0; j < g->h; j++) {
+    uint32_t x = 0;
+    const uint8_t* row = g->data + j * g->w;
+
+    while (x < g->w) {
+      uint8_t v = row[x];
+
+      if (v == 0 || v == 0xff) {
+        uint32_t n = font_gen_rle_run(row, x, g->w, v);
+        uint8_t type = v == 0 ? GLYPH_RLE_TRANSPARENT : GLYPH_RLE_OPAQUE;
+
+        wbuffer_write_uint8(out, (type << 6) | (n - 1));
+        x += n;
+      } else {
+        /*连续两个以上的0或者0xff才单独成段，否则放在原始数据段中更省空间*/
+        uint32_t n = 1;
+        while (x + n < g->w && n < GLYPH_RLE_MAX_COUNT) {
+          uint8_t c = row[x + n];
+          if ((c == 0 || c == 0xff) && font_gen_rle_run(row, x + n, g->w, c) > 1) {
+            break;
+          }
+          n++;
+        }
+
+        wbuffer_write_uint8(out, (GLYPH_RLE_LITERAL << 6) | (n - 1));
+        wbuffer_write_binary(out, row + x, n);
+        x += n;
+      }
+    }
+  }
+
+  return RET_OK;
+}
+
+/*把A8字模编码成指定的格式，不能编码时保持A8*/
+static ret_t font_gen_encode_glyph(glyph_t* g, glyph_format_t format, wbuffer_t* out) {
+  if (g->format != GLYPH_FMT_ALPHA || g->data == NULL) {
+    return RET_NOT_IMPL;
+  }
+
+  switch (format) {
+    case GLYPH_FMT_A4: {
+      return_value_if_fail((g->w + 1) / 2 <= 0xff, RET_NOT_IMPL);
+      g->pitch = (g->w + 1) / 2;
+      g->format = GLYPH_FMT_A4;
+      return font_gen_encode_packed(g, 4, out);
+    }
+    case GLYPH_FMT_A2: {
+      return_value_if_fail((g->w + 3) / 4 <= 0xff, RET_NOT_IMPL);
+      g->pitch = (g->w + 3) / 4;
+      g->format = GLYPH_FMT_A2;
+      return font_gen_encode_packed(g, 2, out);
+    }
+    case GLYPH_FMT_RLE: {
+      g->pitch = 0;
+      g->format = GLYPH_FMT_RLE;
+      return font_gen_encode_rle(g, out);
+    }
+    default: {
+      return RET_NOT_IMPL;
+    }
+  }
+}
+
 uint32_t font_gen_buff(font_t* font, uint16_t font_size, const char* str, wbuffer_t* wbuffer) {
+  return font_gen_buff_ex(font, font_size, GLYPH_FMT_ALPHA, str, wbuffer);
+}
+
+uint32_t font_gen_buff_ex(font_t* font, uint16_t font_size, glyph_format_t format, const char* str,
+                          wbuffer_t* wbuffer) {
   int i = 0;
   glyph_t g;
   int size = 0;
+  wbuffer_t encoded;
   wchar_t wstr[MAX_CHARS];
   font_vmetrics_t vmetrics = font_get_vmetrics(font, font_size);
 
@@ -76,7 +195,9 @@ uint32_t font_gen_buff(font_t* font, uint16_t font_size, const char* str, wbuffe
   memset(header, 0, header_size);
   wbuffer_write_binary(wbuffer, header, header_size);
 
+  wbuffer_init_extendable(&encoded);
   header->char_nr = size;
+  header->format = format;
   header->font_size = (uint8_t)font_size;
   header->ascent = vmetrics.ascent;
   header->descent = vmetrics.descent;
@@ -92,8 +213,15 @@ uint32_t font_gen_buff(font_t* font, uint16_t font_size, const char* str, wbuffe
 
     printf("%d/%d: 0x%04x\n", i, size, c);
     if (font_get_glyph(font, c, font_size, &g) == RET_OK) {
+      const uint8_t* data = g.data;
       uint32_t data_size = (g.pitch ? g.pitch : g.w) * g.h;
 
+      encoded.cursor = 0;
+      if (font_gen_encode_glyph(&g, format, &encoded) == RET_OK) {
+        data = encoded.data;
+        data_size = encoded.cursor;
+      }
+
       wbuffer_write_uint16(wbuffer, g.x);
       wbuffer_write_uint16(wbuffer, g.y);
       wbuffer_write_uint16(wbuffer, g.w);
@@ -104,7 +232,7 @@ uint32_t font_gen_buff(font_t* font, uint16_t font_size, const char* str, wbuffe
 
       if (g.data != NULL) {
         header->index[i].size = data_size;
-        wbuffer_write_binary(wbuffer, g.data, data_size);
+        wbuffer_write_binary(wbuffer, data, data_size);
       }
 
       if (g.format == GLYPH_FMT_MONO) {
@@ -128,6 +256,7 @@ uint32_t font_gen_buff(font_t* font, uint16_t font_size, const char* str, wbuffe
   wbuffer->cursor = 0;
   wbuffer_write_binary(wbuffer, header, header_size);
   wbuffer->cursor = size;
+  wbuffer_deinit(&encoded);
   TKMEM_FREE(header);
 
   return size;
@@ -31,6 +31,12 @@ ret_t font_gen(font_t* font, uint16_t font_size, const char* str, const char* ou
                const char* theme);
 uint32_t font_gen_buff(font_t* font, uint16_t font_size, const char* str, wbuffer_t* wbuffer);
 
+/*format为GLYPH_FMT_A4/GLYPH_FMT_A2/GLYPH_FMT_RLE时，把A8字模压缩成相应的格式*/
+ret_t font_gen_ex(font_t* font, uint16_t font_size, glyph_format_t format, const char* str,
+                  const char* output_filename, const char* theme);
+uint32_t font_gen_buff_ex(font_t* font, uint16_t font_size, glyph_format_t format, const char* str,
+                          wbuffer_t* wbuffer);
+
 END_C_DECLS
 
 #endif /*FONT_GEN_H*/
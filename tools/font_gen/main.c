@@ -41,19 +41,29 @@ int wmain(int argc, wchar_t* argv[]) {
   const char* str_filename = NULL;
   const char* out_filename = NULL;
   const char* theme_name = NULL;
+  glyph_format_t format = GLYPH_FMT_ALPHA;
 
   platform_prepare();
 
   if (argc < 5) {
-    printf("Usage: %S ttf_filename str_filename out_filename font_size [mono]\n", argv[0]);
+    printf("Usage: %S ttf_filename str_filename out_filename font_size [mono|a4|a2|rle]\n",
+           argv[0]);
 
     return 0;
   }
 
   font_size = tk_watoi(argv[4]);
 
-  if (argc > 5 && tk_wstr_eq(argv[5], L"mono")) {
-    mono = TRUE;
+  if (argc > 5) {
+    if (tk_wstr_eq(argv[5], L"mono")) {
+      mono = TRUE;
+    } else if (tk_wstr_eq(argv[5], L"a4")) {
+      format = GLYPH_FMT_A4;
+    } else if (tk_wstr_eq(argv[5], L"a2")) {
+      format = GLYPH_FMT_A2;
+    } else if (tk_wstr_eq(argv[5], L"rle")) {
+      format = GLYPH_FMT_RLE;
+    }
   }
 
   str_t str_theme = {0};
@@ -100,7 +110,7 @@ int wmain(int argc, wchar_t* argv[]) {
   return_value_if_fail(str_buff != NULL, 0);
 
   if (font != NULL) {
-    font_gen(font, (uint16_t)font_size, str_buff, out_filename, theme_name);
+    font_gen_ex(font, (uint16_t)font_size, format, str_buff, out_filename, theme_name);
   }
 
   TKMEM_FREE(ttf_buff);
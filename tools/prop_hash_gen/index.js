@@ -0,0 +1,387 @@
+const fs = require('fs')
+const path = require('path')
+
+/*
+ * 从widget_consts.h中提取WIDGET_PROP_*，生成属性ID和完美哈希表。
+ * 哈希函数必须与生成的C代码(widget_prop_id_from_name)一致。
+ */
+const BOM = '﻿';
+const SEED_MAX = 0xffff;
+const KEY_LEN_MAX = 0xff;
+
+/*
+ * 最常用的属性。复制的名称(比如从XML中解析出来的)不能按地址缓存，
+ * 这些属性按首字符分支直接比较，不用计算哈希。
+ */
+const HOT_PROPS = ['X', 'Y', 'W', 'H', 'VALUE', 'TEXT', 'VISIBLE', 'ENABLE', 'CHECKED', 'NAME'];
+
+/*
+ * 哈希键只取长度和五个位置(0、1、n/2、n/2+n/4、n-1)的字符(类似gperf)，不需要遍历整个属性名。
+ * 生成时检查全部属性的键互不相同。
+ */
+function keyOf(str) {
+  const b = Buffer.from(str, 'utf8');
+  const n = b.length;
+
+  if (n === 0 || n > KEY_LEN_MAX) {
+    throw new Error(`invalid prop name: "${str}"`);
+  }
+
+  const c1 = n > 1 ? b[1] : 0;
+  const low = b[0] | (c1 << 8) | (b[n >> 1] << 16) | (b[n - 1] << 24);
+
+  return (low ^ Math.imul(n | (b[(n >> 1) + (n >> 2)] << 8), 0x9e3779b1)) >>> 0;
+}
+
+function bucketOf(key, bucketsBits) {
+  return Math.imul(key, 0x85ebca6b) >>> (32 - bucketsBits);
+}
+
+function slotOf(key, seed, slotsBits) {
+  return Math.imul((key ^ Math.imul(seed, 0x27d4eb2f)) >>> 0, 0xc2b2ae35) >>> (32 - slotsBits);
+}
+
+function parseProps(filename) {
+  const props = [];
+  const content = fs.readFileSync(filename, 'utf8');
+  const re = /^#define\s+WIDGET_PROP_([A-Z0-9_]+)\s+"([^"]*)"/gm;
+  let m = null;
+
+  while ((m = re.exec(content)) !== null) {
+    if (props.find(iter => iter.value === m[2])) {
+      console.log(`skip duplicated value: WIDGET_PROP_${m[1]} "${m[2]}"`);
+      continue;
+    }
+    props.push({ name: m[1], value: m[2], key: keyOf(m[2]) });
+  }
+
+  if (props.length > 0xff) {
+    throw new Error('too many props, s_widget_prop_slots need uint16_t.');
+  }
+
+  props.forEach((iter, i) => {
+    const other = props.findIndex(p => p.key === iter.key);
+    if (other !== i) {
+      throw new Error(`key conflict: "${iter.value}" "${props[other].value}"`);
+    }
+  });
+
+  return props;
+}
+
+function bitsOf(n) {
+  let bits = 1;
+  while ((1 << bits) < n) {
+    bits++;
+  }
+  return bits;
+}
+
+function genTable(props) {
+  const slotsBits = bitsOf(Math.ceil(props.length * 1.5));
+  const bucketsBits = bitsOf(Math.ceil(props.length / 4));
+  const slotsNr = 1 << slotsBits;
+  const bucketsNr = 1 << bucketsBits;
+  const buckets = [];
+  const slots = new Array(slotsNr).fill(0);
+  const seeds = new Array(bucketsNr).fill(0);
+
+  for (let i = 0; i < bucketsNr; i++) {
+    buckets.push({ index: i, ids: [] });
+  }
+
+  props.forEach((iter, i) => {
+    buckets[bucketOf(iter.key, bucketsBits)].ids.push(i + 1);
+  });
+
+  buckets.sort((a, b) => b.ids.length - a.ids.length || a.index - b.index);
+  buckets.forEach(bucket => {
+    if (bucket.ids.length === 0) {
+      return;
+    }
+
+    for (let seed = 0; seed <= SEED_MAX; seed++) {
+      const used = bucket.ids.map(id => slotOf(props[id - 1].key, seed, slotsBits));
+      const ok = used.every((slot, i) => slots[slot] === 0 && used.indexOf(slot) === i);
+
+      if (ok) {
+        used.forEach((slot, i) => {
+          slots[slot] = bucket.ids[i];
+        });
+        seeds[bucket.index] = seed;
+        return;
+      }
+    }
+
+    throw new Error('no seed found, enlarge the table.');
+  });
+
+  return { slotsBits, bucketsBits, slotsNr, bucketsNr, slots, seeds };
+}
+
+function fileHeader(filename, brief) {
+  return `${BOM}/**
+ * File:   ${filename}
+ * Author: AWTK Develop Team
+ * Brief:  ${brief}
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-18 AWTK Develop Team created
+ *
+ */
+
+/*本文件由tools/prop_hash_gen根据widget_consts.h生成，请不要手工修改。*/
+`;
+}
+
+function formatList(items, indent, width) {
+  const lines = [];
+  let line = '';
+
+  items.forEach((iter, i) => {
+    const item = i + 1 < items.length ? `${iter}, ` : `${iter}`;
+    if (line.length + item.trimEnd().length > width - indent.length) {
+      lines.push(indent + line.trimEnd());
+      line = '';
+    }
+    line += item;
+  });
+
+  if (line.length > 0) {
+    lines.push(indent + line.trimEnd());
+  }
+
+  return lines.join('\n');
+}
+
+function genHeader(props) {
+  let result = fileHeader('widget_prop_ids.h', 'ids of builtin widget properties');
+
+  result += `
+#ifndef TK_WIDGET_PROP_IDS_H
+#define TK_WIDGET_PROP_IDS_H
+
+#include "base/widget_consts.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @enum widget_prop_id_t
+ * @prefix WIDGET_PROP_ID_
+ * 内置控件属性(WIDGET\\_PROP\\_*)的数字ID。
+ *
+ * 用于按ID分发属性，而不是逐个比较属性名。ID只在同一次编译中有效，不要保存。
+ */
+typedef enum _widget_prop_id_t {
+  /**
+   * @const WIDGET_PROP_ID_NONE
+   * 不是内置的属性。
+   */
+  WIDGET_PROP_ID_NONE = 0,
+`;
+
+  props.forEach(iter => {
+    result += `  WIDGET_PROP_ID_${iter.name},\n`;
+  });
+
+  result += `  /**
+   * @const WIDGET_PROP_ID_NR
+   * ID的个数。
+   */
+  WIDGET_PROP_ID_NR
+} widget_prop_id_t;
+
+/**
+ * @method widget_prop_id_from_name
+ * 获取属性名对应的ID(使用完美哈希表，只需要计算一次哈希值和比较一次字符串)。
+ * @param {const char*} name 属性名。
+ *
+ * @return {widget_prop_id_t} 返回ID，不是内置的属性时返回WIDGET\\_PROP\\_ID\\_NONE。
+ */
+widget_prop_id_t widget_prop_id_from_name(const char* name);
+
+/**
+ * @method widget_prop_name_from_id
+ * 获取ID对应的属性名。
+ * @param {widget_prop_id_t} id 属性ID。
+ *
+ * @return {const char*} 返回属性名，ID无效时返回NULL。
+ */
+const char* widget_prop_name_from_id(widget_prop_id_t id);
+
+END_C_DECLS
+
+#endif /*TK_WIDGET_PROP_IDS_H*/
+`;
+
+  return result;
+}
+
+function genHotSwitch(props) {
+  const groups = {};
+  let result = '';
+
+  HOT_PROPS.forEach(name => {
+    const prop = props.find(iter => iter.name === name);
+    if (!prop) {
+      throw new Error(`hot prop not found: WIDGET_PROP_${name}`);
+    }
+
+    const c = prop.value[0];
+    groups[c] = groups[c] || [];
+    groups[c].push(prop);
+  });
+
+  Object.keys(groups).forEach(c => {
+    result += `    case '${c}': {\n`;
+    groups[c].forEach(prop => {
+      if (prop.value.length === 1) {
+        result += `      if (name[1] == '\\0') {\n`;
+      } else {
+        result += `      if (strcmp(name + 1, WIDGET_PROP_${prop.name} + 1) == 0) {\n`;
+      }
+      result += `        return WIDGET_PROP_ID_${prop.name};\n`;
+      result += `      }\n`;
+    });
+    result += `      break;\n`;
+    result += `    }\n`;
+  });
+
+  return result;
+}
+
+function genSource(props, table) {
+  let result = fileHeader('widget_prop_ids.c', 'ids of builtin widget properties');
+  const names = ['NULL'].concat(props.map(iter => `WIDGET_PROP_${iter.name}`));
+  const lens = [0].concat(props.map(iter => Buffer.byteLength(iter.value, 'utf8')));
+
+  result += `
+#include "tkc/utils.h"
+#include "base/widget_prop_ids.h"
+
+#define WIDGET_PROP_HASH_SLOTS_BITS ${table.slotsBits}
+#define WIDGET_PROP_HASH_BUCKETS_BITS ${table.bucketsBits}
+
+static const char* const s_widget_prop_names[WIDGET_PROP_ID_NR] = {
+${formatList(names, '    ', 100)}};
+
+static const uint8_t s_widget_prop_lens[WIDGET_PROP_ID_NR] = {
+${formatList(lens, '    ', 100)}};
+
+static const uint16_t s_widget_prop_seeds[1 << WIDGET_PROP_HASH_BUCKETS_BITS] = {
+${formatList(table.seeds, '    ', 100)}};
+
+static const uint8_t s_widget_prop_slots[1 << WIDGET_PROP_HASH_SLOTS_BITS] = {
+${formatList(table.slots, '    ', 100)}};
+
+/*
+ * 调用者通常直接使用WIDGET_PROP_*常量，链接器会合并相同的字符串常量，
+ * 所以按地址缓存最近查到的ID。只缓存与s_widget_prop_names中地址相同的名称，
+ * 命中时不需要再比较内容(多线程同时写入也只会导致不命中)。
+ */
+#define WIDGET_PROP_ADDR_CACHE_NR 64
+static uint8_t s_widget_prop_addr_cache[WIDGET_PROP_ADDR_CACHE_NR];
+
+static uint32_t widget_prop_addr_cache_index(const char* name) {
+  uintptr_t addr = (uintptr_t)name;
+
+  return (uint32_t)((addr ^ (addr >> 6)) & (WIDGET_PROP_ADDR_CACHE_NR - 1));
+}
+
+/*最常用的属性按首字符直接比较，不是这些属性时返回WIDGET_PROP_ID_NONE*/
+static widget_prop_id_t widget_prop_id_from_hot_name(const char* name) {
+  switch (name[0]) {
+${genHotSwitch(props)}    default: {
+      break;
+    }
+  }
+
+  return WIDGET_PROP_ID_NONE;
+}
+
+widget_prop_id_t widget_prop_id_from_name(const char* name) {
+  uint32_t id = 0;
+  uint32_t key = 0;
+  uint32_t len = 0;
+  uint32_t index = 0;
+  const uint8_t* p = (const uint8_t*)name;
+
+  if (name == NULL || *name == '\\0') {
+    return WIDGET_PROP_ID_NONE;
+  }
+
+  index = widget_prop_addr_cache_index(name);
+  id = s_widget_prop_addr_cache[index];
+  if (s_widget_prop_names[id] == name) {
+    return (widget_prop_id_t)id;
+  }
+
+  id = widget_prop_id_from_hot_name(name);
+  if (id != WIDGET_PROP_ID_NONE) {
+    return (widget_prop_id_t)id;
+  }
+
+  len = strlen(name);
+  if (len > 0xff) {
+    return WIDGET_PROP_ID_NONE;
+  }
+
+  /*键只取长度和五个位置的字符，与tools/prop_hash_gen中的keyOf一致*/
+  key = (p[0] | (p[1] << 8) | (p[len >> 1] << 16) | ((uint32_t)p[len - 1] << 24)) ^
+        ((len | (p[(len >> 1) + (len >> 2)] << 8)) * 0x9e3779b1u);
+  key ^= s_widget_prop_seeds[(key * 0x85ebca6bu) >> (32 - WIDGET_PROP_HASH_BUCKETS_BITS)] *
+         0x27d4eb2fu;
+  id = s_widget_prop_slots[(key * 0xc2b2ae35u) >> (32 - WIDGET_PROP_HASH_SLOTS_BITS)];
+
+  if (id != 0 && s_widget_prop_lens[id] == len) {
+    if (s_widget_prop_names[id] == name) {
+      s_widget_prop_addr_cache[index] = (uint8_t)id;
+      return (widget_prop_id_t)id;
+    } else if (memcmp(s_widget_prop_names[id], name, len) == 0) {
+      return (widget_prop_id_t)id;
+    }
+  }
+
+  return WIDGET_PROP_ID_NONE;
+}
+
+const char* widget_prop_name_from_id(widget_prop_id_t id) {
+  return (uint32_t)id < WIDGET_PROP_ID_NR ? s_widget_prop_names[id] : NULL;
+}
+`;
+
+  return result;
+}
+
+function gen(input, outputDir) {
+  const props = parseProps(input);
+  const table = genTable(props);
+
+  fs.writeFileSync(path.join(outputDir, 'widget_prop_ids.h'), genHeader(props));
+  fs.writeFileSync(path.join(outputDir, 'widget_prop_ids.c'), genSource(props, table));
+  console.log(`${props.length} props, ${table.slotsNr} slots, ${table.bucketsNr} buckets.`);
+}
+
+let input = path.normalize(path.join(__dirname, '../../src/base/widget_consts.h'));
+let outputDir = path.normalize(path.join(__dirname, '../../src/base'));
+
+if (process.argv.length >= 4) {
+  input = process.argv[2];
+  outputDir = process.argv[3];
+} else if (process.argv.length != 2) {
+  console.log('Usage: node index.js widget_consts.h output_dir');
+  process.exit(0);
+}
+
+gen(input, outputDir);
@@ -90,17 +90,69 @@ bool Style::Merge(Style& other) {
 }
 
 ret_t Style::Output(wbuffer_t* wbuffer) {
+  uint32_t i = 0;
   uint32_t size = 0;
+  uint32_t words = 0;
+  uint32_t header_size = 0;
+  wbuffer_t values;
+  const uint8_t* p = NULL;
+  map<uint32_t, uint32_t> offsets;
 
   size = uint_values.Size() + int_values.Size() + str_values.Size() + bin_values.Size();
   log_debug("  size=%d widget_type=%s name=%s state=%s\n", size, this->widget_type.c_str(),
             this->name.c_str(), this->state.c_str());
 
-  wbuffer_write_uint32(wbuffer, size);
-  int_values.WriteToWbuffer(wbuffer);
-  uint_values.WriteToWbuffer(wbuffer);
-  str_values.WriteToWbuffer(wbuffer);
-  bin_values.WriteToWbuffer(wbuffer);
+  wbuffer_init_extendable(&values);
+  int_values.WriteToWbuffer(&values);
+  uint_values.WriteToWbuffer(&values);
+  str_values.WriteToWbuffer(&values);
+  bin_values.WriteToWbuffer(&values);
+
+  /*记录预定义属性的位置(同名时取第一个，与按名称查找的结果一致)*/
+  p = values.data;
+  for (i = 0; i < size; i++) {
+    const style_name_value_header_t* nv = (const style_name_value_header_t*)p;
+    uint32_t id = style_prop_id_from_name((const char*)(p + sizeof(style_name_value_header_t)));
+
+    if (id != STYLE_PROP_ID_INVALID && offsets.find(id) == offsets.end()) {
+      offsets[id] = p - values.data;
+    }
+    p += sizeof(style_name_value_header_t) + nv->name_size + nv->value_size;
+  }
+
+  if (!offsets.empty()) {
+    words = offsets.rbegin()->first / 32 + 1;
+    header_size = TK_ROUND_TO(8 + words * 4 + offsets.size() * 2, 4);
+    if (header_size + values.cursor > 0xffff) {
+      /*偏移量超出uint16的范围，使用不带索引的格式*/
+      offsets.clear();
+    }
+  }
+
+  if (offsets.empty()) {
+    wbuffer_write_uint32(wbuffer, size);
+  } else {
+    vector<uint32_t> bitmap(words, 0);
+    map<uint32_t, uint32_t>::iterator iter;
+
+    for (iter = offsets.begin(); iter != offsets.end(); iter++) {
+      bitmap[iter->first / 32] |= 1u << (iter->first % 32);
+    }
+
+    wbuffer_write_uint32(wbuffer, size | STYLE_DATA_INDEXED);
+    wbuffer_write_uint32(wbuffer, words);
+    for (i = 0; i < words; i++) {
+      wbuffer_write_uint32(wbuffer, bitmap[i]);
+    }
+    for (iter = offsets.begin(); iter != offsets.end(); iter++) {
+      wbuffer_write_uint16(wbuffer, header_size + iter->second);
+    }
+    for (i = 8 + words * 4 + offsets.size() * 2; i < header_size; i++) {
+      wbuffer_write_uint8(wbuffer, 0);
+    }
+  }
+  wbuffer_write_binary(wbuffer, values.data, values.cursor);
+  wbuffer_deinit(&values);
 
   return RET_OK;
 }
@@ -22,12 +22,14 @@
 #ifndef TK_THEME_GEN_H
 #define TK_THEME_GEN_H
 
+#include <map>
 #include <string>
 #include <vector>
 #include "tkc/types_def.h"
 #include "base/theme.h"
 #include "tkc/buffer.h"
 
+using std::map;
 using std::string;
 using std::vector;
 